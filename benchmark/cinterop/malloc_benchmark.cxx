@@ -0,0 +1,114 @@
+///
+/// An allocation heavy workload that only uses the C allocation functions, so the
+/// same binary can be run against the system allocator and, with
+/// LD_PRELOAD=libturbo_malloc.so, against untyped_allocator
+///
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+
+const std::size_t slot_count = 4096U;
+
+///
+/// Mostly small objects with a tail of larger buffers
+///
+std::size_t pick_size(std::mt19937& engine)
+{
+    const std::uint32_t roll = engine() % 100U;
+    if (roll < 80U)
+    {
+	return 16U + engine() % 240U;
+    }
+    else if (roll < 95U)
+    {
+	return 256U + engine() % 3840U;
+    }
+    else
+    {
+	return 4096U + engine() % 61440U;
+    }
+}
+
+void churn(std::size_t seed, std::size_t iterations)
+{
+    std::mt19937 engine(seed);
+    std::vector<void*> slots(slot_count, nullptr);
+    for (std::size_t iteration = 0U; iteration < iterations; ++iteration)
+    {
+	void*& slot = slots[engine() % slot_count];
+	std::free(slot);
+	const std::size_t size = pick_size(engine);
+	slot = std::malloc(size);
+	static_cast<char*>(slot)[0] = 1;
+	static_cast<char*>(slot)[size - 1U] = 1;
+    }
+    for (void* slot : slots)
+    {
+	std::free(slot);
+    }
+}
+
+std::size_t read_resident_kb()
+{
+    std::ifstream statm("/proc/self/statm");
+    std::size_t total = 0U;
+    std::size_t resident = 0U;
+    statm >> total >> resident;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) / 1024U;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    std::size_t iterations = 1000000U;
+    if (argc > 1)
+    {
+	max_threads = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2)
+    {
+	iterations = std::strtoul(argv[2], nullptr, 10);
+    }
+    max_threads = max_threads == 0U ? 1U : max_threads;
+    const char* preload = std::getenv("LD_PRELOAD");
+    std::cout << "allocator: " << (preload == nullptr ? "system" : preload) << ", " << iterations << " free/malloc pairs per thread" << std::endl;
+    std::cout << std::setw(8) << "threads"
+	    << std::setw(16) << "Mops/s"
+	    << std::setw(20) << "peak RSS (KB)"
+	    << std::setw(20) << "final RSS (KB)" << std::endl;
+    for (std::size_t thread_count = 1U; thread_count <= max_threads; thread_count *= 2U)
+    {
+	std::vector<std::thread> threads;
+	auto begin = std::chrono::steady_clock::now();
+	for (std::size_t index = 0U; index < thread_count; ++index)
+	{
+	    threads.emplace_back(churn, index + 1U, iterations);
+	}
+	for (auto&& thread : threads)
+	{
+	    thread.join();
+	}
+	auto elapsed = std::chrono::steady_clock::now() - begin;
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	const double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+	std::cout << std::setw(8) << thread_count
+		<< std::setw(16) << std::fixed << std::setprecision(2) << (thread_count * iterations) / seconds / 1000000.0
+		<< std::setw(20) << usage.ru_maxrss
+		<< std::setw(20) << read_resident_kb() << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+///
+/// Grows many buffers a few bytes at a time, comparing untyped_allocator::realloc
+/// with the malloc, memcpy and free sequence callers had to write before it existed
+///
+#include <turbo/cinterop/untyped_allocator.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace tci = turbo::cinterop;
+namespace tme = turbo::memory;
+
+namespace {
+
+const std::size_t buffer_count = 256U;
+const std::size_t max_size = 4096U;
+
+std::vector<tme::block_config> make_config()
+{
+    std::vector<tme::block_config> config;
+    for (std::size_t size = 16U; size <= max_size; size *= 2U)
+    {
+	config.emplace_back(size, static_cast<std::uint32_t>(buffer_count * 2U));
+    }
+    return config;
+}
+
+struct result
+{
+    double nanoseconds;
+    std::size_t copied;
+};
+
+void* copy_resize(tci::untyped_allocator& allocator, void* ptr, std::size_t old_size, std::size_t size, std::size_t& copied)
+{
+    void* output = allocator.malloc(size);
+    std::memcpy(output, ptr, old_size);
+    copied += old_size;
+    allocator.free(ptr);
+    return output;
+}
+
+void* realloc_resize(tci::untyped_allocator& allocator, void* ptr, std::size_t old_size, std::size_t size, std::size_t& copied)
+{
+    void* output = allocator.realloc(ptr, size);
+    if (output != ptr)
+    {
+	copied += std::min(allocator.usable_size(output), old_size);
+    }
+    return output;
+}
+
+template <class resize_t>
+result measure(std::size_t step, std::size_t rounds, resize_t resize)
+{
+    tci::untyped_allocator allocator(buffer_count, make_config());
+    std::vector<void*> buffers(buffer_count, nullptr);
+    std::chrono::steady_clock::duration elapsed(0);
+    std::size_t operations = 0U;
+    std::size_t copied = 0U;
+    for (std::size_t round = 0U; round < rounds; ++round)
+    {
+	for (void*& buffer : buffers)
+	{
+	    buffer = allocator.malloc(step);
+	}
+	auto begin = std::chrono::steady_clock::now();
+	for (std::size_t size = step; size + step <= max_size; size += step)
+	{
+	    for (void*& buffer : buffers)
+	    {
+		buffer = resize(allocator, buffer, size, size + step, copied);
+	    }
+	    operations += buffers.size();
+	}
+	elapsed += std::chrono::steady_clock::now() - begin;
+	for (void* buffer : buffers)
+	{
+	    allocator.free(buffer);
+	}
+    }
+    return { static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / operations, copied / rounds };
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t rounds = 20U;
+    if (argc > 1)
+    {
+	rounds = std::strtoul(argv[1], nullptr, 10);
+    }
+    std::cout << buffer_count << " buffers grown up to " << max_size << " bytes" << std::endl;
+    std::cout << std::setw(8) << "step"
+	    << std::setw(18) << "copy (ns/op)"
+	    << std::setw(18) << "realloc (ns/op)"
+	    << std::setw(18) << "copy (KB)"
+	    << std::setw(18) << "realloc (KB)" << std::endl;
+    for (std::size_t step : { 8U, 64U, 256U })
+    {
+	const result copy = measure(step, rounds, copy_resize);
+	const result grow = measure(step, rounds, realloc_resize);
+	std::cout << std::setw(8) << step
+		<< std::setw(18) << std::fixed << std::setprecision(1) << copy.nanoseconds
+		<< std::setw(18) << grow.nanoseconds
+		<< std::setw(18) << copy.copied / 1024U
+		<< std::setw(18) << grow.copied / 1024U << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include <turbo/container/mpmc_ring_queue.hpp>
+#include <turbo/container/mpmc_ring_queue.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace tco = turbo::container;
+
+namespace {
+
+const std::uint32_t queue_capacity = 1024U;
+
+struct record
+{
+    std::uint64_t sequence;
+    std::array<std::uint64_t, 3> payload;
+};
+
+inline void set_sequence(std::uint32_t& value, std::uint64_t sequence) { value = static_cast<std::uint32_t>(sequence); }
+inline void set_sequence(record& value, std::uint64_t sequence) { value.sequence = sequence; }
+inline std::uint64_t get_sequence(const std::uint32_t& value) { return value; }
+inline std::uint64_t get_sequence(const record& value) { return value.sequence; }
+
+struct outcome
+{
+    double items_per_second;
+    ///
+    /// Attempts that lost a race or hit a half finished slot, per item
+    ///
+    double contended_per_item;
+};
+
+///
+/// Moves items from every producer to the consumers, yielding whenever an attempt
+/// does not succeed so oversubscribed machines still make progress
+///
+template <class value_t>
+outcome measure(std::uint32_t producer_count, std::uint32_t consumer_count, std::uint64_t items)
+{
+    typedef tco::mpmc_ring_queue<value_t> queue_type;
+    queue_type queue(queue_capacity, static_cast<std::uint16_t>(producer_count + consumer_count));
+    const std::uint64_t per_producer = items / producer_count;
+    const std::uint64_t total = per_producer * producer_count;
+    std::atomic<std::uint64_t> consumed(0U);
+    std::atomic<std::uint64_t> contended(0U);
+    std::atomic<std::uint64_t> checksum(0U);
+    std::vector<std::thread> threads;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::uint32_t producer_index = 0U; producer_index < producer_count; ++producer_index)
+    {
+	threads.emplace_back([&] ()
+	{
+	    typename queue_type::producer& producer = queue.get_producer();
+	    std::uint64_t local_contended = 0U;
+	    value_t value = value_t();
+	    for (std::uint64_t count = 0U; count < per_producer;)
+	    {
+		set_sequence(value, count);
+		switch (producer.try_enqueue_copy(value))
+		{
+		    case queue_type::producer::result::success:
+		    {
+			++count;
+			break;
+		    }
+		    case queue_type::producer::result::queue_full:
+		    {
+			std::this_thread::yield();
+			break;
+		    }
+		    default:
+		    {
+			++local_contended;
+			std::this_thread::yield();
+			break;
+		    }
+		}
+	    }
+	    contended.fetch_add(local_contended);
+	});
+    }
+    for (std::uint32_t consumer_index = 0U; consumer_index < consumer_count; ++consumer_index)
+    {
+	threads.emplace_back([&] ()
+	{
+	    typename queue_type::consumer& consumer = queue.get_consumer();
+	    std::uint64_t local_contended = 0U;
+	    std::uint64_t local_checksum = 0U;
+	    value_t value = value_t();
+	    while (consumed.load(std::memory_order_relaxed) < total)
+	    {
+		switch (consumer.try_dequeue_copy(value))
+		{
+		    case queue_type::consumer::result::success:
+		    {
+			local_checksum += get_sequence(value);
+			consumed.fetch_add(1U, std::memory_order_relaxed);
+			break;
+		    }
+		    case queue_type::consumer::result::queue_empty:
+		    {
+			std::this_thread::yield();
+			break;
+		    }
+		    default:
+		    {
+			++local_contended;
+			std::this_thread::yield();
+			break;
+		    }
+		}
+	    }
+	    contended.fetch_add(local_contended);
+	    checksum.fetch_add(local_checksum);
+	});
+    }
+    for (std::thread& thread : threads)
+    {
+	thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    if (checksum.load() != producer_count * (per_producer * (per_producer - 1U) / 2U))
+    {
+	std::cerr << "values were lost or duplicated" << std::endl;
+    }
+    const double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+    return outcome { total / seconds, static_cast<double>(contended.load()) / total };
+}
+
+template <class value_t>
+void report(const char* name, std::uint64_t items)
+{
+    static const std::array<std::pair<std::uint32_t, std::uint32_t>, 7> ratios { {
+	    {1U, 1U}, {1U, 4U}, {4U, 1U}, {2U, 2U}, {4U, 4U}, {8U, 8U}, {16U, 16U} } };
+    for (auto& ratio : ratios)
+    {
+	const outcome result = measure<value_t>(ratio.first, ratio.second, items);
+	std::cout << std::setw(12) << name
+		<< std::setw(11) << ratio.first << ':' << std::left << std::setw(8) << ratio.second << std::right
+		<< std::setw(16) << result.items_per_second / 1000000.0
+		<< std::setw(16) << result.contended_per_item << std::endl;
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::uint64_t items = 2000000U;
+    if (argc > 1)
+    {
+	items = std::strtoull(argv[1], nullptr, 10);
+    }
+    std::cout << items << " items through a queue of " << queue_capacity << " slots on "
+	    << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    std::cout << std::setw(12) << "value" << std::setw(20) << "producers:consumers"
+	    << std::setw(16) << "M items/sec" << std::setw(16) << "contended/item" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    report<std::uint32_t>("uint32_t", items);
+    report<record>("32B record", items);
+    return 0;
+}
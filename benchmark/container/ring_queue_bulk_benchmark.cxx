@@ -0,0 +1,190 @@
+#include <turbo/container/mpmc_ring_queue.hpp>
+#include <turbo/container/mpmc_ring_queue.hh>
+#include <turbo/container/spsc_ring_queue.hpp>
+#include <turbo/container/spsc_ring_queue.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace tco = turbo::container;
+
+namespace {
+
+const std::uint32_t queue_capacity = 1024U;
+const std::uint32_t max_batch = 64U;
+
+struct record
+{
+    std::uint64_t sequence;
+    std::array<std::uint64_t, 3> payload;
+};
+
+inline void set_sequence(std::uint64_t& value, std::uint64_t sequence) { value = sequence; }
+inline void set_sequence(record& value, std::uint64_t sequence) { value.sequence = sequence; }
+inline std::uint64_t get_sequence(const std::uint64_t& value) { return value; }
+inline std::uint64_t get_sequence(const record& value) { return value.sequence; }
+
+///
+/// Enqueues batch values with the single item path, or with one bulk call when the
+/// batch is bigger than one, returning how many were enqueued
+///
+template <class producer_t, class value_t>
+std::uint32_t enqueue(producer_t& producer, const std::array<value_t, max_batch>& input, std::uint32_t batch)
+{
+    if (batch == 1U)
+    {
+	return producer.try_enqueue_copy(input[0]) == producer_t::result::success ? 1U : 0U;
+    }
+    std::uint32_t count = 0U;
+    producer.try_enqueue_bulk(input.cbegin(), input.cbegin() + batch, count);
+    return count;
+}
+
+template <class consumer_t, class value_t>
+std::uint32_t dequeue(consumer_t& consumer, std::array<value_t, max_batch>& output, std::uint32_t batch)
+{
+    if (batch == 1U)
+    {
+	return consumer.try_dequeue_copy(output[0]) == consumer_t::result::success ? 1U : 0U;
+    }
+    std::uint32_t count = 0U;
+    consumer.try_dequeue_bulk(output.begin(), batch, count);
+    return count;
+}
+
+///
+/// Fills and drains the queue on one thread, so only the cost of the operations is measured
+///
+template <class value_t, class producer_t, class consumer_t>
+double measure_uncontended(producer_t& producer, consumer_t& consumer, std::uint64_t items, std::uint32_t batch)
+{
+    std::array<value_t, max_batch> input;
+    std::array<value_t, max_batch> output;
+    for (std::uint32_t index = 0U; index < max_batch; ++index)
+    {
+	set_sequence(input[index], index);
+    }
+    std::uint64_t checksum = 0U;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::uint64_t moved = 0U; moved < items;)
+    {
+	for (std::uint32_t filled = 0U; filled + batch <= queue_capacity; filled += batch)
+	{
+	    enqueue(producer, input, batch);
+	}
+	for (std::uint32_t drained = 0U; drained < queue_capacity;)
+	{
+	    const std::uint32_t count = dequeue(consumer, output, batch);
+	    for (std::uint32_t index = 0U; index < count; ++index)
+	    {
+		checksum += get_sequence(output[index]);
+	    }
+	    drained += count;
+	}
+	moved += queue_capacity;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    const std::uint64_t rounds = (items + queue_capacity - 1U) / queue_capacity;
+    if (checksum != rounds * (queue_capacity / batch) * (batch * (batch - 1U) / 2U))
+    {
+	std::cerr << "values were lost or duplicated" << std::endl;
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / items;
+}
+
+///
+/// Streams items from a producer thread to a consumer thread
+///
+template <class value_t, class producer_t, class consumer_t>
+double measure_transfer(producer_t& producer, consumer_t& consumer, std::uint64_t items, std::uint32_t batch)
+{
+    auto begin = std::chrono::steady_clock::now();
+    std::thread producer_thread([&producer, items, batch] ()
+    {
+	std::array<value_t, max_batch> input;
+	for (std::uint64_t sent = 0U; sent < items;)
+	{
+	    for (std::uint32_t index = 0U; index < batch; ++index)
+	    {
+		set_sequence(input[index], sent + index);
+	    }
+	    const std::uint32_t count = enqueue(producer, input, batch);
+	    sent += count;
+	    if (count == 0U)
+	    {
+		std::this_thread::yield();
+	    }
+	}
+    });
+    std::array<value_t, max_batch> output;
+    std::uint64_t checksum = 0U;
+    for (std::uint64_t received = 0U; received < items;)
+    {
+	const std::uint32_t count = dequeue(consumer, output, batch);
+	for (std::uint32_t index = 0U; index < count; ++index)
+	{
+	    checksum += get_sequence(output[index]);
+	}
+	received += count;
+	if (count == 0U)
+	{
+	    std::this_thread::yield();
+	}
+    }
+    producer_thread.join();
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    if (checksum != items * (items - 1U) / 2U)
+    {
+	std::cerr << "values were lost or duplicated" << std::endl;
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / items;
+}
+
+template <class value_t>
+void report(const char* name, std::uint64_t items)
+{
+    static const std::array<std::uint32_t, 4> batches { {1U, 4U, 16U, 64U} };
+    for (std::uint32_t batch : batches)
+    {
+	// whole batches only, so every bulk call can be given a full batch
+	const std::uint64_t whole = items - items % batch;
+	tco::mpmc_ring_queue<value_t> mpmc_queue(queue_capacity, 1U);
+	auto& mpmc_producer = mpmc_queue.get_producer();
+	auto& mpmc_consumer = mpmc_queue.get_consumer();
+	const double mpmc_alone = measure_uncontended<value_t>(mpmc_producer, mpmc_consumer, whole, batch);
+	const double mpmc_transfer = measure_transfer<value_t>(mpmc_producer, mpmc_consumer, whole, batch);
+	tco::spsc_ring_queue<value_t> spsc_queue(queue_capacity);
+	auto& spsc_producer = spsc_queue.get_producer();
+	auto& spsc_consumer = spsc_queue.get_consumer();
+	const double spsc_alone = measure_uncontended<value_t>(spsc_producer, spsc_consumer, whole, batch);
+	const double spsc_transfer = measure_transfer<value_t>(spsc_producer, spsc_consumer, whole, batch);
+	std::cout << std::setw(12) << name << std::setw(8) << batch
+		<< std::setw(14) << mpmc_alone << std::setw(14) << mpmc_transfer
+		<< std::setw(14) << spsc_alone << std::setw(14) << spsc_transfer << std::endl;
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::uint64_t items = 4000000U;
+    if (argc > 1)
+    {
+	items = std::strtoull(argv[1], nullptr, 10);
+    }
+    std::cout << "ns per item for " << items << " items through queues of " << queue_capacity << " slots; "
+	    << "batch 1 uses the single item operations" << std::endl;
+    std::cout << std::setw(12) << "value" << std::setw(8) << "batch"
+	    << std::setw(14) << "mpmc alone" << std::setw(14) << "mpmc 1:1"
+	    << std::setw(14) << "spsc alone" << std::setw(14) << "spsc 1:1" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    report<std::uint64_t>("uint64_t", items);
+    report<record>("32B record", items);
+    return 0;
+}
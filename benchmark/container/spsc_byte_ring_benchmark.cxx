@@ -0,0 +1,264 @@
+#include <turbo/container/spsc_byte_ring.hpp>
+#include <turbo/container/spsc_byte_ring.hh>
+#include <turbo/container/spsc_ring_queue.hpp>
+#include <turbo/container/spsc_ring_queue.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tco = turbo::container;
+
+namespace {
+
+const std::uint32_t min_length = 16U;
+const std::uint32_t max_length = 1500U;
+const std::uint32_t ring_bytes = 1U << 20U;
+const std::uint32_t queue_capacity = 1024U;
+
+///
+/// Message lengths spread between min_length and max_length, generated up front so the
+/// measurement does not include the generator
+///
+std::vector<std::uint32_t> make_lengths(std::uint32_t count)
+{
+    std::vector<std::uint32_t> lengths;
+    lengths.reserve(count);
+    std::uint32_t state = 12345U;
+    for (std::uint32_t index = 0U; index < count; ++index)
+    {
+	state = state * 1103515245U + 12345U;
+	lengths.push_back(min_length + (state >> 8U) % (max_length - min_length + 1U));
+    }
+    return lengths;
+}
+
+struct padded_slot
+{
+    std::uint32_t length;
+    std::array<std::uint8_t, max_length> bytes;
+};
+
+///
+/// Writes the sequence number at the front of the message and fills the rest
+///
+inline void fill(std::uint8_t* message, std::uint32_t length, std::uint64_t sequence)
+{
+    std::memcpy(message, &sequence, sizeof(sequence));
+    std::memset(message + sizeof(sequence), static_cast<int>(sequence), length - sizeof(sequence));
+}
+
+inline std::uint64_t read_sequence(const std::uint8_t* message)
+{
+    std::uint64_t sequence = 0U;
+    std::memcpy(&sequence, message, sizeof(sequence));
+    return sequence;
+}
+
+///
+/// Messages built in place with reserve and commit, and read in place with peek and release
+///
+struct byte_ring_in_place
+{
+    static const char* name() { return "byte ring in place"; }
+    static std::uint32_t footprint() { return ring_bytes; }
+    tco::spsc_byte_ring<> ring;
+    tco::spsc_byte_ring<>::producer& producer;
+    tco::spsc_byte_ring<>::consumer& consumer;
+    byte_ring_in_place() : ring(ring_bytes), producer(ring.get_producer()), consumer(ring.get_consumer()) { }
+    bool send(std::uint32_t length, std::uint64_t sequence, std::uint8_t*)
+    {
+	std::uint8_t* storage = producer.reserve(length);
+	if (storage == nullptr)
+	{
+	    return false;
+	}
+	fill(storage, length, sequence);
+	producer.commit(length);
+	return true;
+    }
+    bool receive(std::uint64_t& sequence, std::uint32_t& length, std::uint8_t*)
+    {
+	const std::uint8_t* message = consumer.peek(length);
+	if (message == nullptr)
+	{
+	    return false;
+	}
+	sequence = read_sequence(message);
+	consumer.release();
+	return true;
+    }
+};
+
+///
+/// Messages built in a scratch buffer and copied through the ring with try_write and try_read
+///
+struct byte_ring_copy
+{
+    static const char* name() { return "byte ring copy"; }
+    static std::uint32_t footprint() { return ring_bytes; }
+    tco::spsc_byte_ring<> ring;
+    tco::spsc_byte_ring<>::producer& producer;
+    tco::spsc_byte_ring<>::consumer& consumer;
+    byte_ring_copy() : ring(ring_bytes), producer(ring.get_producer()), consumer(ring.get_consumer()) { }
+    bool send(std::uint32_t length, std::uint64_t sequence, std::uint8_t* scratch)
+    {
+	fill(scratch, length, sequence);
+	return producer.try_write(scratch, length) == tco::spsc_byte_ring<>::producer::result::success;
+    }
+    bool receive(std::uint64_t& sequence, std::uint32_t& length, std::uint8_t* scratch)
+    {
+	if (consumer.try_read(scratch, max_length, length) != tco::spsc_byte_ring<>::consumer::result::success)
+	{
+	    return false;
+	}
+	sequence = read_sequence(scratch);
+	return true;
+    }
+};
+
+///
+/// Every slot padded to the largest message
+///
+struct padded_queue
+{
+    static const char* name() { return "padded slots"; }
+    static std::uint32_t footprint() { return queue_capacity * sizeof(padded_slot); }
+    tco::spsc_ring_queue<padded_slot> queue;
+    tco::spsc_ring_queue<padded_slot>::producer& producer;
+    tco::spsc_ring_queue<padded_slot>::consumer& consumer;
+    padded_queue() : queue(queue_capacity), producer(queue.get_producer()), consumer(queue.get_consumer()) { }
+    bool send(std::uint32_t length, std::uint64_t sequence, std::uint8_t*)
+    {
+	void* storage = producer.reserve();
+	if (storage == nullptr)
+	{
+	    return false;
+	}
+	padded_slot* slot = new (storage) padded_slot;
+	slot->length = length;
+	fill(slot->bytes.data(), length, sequence);
+	producer.commit();
+	return true;
+    }
+    bool receive(std::uint64_t& sequence, std::uint32_t& length, std::uint8_t*)
+    {
+	padded_slot* slot = consumer.peek();
+	if (slot == nullptr)
+	{
+	    return false;
+	}
+	length = slot->length;
+	sequence = read_sequence(slot->bytes.data());
+	consumer.release();
+	return true;
+    }
+};
+
+///
+/// A heap allocation for every message
+///
+struct allocating_queue
+{
+    static const char* name() { return "vector per message"; }
+    static std::uint32_t footprint() { return queue_capacity * sizeof(std::vector<std::uint8_t>); }
+    typedef tco::spsc_ring_queue<std::vector<std::uint8_t>> queue_type;
+    queue_type queue;
+    queue_type::producer& producer;
+    queue_type::consumer& consumer;
+    allocating_queue() : queue(queue_capacity), producer(queue.get_producer()), consumer(queue.get_consumer()) { }
+    bool send(std::uint32_t length, std::uint64_t sequence, std::uint8_t*)
+    {
+	std::vector<std::uint8_t> message(length);
+	fill(message.data(), length, sequence);
+	return producer.try_enqueue_move(std::move(message))
+		== queue_type::producer::result::success;
+    }
+    bool receive(std::uint64_t& sequence, std::uint32_t& length, std::uint8_t*)
+    {
+	std::vector<std::uint8_t> message;
+	if (consumer.try_dequeue_move(message) != queue_type::consumer::result::success)
+	{
+	    return false;
+	}
+	length = message.size();
+	sequence = read_sequence(message.data());
+	return true;
+    }
+};
+
+///
+/// Streams every message from a producer thread to a consumer thread
+///
+template <class channel_t>
+void report(const std::vector<std::uint32_t>& lengths)
+{
+    channel_t channel;
+    const std::uint64_t messages = lengths.size();
+    auto begin = std::chrono::steady_clock::now();
+    std::thread producer_thread([&channel, &lengths, messages] ()
+    {
+	std::vector<std::uint8_t> scratch(max_length);
+	for (std::uint64_t sequence = 0U; sequence < messages; ++sequence)
+	{
+	    while (!channel.send(lengths[sequence], sequence, scratch.data()))
+	    {
+		std::this_thread::yield();
+	    }
+	}
+    });
+    std::vector<std::uint8_t> scratch(max_length);
+    std::uint64_t bytes = 0U;
+    std::uint64_t mismatches = 0U;
+    for (std::uint64_t expected = 0U; expected < messages; ++expected)
+    {
+	std::uint64_t sequence = 0U;
+	std::uint32_t length = 0U;
+	while (!channel.receive(sequence, length, scratch.data()))
+	{
+	    std::this_thread::yield();
+	}
+	bytes += length;
+	mismatches += sequence == expected && length == lengths[expected] ? 0U : 1U;
+    }
+    producer_thread.join();
+    const double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(
+	    std::chrono::steady_clock::now() - begin).count();
+    if (mismatches != 0U)
+    {
+	std::cerr << "messages were lost, reordered or truncated" << std::endl;
+    }
+    std::cout << std::setw(20) << channel_t::name()
+	    << std::setw(12) << bytes / seconds / 1000000.0
+	    << std::setw(14) << messages / seconds
+	    << std::setw(14) << channel_t::footprint() / 1024U << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::uint32_t messages = 2000000U;
+    if (argc > 1)
+    {
+	messages = std::strtoul(argv[1], nullptr, 10);
+    }
+    const std::vector<std::uint32_t> lengths = make_lengths(messages);
+    std::cout << messages << " messages of " << min_length << " to " << max_length << " bytes; "
+	    << "ring KiB is the preallocated storage" << std::endl;
+    std::cout << std::setw(20) << "channel" << std::setw(12) << "MB/s"
+	    << std::setw(14) << "msgs/s" << std::setw(14) << "ring KiB" << std::endl;
+    std::cout << std::fixed << std::setprecision(0);
+    report<byte_ring_in_place>(lengths);
+    report<byte_ring_copy>(lengths);
+    report<padded_queue>(lengths);
+    report<allocating_queue>(lengths);
+    return 0;
+}
@@ -0,0 +1,210 @@
+#include <turbo/container/spsc_ring_queue.hpp>
+#include <turbo/container/spsc_ring_queue.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <thread>
+
+namespace tco = turbo::container;
+
+namespace {
+
+const std::uint32_t queue_capacity = 1024U;
+
+struct record
+{
+    std::uint64_t sequence;
+    std::array<std::uint64_t, 3> payload;
+};
+
+inline void set_sequence(std::uint64_t& value, std::uint64_t sequence) { value = sequence; }
+inline void set_sequence(record& value, std::uint64_t sequence) { value.sequence = sequence; }
+inline std::uint64_t get_sequence(const std::uint64_t& value) { return value; }
+inline std::uint64_t get_sequence(const record& value) { return value.sequence; }
+
+///
+/// Moves one value with try_enqueue_copy and try_dequeue_copy
+///
+struct copy_api
+{
+    template <class producer_t>
+    static bool send(producer_t& producer, std::uint64_t sequence)
+    {
+	typename producer_t::value_type value;
+	set_sequence(value, sequence);
+	return producer.try_enqueue_copy(value) == producer_t::result::success;
+    }
+    template <class consumer_t>
+    static bool receive(consumer_t& consumer, std::uint64_t& sequence)
+    {
+	typename consumer_t::value_type value;
+	if (consumer.try_dequeue_copy(value) != consumer_t::result::success)
+	{
+	    return false;
+	}
+	sequence = get_sequence(value);
+	return true;
+    }
+};
+
+///
+/// Moves one value by constructing it in the slot with reserve and commit, and reading
+/// it where it lies with peek and release
+///
+struct in_place_api
+{
+    template <class producer_t>
+    static bool send(producer_t& producer, std::uint64_t sequence)
+    {
+	void* slot = producer.reserve();
+	if (slot == nullptr)
+	{
+	    return false;
+	}
+	set_sequence(*new (slot) typename producer_t::value_type, sequence);
+	producer.commit();
+	return true;
+    }
+    template <class consumer_t>
+    static bool receive(consumer_t& consumer, std::uint64_t& sequence)
+    {
+	typename consumer_t::value_type* value = consumer.peek();
+	if (value == nullptr)
+	{
+	    return false;
+	}
+	sequence = get_sequence(*value);
+	consumer.release();
+	return true;
+    }
+};
+
+///
+/// Bounces one value back and forth between two threads through a pair of queues, so
+/// every round trip pays the full cost of a handover in each direction
+///
+template <class value_t, class api_t>
+double measure_ping_pong(std::uint64_t rounds)
+{
+    tco::spsc_ring_queue<value_t> ping_queue(queue_capacity);
+    tco::spsc_ring_queue<value_t> pong_queue(queue_capacity);
+    auto& ping_producer = ping_queue.get_producer();
+    auto& ping_consumer = ping_queue.get_consumer();
+    auto& pong_producer = pong_queue.get_producer();
+    auto& pong_consumer = pong_queue.get_consumer();
+    std::thread echo_thread([&] ()
+    {
+	for (std::uint64_t round = 0U; round < rounds; ++round)
+	{
+	    std::uint64_t sequence = 0U;
+	    while (!api_t::receive(ping_consumer, sequence))
+	    {
+		std::this_thread::yield();
+	    }
+	    while (!api_t::send(pong_producer, sequence))
+	    {
+		std::this_thread::yield();
+	    }
+	}
+    });
+    std::uint64_t mismatches = 0U;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::uint64_t round = 0U; round < rounds; ++round)
+    {
+	while (!api_t::send(ping_producer, round))
+	{
+	    std::this_thread::yield();
+	}
+	std::uint64_t sequence = 0U;
+	while (!api_t::receive(pong_consumer, sequence))
+	{
+	    std::this_thread::yield();
+	}
+	mismatches += sequence == round ? 0U : 1U;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    echo_thread.join();
+    if (mismatches != 0U)
+    {
+	std::cerr << "values were lost or reordered" << std::endl;
+    }
+    return rounds / std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+}
+
+///
+/// Streams items from a producer thread to a consumer thread through one queue
+///
+template <class value_t, class api_t>
+double measure_stream(std::uint64_t items)
+{
+    tco::spsc_ring_queue<value_t> queue(queue_capacity);
+    auto& producer = queue.get_producer();
+    auto& consumer = queue.get_consumer();
+    auto begin = std::chrono::steady_clock::now();
+    std::thread producer_thread([&producer, items] ()
+    {
+	for (std::uint64_t sent = 0U; sent < items; ++sent)
+	{
+	    while (!api_t::send(producer, sent))
+	    {
+		std::this_thread::yield();
+	    }
+	}
+    });
+    std::uint64_t checksum = 0U;
+    for (std::uint64_t received = 0U; received < items; ++received)
+    {
+	std::uint64_t sequence = 0U;
+	while (!api_t::receive(consumer, sequence))
+	{
+	    std::this_thread::yield();
+	}
+	checksum += sequence;
+    }
+    producer_thread.join();
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    if (checksum != items * (items - 1U) / 2U)
+    {
+	std::cerr << "values were lost or duplicated" << std::endl;
+    }
+    return items / std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+}
+
+template <class value_t, class api_t>
+void report(const char* value_name, const char* api_name, std::uint64_t rounds, std::uint64_t items)
+{
+    const double ping_pong = measure_ping_pong<value_t, api_t>(rounds);
+    const double stream = measure_stream<value_t, api_t>(items);
+    std::cout << std::setw(12) << value_name << std::setw(10) << api_name
+	    << std::setw(18) << ping_pong << std::setw(18) << stream << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::uint64_t rounds = 200000U;
+    std::uint64_t items = 10000000U;
+    if (argc > 1)
+    {
+	rounds = std::strtoull(argv[1], nullptr, 10);
+    }
+    if (argc > 2)
+    {
+	items = std::strtoull(argv[2], nullptr, 10);
+    }
+    std::cout << rounds << " ping pong round trips and " << items << " streamed items through queues of "
+	    << queue_capacity << " slots" << std::endl;
+    std::cout << std::setw(12) << "value" << std::setw(10) << "api"
+	    << std::setw(18) << "round trips/s" << std::setw(18) << "stream items/s" << std::endl;
+    std::cout << std::fixed << std::setprecision(0);
+    report<std::uint64_t, copy_api>("uint64_t", "copy", rounds, items);
+    report<std::uint64_t, in_place_api>("uint64_t", "in place", rounds, items);
+    report<record, copy_api>("32B record", "copy", rounds, items);
+    report<record, in_place_api>("32B record", "in place", rounds, items);
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include <turbo/container/mpmc_ring_queue.hpp>
+#include <turbo/container/mpmc_ring_queue.hh>
+#include <turbo/container/spsc_ring_queue.hpp>
+#include <turbo/container/spsc_ring_queue.hh>
+#include <turbo/container/wait_strategy.hpp>
+#include <turbo/container/wait_strategy.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <time.h>
+
+namespace tco = turbo::container;
+
+namespace {
+
+const std::uint32_t queue_capacity = 1024U;
+const std::uint64_t stop_value = UINT64_MAX;
+
+///
+/// CPU time used so far by the calling thread
+///
+std::chrono::nanoseconds thread_cpu_time()
+{
+    struct timespec now = { 0, 0 };
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+}
+
+template <class wait_t>
+struct spsc_channel
+{
+    typedef tco::spsc_ring_queue<std::uint64_t, std::allocator<std::uint64_t>, wait_t> queue_type;
+    static const char* name() { return "spsc"; }
+    queue_type queue;
+    typename queue_type::producer& producer;
+    typename queue_type::consumer& consumer;
+    spsc_channel() : queue(queue_capacity), producer(queue.get_producer()), consumer(queue.get_consumer()) { }
+};
+
+template <class wait_t>
+struct mpmc_channel
+{
+    typedef tco::mpmc_ring_queue<std::uint64_t, std::allocator, wait_t> queue_type;
+    static const char* name() { return "mpmc"; }
+    queue_type queue;
+    typename queue_type::producer& producer;
+    typename queue_type::consumer& consumer;
+    mpmc_channel() : queue(queue_capacity, 1U), producer(queue.get_producer()), consumer(queue.get_consumer()) { }
+};
+
+///
+/// Share of one core a consumer blocked on an empty queue burns while nothing arrives
+///
+template <class channel_t>
+double measure_idle_cpu(std::chrono::milliseconds idle)
+{
+    channel_t channel;
+    std::chrono::nanoseconds consumer_cpu(0);
+    std::thread consumer_thread([&channel, &consumer_cpu] ()
+    {
+	const std::chrono::nanoseconds begin = thread_cpu_time();
+	std::uint64_t value = 0U;
+	channel.consumer.dequeue_copy(value);
+	consumer_cpu = thread_cpu_time() - begin;
+    });
+    std::this_thread::sleep_for(idle);
+    channel.producer.enqueue_copy(stop_value);
+    consumer_thread.join();
+    return 100.0 * consumer_cpu.count() / std::chrono::duration_cast<std::chrono::nanoseconds>(idle).count();
+}
+
+///
+/// Round trip latencies of one value bounced between two threads with the blocking
+/// operations, sorted
+///
+template <class channel_t>
+std::vector<std::chrono::nanoseconds> measure_round_trips(std::uint32_t rounds)
+{
+    channel_t ping;
+    channel_t pong;
+    std::thread echo_thread([&ping, &pong] ()
+    {
+	for (std::uint64_t value = 0U; value != stop_value;)
+	{
+	    ping.consumer.dequeue_copy(value);
+	    pong.producer.enqueue_copy(value);
+	}
+    });
+    std::vector<std::chrono::nanoseconds> latencies;
+    latencies.reserve(rounds);
+    for (std::uint32_t round = 0U; round < rounds; ++round)
+    {
+	const auto begin = std::chrono::steady_clock::now();
+	ping.producer.enqueue_copy(round);
+	std::uint64_t value = 0U;
+	pong.consumer.dequeue_copy(value);
+	latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin));
+    }
+    ping.producer.enqueue_copy(stop_value);
+    std::uint64_t value = 0U;
+    pong.consumer.dequeue_copy(value);
+    echo_thread.join();
+    std::sort(latencies.begin(), latencies.end());
+    return latencies;
+}
+
+///
+/// Items per second streamed with the blocking operations, which includes the cost of
+/// notifying on every enqueue and dequeue
+///
+template <class channel_t>
+double measure_stream(std::uint64_t items)
+{
+    channel_t channel;
+    const auto begin = std::chrono::steady_clock::now();
+    std::thread producer_thread([&channel, items] ()
+    {
+	for (std::uint64_t value = 0U; value < items; ++value)
+	{
+	    channel.producer.enqueue_copy(value);
+	}
+    });
+    std::uint64_t checksum = 0U;
+    for (std::uint64_t count = 0U; count < items; ++count)
+    {
+	std::uint64_t value = 0U;
+	channel.consumer.dequeue_copy(value);
+	checksum += value;
+    }
+    producer_thread.join();
+    const double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(
+	    std::chrono::steady_clock::now() - begin).count();
+    if (checksum != items * (items - 1U) / 2U)
+    {
+	std::cerr << "values were lost or duplicated" << std::endl;
+    }
+    return items / seconds;
+}
+
+template <class channel_t>
+void report(const char* strategy, std::chrono::milliseconds idle, std::uint32_t rounds, std::uint64_t items)
+{
+    const double idle_cpu = measure_idle_cpu<channel_t>(idle);
+    const std::vector<std::chrono::nanoseconds> latencies = measure_round_trips<channel_t>(rounds);
+    const double stream = measure_stream<channel_t>(items);
+    std::cout << std::setw(6) << channel_t::name() << std::setw(12) << strategy
+	    << std::setw(12) << idle_cpu
+	    << std::setw(14) << latencies[latencies.size() / 2U].count()
+	    << std::setw(14) << latencies[latencies.size() * 99U / 100U].count()
+	    << std::setw(16) << stream << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::chrono::milliseconds idle(500);
+    std::uint32_t rounds = 20000U;
+    std::uint64_t items = 2000000U;
+    if (argc > 1)
+    {
+	idle = std::chrono::milliseconds(std::strtoul(argv[1], nullptr, 10));
+    }
+    if (argc > 2)
+    {
+	rounds = std::strtoul(argv[2], nullptr, 10);
+    }
+    if (argc > 3)
+    {
+	items = std::strtoull(argv[3], nullptr, 10);
+    }
+    std::cout << "idle consumer for " << idle.count() << " ms, " << rounds << " blocking round trips, "
+	    << items << " blocking streamed items; on machines with fewer cores than threads the spin"
+	    << " strategy only progresses when the scheduler preempts it" << std::endl;
+    std::cout << std::setw(6) << "queue" << std::setw(12) << "strategy"
+	    << std::setw(12) << "idle CPU %" << std::setw(14) << "p50 RTT ns" << std::setw(14) << "p99 RTT ns"
+	    << std::setw(16) << "stream items/s" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    report<spsc_channel<tco::spin_wait>>("spin", idle, rounds, items);
+    report<spsc_channel<tco::spin_yield_wait<>>>("spin yield", idle, rounds, items);
+    report<spsc_channel<tco::spin_park_wait<>>>("spin park", idle, rounds, items);
+    report<mpmc_channel<tco::spin_wait>>("spin", idle, rounds, items);
+    report<mpmc_channel<tco::spin_yield_wait<>>>("spin yield", idle, rounds, items);
+    report<mpmc_channel<tco::spin_park_wait<>>>("spin park", idle, rounds, items);
+    return 0;
+}
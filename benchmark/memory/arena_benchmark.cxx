@@ -0,0 +1,86 @@
+#include <turbo/memory/arena.hpp>
+#include <turbo/memory/arena.hh>
+#include <turbo/memory/cstdlib_allocator.hpp>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/memory/slab_allocator.hh>
+#include <turbo/container/emplacing_skiplist.hpp>
+#include <turbo/container/emplacing_skiplist.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace tco = turbo::container;
+namespace tme = turbo::memory;
+
+namespace {
+
+const std::uint32_t entry_count = 10000U;
+
+///
+/// Builds and tears down a skiplist per iteration; after_teardown lets the arena rewind
+///
+template <class allocator_t, class after_t>
+double measure(allocator_t& allocator, const std::vector<std::uint32_t>& keys, std::size_t iterations, after_t after_teardown)
+{
+    typedef tco::emplacing_skiplist<std::uint32_t, std::uint64_t, allocator_t> map_type;
+    std::uint64_t checksum = 0U;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t iteration = 0U; iteration < iterations; ++iteration)
+    {
+	{
+	    map_type map(allocator);
+	    for (std::uint32_t key : keys)
+	    {
+		map.emplace(key, key * 3U);
+	    }
+	    checksum += map.size();
+	}
+	after_teardown();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    if (checksum != entry_count * iterations)
+    {
+	std::cerr << "unexpected skiplist size" << std::endl;
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) / iterations;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    typedef tco::emplacing_skiplist<std::uint32_t, std::uint64_t, tme::concurrent_sized_slab> slab_map;
+    std::size_t iterations = 100U;
+    if (argc > 1)
+    {
+	iterations = std::strtoul(argv[1], nullptr, 10);
+    }
+    std::vector<std::uint32_t> keys(entry_count);
+    std::iota(keys.begin(), keys.end(), 0U);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(entry_count));
+    tme::cstdlib_typed_allocator system;
+    const double system_time = measure(system, keys, iterations, [] () -> void { });
+    tme::concurrent_sized_slab slab(entry_count, {
+	    {slab_map::node_sizes[0], entry_count},
+	    {slab_map::node_sizes[1], entry_count},
+	    {slab_map::node_sizes[2], entry_count} });
+    const double slab_time = measure(slab, keys, iterations, [] () -> void { });
+    tme::arena arena;
+    const tme::arena::mark start = arena.get_mark();
+    const double arena_time = measure(arena, keys, iterations, [&arena, &start] () -> void
+    {
+	arena.rewind(start);
+    });
+    std::cout << "build and tear down a " << entry_count << " entry emplacing_skiplist" << std::endl;
+    std::cout << std::setw(24) << "allocator" << std::setw(20) << "us/iteration" << std::endl;
+    std::cout << std::setw(24) << "cstdlib" << std::setw(20) << std::fixed << std::setprecision(1) << system_time << std::endl;
+    std::cout << std::setw(24) << "concurrent_sized_slab" << std::setw(20) << slab_time << std::endl;
+    std::cout << std::setw(24) << "arena" << std::setw(20) << arena_time << std::endl;
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <turbo/memory/block.hpp>
+#include <turbo/memory/block.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace tme = turbo::memory;
+
+static const std::size_t value_size = 64U;
+static const std::size_t batch_size = 8U;
+
+///
+/// Each worker allocates a small batch, writes to every value and frees the batch again;
+/// the block is large enough that a FIFO free list walks through memory that is no longer cached
+///
+void churn(tme::block& block, std::uint64_t iterations)
+{
+    std::array<std::uint64_t*, batch_size> batch;
+    for (std::uint64_t iteration = 0U; iteration < iterations; ++iteration)
+    {
+	for (auto&& pointer : batch)
+	{
+	    pointer = static_cast<std::uint64_t*>(block.allocate());
+	    std::fill_n(pointer, value_size / sizeof(std::uint64_t), iteration);
+	}
+	for (auto&& pointer : batch)
+	{
+	    block.free(pointer);
+	}
+    }
+}
+
+double run(std::size_t thread_count, std::uint64_t iterations, tme::block::capacity_type capacity, tme::block::free_list_mode mode)
+{
+    tme::block block(value_size, capacity, value_size, mode);
+    std::atomic<bool> start(false);
+    std::vector<std::thread> workers;
+    for (std::size_t count = 0U; count < thread_count; ++count)
+    {
+	workers.emplace_back([&] () -> void
+	{
+	    while (!start.load(std::memory_order_acquire)) { }
+	    churn(block, iterations);
+	});
+    }
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto&& worker : workers)
+    {
+	worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - begin).count();
+    const double operations = static_cast<double>(thread_count * iterations * batch_size * 2U);
+    return operations / seconds / 1000000.0;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t max_threads = std::max(1U, std::thread::hardware_concurrency());
+    std::uint64_t iterations = 200000U;
+    if (argc > 1)
+    {
+	max_threads = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2)
+    {
+	iterations = std::strtoull(argv[2], nullptr, 10);
+    }
+    std::cout << "allocate/free churn of " << value_size << " byte values in batches of " << batch_size << std::endl;
+    std::cout << std::setw(8) << "threads"
+	    << std::setw(12) << "capacity"
+	    << std::setw(20) << "queue (Mops/s)"
+	    << std::setw(20) << "stack (Mops/s)"
+	    << std::setw(12) << "speedup" << std::endl;
+    for (std::size_t thread_count = 1U; thread_count <= max_threads; ++thread_count)
+    {
+	for (tme::block::capacity_type capacity : { 1024U, 262144U })
+	{
+	    const double queue_rate = run(thread_count, iterations, capacity, tme::block::free_list_mode::ring_queue);
+	    const double stack_rate = run(thread_count, iterations, capacity, tme::block::free_list_mode::index_stack);
+	    std::cout << std::setw(8) << thread_count
+		    << std::setw(12) << capacity
+		    << std::setw(20) << std::fixed << std::setprecision(2) << queue_rate
+		    << std::setw(20) << stack_rate
+		    << std::setw(12) << stack_rate / queue_rate << std::endl;
+	}
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <turbo/memory/block.hpp>
+#include <turbo/memory/block.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace tme = turbo::memory;
+
+static const std::size_t value_size = 64U;
+static const std::size_t batch_size = 8U;
+static const tme::block::capacity_type node_capacity = 1024U;
+
+///
+/// Each worker allocates a small batch from the list and frees it again
+///
+void churn(tme::block_list& list, std::uint64_t iterations)
+{
+    std::array<void*, batch_size> batch;
+    for (std::uint64_t iteration = 0U; iteration < iterations; ++iteration)
+    {
+	for (auto&& pointer : batch)
+	{
+	    pointer = list.allocate();
+	}
+	for (auto&& pointer : batch)
+	{
+	    list.free(pointer);
+	}
+    }
+}
+
+///
+/// Returns nanoseconds per allocate or free; when the first block is held every
+/// allocation has to walk on to the second block
+///
+double run(std::size_t thread_count, std::uint64_t iterations, bool hold_first)
+{
+    tme::block_list list(value_size, node_capacity);
+    list.begin().try_append(list.create_node(node_capacity));
+    std::vector<void*> held;
+    if (hold_first)
+    {
+	for (void* pointer = list.begin()->allocate(); pointer != nullptr; pointer = list.begin()->allocate())
+	{
+	    held.push_back(pointer);
+	}
+    }
+    std::atomic<bool> start(false);
+    std::vector<std::thread> workers;
+    for (std::size_t count = 0U; count < thread_count; ++count)
+    {
+	workers.emplace_back([&] () -> void
+	{
+	    while (!start.load(std::memory_order_acquire)) { }
+	    churn(list, iterations);
+	});
+    }
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto&& worker : workers)
+    {
+	worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    for (void* pointer : held)
+    {
+	list.free(pointer);
+    }
+    const double operations = static_cast<double>(iterations * batch_size * 2U);
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / operations;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t max_threads = std::max(1U, std::thread::hardware_concurrency());
+    std::uint64_t iterations = 500000U;
+    if (argc > 1)
+    {
+	max_threads = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2)
+    {
+	iterations = std::strtoull(argv[2], nullptr, 10);
+    }
+    std::cout << "block_list allocate/free of " << value_size << " byte values in batches of " << batch_size << std::endl;
+    std::cout << std::setw(8) << "threads"
+	    << std::setw(24) << "first block (ns/op)"
+	    << std::setw(24) << "second block (ns/op)" << std::endl;
+    for (std::size_t thread_count = 1U; thread_count <= max_threads; thread_count *= 2U)
+    {
+	const double first = run(thread_count, iterations, false);
+	const double second = run(thread_count, iterations, true);
+	std::cout << std::setw(8) << thread_count
+		<< std::setw(24) << std::fixed << std::setprecision(1) << first
+		<< std::setw(24) << second << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <turbo/memory/block.hpp>
+#include <turbo/memory/block.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace tme = turbo::memory;
+
+static const tme::block::capacity_type node_capacity = 1024U;
+
+///
+/// The search every free used to perform before the page map existed
+///
+void linear_free(tme::block_list& list, void* pointer)
+{
+    for (auto&& block : list)
+    {
+	if (block.in_range(pointer))
+	{
+	    block.free(pointer);
+	    break;
+	}
+    }
+}
+
+void fill(tme::block_list& list, std::vector<void*>& allocation)
+{
+    allocation.clear();
+    for (auto&& block : list)
+    {
+	for (void* pointer = block.allocate(); pointer != nullptr; pointer = block.allocate())
+	{
+	    allocation.push_back(pointer);
+	}
+    }
+}
+
+template <class free_t>
+double measure(tme::block_list& list, std::size_t rounds, free_t free_func)
+{
+    std::vector<void*> allocation;
+    std::mt19937 engine(rounds);
+    std::chrono::steady_clock::duration elapsed(0);
+    std::size_t operations = 0U;
+    for (std::size_t round = 0U; round < rounds; ++round)
+    {
+	fill(list, allocation);
+	std::shuffle(allocation.begin(), allocation.end(), engine);
+	auto begin = std::chrono::steady_clock::now();
+	for (void* pointer : allocation)
+	{
+	    free_func(list, pointer);
+	}
+	elapsed += std::chrono::steady_clock::now() - begin;
+	operations += allocation.size();
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / operations;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t rounds = 20U;
+    if (argc > 1)
+    {
+	rounds = std::strtoul(argv[1], nullptr, 10);
+    }
+    std::cout << "free latency for " << node_capacity << " x 64 byte slots per block, frees in random order" << std::endl;
+    std::cout << std::setw(8) << "blocks"
+	    << std::setw(20) << "linear (ns/op)"
+	    << std::setw(20) << "page map (ns/op)" << std::endl;
+    for (std::size_t block_count : { 1U, 8U, 32U })
+    {
+	tme::block_list list(64U, node_capacity);
+	auto iter = list.begin();
+	for (std::size_t count = 1U; count < block_count; ++count, ++iter)
+	{
+	    iter.try_append(list.create_node(node_capacity));
+	}
+	const double linear = measure(list, rounds, linear_free);
+	const double mapped = measure(list, rounds, [] (tme::block_list& list, void* pointer) -> void
+	{
+	    list.free(pointer);
+	});
+	std::cout << std::setw(8) << block_count
+		<< std::setw(20) << std::fixed << std::setprecision(1) << linear
+		<< std::setw(20) << mapped << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <turbo/memory/block.hpp>
+#include <turbo/memory/block.hh>
+#include <sys/resource.h>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace tme = turbo::memory;
+
+static const std::size_t value_size = 64U;
+
+long minor_faults()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+///
+/// Reports the cost of touching every value of a freshly made block for the first time,
+/// the page faults taken doing so, and the latency of random reads once everything is resident
+///
+void measure(const char* label, const tme::storage_policy& policy, tme::block::capacity_type capacity, std::size_t reads)
+{
+    const long faults_before = minor_faults();
+    auto setup_begin = std::chrono::steady_clock::now();
+    tme::block block(value_size, capacity, value_size, tme::block::free_list_mode::ring_queue, policy);
+    auto setup_end = std::chrono::steady_clock::now();
+    std::vector<std::uint64_t*> allocation;
+    allocation.reserve(capacity);
+    const long faults_setup = minor_faults();
+    auto touch_begin = std::chrono::steady_clock::now();
+    for (std::uint64_t* pointer = static_cast<std::uint64_t*>(block.allocate()); pointer != nullptr; pointer = static_cast<std::uint64_t*>(block.allocate()))
+    {
+	*pointer = allocation.size();
+	allocation.push_back(pointer);
+    }
+    auto touch_end = std::chrono::steady_clock::now();
+    const long faults_touch = minor_faults();
+    std::mt19937_64 engine(capacity);
+    std::shuffle(allocation.begin(), allocation.end(), engine);
+    std::uint64_t sum = 0U;
+    auto read_begin = std::chrono::steady_clock::now();
+    for (std::size_t read = 0U; read < reads; ++read)
+    {
+	sum += *allocation[(read * 7919U) % allocation.size()];
+    }
+    auto read_end = std::chrono::steady_clock::now();
+    for (std::uint64_t* pointer : allocation)
+    {
+	block.free(pointer);
+    }
+    typedef std::chrono::duration<double, std::milli> milliseconds;
+    typedef std::chrono::duration<double, std::nano> nanoseconds;
+    std::cout << std::setw(16) << label
+	    << std::setw(10) << (policy.prefault ? "yes" : "no")
+	    << std::setw(14) << std::fixed << std::setprecision(2) << milliseconds(setup_end - setup_begin).count()
+	    << std::setw(12) << faults_setup - faults_before
+	    << std::setw(14) << milliseconds(touch_end - touch_begin).count()
+	    << std::setw(12) << faults_touch - faults_setup
+	    << std::setw(14) << nanoseconds(read_end - read_begin).count() / reads
+	    << ((sum == 0U) ? " " : "") << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    tme::block::capacity_type capacity = 1U << 20U;
+    std::size_t reads = 10000000U;
+    if (argc > 1)
+    {
+	capacity = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2)
+    {
+	reads = std::strtoull(argv[2], nullptr, 10);
+    }
+    typedef tme::storage_policy::backing backing;
+    const std::vector<std::pair<const char*, backing>> sources {
+	{ "heap", backing::heap },
+	{ "mapped", backing::mapped },
+	{ "transparent", backing::transparent_huge_page },
+	{ "explicit", backing::explicit_huge_page }
+    };
+    std::cout << capacity << " values of " << value_size << " bytes, " << reads << " random reads" << std::endl;
+    std::cout << std::setw(16) << "storage"
+	    << std::setw(10) << "prefault"
+	    << std::setw(14) << "setup (ms)"
+	    << std::setw(12) << "faults"
+	    << std::setw(14) << "touch (ms)"
+	    << std::setw(12) << "faults"
+	    << std::setw(14) << "read (ns)" << std::endl;
+    for (auto&& source : sources)
+    {
+	for (bool prefault : { false, true })
+	{
+	    measure(source.first, tme::storage_policy(source.second, prefault), capacity, reads);
+	}
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <turbo/memory/epoch.hpp>
+#include <turbo/memory/epoch.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+struct node
+{
+    std::uint64_t value;
+};
+
+std::atomic<node*> shared(nullptr);
+
+template <class read_t>
+double measure_reads(std::size_t thread_count, std::size_t iterations, bool with_writer, tme::epoch_domain& domain, read_t read)
+{
+    std::atomic<bool> start(false);
+    std::atomic<bool> finished(false);
+    std::atomic<std::uint64_t> checksum(0U);
+    std::vector<std::thread> threads;
+    std::vector<std::chrono::steady_clock::duration> elapsed(thread_count);
+    for (std::size_t index = 0U; index < thread_count; ++index)
+    {
+	threads.emplace_back([&, index] () -> void
+	{
+	    while (!start.load(std::memory_order_acquire))
+	    {
+		std::this_thread::yield();
+	    }
+	    std::uint64_t sum = 0U;
+	    auto begin = std::chrono::steady_clock::now();
+	    for (std::size_t iteration = 0U; iteration < iterations; ++iteration)
+	    {
+		sum += read();
+	    }
+	    elapsed[index] = std::chrono::steady_clock::now() - begin;
+	    checksum.fetch_add(sum, std::memory_order_relaxed);
+	});
+    }
+    std::thread writer;
+    if (with_writer)
+    {
+	writer = std::thread([&] () -> void
+	{
+	    tme::epoch_domain::participant& record = domain.get_local();
+	    std::uint64_t value = 0U;
+	    while (!finished.load(std::memory_order_acquire))
+	    {
+		node* previous = shared.exchange(new node{++value}, std::memory_order_acq_rel);
+		record.retire(previous);
+		std::this_thread::yield();
+	    }
+	});
+    }
+    start.store(true, std::memory_order_release);
+    for (auto&& thread : threads)
+    {
+	thread.join();
+    }
+    finished.store(true, std::memory_order_release);
+    if (writer.joinable())
+    {
+	writer.join();
+    }
+    std::chrono::steady_clock::duration total(0);
+    for (auto&& duration : elapsed)
+    {
+	total += duration;
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(total).count()) / (iterations * thread_count);
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    std::size_t iterations = 10000000U;
+    if (argc > 1)
+    {
+	max_threads = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2)
+    {
+	iterations = std::strtoul(argv[2], nullptr, 10);
+    }
+    max_threads = max_threads == 0U ? 1U : max_threads;
+    tme::epoch_domain domain;
+    std::mutex mutex;
+    shared.store(new node{0U});
+    std::cout << "read path latency, " << iterations << " reads per thread" << std::endl;
+    std::cout << std::setw(8) << "threads"
+	    << std::setw(10) << "writer"
+	    << std::setw(16) << "bare (ns/op)"
+	    << std::setw(16) << "pin (ns/op)"
+	    << std::setw(16) << "local (ns/op)"
+	    << std::setw(16) << "mutex (ns/op)" << std::endl;
+    for (std::size_t thread_count = 1U; thread_count <= max_threads; thread_count *= 2U)
+    {
+	for (bool with_writer : { false, true })
+	{
+	    const double bare = measure_reads(thread_count, iterations, with_writer, domain, [] () -> std::uint64_t
+	    {
+		return shared.load(std::memory_order_acquire)->value;
+	    });
+	    // the participant is looked up once and reused for every read
+	    const double pinned = measure_reads(thread_count, iterations, with_writer, domain, [&] () -> std::uint64_t
+	    {
+		static thread_local tme::epoch_domain::participant* record = &domain.get_local();
+		tme::epoch_domain::guard guard(*record);
+		return shared.load(std::memory_order_acquire)->value;
+	    });
+	    // the participant is looked up on every read
+	    const double local = measure_reads(thread_count, iterations, with_writer, domain, [&] () -> std::uint64_t
+	    {
+		tme::epoch_domain::guard guard(domain.get_local());
+		return shared.load(std::memory_order_acquire)->value;
+	    });
+	    const double locked = measure_reads(thread_count, iterations / 4U, with_writer, domain, [&] () -> std::uint64_t
+	    {
+		std::lock_guard<std::mutex> lock(mutex);
+		return shared.load(std::memory_order_acquire)->value;
+	    });
+	    std::cout << std::setw(8) << thread_count
+		    << std::setw(10) << (with_writer ? "yes" : "no")
+		    << std::setw(16) << std::fixed << std::setprecision(2) << bare
+		    << std::setw(16) << pinned
+		    << std::setw(16) << local
+		    << std::setw(16) << locked << std::endl;
+	}
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <turbo/memory/large_object.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+const std::size_t live_count = 32U;
+
+struct latency
+{
+    double mean;
+    double p99;
+};
+
+///
+/// Replaces a random live buffer each iteration, touching the first and last page of
+/// the new one, and reports the latency of each allocate, touch and free
+///
+template <class allocate_t, class free_t>
+latency measure(std::size_t min_size, std::size_t max_size, std::size_t iterations, allocate_t allocate, free_t release)
+{
+    std::mt19937 engine(static_cast<std::uint32_t>(min_size));
+    std::uniform_int_distribution<std::size_t> pick_size(min_size, max_size);
+    std::vector<std::pair<void*, std::size_t>> live;
+    for (std::size_t index = 0U; index < live_count; ++index)
+    {
+	const std::size_t size = pick_size(engine);
+	live.emplace_back(allocate(size), size);
+    }
+    std::vector<std::chrono::steady_clock::duration> samples;
+    samples.reserve(iterations);
+    for (std::size_t iteration = 0U; iteration < iterations; ++iteration)
+    {
+	auto& slot = live[engine() % live_count];
+	const std::size_t size = pick_size(engine);
+	auto begin = std::chrono::steady_clock::now();
+	release(slot.first);
+	slot.first = allocate(size);
+	slot.second = size;
+	static_cast<std::uint8_t*>(slot.first)[0] = 1U;
+	static_cast<std::uint8_t*>(slot.first)[size - 1U] = 1U;
+	samples.push_back(std::chrono::steady_clock::now() - begin);
+    }
+    for (auto&& slot : live)
+    {
+	release(slot.first);
+    }
+    std::sort(samples.begin(), samples.end());
+    std::chrono::steady_clock::duration total(0);
+    for (auto&& sample : samples)
+    {
+	total += sample;
+    }
+    return {
+	    static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(total).count()) / samples.size(),
+	    static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(samples[samples.size() * 99U / 100U]).count()) };
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = 100000U;
+    if (argc > 1)
+    {
+	iterations = std::strtoul(argv[1], nullptr, 10);
+    }
+    std::cout << "free, malloc and touch of one of " << live_count << " live buffers" << std::endl;
+    std::cout << std::setw(20) << "size range"
+	    << std::setw(18) << "malloc (ns)"
+	    << std::setw(18) << "malloc p99 (ns)"
+	    << std::setw(18) << "tier (ns)"
+	    << std::setw(18) << "tier p99 (ns)" << std::endl;
+    for (std::size_t min_size : { 64U << 10U, 256U << 10U, 1U << 20U })
+    {
+	const std::size_t max_size = min_size * 4U;
+	const latency system = measure(min_size, max_size, iterations, [] (std::size_t size) -> void*
+	{
+	    return std::malloc(size);
+	},
+	[] (void* pointer) -> void
+	{
+	    std::free(pointer);
+	});
+	const tme::large_object_config config;
+	tme::large_object_tier tier(config);
+	const latency tiered = measure(min_size, max_size, iterations, [&tier] (std::size_t size) -> void*
+	{
+	    return tier.allocate(size);
+	},
+	[&tier] (void* pointer) -> void
+	{
+	    tier.deallocate(pointer);
+	});
+	std::cout << std::setw(9) << (min_size >> 10U) << "-" << std::setw(7) << (max_size >> 10U) << " KB"
+		<< std::setw(18) << std::fixed << std::setprecision(1) << system.mean
+		<< std::setw(18) << system.p99
+		<< std::setw(18) << tiered.mean
+		<< std::setw(18) << tiered.p99 << std::endl;
+    }
+    return 0;
+}
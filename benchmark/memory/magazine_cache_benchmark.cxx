@@ -0,0 +1,111 @@
+#include <turbo/memory/magazine_cache.hpp>
+#include <turbo/memory/magazine_cache.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/memory/slab_allocator.hh>
+
+namespace tme = turbo::memory;
+
+struct record
+{
+    std::uint16_t first;
+    std::uint32_t second;
+    std::uint64_t third;
+};
+
+static const std::size_t batch_size = 8U;
+
+///
+/// Each worker repeatedly allocates a small batch of records and then frees it, which is
+/// the alloc/free pairing seen in a request pipeline
+///
+template <class allocator_t>
+void churn(allocator_t& allocator, std::uint64_t iterations)
+{
+    std::array<record*, batch_size> batch;
+    for (std::uint64_t iteration = 0U; iteration < iterations; ++iteration)
+    {
+	for (auto&& pointer : batch)
+	{
+	    pointer = allocator.template allocate<record>();
+	    pointer->third = iteration;
+	}
+	for (auto&& pointer : batch)
+	{
+	    allocator.deallocate(pointer);
+	}
+    }
+}
+
+double run(std::size_t thread_count, std::uint64_t iterations, bool use_magazine)
+{
+    tme::concurrent_sized_slab slab(batch_size * thread_count, { {sizeof(record), static_cast<tme::capacity_type>(batch_size * thread_count * 2U)} });
+    std::atomic<bool> start(false);
+    std::vector<std::thread> workers;
+    for (std::size_t count = 0U; count < thread_count; ++count)
+    {
+	workers.emplace_back([&] () -> void
+	{
+	    while (!start.load(std::memory_order_acquire)) { }
+	    if (use_magazine)
+	    {
+		tme::magazine_cache cache(slab, batch_size * 4U);
+		churn(cache, iterations);
+	    }
+	    else
+	    {
+		churn(slab, iterations);
+	    }
+	});
+    }
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto&& worker : workers)
+    {
+	worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - begin).count();
+    const double operations = static_cast<double>(thread_count * iterations * batch_size * 2U);
+    return operations / seconds / 1000000.0;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t max_threads = std::max(1U, std::thread::hardware_concurrency());
+    std::uint64_t iterations = 100000U;
+    if (argc > 1)
+    {
+	max_threads = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2)
+    {
+	iterations = std::strtoull(argv[2], nullptr, 10);
+    }
+    std::cout << "allocate/deallocate pairs of " << sizeof(record) << " byte records in batches of " << batch_size << std::endl;
+    std::cout << std::setw(8) << "threads"
+	    << std::setw(20) << "slab (Mops/s)"
+	    << std::setw(20) << "magazine (Mops/s)"
+	    << std::setw(12) << "speedup" << std::endl;
+    for (std::size_t thread_count = 1U; thread_count <= max_threads; ++thread_count)
+    {
+	const double slab_rate = run(thread_count, iterations, false);
+	const double magazine_rate = run(thread_count, iterations, true);
+	std::cout << std::setw(8) << thread_count
+		<< std::setw(20) << std::fixed << std::setprecision(2) << slab_rate
+		<< std::setw(20) << magazine_rate
+		<< std::setw(12) << magazine_rate / slab_rate << std::endl;
+    }
+    return 0;
+}
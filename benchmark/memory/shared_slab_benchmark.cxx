@@ -0,0 +1,156 @@
+#include <turbo/memory/shared_slab.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+const std::size_t object_size = 4096U;
+const std::size_t pool_size = 256U;
+
+bool write_all(int descriptor, const void* buffer, std::size_t length)
+{
+    const std::uint8_t* position = static_cast<const std::uint8_t*>(buffer);
+    while (length != 0U)
+    {
+	const ssize_t written = ::write(descriptor, position, length);
+	if (written <= 0)
+	{
+	    return false;
+	}
+	position += written;
+	length -= written;
+    }
+    return true;
+}
+
+bool read_all(int descriptor, void* buffer, std::size_t length)
+{
+    std::uint8_t* position = static_cast<std::uint8_t*>(buffer);
+    while (length != 0U)
+    {
+	const ssize_t received = ::read(descriptor, position, length);
+	if (received <= 0)
+	{
+	    return false;
+	}
+	position += received;
+	length -= received;
+    }
+    return true;
+}
+
+///
+/// Runs producer in a child that writes to the pipe and consumer in this process,
+/// returning the nanoseconds per object
+///
+template <class producer_f, class consumer_f>
+double measure(std::size_t objects, producer_f producer, consumer_f consumer)
+{
+    int channel[2];
+    if (::pipe(channel) != 0)
+    {
+	std::cerr << "unable to create pipe" << std::endl;
+	std::exit(1);
+    }
+    auto begin = std::chrono::steady_clock::now();
+    const pid_t pid = ::fork();
+    if (pid == 0)
+    {
+	::close(channel[0]);
+	const int status = producer(channel[1]) ? 0 : 1;
+	::close(channel[1]);
+	::_exit(status);
+    }
+    ::close(channel[1]);
+    std::uint64_t checksum = consumer(channel[0]);
+    ::close(channel[0]);
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    if (checksum != objects || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+	std::cerr << "transfer failed" << std::endl;
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / objects;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t objects = 100000U;
+    if (argc > 1)
+    {
+	objects = std::strtoul(argv[1], nullptr, 10);
+    }
+    const double copy_time = measure(objects, [objects] (int output) -> bool
+    {
+	std::vector<std::uint8_t> object(object_size, 1U);
+	for (std::size_t count = 0U; count < objects; ++count)
+	{
+	    if (!write_all(output, object.data(), object.size()))
+	    {
+		return false;
+	    }
+	}
+	return true;
+    },
+    [objects] (int input) -> std::uint64_t
+    {
+	std::vector<std::uint8_t> object(object_size);
+	std::uint64_t checksum = 0U;
+	for (std::size_t count = 0U; count < objects && read_all(input, object.data(), object.size()); ++count)
+	{
+	    checksum += object[object_size - 1U];
+	}
+	return checksum;
+    });
+    tme::shared_sized_slab slab(std::vector<tme::block_config>{ {object_size, pool_size} });
+    const double offset_time = measure(objects, [&slab, objects] (int output) -> bool
+    {
+	tme::shared_sized_slab child_slab(::dup(slab.get_descriptor()));
+	for (std::size_t count = 0U; count < objects; ++count)
+	{
+	    std::uint8_t* object = nullptr;
+	    while ((object = static_cast<std::uint8_t*>(child_slab.allocate(object_size))) == nullptr)
+	    {
+		// the pool is full until the consumer catches up
+		::usleep(10U);
+	    }
+	    object[object_size - 1U] = 1U;
+	    const tme::shared_sized_slab::offset_type offset = child_slab.to_offset(object);
+	    if (!write_all(output, &offset, sizeof(offset)))
+	    {
+		return false;
+	    }
+	}
+	return true;
+    },
+    [&slab, objects] (int input) -> std::uint64_t
+    {
+	std::uint64_t checksum = 0U;
+	tme::shared_sized_slab::offset_type offset = 0U;
+	for (std::size_t count = 0U; count < objects && read_all(input, &offset, sizeof(offset)); ++count)
+	{
+	    std::uint8_t* object = slab.from_offset<std::uint8_t>(offset);
+	    checksum += object[object_size - 1U];
+	    slab.free(object);
+	}
+	return checksum;
+    });
+    std::cout << "hand " << objects << " objects of " << object_size << " bytes from a child process to its parent" << std::endl;
+    std::cout << std::setw(32) << "transfer" << std::setw(16) << "ns/object" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(32) << "copy through a pipe" << std::setw(16) << copy_time << std::endl;
+    std::cout << std::setw(32) << "offset into a shared slab" << std::setw(16) << offset_time << std::endl;
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/memory/slab_allocator.hh>
+#include <turbo/memory/size_class.hpp>
+#include <turbo/memory/size_class.hh>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+const std::size_t max_size = 4096U;
+
+///
+/// The bucket search every allocate used to perform before the size class table existed
+///
+std::size_t log2_bucket(std::size_t size, std::size_t smallest_exponent)
+{
+    std::size_t exponent = std::llround(std::ceil(std::log2(size)));
+    return (size == 0U || exponent < smallest_exponent) ? 0U : exponent - smallest_exponent;
+}
+
+std::vector<std::size_t> make_sizes(std::size_t count, bool small)
+{
+    std::mt19937 engine(count);
+    std::vector<std::size_t> sizes;
+    // small objects cluster around a few dozen bytes, as in a typical node based container
+    std::lognormal_distribution<double> small_dist(3.5, 0.6);
+    std::uniform_int_distribution<std::size_t> uniform_dist(1U, max_size);
+    while (sizes.size() < count)
+    {
+	const std::size_t size = small ? static_cast<std::size_t>(small_dist(engine)) : uniform_dist(engine);
+	if (size != 0U && size <= max_size)
+	{
+	    sizes.push_back(size);
+	}
+    }
+    return sizes;
+}
+
+template <class func_t>
+double measure(const std::vector<std::size_t>& sizes, std::size_t rounds, func_t func)
+{
+    std::size_t sink = 0U;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t round = 0U; round < rounds; ++round)
+    {
+	for (std::size_t size : sizes)
+	{
+	    sink += func(size);
+	}
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    if (sink == 1U)
+    {
+	std::cout << "";
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / (rounds * sizes.size());
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t rounds = 50U;
+    if (argc > 1)
+    {
+	rounds = std::strtoul(argv[1], nullptr, 10);
+    }
+    const std::vector<tme::block_config> config{ {8U, 256U}, {max_size, 256U} };
+    for (bool small : { true, false })
+    {
+	const std::vector<std::size_t> sizes(make_sizes(16384U, small));
+	std::cout << (small ? "log-normal sizes around 33 bytes" : "uniform sizes from 1 to 4096 bytes") << std::endl;
+	std::cout << std::setw(12) << "classes"
+		<< std::setw(10) << "buckets"
+		<< std::setw(18) << "wasted (%)"
+		<< std::setw(18) << "lookup (ns/op)"
+		<< std::setw(24) << "malloc+free (ns/op)" << std::endl;
+	const double old_lookup = measure(sizes, rounds, [] (std::size_t size) -> std::size_t
+	{
+	    return log2_bucket(size, 3U);
+	});
+	std::cout << std::setw(12) << "log2" << std::setw(10) << "-" << std::setw(18) << "-"
+		<< std::setw(18) << std::fixed << std::setprecision(2) << old_lookup
+		<< std::setw(24) << "-" << std::endl;
+	for (std::size_t classes : { 1U, 2U, 4U, 8U })
+	{
+	    tme::concurrent_sized_slab slab(256U, config, classes);
+	    std::size_t requested = 0U;
+	    std::size_t reserved = 0U;
+	    for (std::size_t size : sizes)
+	    {
+		requested += size;
+		reserved += slab.at(size).get_value_size();
+	    }
+	    const tme::size_class_table table(8U, classes);
+	    const double lookup = measure(sizes, rounds, [&] (std::size_t size) -> std::size_t
+	    {
+		return table.find_bucket(size);
+	    });
+	    const double churn = measure(sizes, rounds, [&] (std::size_t size) -> std::size_t
+	    {
+		void* pointer = slab.malloc(size);
+		slab.free(pointer, size);
+		return reinterpret_cast<std::uintptr_t>(pointer) & 1U;
+	    });
+	    std::cout << std::setw(12) << classes
+		    << std::setw(10) << slab.get_block_config().size()
+		    << std::setw(18) << 100.0 * (reserved - requested) / reserved
+		    << std::setw(18) << lookup
+		    << std::setw(24) << churn << std::endl;
+	}
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/memory/slab_allocator.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+const std::size_t handle_count = 1000U;
+
+///
+/// Makes a batch of handles, copies each once and then drops them all
+///
+template <class make_f>
+double measure(make_f make, std::size_t iterations)
+{
+    typedef decltype(make(0U)) handle_type;
+    std::vector<handle_type> handles;
+    std::vector<handle_type> copies;
+    handles.reserve(handle_count);
+    copies.reserve(handle_count);
+    std::uint64_t checksum = 0U;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t iteration = 0U; iteration < iterations; ++iteration)
+    {
+	for (std::size_t index = 0U; index < handle_count; ++index)
+	{
+	    handles.push_back(make(index));
+	}
+	copies.assign(handles.cbegin(), handles.cend());
+	for (auto&& handle : copies)
+	{
+	    checksum += *handle;
+	}
+	handles.clear();
+	copies.clear();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    if (checksum != iterations * (handle_count * (handle_count - 1U) / 2U))
+    {
+	std::cerr << "unexpected checksum" << std::endl;
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / (iterations * handle_count);
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = 10000U;
+    if (argc > 1)
+    {
+	iterations = std::strtoul(argv[1], nullptr, 10);
+    }
+    tme::concurrent_sized_slab slab(handle_count, {
+	    {sizeof(std::uint64_t), static_cast<std::uint32_t>(handle_count)},
+	    {sizeof(tme::slab_shared_ptr<std::uint64_t>::node_type), static_cast<std::uint32_t>(handle_count)} });
+    const double std_time = measure([] (std::size_t index) -> std::shared_ptr<std::uint64_t>
+    {
+	return std::make_shared<std::uint64_t>(index);
+    }, iterations);
+    // the shape of make_shared before slab_shared_ptr: slab storage, global control block
+    const double wrapped_time = measure([&slab] (std::size_t index) -> std::shared_ptr<std::uint64_t>
+    {
+	std::uint64_t* value = new (slab.allocate<std::uint64_t>()) std::uint64_t(index);
+	return std::shared_ptr<std::uint64_t>(value, std::bind(
+		static_cast<void (tme::concurrent_sized_slab::*)(std::uint64_t*)>(&tme::concurrent_sized_slab::deallocate<std::uint64_t>),
+		&slab,
+		std::placeholders::_1));
+    }, iterations);
+    const double slab_time = measure([&slab] (std::size_t index) -> tme::slab_shared_ptr<std::uint64_t>
+    {
+	return slab.make_shared<std::uint64_t>(index).second;
+    }, iterations);
+    std::cout << "make, copy and drop " << handle_count << " shared handles" << std::endl;
+    std::cout << std::setw(40) << "handle" << std::setw(16) << "ns/handle" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(40) << "std::make_shared" << std::setw(16) << std_time << std::endl;
+    std::cout << std::setw(40) << "std::shared_ptr over slab storage" << std::setw(16) << wrapped_time << std::endl;
+    std::cout << std::setw(40) << "slab_shared_ptr" << std::setw(16) << slab_time << std::endl;
+    return 0;
+}
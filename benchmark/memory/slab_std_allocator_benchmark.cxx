@@ -0,0 +1,74 @@
+#include <turbo/memory/slab_std_allocator.hpp>
+#include <turbo/memory/slab_std_allocator.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+const std::size_t key_count = 100000U;
+
+///
+/// Keeps the map at about half the key range while randomly inserting and erasing
+///
+template <class map_t>
+double measure(map_t& map, std::size_t operations)
+{
+    std::mt19937_64 engine(key_count);
+    std::uniform_int_distribution<std::uint64_t> pick_key(0U, key_count - 1U);
+    std::uint64_t checksum = 0U;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t operation = 0U; operation < operations; ++operation)
+    {
+	const std::uint64_t key = pick_key(engine);
+	auto iter = map.find(key);
+	if (iter == map.end())
+	{
+	    map.emplace(key, key);
+	}
+	else
+	{
+	    checksum += iter->second;
+	    map.erase(iter);
+	}
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    if (checksum == 0U)
+    {
+	std::cerr << "nothing was erased" << std::endl;
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / operations;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    typedef std::pair<const std::uint64_t, std::uint64_t> entry_type;
+    typedef tme::slab_std_allocator<entry_type> allocator_type;
+    typedef std::unordered_map<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>, allocator_type> slab_map;
+    std::size_t operations = 10000000U;
+    if (argc > 1)
+    {
+	operations = std::strtoul(argv[1], nullptr, 10);
+    }
+    std::unordered_map<std::uint64_t, std::uint64_t> system_map;
+    const double system_time = measure(system_map, operations);
+    // nodes are 32 bytes; the bucket array outgrows every bucket and falls back
+    tme::concurrent_sized_slab slab(key_count, { {32U, static_cast<std::uint32_t>(key_count)} });
+    slab_map adapted_map(16U, std::hash<std::uint64_t>(), std::equal_to<std::uint64_t>(), allocator_type(slab));
+    const double slab_time = measure(adapted_map, operations);
+    std::cout << "std::unordered_map random insert and erase over " << key_count << " keys" << std::endl;
+    std::cout << std::setw(24) << "allocator" << std::setw(16) << "ns/op" << std::endl;
+    std::cout << std::setw(24) << "std::allocator" << std::setw(16) << std::fixed << std::setprecision(1) << system_time << std::endl;
+    std::cout << std::setw(24) << "slab_std_allocator" << std::setw(16) << slab_time << std::endl;
+    return 0;
+}
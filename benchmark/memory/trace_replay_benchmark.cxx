@@ -0,0 +1,325 @@
+#include <turbo/memory/allocation_trace.hpp>
+#include <turbo/memory/arena.hpp>
+#include <turbo/memory/arena.hh>
+#include <turbo/memory/large_object.hpp>
+#include <turbo/memory/slab_allocator.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+const std::size_t page_size = 4096U;
+const std::size_t synthetic_threads = 4U;
+const std::size_t synthetic_operations = 200000U;
+const std::size_t synthetic_live_limit = 4096U;
+
+///
+/// Stands in for allocations that failed, so their frees are skipped rather than waited on
+///
+void* const failed = reinterpret_cast<void*>(1U);
+
+std::size_t pick_size(std::mt19937& engine)
+{
+    const std::uint32_t choice = engine() % 100U;
+    if (choice < 70U)
+    {
+	return 8U + engine() % 120U;
+    }
+    else if (choice < 95U)
+    {
+	return 128U + engine() % 1920U;
+    }
+    else if (choice < 99U)
+    {
+	return 2048U + engine() % 30720U;
+    }
+    else
+    {
+	return 32768U + engine() % 98304U;
+    }
+}
+
+///
+/// Records a mixed size workload around std::malloc, where a tenth of the objects are
+/// handed to another thread to free
+///
+void synthesize(const std::string& path)
+{
+    tme::trace_recorder recorder(path);
+    std::mutex handoff_mutex;
+    std::deque<std::pair<void*, std::size_t>> handoff;
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 0U; thread < synthetic_threads; ++thread)
+    {
+	threads.emplace_back([&, thread] ()
+	{
+	    std::mt19937 engine(thread + 1U);
+	    std::vector<std::pair<void*, std::size_t>> live;
+	    auto release = [&recorder] (const std::pair<void*, std::size_t>& entry)
+	    {
+		recorder.record_free(entry.second, entry.first);
+		std::free(entry.first);
+	    };
+	    for (std::size_t operation = 0U; operation < synthetic_operations; ++operation)
+	    {
+		if (live.empty() || (live.size() < synthetic_live_limit && engine() % 2U == 0U))
+		{
+		    const std::size_t size = pick_size(engine);
+		    void* pointer = std::malloc(size);
+		    recorder.record_allocate(size, pointer);
+		    live.emplace_back(pointer, size);
+		}
+		else
+		{
+		    const std::size_t index = engine() % live.size();
+		    std::swap(live[index], live.back());
+		    if (engine() % 10U == 0U)
+		    {
+			std::lock_guard<std::mutex> lock(handoff_mutex);
+			handoff.push_back(live.back());
+		    }
+		    else
+		    {
+			release(live.back());
+		    }
+		    live.pop_back();
+		}
+		if (operation % 64U == 0U)
+		{
+		    std::lock_guard<std::mutex> lock(handoff_mutex);
+		    if (!handoff.empty())
+		    {
+			release(handoff.front());
+			handoff.pop_front();
+		    }
+		}
+	    }
+	    for (auto& entry : live)
+	    {
+		release(entry);
+	    }
+	});
+    }
+    for (std::thread& thread : threads)
+    {
+	thread.join();
+    }
+    for (auto& entry : handoff)
+    {
+	recorder.record_free(entry.second, entry.first);
+	std::free(entry.first);
+    }
+}
+
+struct slab_allocator
+{
+    explicit slab_allocator(tme::concurrent_sized_slab& slab) : slab(slab) { }
+    inline void* allocate(std::size_t size) { return slab.malloc(size); }
+    inline void deallocate(void* pointer, std::size_t size) { slab.free(pointer, size); }
+    tme::concurrent_sized_slab& slab;
+};
+
+struct cstdlib_allocator
+{
+    inline void* allocate(std::size_t size) { return std::malloc(size); }
+    inline void deallocate(void* pointer, std::size_t) { std::free(pointer); }
+};
+
+struct arena_allocator
+{
+    inline void* allocate(std::size_t size) { return memory.allocate(size, alignof(std::max_align_t)); }
+    inline void deallocate(void*, std::size_t) { }
+    tme::arena memory;
+};
+
+long get_peak_rss()
+{
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+///
+/// Replays every recorded thread on a thread of its own; a free waits until the
+/// allocation it pairs with has happened on whichever thread made it
+///
+template <class make_allocator_f>
+void replay(const char* name, const tme::trace_reader& reader, make_allocator_f make_allocator)
+{
+    const std::vector<tme::trace_event>& events = reader.get_events();
+    std::vector<std::vector<const tme::trace_event*>> schedule(reader.get_thread_count());
+    for (const tme::trace_event& event : events)
+    {
+	schedule[event.thread].push_back(&event);
+    }
+    std::unique_ptr<std::atomic<void*>[]> slots(new std::atomic<void*>[reader.get_id_count()]);
+    for (std::uint64_t id = 0U; id < reader.get_id_count(); ++id)
+    {
+	slots[id].store(nullptr, std::memory_order_relaxed);
+    }
+    const long baseline = get_peak_rss();
+    std::atomic<std::uint64_t> failures(0U);
+    std::vector<std::thread> threads;
+    auto begin = std::chrono::steady_clock::now();
+    for (auto& thread_events : schedule)
+    {
+	threads.emplace_back([&thread_events, &slots, &failures, &make_allocator] ()
+	{
+	    auto allocator = make_allocator();
+	    for (const tme::trace_event* event : thread_events)
+	    {
+		std::atomic<void*>& slot = slots[event->pointer_id];
+		if (event->kind == tme::trace_event::kind_type::allocate)
+		{
+		    const std::size_t size = event->size == 0U ? 1U : event->size;
+		    std::uint8_t* pointer = static_cast<std::uint8_t*>(allocator->allocate(size));
+		    if (pointer == nullptr)
+		    {
+			failures.fetch_add(1U, std::memory_order_relaxed);
+			slot.store(failed, std::memory_order_release);
+			continue;
+		    }
+		    // touch every page so peak RSS reflects what a real user of the memory would see
+		    for (std::size_t offset = 0U; offset < size; offset += page_size)
+		    {
+			pointer[offset] = 1U;
+		    }
+		    slot.store(pointer, std::memory_order_release);
+		}
+		else
+		{
+		    void* pointer = nullptr;
+		    while ((pointer = slot.load(std::memory_order_acquire)) == nullptr)
+		    {
+			std::this_thread::yield();
+		    }
+		    if (pointer != failed)
+		    {
+			allocator->deallocate(pointer, event->size == 0U ? 1U : event->size);
+		    }
+		}
+	    }
+	});
+    }
+    for (std::thread& thread : threads)
+    {
+	thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    const double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+    const long peak = get_peak_rss();
+    const double fragmentation = reader.get_peak_live_bytes() == 0U
+	    ? 0.0
+	    : static_cast<double>(peak - baseline) * 1024.0 / reader.get_peak_live_bytes();
+    std::cout << std::setw(16) << name
+	    << std::setw(16) << static_cast<std::uint64_t>(events.size() / seconds)
+	    << std::setw(16) << (peak - baseline)
+	    << std::setw(16) << fragmentation
+	    << std::setw(16) << failures.load() << std::endl;
+}
+
+///
+/// Runs the replay in a child process so every allocator starts from the same heap and
+/// gets a peak RSS of its own
+///
+template <class make_allocator_f>
+void replay_in_child(const char* name, const tme::trace_reader& reader, make_allocator_f make_allocator)
+{
+    std::cout.flush();
+    const pid_t pid = ::fork();
+    if (pid == 0)
+    {
+	replay(name, reader, make_allocator);
+	std::cout.flush();
+	::_exit(0);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+	std::cerr << name << " replay failed" << std::endl;
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::string path;
+    bool synthetic = argc < 2;
+    if (synthetic)
+    {
+	const char* directory = std::getenv("TMPDIR");
+	path = std::string(directory == nullptr || *directory == '\0' ? "/tmp" : directory)
+		+ "/turbo_trace_replay_benchmark_" + std::to_string(::getpid());
+	// recorded in a child so the heap it leaves behind does not flatter the cstdlib replay
+	const pid_t pid = ::fork();
+	if (pid == 0)
+	{
+	    synthesize(path);
+	    ::_exit(0);
+	}
+	int status = 0;
+	::waitpid(pid, &status, 0);
+    }
+    else
+    {
+	path = argv[1];
+    }
+    const tme::block::capacity_type initial_capacity = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 256U;
+    const tme::block::capacity_type contingency_capacity = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 256U;
+    const tme::trace_reader reader(path);
+    if (synthetic)
+    {
+	std::remove(path.c_str());
+    }
+    std::cout << "replay of " << reader.get_events().size() << " events from " << reader.get_thread_count()
+	    << " threads, peak live " << (reader.get_peak_live_bytes() >> 10U) << " KiB, "
+	    << reader.get_dropped_frees() << " unmatched frees dropped" << std::endl;
+    std::cout << std::setw(16) << "allocator" << std::setw(16) << "ops/sec" << std::setw(16) << "peak RSS KiB"
+	    << std::setw(16) << "RSS/live" << std::setw(16) << "failures" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    replay_in_child("slab", reader, [initial_capacity, contingency_capacity] ()
+    {
+	// shared by every replay thread; built by the first one to ask
+	static std::once_flag once;
+	static std::unique_ptr<tme::concurrent_sized_slab> slab;
+	std::call_once(once, [initial_capacity, contingency_capacity] ()
+	{
+	    std::vector<tme::block_config> config;
+	    for (std::size_t size = 8U; size <= 32768U; size <<= 1U)
+	    {
+		config.emplace_back(size, initial_capacity);
+	    }
+	    slab.reset(new tme::concurrent_sized_slab(contingency_capacity, config, 1U, tme::large_object_config()));
+	});
+	return std::unique_ptr<slab_allocator>(new slab_allocator(*slab));
+    });
+    replay_in_child("cstdlib", reader, [] ()
+    {
+	return std::unique_ptr<cstdlib_allocator>(new cstdlib_allocator());
+    });
+    replay_in_child("arena", reader, [] ()
+    {
+	return std::unique_ptr<arena_allocator>(new arena_allocator());
+    });
+    return 0;
+}
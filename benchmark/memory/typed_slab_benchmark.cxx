@@ -0,0 +1,103 @@
+#include <turbo/memory/typed_slab.hpp>
+#include <turbo/memory/typed_slab.hh>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/memory/slab_allocator.hh>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+const std::size_t batch_size = 256U;
+
+struct type_index
+{
+    template <class value_t>
+    static std::size_t get_index();
+};
+
+template <>
+std::size_t type_index::get_index<std::uint32_t>()
+{
+    return 0U;
+}
+
+template <>
+std::size_t type_index::get_index<std::uint64_t>()
+{
+    return 1U;
+}
+
+template <>
+std::size_t type_index::get_index<std::string>()
+{
+    return 2U;
+}
+
+///
+/// Allocates and frees a batch of values of each type in turn
+///
+template <class slab_t>
+double measure(slab_t& slab, std::size_t rounds)
+{
+    std::vector<std::uint32_t*> small;
+    std::vector<std::uint64_t*> medium;
+    std::vector<std::string*> large;
+    std::size_t failures = 0U;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t round = 0U; round < rounds; ++round)
+    {
+	for (std::size_t count = 0U; count < batch_size; ++count)
+	{
+	    small.push_back(slab.template allocate<std::uint32_t>());
+	    medium.push_back(slab.template allocate<std::uint64_t>());
+	    large.push_back(slab.template allocate<std::string>());
+	}
+	for (std::size_t count = 0U; count < batch_size; ++count)
+	{
+	    failures += (small[count] == nullptr) + (medium[count] == nullptr) + (large[count] == nullptr);
+	    slab.deallocate(small[count]);
+	    slab.deallocate(medium[count]);
+	    slab.deallocate(large[count]);
+	}
+	small.clear();
+	medium.clear();
+	large.clear();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    if (failures != 0U)
+    {
+	std::cerr << failures << " allocations failed" << std::endl;
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / (rounds * batch_size * 3U);
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t rounds = 10000U;
+    if (argc > 1)
+    {
+	rounds = std::strtoul(argv[1], nullptr, 10);
+    }
+    tme::concurrent_typed_slab<type_index> runtime_slab({
+	    {sizeof(std::uint32_t), batch_size},
+	    {sizeof(std::uint64_t), batch_size},
+	    {sizeof(std::string), batch_size} });
+    tme::typed_slab<std::uint32_t, std::uint64_t, std::string> compile_time_slab(batch_size, batch_size);
+    const double runtime_time = measure(runtime_slab, rounds);
+    const double compile_time_time = measure(compile_time_slab, rounds);
+    std::cout << "allocate and free batches of " << batch_size << " values of 3 types" << std::endl;
+    std::cout << std::setw(32) << "slab" << std::setw(16) << "ns/value" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(32) << "concurrent_typed_slab" << std::setw(16) << runtime_time << std::endl;
+    std::cout << std::setw(32) << "typed_slab" << std::setw(16) << compile_time_time << std::endl;
+    return 0;
+}
@@ -0,0 +1,299 @@
+///
+/// Replaces the C allocation functions with untyped_allocator so that existing
+/// binaries can run on the slabs, either by linking against this library or with
+/// LD_PRELOAD. Sizes and alignments the slabs are not configured for, and every
+/// allocation made before the slabs are ready or from within the slabs themselves,
+/// fall through to the system allocator. Memory is returned to whichever allocator
+/// owns it, so the two can be mixed freely.
+///
+/// The fall through relies on the __libc_ entry points, so this is glibc only.
+///
+#include "malloc_preload.hpp"
+#include "untyped_allocator.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <dlfcn.h>
+#include <turbo/memory/block.hpp>
+#include <turbo/memory/slab_allocator.hh>
+#include <turbo/toolset/attribute.hpp>
+#include <turbo/toolset/extension.hpp>
+
+extern "C" {
+
+void* __libc_malloc(std::size_t size);
+void __libc_free(void* ptr);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+
+} // extern "C"
+
+namespace tci = turbo::cinterop;
+namespace tme = turbo::memory;
+
+namespace {
+
+///
+/// malloc must return memory aligned for any fundamental type
+///
+const std::size_t min_size = 16U;
+const std::size_t max_size = 4096U;
+const std::uint32_t contingency_capacity = 256U;
+///
+/// Slots are only aligned up to the page size since the size classes are powers of 2
+/// and every block starts on a page boundary
+///
+const std::size_t max_alignment = 4096U;
+
+enum class preload_state
+{
+    uninitialised,
+    initialising,
+    ready
+};
+
+std::atomic<preload_state> state(preload_state::uninitialised);
+
+std::aligned_storage<sizeof(tci::untyped_allocator), alignof(tci::untyped_allocator)>::type allocator_storage;
+
+std::atomic<tci::untyped_allocator*> allocator(nullptr);
+
+///
+/// Set while a thread is inside the slabs, so the allocations they make themselves go to the system
+///
+__attribute__((tls_model("initial-exec"))) thread_local bool in_slab = false;
+
+std::vector<tme::block_config> make_config()
+{
+    std::vector<tme::block_config> config;
+    // mapped storage keeps the blocks out of the system heap and only commits pages that are used
+    const tme::storage_policy storage(tme::storage_policy::backing::mapped, false);
+    for (std::size_t size = min_size; size <= max_size; size *= 2U)
+    {
+	config.emplace_back(size, static_cast<std::uint32_t>(65536U / size), contingency_capacity, 2U, storage);
+    }
+    return config;
+}
+
+///
+/// Returns the allocator once it is ready, or nullptr if this call has to use the system allocator
+///
+tci::untyped_allocator* acquire_allocator()
+{
+    tci::untyped_allocator* ready = allocator.load(std::memory_order_acquire);
+    if (TURBO_LIKELY(ready != nullptr))
+    {
+	return in_slab ? nullptr : ready;
+    }
+    preload_state current = state.load(std::memory_order_acquire);
+    if (current == preload_state::uninitialised
+	    && !in_slab
+	    && state.compare_exchange_strong(current, preload_state::initialising, std::memory_order_acq_rel))
+    {
+	tci::slab_section section;
+	// never destroyed, so memory can still be freed during static destruction
+	allocator.store(new (&allocator_storage) tci::untyped_allocator(contingency_capacity, make_config()), std::memory_order_release);
+	state.store(preload_state::ready, std::memory_order_release);
+	return nullptr;
+    }
+    return nullptr;
+}
+
+inline std::size_t calc_slab_size(std::size_t size, std::size_t alignment)
+{
+    return std::max(std::max(size, alignment), min_size);
+}
+
+void* allocate(std::size_t size, std::size_t alignment)
+{
+    tci::untyped_allocator* slab = acquire_allocator();
+    const std::size_t slab_size = calc_slab_size(size, alignment);
+    if (slab != nullptr && alignment <= max_alignment && slab_size <= max_size)
+    {
+	tci::slab_section section;
+	void* result = (alignment <= min_size) ? slab->malloc(slab_size) : slab->aligned_alloc(alignment, std::max(size, min_size));
+	if (TURBO_LIKELY(result != nullptr))
+	{
+	    return result;
+	}
+    }
+    return (alignment <= min_size) ? __libc_malloc(size) : __libc_memalign(alignment, size);
+}
+
+///
+/// The slot size when the slabs own the address, otherwise 0
+///
+inline std::size_t find_slab_size(const void* ptr)
+{
+    tci::untyped_allocator* slab = allocator.load(std::memory_order_acquire);
+    return (slab == nullptr || ptr == nullptr) ? 0U : slab->usable_size(ptr);
+}
+
+void deallocate(void* ptr)
+{
+    if (find_slab_size(ptr) != 0U)
+    {
+	tci::slab_section section;
+	allocator.load(std::memory_order_acquire)->free(ptr);
+    }
+    else
+    {
+	__libc_free(ptr);
+    }
+}
+
+inline bool is_valid_alignment(std::size_t alignment)
+{
+    return alignment != 0U && (alignment & (alignment - 1U)) == 0U;
+}
+
+} // anonymous namespace
+
+namespace turbo {
+namespace cinterop {
+
+slab_section::slab_section()
+    :
+	previous_(in_slab)
+{
+    in_slab = true;
+}
+
+slab_section::~slab_section()
+{
+    in_slab = previous_;
+}
+
+bool is_in_slab_section()
+{
+    return in_slab;
+}
+
+} // namespace cinterop
+} // namespace turbo
+
+extern "C" {
+
+TURBO_DECL_EXPORT void* malloc(std::size_t size) __THROW
+{
+    return allocate(size, min_size);
+}
+
+TURBO_DECL_EXPORT void free(void* ptr) __THROW
+{
+    deallocate(ptr);
+}
+
+TURBO_DECL_EXPORT void* calloc(std::size_t count, std::size_t size) __THROW
+{
+    if (count != 0U && size > std::numeric_limits<std::size_t>::max() / count)
+    {
+	errno = ENOMEM;
+	return nullptr;
+    }
+    const std::size_t total = count * size;
+    tci::untyped_allocator* slab = acquire_allocator();
+    if (slab == nullptr || calc_slab_size(total, min_size) > max_size)
+    {
+	return __libc_calloc(count, size);
+    }
+    void* result = allocate(total, min_size);
+    if (result != nullptr)
+    {
+	// slots are reused without being cleared
+	std::memset(result, 0, total);
+    }
+    return result;
+}
+
+TURBO_DECL_EXPORT void* realloc(void* ptr, std::size_t size) __THROW
+{
+    if (ptr == nullptr)
+    {
+	return allocate(size, min_size);
+    }
+    const std::size_t old_size = find_slab_size(ptr);
+    if (old_size == 0U)
+    {
+	return __libc_realloc(ptr, size);
+    }
+    if (size == 0U)
+    {
+	deallocate(ptr);
+	return nullptr;
+    }
+    if (calc_slab_size(size, min_size) <= max_size)
+    {
+	tci::slab_section section;
+	// stays in place while the size class is unchanged
+	void* result = allocator.load(std::memory_order_acquire)->realloc(ptr, calc_slab_size(size, min_size));
+	if (result != nullptr)
+	{
+	    return result;
+	}
+    }
+    void* result = allocate(size, min_size);
+    if (result != nullptr)
+    {
+	std::memcpy(result, ptr, std::min(old_size, size));
+	deallocate(ptr);
+    }
+    return result;
+}
+
+TURBO_DECL_EXPORT int posix_memalign(void** output, std::size_t alignment, std::size_t size) __THROW
+{
+    if (!is_valid_alignment(alignment) || alignment % sizeof(void*) != 0U)
+    {
+	return EINVAL;
+    }
+    void* result = allocate(size, alignment);
+    if (result == nullptr)
+    {
+	return ENOMEM;
+    }
+    *output = result;
+    return 0;
+}
+
+TURBO_DECL_EXPORT void* aligned_alloc(std::size_t alignment, std::size_t size) __THROW
+{
+    if (!is_valid_alignment(alignment))
+    {
+	errno = EINVAL;
+	return nullptr;
+    }
+    return allocate(size, alignment);
+}
+
+TURBO_DECL_EXPORT void* memalign(std::size_t alignment, std::size_t size) __THROW
+{
+    if (!is_valid_alignment(alignment))
+    {
+	errno = EINVAL;
+	return nullptr;
+    }
+    return allocate(size, alignment);
+}
+
+TURBO_DECL_EXPORT std::size_t malloc_usable_size(void* ptr) __THROW
+{
+    const std::size_t slab_size = find_slab_size(ptr);
+    if (slab_size != 0U || ptr == nullptr)
+    {
+	return slab_size;
+    }
+    typedef std::size_t (*usable_size_function)(void*);
+    static usable_size_function system_usable_size = reinterpret_cast<usable_size_function>(dlsym(RTLD_NEXT, "malloc_usable_size"));
+    return system_usable_size == nullptr ? 0U : system_usable_size(ptr);
+}
+
+} // extern "C"
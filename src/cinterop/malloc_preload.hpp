@@ -0,0 +1,34 @@
+#ifndef TURBO_CINTEROP_MALLOC_PRELOAD_HPP
+#define TURBO_CINTEROP_MALLOC_PRELOAD_HPP
+
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace cinterop {
+
+///
+/// While a section is open on a thread, the C allocation functions of the preload
+/// library send that thread's allocations to the system allocator. The library opens
+/// one around every call into the slabs, so that the slabs never re-enter themselves.
+/// Sections nest; closing one restores whatever the enclosing section set.
+///
+class TURBO_SYMBOL_DECL slab_section
+{
+public:
+    slab_section();
+    ~slab_section();
+private:
+    slab_section(const slab_section&) = delete;
+    slab_section& operator=(const slab_section&) = delete;
+    bool previous_;
+};
+
+///
+/// Whether a slab_section is open on the calling thread
+///
+TURBO_SYMBOL_DECL bool is_in_slab_section();
+
+} // namespace cinterop
+} // namespace turbo
+
+#endif
@@ -1,10 +1,13 @@
 #include "untyped_allocator.hpp"
+#include <cstring>
+#include <algorithm>
+#include <functional>
 #include <utility>
-#include <turbo/container/bitwise_trie.hh>
-#include <turbo/container/trie_key.hpp>
+#include <turbo/memory/allocation_trace.hh>
+#include <turbo/memory/block.hpp>
 #include <turbo/memory/slab_allocator.hh>
+#include <turbo/toolset/extension.hpp>
 
-namespace tco = turbo::container;
 namespace tme = turbo::memory;
 
 namespace turbo {
@@ -14,91 +17,133 @@ untyped_allocator::untyped_allocator(
 	std::uint32_t contingency_capacity,
 	const std::vector<tme::block_config>& config)
     :
-	allocation_slab_(contingency_capacity, config),
-	trie_slab_(contingency_capacity, derive_trie_config(tme::calibrate(contingency_capacity, config))),
-	address_map_(trie_slab_)
-{
-    init_address_map();
-}
+	allocation_slab_(contingency_capacity, config)
+{ }
 
 untyped_allocator::untyped_allocator(const untyped_allocator& other)
     :
-	allocation_slab_(other.allocation_slab_),
-	trie_slab_(2U, other.trie_slab_.get_block_config()),
-	address_map_(trie_slab_)
-{
-    init_address_map();
-}
-
-///
-/// For some reason using the default destructor requires users of this library
-/// to include bitwise_trie.hh (a GCC bug?), so defining a custom destructor
-/// to avoid this
-///
-untyped_allocator::~untyped_allocator()
+	allocation_slab_(other.allocation_slab_)
 { }
 
 untyped_allocator& untyped_allocator::operator=(const untyped_allocator& other)
 {
     if (this != &other
-	    && this->trie_slab_.get_block_config() == other.trie_slab_.get_block_config()
-	    && this->address_map_.size() >= other.address_map_.size())
+	    && this->allocation_slab_.get_block_config() == other.allocation_slab_.get_block_config()
+	    && this->get_block_count() >= other.get_block_count())
     {
 	this->allocation_slab_ = other.allocation_slab_;
     }
     return *this;
 }
 
+std::size_t untyped_allocator::get_block_count() const
+{
+    std::size_t count = 0U;
+    for (auto iter = allocation_slab_.cbegin(); iter != allocation_slab_.cend(); ++iter)
+    {
+	count += iter->get_list_size();
+    }
+    return count;
+}
+
 void* untyped_allocator::malloc(std::size_t size)
 {
     if (!allocation_slab_.in_configured_range(size))
     {
 	return nullptr;
     }
-    turbo::memory::block_list& list = allocation_slab_.at(size);
-    std::size_t old_size = list.get_list_size();
-    void* result = allocation_slab_.malloc(size);
-    std::size_t new_size = list.get_list_size();
-    if (old_size < new_size)
-    {
-	for (auto iter = list.begin(); iter != list.end(); ++iter)
-	{
-	    if (iter.is_last())
-	    {
-		address_map_.emplace(reinterpret_cast<std::uintptr_t>(iter->get_base_address()), iter->get_value_size());
-	    }
-	}
-    }
+    void* result = allocation_slab_.at(size).allocate();
+    tme::trace_allocate(size, result);
     return result;
 }
 
 void untyped_allocator::free(void* ptr)
 {
-    auto iter = address_map_.find_less_equal(reinterpret_cast<std::uintptr_t>(ptr));
-    if (iter != address_map_.cend())
+    tme::block_list* list = find_list(ptr);
+    if (list != nullptr)
     {
-	allocation_slab_.free(ptr, *iter);
+	// recorded before the slot is released, so its next allocation is always recorded after
+	tme::trace_free(list->get_value_size(), ptr);
+	list->free(ptr);
     }
 }
 
-std::vector<tme::block_config> untyped_allocator::derive_trie_config(const std::vector<tme::block_config>& alloc_config)
+void* untyped_allocator::realloc(void* ptr, std::size_t size)
 {
-    typedef tco::uint_trie_key<std::uintptr_t, trie_type::radix> key_type;
-    std::vector<tme::block_config> result;
-    result.push_back(tme::block_config(trie_type::node_sizes[0], alloc_config.size() * growth_contingency));
-    result.push_back(tme::block_config(trie_type::node_sizes[1], alloc_config.size() * growth_contingency * key_type::max_prefix_capacity()));
-    return std::move(result);
+    if (ptr == nullptr)
+    {
+	return malloc(size);
+    }
+    tme::block_list* old_list = find_list(ptr);
+    if (old_list == nullptr || !allocation_slab_.in_configured_range(size))
+    {
+	return nullptr;
+    }
+    tme::block_list& new_list = allocation_slab_.at(size);
+    if (&new_list == old_list)
+    {
+	return ptr;
+    }
+    void* result = new_list.allocate();
+    if (result != nullptr)
+    {
+	tme::trace_allocate(size, result);
+	std::memcpy(result, ptr, std::min(old_list->get_value_size(), new_list.get_value_size()));
+	tme::trace_free(old_list->get_value_size(), ptr);
+	old_list->free(ptr);
+    }
+    return result;
 }
 
-void untyped_allocator::init_address_map()
+void* untyped_allocator::aligned_alloc(std::size_t alignment, std::size_t size)
 {
-    for (tme::block_list& list: allocation_slab_)
+    if (alignment == 0U || (alignment & (alignment - 1U)) != 0U || !allocation_slab_.in_configured_range(size))
+    {
+	return nullptr;
+    }
+    // classes only grow from here, so the first naturally aligned one wastes the least
+    auto iter = allocation_slab_.begin() + (&allocation_slab_.at(size) - &(*allocation_slab_.begin()));
+    for (; iter != allocation_slab_.end(); ++iter)
     {
-	for (tme::block& block: list)
+	if (calc_slot_alignment(iter->get_value_size()) >= alignment)
 	{
-	    address_map_.emplace(reinterpret_cast<std::uintptr_t>(block.get_base_address()), block.get_value_size());
+	    void* result = iter->allocate();
+	    tme::trace_allocate(size, result);
+	    return result;
 	}
     }
+    return nullptr;
+}
+
+bool untyped_allocator::owns(const void* ptr) const
+{
+    return find_list(ptr) != nullptr;
+}
+
+std::size_t untyped_allocator::usable_size(const void* ptr) const
+{
+    const tme::block_list* list = find_list(ptr);
+    return list == nullptr ? 0U : list->get_value_size();
+}
+
+const tme::block_list* untyped_allocator::find_list(const void* ptr) const
+{
+    const tme::block* owner = tme::block::find_owner(ptr);
+    if (owner == nullptr || owner->get_list() == nullptr || allocation_slab_.cbegin() == allocation_slab_.cend())
+    {
+	return nullptr;
+    }
+    // the owner could belong to another allocator or slab
+    const tme::block_list* first = &(*allocation_slab_.cbegin());
+    const tme::block_list* last = first + (allocation_slab_.cend() - allocation_slab_.cbegin());
+    const tme::block_list* list = owner->get_list();
+    return std::less_equal<const tme::block_list*>()(first, list) && std::less<const tme::block_list*>()(list, last) ? list : nullptr;
+}
+
+tme::block_list* untyped_allocator::find_list(const void* ptr)
+{
+    const tme::block_list* list = static_cast<const untyped_allocator*>(this)->find_list(ptr);
+    return list == nullptr ? nullptr : &(*(allocation_slab_.begin() + (list - &(*allocation_slab_.cbegin()))));
 }
 
 } // namespace cinterop
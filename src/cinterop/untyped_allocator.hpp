@@ -2,18 +2,11 @@
 #define TURBO_CINTEROP_UNTYPED_ALLOCATOR_HPP
 
 #include <cstdint>
-#include <turbo/container/bitwise_trie.hpp>
 #include <turbo/memory/slab_allocator.hpp>
 #include <turbo/toolset/attribute.hpp>
 
 namespace turbo {
 
-namespace memory {
-
-class block;
-
-} // namespace memory
-
 namespace cinterop {
 
 class untyped_allocator_tester;
@@ -21,28 +14,58 @@ class untyped_allocator_tester;
 class TURBO_SYMBOL_DECL untyped_allocator final
 {
 public:
-    static const std::size_t growth_contingency = 2U;
     untyped_allocator(std::uint32_t contingency_capacity, const std::vector<turbo::memory::block_config>& config);
     untyped_allocator(const untyped_allocator& other);
-    ~untyped_allocator();
     untyped_allocator& operator=(const untyped_allocator& other);
-    inline std::size_t get_block_count()
-    {
-	return address_map_.size();
-    }
+    std::size_t get_block_count() const;
     void* malloc(std::size_t size);
     void free(void* ptr);
+    ///
+    /// Returns ptr unchanged while size still maps to the slot's size class, otherwise
+    /// moves the contents to the right class with a single copy. Returns nullptr and
+    /// leaves ptr untouched if size is not in the configured range.
+    ///
+    void* realloc(void* ptr, std::size_t size);
+    ///
+    /// Serves a power of 2 alignment from the smallest class whose slots are naturally
+    /// aligned to it; returns nullptr for other alignments or if no class qualifies
+    ///
+    void* aligned_alloc(std::size_t alignment, std::size_t size);
+    inline void* memalign(std::size_t alignment, std::size_t size)
+    {
+	return aligned_alloc(alignment, size);
+    }
+    ///
+    /// Whether the address lies in a slab block rather than memory from elsewhere
+    ///
+    bool owns(const void* ptr) const;
+    ///
+    /// The size of the slot holding the address, or 0 if it was not allocated by a slab
+    ///
+    std::size_t usable_size(const void* ptr) const;
     friend class untyped_allocator_tester;
 private:
-    typedef turbo::container::bitwise_trie<std::uintptr_t, std::size_t, turbo::memory::concurrent_sized_slab> trie_type;
     untyped_allocator() = delete;
     untyped_allocator(untyped_allocator&&) = delete;
     untyped_allocator& operator=(untyped_allocator&&) = delete;
-    static std::vector<turbo::memory::block_config> derive_trie_config(const std::vector<turbo::memory::block_config>& alloc_config);
-    void init_address_map();
+    ///
+    /// Every slot of a list is aligned to the lowest set bit of its value size. block_list
+    /// asks its blocks to align values to their size. block::calc_region_alignment
+    /// raises the alignment of a block's region from the shared page granule towards
+    /// that, up to a page, and the block aligns its base within the region using the
+    /// spare slot it keeps for the purpose.
+    ///
+    static inline std::size_t calc_slot_alignment(std::size_t value_size)
+    {
+	return value_size & (~value_size + 1U);
+    }
+    ///
+    /// The list of this allocator that the address was allocated from, found through the
+    /// owning block, or nullptr so that free never touches memory from anywhere else
+    ///
+    const turbo::memory::block_list* find_list(const void* ptr) const;
+    turbo::memory::block_list* find_list(const void* ptr);
     turbo::memory::concurrent_sized_slab allocation_slab_;
-    turbo::memory::concurrent_sized_slab trie_slab_;
-    trie_type address_map_;
 };
 
 } // namespace cinterop
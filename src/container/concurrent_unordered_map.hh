@@ -63,24 +63,15 @@ typename concurrent_unordered_map<k, e, h, a>::emplace_result concurrent_unorder
 	std::tuple<key_args_t...>&& key_args,
 	std::tuple<value_args_t...>&& value_args)
 {
-    value_type* allocation = allocator_.template allocate<value_type>();
-    if (allocation == nullptr)
+    auto made = allocator_.template make_shared<value_type>(
+	    std::piecewise_construct,
+	    std::move(key_args),
+	    std::move(value_args));
+    if (made.first != turbo::memory::make_result::success)
     {
 	return emplace_result::allocator_full;
     }
-    std::shared_ptr<value_type> value(new (allocation) value_type(
-	    std::piecewise_construct,
-	    std::move(key_args),
-	    std::move(value_args)),
-	    [this](value_type* ptr) -> void
-	    {
-		if (ptr == nullptr)
-		{
-		    return;
-		}
-		ptr->~value_type();
-		this->allocator_.deallocate(ptr);
-	    });
+    shared_value_type value(std::move(made.second));
     // TODO: decide when to resize the map
     std::size_t bucket_id = hash_func_(value->first) & (group_.size() - 1);
     std::unique_lock<tth::shared_mutex> lock(group_[bucket_id].mutex(), std::defer_lock);
@@ -14,6 +14,14 @@
 namespace turbo {
 namespace container {
 
+///
+/// Values are held in slab_shared_ptr handles made by typed_allocator_t::make_shared, so
+/// the allocator has to be one of the slabs, concurrent_sized_slab or
+/// concurrent_typed_slab. Each value takes a slot big enough for node_type, which adds
+/// the reference count to value_type. Configure the allocator for sizeof(node_type)
+/// rather than sizeof(value_type); when no bucket holds node_type, or the one that
+/// does is full, try_emplace returns allocator_full.
+///
 template<typename key_t, typename element_t, typename hash_f = std::hash<key_t>, class typed_allocator_t = turbo::memory::concurrent_sized_slab>
 class concurrent_unordered_map
 {
@@ -21,7 +29,8 @@ public:
     typedef key_t key_type;
     typedef element_t mapped_type;
     typedef std::pair<key_type, mapped_type> value_type;
-    typedef std::shared_ptr<value_type> shared_value_type;
+    typedef turbo::memory::slab_shared_ptr<value_type> shared_value_type;
+    typedef typename shared_value_type::node_type node_type;
     typedef hash_f hasher;
     typedef typed_allocator_t allocator_type;
 
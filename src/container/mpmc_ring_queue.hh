@@ -3,37 +3,43 @@
 
 #include <turbo/container/mpmc_ring_queue.hpp>
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
 #include <turbo/algorithm/recovery.hh>
+#include <turbo/container/ring_capacity.hh>
+#include <turbo/container/wait_strategy.hh>
 
 namespace turbo {
 namespace container {
 
-template <class value_t, template <class type_t> class allocator_t>
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
 class mpmc_key
 {
     mpmc_key() { }
-    friend class mpmc_ring_queue<value_t, allocator_t>;
+    friend class mpmc_ring_queue<value_t, allocator_t, wait_t>;
 };
 
 template <class value_t>
 node<value_t>::node() noexcept
     :
-	guard(status::unused)
+	sequence(0U),
+	skipped(false)
 { }
 
 template <class value_t>
 node<value_t>::node(const value_t& the_value)
     :
-	guard(status::unused),
+	sequence(0U),
+	skipped(false),
 	value(the_value)
 { }
 
 template <class value_t>
 node<value_t>::node(const node& other)
     :
-	guard(other.guard.load()),
+	sequence(other.sequence.load()),
+	skipped(other.skipped),
 	value(other.value)
 { }
 
@@ -42,7 +48,8 @@ node<value_t>& node<value_t>::operator=(const node& other)
 {
     if (this != &other)
     {
-	guard.store(other.guard.load(std::memory_order_acquire), std::memory_order_release);
+	sequence.store(other.sequence.load(std::memory_order_acquire), std::memory_order_release);
+	skipped = other.skipped;
 	value = other.value;
     }
     return *this;
@@ -51,19 +58,22 @@ node<value_t>& node<value_t>::operator=(const node& other)
 template <class value_t>
 bool node<value_t>::operator==(const node& other) const
 {
-    return this->guard.load() == other.guard.load()
+    return this->sequence.load() == other.sequence.load()
+	&& this->skipped == other.skipped
 	&& this->value == other.value;
 }
 
 template <class value_t>
 atomic_node<value_t>::atomic_node(const value_t& the_value)
     :
+	sequence(0U),
 	value(the_value)
 { }
 
 template <class value_t>
 atomic_node<value_t>::atomic_node(const atomic_node& other)
     :
+	sequence(other.sequence.load()),
 	value(other.value.load())
 { }
 
@@ -72,6 +82,7 @@ atomic_node<value_t>& atomic_node<value_t>::operator=(const atomic_node& other)
 {
     if (this != &other)
     {
+	sequence.store(other.sequence.load(std::memory_order_acquire), std::memory_order_release);
 	value.store(other.value.load(std::memory_order_acquire), std::memory_order_release);
     }
     return *this;
@@ -83,76 +94,192 @@ bool atomic_node<value_t>::operator==(const atomic_node& other) const
     return this->value.load() == other.value.load();
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-mpmc_producer<value_t, allocator_t>::mpmc_producer(const key&, mpmc_ring_queue<value_t, allocator_t>& queue)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+mpmc_producer<value_t, allocator_t, wait_t>::mpmc_producer(const key&, mpmc_ring_queue<value_t, allocator_t, wait_t>& queue)
     :
 	queue_(queue)
 { }
 
-template <class value_t, template <class type_t> class allocator_t>
-mpmc_producer<value_t, allocator_t>::mpmc_producer(const mpmc_producer& other)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+mpmc_producer<value_t, allocator_t, wait_t>::mpmc_producer(const mpmc_producer& other)
     :
 	queue_(other.queue_)
 { }
 
-template <class value_t, template <class type_t> class allocator_t>
-bool mpmc_producer<value_t, allocator_t>::operator==(const mpmc_producer& other) const
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+bool mpmc_producer<value_t, allocator_t, wait_t>::operator==(const mpmc_producer& other) const
 {
     return &(this->queue_) == &(other.queue_);
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-typename mpmc_producer<value_t, allocator_t>::result mpmc_producer<value_t, allocator_t>::try_enqueue_copy(const value_t& input)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<value_t, allocator_t, wait_t>::result mpmc_producer<value_t, allocator_t, wait_t>::try_enqueue_copy(const value_t& input)
 {
     return queue_.try_enqueue_copy(input);
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-typename mpmc_producer<value_t, allocator_t>::result mpmc_producer<value_t, allocator_t>::try_enqueue_move(value_t&& input)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<value_t, allocator_t, wait_t>::result mpmc_producer<value_t, allocator_t, wait_t>::try_enqueue_move(value_t&& input)
 {
     return queue_.try_enqueue_move(std::move(input));
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-mpmc_consumer<value_t, allocator_t>::mpmc_consumer(const key&, mpmc_ring_queue<value_t, allocator_t>& queue)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+template <class iterator_t>
+typename mpmc_producer<value_t, allocator_t, wait_t>::result mpmc_producer<value_t, allocator_t, wait_t>::try_enqueue_bulk(
+	iterator_t first,
+	iterator_t last,
+	uint32_t& count)
+{
+    return queue_.try_enqueue_bulk(first, last, count);
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+void mpmc_producer<value_t, allocator_t, wait_t>::enqueue_copy(const value_t& input)
+{
+    queue_.not_full_.wait([&] () -> bool
+    {
+	return queue_.try_enqueue_copy(input) == result::success;
+    });
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+void mpmc_producer<value_t, allocator_t, wait_t>::enqueue_move(value_t&& input)
+{
+    queue_.not_full_.wait([&] () -> bool
+    {
+	return queue_.try_enqueue_move(std::move(input)) == result::success;
+    });
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+template <class rep_t, class period_t>
+typename mpmc_producer<value_t, allocator_t, wait_t>::result mpmc_producer<value_t, allocator_t, wait_t>::try_enqueue_copy_for(
+	const value_t& input,
+	const std::chrono::duration<rep_t, period_t>& timeout)
+{
+    const bool enqueued = queue_.not_full_.wait_until([&] () -> bool
+    {
+	return queue_.try_enqueue_copy(input) == result::success;
+    },
+    wait_t::clock_type::now() + std::chrono::duration_cast<typename wait_t::clock_type::duration>(timeout));
+    return enqueued ? result::success : result::queue_full;
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+template <class rep_t, class period_t>
+typename mpmc_producer<value_t, allocator_t, wait_t>::result mpmc_producer<value_t, allocator_t, wait_t>::try_enqueue_move_for(
+	value_t&& input,
+	const std::chrono::duration<rep_t, period_t>& timeout)
+{
+    const bool enqueued = queue_.not_full_.wait_until([&] () -> bool
+    {
+	return queue_.try_enqueue_move(std::move(input)) == result::success;
+    },
+    wait_t::clock_type::now() + std::chrono::duration_cast<typename wait_t::clock_type::duration>(timeout));
+    return enqueued ? result::success : result::queue_full;
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+mpmc_consumer<value_t, allocator_t, wait_t>::mpmc_consumer(const key&, mpmc_ring_queue<value_t, allocator_t, wait_t>& queue)
     :
 	queue_(queue)
 { }
 
-template <class value_t, template <class type_t> class allocator_t>
-mpmc_consumer<value_t, allocator_t>::mpmc_consumer(const mpmc_consumer& other)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+mpmc_consumer<value_t, allocator_t, wait_t>::mpmc_consumer(const mpmc_consumer& other)
     :
 	queue_(other.queue_)
 { }
 
-template <class value_t, template <class type_t> class allocator_t>
-bool mpmc_consumer<value_t, allocator_t>::operator==(const mpmc_consumer& other) const
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+bool mpmc_consumer<value_t, allocator_t, wait_t>::operator==(const mpmc_consumer& other) const
 {
     return &(this->queue_) == &(other.queue_);
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-typename mpmc_consumer<value_t, allocator_t>::result mpmc_consumer<value_t, allocator_t>::try_dequeue_copy(value_t& output)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<value_t, allocator_t, wait_t>::result mpmc_consumer<value_t, allocator_t, wait_t>::try_dequeue_copy(value_t& output)
 {
     return queue_.try_dequeue_copy(output);
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-typename mpmc_consumer<value_t, allocator_t>::result mpmc_consumer<value_t, allocator_t>::try_dequeue_move(value_t& output)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<value_t, allocator_t, wait_t>::result mpmc_consumer<value_t, allocator_t, wait_t>::try_dequeue_move(value_t& output)
 {
     return queue_.try_dequeue_move(output);
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-mpmc_ring_queue<value_t, allocator_t>::mpmc_ring_queue(uint32_t capacity)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+template <class iterator_t>
+typename mpmc_consumer<value_t, allocator_t, wait_t>::result mpmc_consumer<value_t, allocator_t, wait_t>::try_dequeue_bulk(
+	iterator_t output,
+	uint32_t limit,
+	uint32_t& count)
+{
+    return queue_.try_dequeue_bulk(output, limit, count);
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+void mpmc_consumer<value_t, allocator_t, wait_t>::dequeue_copy(value_t& output)
+{
+    queue_.not_empty_.wait([&] () -> bool
+    {
+	return queue_.try_dequeue_copy(output) == result::success;
+    });
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+void mpmc_consumer<value_t, allocator_t, wait_t>::dequeue_move(value_t& output)
+{
+    queue_.not_empty_.wait([&] () -> bool
+    {
+	return queue_.try_dequeue_move(output) == result::success;
+    });
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+template <class rep_t, class period_t>
+typename mpmc_consumer<value_t, allocator_t, wait_t>::result mpmc_consumer<value_t, allocator_t, wait_t>::try_dequeue_copy_for(
+	value_t& output,
+	const std::chrono::duration<rep_t, period_t>& timeout)
+{
+    const bool dequeued = queue_.not_empty_.wait_until([&] () -> bool
+    {
+	return queue_.try_dequeue_copy(output) == result::success;
+    },
+    wait_t::clock_type::now() + std::chrono::duration_cast<typename wait_t::clock_type::duration>(timeout));
+    return dequeued ? result::success : result::queue_empty;
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+template <class rep_t, class period_t>
+typename mpmc_consumer<value_t, allocator_t, wait_t>::result mpmc_consumer<value_t, allocator_t, wait_t>::try_dequeue_move_for(
+	value_t& output,
+	const std::chrono::duration<rep_t, period_t>& timeout)
+{
+    const bool dequeued = queue_.not_empty_.wait_until([&] () -> bool
+    {
+	return queue_.try_dequeue_move(output) == result::success;
+    },
+    wait_t::clock_type::now() + std::chrono::duration_cast<typename wait_t::clock_type::duration>(timeout));
+    return dequeued ? result::success : result::queue_empty;
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+mpmc_ring_queue<value_t, allocator_t, wait_t>::mpmc_ring_queue(uint32_t capacity)
     :
 	mpmc_ring_queue(capacity, 0U)
 { }
 
-template <class value_t, template <class type_t> class allocator_t>
-mpmc_ring_queue<value_t, allocator_t>::mpmc_ring_queue(uint32_t capacity, uint16_t handle_limit)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+mpmc_ring_queue<value_t, allocator_t, wait_t>::mpmc_ring_queue(uint32_t capacity, uint16_t handle_limit)
     :
-	buffer_(capacity),
+	// one slot cannot tell a published value from a free slot of the next lap
+	capacity_(std::max(calc_ring_capacity(capacity), capacity == 0U ? 0U : 2U)),
+	mask_(capacity_ == 0U ? 0U : capacity_ - 1U),
+	// an empty ring still gets one slot, whose sequence never lets anyone in
+	buffer_(capacity_ == 0U ? 1U : capacity_),
 	head_(0),
 	tail_(0),
 	producer_list_(handle_limit, key(), *this),
@@ -163,19 +290,18 @@ mpmc_ring_queue<value_t, allocator_t>::mpmc_ring_queue(uint32_t capacity, uint16
     {
 	throw std::invalid_argument("uin32_t is not atomic on this platform");
     }
-    for (auto iter = buffer_.begin(); iter != buffer_.end(); ++iter)
+    // a slot is free for the producer whose head index matches its sequence
+    for (uint32_t index = 0U; index < buffer_.size(); ++index)
     {
-	if (!iter->guard.is_lock_free())
-	{
-	    throw std::invalid_argument("uin8_t is not atomic on this platform");
-	}
-	iter->guard.store(node_type::status::unused, std::memory_order_release);
+	buffer_[index].sequence.store(capacity_ == 0U ? std::numeric_limits<uint32_t>::max() : index, std::memory_order_relaxed);
     }
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-mpmc_ring_queue<value_t, allocator_t>::mpmc_ring_queue(const mpmc_ring_queue& other)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+mpmc_ring_queue<value_t, allocator_t, wait_t>::mpmc_ring_queue(const mpmc_ring_queue& other)
     :
+	capacity_(other.capacity_),
+	mask_(other.mask_),
 	buffer_(other.buffer_),
 	head_(other.head_.load()),
 	tail_(other.tail_.load()),
@@ -183,8 +309,8 @@ mpmc_ring_queue<value_t, allocator_t>::mpmc_ring_queue(const mpmc_ring_queue& ot
 	consumer_list_(other.consumer_list_, this)
 { }
 
-template <class value_t, template <class type_t> class allocator_t>
-mpmc_ring_queue<value_t, allocator_t>& mpmc_ring_queue<value_t, allocator_t>::operator=(const mpmc_ring_queue& other)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+mpmc_ring_queue<value_t, allocator_t, wait_t>& mpmc_ring_queue<value_t, allocator_t, wait_t>::operator=(const mpmc_ring_queue& other)
 {
     if (this != &other && this->buffer_.size() == other.buffer_.size())
     {
@@ -195,8 +321,8 @@ mpmc_ring_queue<value_t, allocator_t>& mpmc_ring_queue<value_t, allocator_t>::op
     return *this;
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-bool mpmc_ring_queue<value_t, allocator_t>::operator==(const mpmc_ring_queue& other) const
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+bool mpmc_ring_queue<value_t, allocator_t, wait_t>::operator==(const mpmc_ring_queue& other) const
 {
     return this->buffer_ == other.buffer_
 	&& this->head_.load() == other.head_.load()
@@ -205,37 +331,37 @@ bool mpmc_ring_queue<value_t, allocator_t>::operator==(const mpmc_ring_queue& ot
 	&& this->consumer_list_ == other.consumer_list_;
 }
 
-template <class value_t, template <class type_t> class allocator_t>
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
 template <class handle_t>
-mpmc_ring_queue<value_t, allocator_t>::mpmc_ring_queue::handle_list<handle_t>::handle_list(
+mpmc_ring_queue<value_t, allocator_t, wait_t>::mpmc_ring_queue::handle_list<handle_t>::handle_list(
 	uint16_t limit,
 	const key& the_key,
-	mpmc_ring_queue<value_t, allocator_t>& queue)
+	mpmc_ring_queue<value_t, allocator_t, wait_t>& queue)
     :
 	counter(0),
 	list(limit, handle_t(the_key, queue))
 { }
 
-template <class value_t, template <class type_t> class allocator_t>
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
 template <class handle_t>
-mpmc_ring_queue<value_t, allocator_t>::mpmc_ring_queue::handle_list<handle_t>::handle_list(
+mpmc_ring_queue<value_t, allocator_t, wait_t>::mpmc_ring_queue::handle_list<handle_t>::handle_list(
 	const handle_list& other,
-	mpmc_ring_queue<value_t, allocator_t>* queue)
+	mpmc_ring_queue<value_t, allocator_t, wait_t>* queue)
     :
 	counter(0),
 	list(other.list.size(), queue != nullptr ? static_cast<const handle_t&>(handle_t(key(), *queue)) : *(other.list.cbegin()))
 { }
 
-template <class value_t, template <class type_t> class allocator_t>
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
 template <class handle_t>
-bool mpmc_ring_queue<value_t, allocator_t>::mpmc_ring_queue::handle_list<handle_t>::operator==(
+bool mpmc_ring_queue<value_t, allocator_t, wait_t>::mpmc_ring_queue::handle_list<handle_t>::operator==(
 	const handle_list& other) const
 {
     return this->list.size() == other.list.size();
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-typename mpmc_ring_queue<value_t, allocator_t>::producer& mpmc_ring_queue<value_t, allocator_t>::get_producer()
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_ring_queue<value_t, allocator_t, wait_t>::producer& mpmc_ring_queue<value_t, allocator_t, wait_t>::get_producer()
 {
     uint16_t count = 0;
     do
@@ -250,8 +376,8 @@ typename mpmc_ring_queue<value_t, allocator_t>::producer& mpmc_ring_queue<value_
     return producer_list_.list[count];
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-typename mpmc_ring_queue<value_t, allocator_t>::consumer& mpmc_ring_queue<value_t, allocator_t>::get_consumer()
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_ring_queue<value_t, allocator_t, wait_t>::consumer& mpmc_ring_queue<value_t, allocator_t, wait_t>::get_consumer()
 {
     uint16_t count = 0;
     do
@@ -266,148 +392,354 @@ typename mpmc_ring_queue<value_t, allocator_t>::consumer& mpmc_ring_queue<value_
     return consumer_list_.list[count];
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-typename mpmc_producer<value_t, allocator_t>::result mpmc_ring_queue<value_t, allocator_t>::try_enqueue_copy(const value_t& input)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<value_t, allocator_t, wait_t>::result mpmc_ring_queue<value_t, allocator_t, wait_t>::claim_head(uint32_t& head, node_type*& slot)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    // for unsigned integrals nothing extra is needed to handle overflow
-    if (head - tail == buffer_.capacity())
-    {
-	return producer::result::queue_full;
-    }
-    typename node_type::status guard = buffer_[head % buffer_.capacity()].guard.load(std::memory_order_acquire);
-    if (guard == node_type::status::unused)
+    head = head_.load(std::memory_order_relaxed);
+    while (true)
     {
-	if (head_.compare_exchange_strong(head, head + 1, std::memory_order_release))
+	slot = &buffer_[head & mask_];
+	// for unsigned integrals nothing extra is needed to handle overflow
+	const std::int32_t lap = static_cast<std::int32_t>(slot->sequence.load(std::memory_order_acquire) - head);
+	if (lap == 0)
+	{
+	    // on failure head is reloaded with the index another producer moved it to
+	    if (head_.compare_exchange_weak(head, head + 1U, std::memory_order_relaxed))
+	    {
+		return producer::result::success;
+	    }
+	}
+	else if (lap < 0)
 	{
-	    buffer_[head % buffer_.capacity()].value = input;
-	    buffer_[head % buffer_.capacity()].guard.store(node_type::status::used, std::memory_order_release);
-	    return producer::result::success;
+	    // the slot still holds the previous lap's value
+	    return head - tail_.load(std::memory_order_acquire) >= capacity_
+		    ? producer::result::queue_full
+		    : producer::result::busy;
 	}
 	else
 	{
-	    return producer::result::beaten;
+	    head = head_.load(std::memory_order_relaxed);
 	}
     }
-    else
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<value_t, allocator_t, wait_t>::result mpmc_ring_queue<value_t, allocator_t, wait_t>::claim_tail(uint32_t& tail, node_type*& slot)
+{
+    tail = tail_.load(std::memory_order_relaxed);
+    while (true)
     {
-	return producer::result::busy;
+	slot = &buffer_[tail & mask_];
+	const std::int32_t lap = static_cast<std::int32_t>(slot->sequence.load(std::memory_order_acquire) - (tail + 1U));
+	if (lap == 0)
+	{
+	    if (tail_.compare_exchange_weak(tail, tail + 1U, std::memory_order_relaxed))
+	    {
+		if (!slot->skipped)
+		{
+		    return consumer::result::success;
+		}
+		// the producer of this slot failed to write it, so hand it straight back
+		slot->skipped = false;
+		slot->sequence.store(tail + capacity_, std::memory_order_release);
+		not_full_.notify();
+		tail = tail_.load(std::memory_order_relaxed);
+	    }
+	}
+	else if (lap < 0)
+	{
+	    // nothing has been published to the slot for this lap yet
+	    return head_.load(std::memory_order_acquire) == tail
+		    ? consumer::result::queue_empty
+		    : consumer::result::busy;
+	}
+	else
+	{
+	    tail = tail_.load(std::memory_order_relaxed);
+	}
     }
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-typename mpmc_producer<value_t, allocator_t>::result mpmc_ring_queue<value_t, allocator_t>::try_enqueue_move(value_t&& input)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<value_t, allocator_t, wait_t>::result mpmc_ring_queue<value_t, allocator_t, wait_t>::claim_head_run(uint32_t wanted, uint32_t& head, uint32_t& quantity)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    // for unsigned integrals nothing extra is needed to handle overflow
-    if (head - tail == buffer_.capacity())
+    head = head_.load(std::memory_order_relaxed);
+    while (true)
     {
-	return producer::result::queue_full;
+	// only reserve the run of slots that the consumers of the previous lap have finished with
+	quantity = 0U;
+	while (quantity < wanted && buffer_[(head + quantity) & mask_].sequence.load(std::memory_order_acquire) == head + quantity)
+	{
+	    ++quantity;
+	}
+	if (quantity != 0U)
+	{
+	    if (head_.compare_exchange_weak(head, head + quantity, std::memory_order_relaxed))
+	    {
+		return producer::result::success;
+	    }
+	}
+	else if (static_cast<std::int32_t>(buffer_[head & mask_].sequence.load(std::memory_order_acquire) - head) < 0)
+	{
+	    return head - tail_.load(std::memory_order_acquire) >= capacity_
+		    ? producer::result::queue_full
+		    : producer::result::busy;
+	}
+	else
+	{
+	    head = head_.load(std::memory_order_relaxed);
+	}
     }
-    typename node_type::status guard = buffer_[head % buffer_.capacity()].guard.load(std::memory_order_acquire);
-    if (guard == node_type::status::unused)
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<value_t, allocator_t, wait_t>::result mpmc_ring_queue<value_t, allocator_t, wait_t>::claim_tail_run(uint32_t wanted, uint32_t& tail, uint32_t& quantity)
+{
+    tail = tail_.load(std::memory_order_relaxed);
+    while (true)
     {
-	if (head_.compare_exchange_strong(head, head + 1, std::memory_order_release))
+	// only claim the run of slots that their producers have finished writing
+	quantity = 0U;
+	while (quantity < wanted && buffer_[(tail + quantity) & mask_].sequence.load(std::memory_order_acquire) == tail + quantity + 1U)
+	{
+	    ++quantity;
+	}
+	if (quantity != 0U)
+	{
+	    if (tail_.compare_exchange_weak(tail, tail + quantity, std::memory_order_relaxed))
+	    {
+		return consumer::result::success;
+	    }
+	}
+	else if (static_cast<std::int32_t>(buffer_[tail & mask_].sequence.load(std::memory_order_acquire) - (tail + 1U)) < 0)
 	{
-	    buffer_[head % buffer_.capacity()].value = std::move(input);
-	    buffer_[head % buffer_.capacity()].guard.store(node_type::status::used, std::memory_order_release);
-	    return producer::result::success;
+	    return head_.load(std::memory_order_acquire) == tail
+		    ? consumer::result::queue_empty
+		    : consumer::result::busy;
 	}
 	else
 	{
-	    return producer::result::beaten;
+	    tail = tail_.load(std::memory_order_relaxed);
 	}
     }
-    else
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<value_t, allocator_t, wait_t>::result mpmc_ring_queue<value_t, allocator_t, wait_t>::try_enqueue_copy(const value_t& input)
+{
+    uint32_t head = 0U;
+    node_type* slot = nullptr;
+    const typename producer::result result = claim_head(head, slot);
+    if (result == producer::result::success)
     {
-	return producer::result::busy;
+	bool written = false;
+	turbo::algorithm::recovery::try_and_ensure(
+	[&] ()
+	{
+	    slot->value = input;
+	    written = true;
+	},
+	[&] ()
+	{
+	    // should the assignment throw, publish the slot as skipped so that consumers are not held up
+	    slot->skipped = !written;
+	    slot->sequence.store(head + 1U, std::memory_order_release);
+	    not_empty_.notify();
+	});
     }
+    return result;
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-typename mpmc_consumer<value_t, allocator_t>::result mpmc_ring_queue<value_t, allocator_t>::try_dequeue_copy(value_t& output)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<value_t, allocator_t, wait_t>::result mpmc_ring_queue<value_t, allocator_t, wait_t>::try_enqueue_move(value_t&& input)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    if (head == tail)
+    uint32_t head = 0U;
+    node_type* slot = nullptr;
+    const typename producer::result result = claim_head(head, slot);
+    if (result == producer::result::success)
     {
-	return consumer::result::queue_empty;
+	bool written = false;
+	turbo::algorithm::recovery::try_and_ensure(
+	[&] ()
+	{
+	    slot->value = std::move(input);
+	    written = true;
+	},
+	[&] ()
+	{
+	    // should the assignment throw, publish the slot as skipped so that consumers are not held up
+	    slot->skipped = !written;
+	    slot->sequence.store(head + 1U, std::memory_order_release);
+	    not_empty_.notify();
+	});
     }
-    typename node_type::status guard = buffer_[tail % buffer_.capacity()].guard.load(std::memory_order_acquire);
-    if (guard == node_type::status::used)
+    return result;
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<value_t, allocator_t, wait_t>::result mpmc_ring_queue<value_t, allocator_t, wait_t>::try_dequeue_copy(value_t& output)
+{
+    uint32_t tail = 0U;
+    node_type* slot = nullptr;
+    const typename consumer::result result = claim_tail(tail, slot);
+    if (result == consumer::result::success)
     {
-	if (tail_.compare_exchange_strong(tail, tail + 1, std::memory_order_release))
+	turbo::algorithm::recovery::try_and_ensure(
+	[&] ()
 	{
-	    turbo::algorithm::recovery::try_and_ensure(
-	    [&] ()
-	    {
-		output = buffer_[tail % buffer_.capacity()].value;
-	    },
-	    [&] ()
-	    {
-		buffer_[tail % buffer_.capacity()].guard.store(node_type::status::unused, std::memory_order_release);
-	    });
-	    return consumer::result::success;
-	}
-	else
+	    output = slot->value;
+	},
+	[&] ()
 	{
-	    return consumer::result::beaten;
-	}
+	    slot->sequence.store(tail + capacity_, std::memory_order_release);
+	    not_full_.notify();
+	});
     }
-    else
+    return result;
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<value_t, allocator_t, wait_t>::result mpmc_ring_queue<value_t, allocator_t, wait_t>::try_dequeue_move(value_t& output)
+{
+    uint32_t tail = 0U;
+    node_type* slot = nullptr;
+    const typename consumer::result result = claim_tail(tail, slot);
+    if (result == consumer::result::success)
     {
-	return consumer::result::busy;
+	turbo::algorithm::recovery::try_and_ensure(
+	[&] ()
+	{
+	    output = std::move(slot->value);
+	},
+	[&] ()
+	{
+	    slot->sequence.store(tail + capacity_, std::memory_order_release);
+	    not_full_.notify();
+	});
     }
+    return result;
 }
 
-template <class value_t, template <class type_t> class allocator_t>
-typename mpmc_consumer<value_t, allocator_t>::result mpmc_ring_queue<value_t, allocator_t>::try_dequeue_move(value_t& output)
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+template <class iterator_t>
+typename mpmc_producer<value_t, allocator_t, wait_t>::result mpmc_ring_queue<value_t, allocator_t, wait_t>::try_enqueue_bulk(
+	iterator_t first,
+	iterator_t last,
+	uint32_t& count)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    if (head == tail)
+    count = 0U;
+    const uint32_t wanted = std::min<uint32_t>(capacity_, std::distance(first, last));
+    if (wanted == 0U)
+    {
+	return capacity_ == 0U ? producer::result::queue_full : producer::result::success;
+    }
+    uint32_t head = 0U;
+    uint32_t quantity = 0U;
+    const typename producer::result result = claim_head_run(wanted, head, quantity);
+    if (result != producer::result::success)
     {
-	return consumer::result::queue_empty;
+	return result;
     }
-    typename node_type::status guard = buffer_[tail % buffer_.capacity()].guard.load(std::memory_order_acquire);
-    if (guard == node_type::status::used)
+    turbo::algorithm::recovery::try_and_ensure(
+    [&] ()
     {
-	if (tail_.compare_exchange_strong(tail, tail + 1, std::memory_order_release))
+	for (; count < quantity; ++count, ++first)
 	{
-	    turbo::algorithm::recovery::try_and_ensure(
-	    [&] ()
-	    {
-		output = std::move(buffer_[tail % buffer_.capacity()].value);
-	    },
-	    [&] ()
-	    {
-		buffer_[tail % buffer_.capacity()].guard.store(node_type::status::unused, std::memory_order_release);
-	    });
-	    return consumer::result::success;
+	    node_type& slot = buffer_[(head + count) & mask_];
+	    slot.value = *first;
+	    slot.sequence.store(head + count + 1U, std::memory_order_release);
 	}
-	else
+    },
+    [&] ()
+    {
+	// should an assignment throw, publish the claimed slots that were not written as skipped
+	for (uint32_t index = count; index < quantity; ++index)
 	{
-	    return consumer::result::beaten;
+	    node_type& slot = buffer_[(head + index) & mask_];
+	    slot.skipped = true;
+	    slot.sequence.store(head + index + 1U, std::memory_order_release);
 	}
+	not_empty_.notify();
+    });
+    return result;
+}
+
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
+template <class iterator_t>
+typename mpmc_consumer<value_t, allocator_t, wait_t>::result mpmc_ring_queue<value_t, allocator_t, wait_t>::try_dequeue_bulk(
+	iterator_t output,
+	uint32_t limit,
+	uint32_t& count)
+{
+    count = 0U;
+    const uint32_t wanted = std::min<uint32_t>(capacity_, limit);
+    if (wanted == 0U)
+    {
+	return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire)
+		? consumer::result::queue_empty
+		: consumer::result::success;
     }
-    else
+    // a run made up only of skipped slots yields nothing, so claim the next one
+    while (true)
     {
-	return consumer::result::busy;
+	uint32_t tail = 0U;
+	uint32_t quantity = 0U;
+	const typename consumer::result result = claim_tail_run(wanted, tail, quantity);
+	if (result != consumer::result::success)
+	{
+	    return result;
+	}
+	uint32_t index = 0U;
+	turbo::algorithm::recovery::try_and_ensure(
+	[&] ()
+	{
+	    for (; index < quantity; ++index)
+	    {
+		node_type& slot = buffer_[(tail + index) & mask_];
+		if (slot.skipped)
+		{
+		    slot.skipped = false;
+		}
+		else
+		{
+		    *output = std::move(slot.value);
+		    ++output;
+		    ++count;
+		}
+		slot.sequence.store(tail + index + capacity_, std::memory_order_release);
+	    }
+	},
+	[&] ()
+	{
+	    // should an assignment throw, give back the claimed slots that were not read
+	    for (uint32_t rest = index; rest < quantity; ++rest)
+	    {
+		node_type& slot = buffer_[(tail + rest) & mask_];
+		slot.skipped = false;
+		slot.sequence.store(tail + rest + capacity_, std::memory_order_release);
+	    }
+	    not_full_.notify();
+	});
+	if (count != 0U)
+	{
+	    return result;
+	}
     }
 }
-
-template <template <class type_t> class allocator_t>
-mpmc_ring_queue<std::uint32_t, allocator_t>::mpmc_ring_queue(uint32_t capacity)
+template <template <class type_t> class allocator_t, class wait_t>
+mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::mpmc_ring_queue(uint32_t capacity)
     :
 	mpmc_ring_queue(capacity, 0U)
 { }
 
-template <template <class type_t> class allocator_t>
-mpmc_ring_queue<std::uint32_t, allocator_t>::mpmc_ring_queue(uint32_t capacity, uint16_t handle_limit)
+template <template <class type_t> class allocator_t, class wait_t>
+mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::mpmc_ring_queue(uint32_t capacity, uint16_t handle_limit)
     :
-	buffer_(capacity),
+	// one slot cannot tell a published value from a free slot of the next lap
+	capacity_(std::max(calc_ring_capacity(capacity), capacity == 0U ? 0U : 2U)),
+	mask_(capacity_ == 0U ? 0U : capacity_ - 1U),
+	// an empty ring still gets one slot, whose sequence never lets anyone in
+	buffer_(capacity_ == 0U ? 1U : capacity_),
 	head_(0),
 	tail_(0),
 	producer_list_(handle_limit, key(), *this),
@@ -418,11 +750,18 @@ mpmc_ring_queue<std::uint32_t, allocator_t>::mpmc_ring_queue(uint32_t capacity,
     {
 	throw std::invalid_argument("std::uint32_t is not atomic on this platform");
     }
+    // a slot is free for the producer whose head index matches its sequence
+    for (uint32_t index = 0U; index < buffer_.size(); ++index)
+    {
+	buffer_[index].sequence.store(capacity_ == 0U ? std::numeric_limits<uint32_t>::max() : index, std::memory_order_relaxed);
+    }
 }
 
-template <template <class type_t> class allocator_t>
-mpmc_ring_queue<std::uint32_t, allocator_t>::mpmc_ring_queue(const mpmc_ring_queue& other)
+template <template <class type_t> class allocator_t, class wait_t>
+mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::mpmc_ring_queue(const mpmc_ring_queue& other)
     :
+	capacity_(other.capacity_),
+	mask_(other.mask_),
 	buffer_(other.buffer_),
 	head_(other.head_.load()),
 	tail_(other.tail_.load()),
@@ -430,8 +769,8 @@ mpmc_ring_queue<std::uint32_t, allocator_t>::mpmc_ring_queue(const mpmc_ring_que
 	consumer_list_(other.consumer_list_, this)
 { }
 
-template <template <class type_t> class allocator_t>
-mpmc_ring_queue<std::uint32_t, allocator_t>& mpmc_ring_queue<std::uint32_t, allocator_t>::operator=(const mpmc_ring_queue& other)
+template <template <class type_t> class allocator_t, class wait_t>
+mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>& mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::operator=(const mpmc_ring_queue& other)
 {
     if (this != &other && this->buffer_.size() == other.buffer_.size())
     {
@@ -442,8 +781,8 @@ mpmc_ring_queue<std::uint32_t, allocator_t>& mpmc_ring_queue<std::uint32_t, allo
     return *this;
 }
 
-template <template <class type_t> class allocator_t>
-bool mpmc_ring_queue<std::uint32_t, allocator_t>::operator==(const mpmc_ring_queue& other) const
+template <template <class type_t> class allocator_t, class wait_t>
+bool mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::operator==(const mpmc_ring_queue& other) const
 {
     return this->buffer_ == other.buffer_
 	&& this->head_.load() == other.head_.load()
@@ -452,37 +791,37 @@ bool mpmc_ring_queue<std::uint32_t, allocator_t>::operator==(const mpmc_ring_que
 	&& this->consumer_list_ == other.consumer_list_;
 }
 
-template <template <class type_t> class allocator_t>
+template <template <class type_t> class allocator_t, class wait_t>
 template <class handle_t>
-mpmc_ring_queue<std::uint32_t, allocator_t>::mpmc_ring_queue::handle_list<handle_t>::handle_list(
+mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::mpmc_ring_queue::handle_list<handle_t>::handle_list(
 	uint16_t limit,
 	const key& the_key,
-	mpmc_ring_queue<std::uint32_t, allocator_t>& queue)
+	mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>& queue)
     :
 	counter(0),
 	list(limit, handle_t(the_key, queue))
 { }
 
-template <template <class type_t> class allocator_t>
+template <template <class type_t> class allocator_t, class wait_t>
 template <class handle_t>
-mpmc_ring_queue<std::uint32_t, allocator_t>::mpmc_ring_queue::handle_list<handle_t>::handle_list(
+mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::mpmc_ring_queue::handle_list<handle_t>::handle_list(
 	const handle_list& other,
-	mpmc_ring_queue<std::uint32_t, allocator_t>* queue)
+	mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>* queue)
     :
 	counter(0),
 	list(other.list.size(), queue != nullptr ? static_cast<const handle_t&>(handle_t(key(), *queue)) : *(other.list.cbegin()))
 { }
 
-template <template <class type_t> class allocator_t>
+template <template <class type_t> class allocator_t, class wait_t>
 template <class handle_t>
-bool mpmc_ring_queue<std::uint32_t, allocator_t>::mpmc_ring_queue::handle_list<handle_t>::operator==(
+bool mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::mpmc_ring_queue::handle_list<handle_t>::operator==(
 	const handle_list& other) const
 {
     return this->list.size() == other.list.size();
 }
 
-template <template <class type_t> class allocator_t>
-typename mpmc_ring_queue<std::uint32_t, allocator_t>::producer& mpmc_ring_queue<std::uint32_t, allocator_t>::get_producer()
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::producer& mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::get_producer()
 {
     uint16_t count = 0;
     do
@@ -497,8 +836,8 @@ typename mpmc_ring_queue<std::uint32_t, allocator_t>::producer& mpmc_ring_queue<
     return producer_list_.list[count];
 }
 
-template <template <class type_t> class allocator_t>
-typename mpmc_ring_queue<std::uint32_t, allocator_t>::consumer& mpmc_ring_queue<std::uint32_t, allocator_t>::get_consumer()
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::consumer& mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::get_consumer()
 {
     uint16_t count = 0;
     do
@@ -513,98 +852,265 @@ typename mpmc_ring_queue<std::uint32_t, allocator_t>::consumer& mpmc_ring_queue<
     return consumer_list_.list[count];
 }
 
-template <template <class type_t> class allocator_t>
-typename mpmc_producer<std::uint32_t, allocator_t>::result mpmc_ring_queue<std::uint32_t, allocator_t>::try_enqueue_copy(value_type input)
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<std::uint32_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::claim_head(uint32_t& head, node_type*& slot)
+{
+    head = head_.load(std::memory_order_relaxed);
+    while (true)
+    {
+	slot = &buffer_[head & mask_];
+	// for unsigned integrals nothing extra is needed to handle overflow
+	const std::int32_t lap = static_cast<std::int32_t>(slot->sequence.load(std::memory_order_acquire) - head);
+	if (lap == 0)
+	{
+	    // on failure head is reloaded with the index another producer moved it to
+	    if (head_.compare_exchange_weak(head, head + 1U, std::memory_order_relaxed))
+	    {
+		return producer::result::success;
+	    }
+	}
+	else if (lap < 0)
+	{
+	    // the slot still holds the previous lap's value
+	    return head - tail_.load(std::memory_order_acquire) >= capacity_
+		    ? producer::result::queue_full
+		    : producer::result::busy;
+	}
+	else
+	{
+	    head = head_.load(std::memory_order_relaxed);
+	}
+    }
+}
+
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<std::uint32_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::claim_tail(uint32_t& tail, node_type*& slot)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    // for unsigned integrals nothing extra is needed to handle overflow
-    if (head - tail == buffer_.capacity())
+    tail = tail_.load(std::memory_order_relaxed);
+    while (true)
     {
-	return producer::result::queue_full;
+	slot = &buffer_[tail & mask_];
+	const std::int32_t lap = static_cast<std::int32_t>(slot->sequence.load(std::memory_order_acquire) - (tail + 1U));
+	if (lap == 0)
+	{
+	    if (tail_.compare_exchange_weak(tail, tail + 1U, std::memory_order_relaxed))
+	    {
+		return consumer::result::success;
+	    }
+	}
+	else if (lap < 0)
+	{
+	    // nothing has been published to the slot for this lap yet
+	    return head_.load(std::memory_order_acquire) == tail
+		    ? consumer::result::queue_empty
+		    : consumer::result::busy;
+	}
+	else
+	{
+	    tail = tail_.load(std::memory_order_relaxed);
+	}
     }
-    else if (head_.compare_exchange_strong(head, head + 1, std::memory_order_release))
+}
+
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<std::uint32_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::claim_head_run(uint32_t wanted, uint32_t& head, uint32_t& quantity)
+{
+    head = head_.load(std::memory_order_relaxed);
+    while (true)
     {
-	buffer_[head % buffer_.capacity()].value.store(input, std::memory_order_release);
-	return producer::result::success;
+	// only reserve the run of slots that the consumers of the previous lap have finished with
+	quantity = 0U;
+	while (quantity < wanted && buffer_[(head + quantity) & mask_].sequence.load(std::memory_order_acquire) == head + quantity)
+	{
+	    ++quantity;
+	}
+	if (quantity != 0U)
+	{
+	    if (head_.compare_exchange_weak(head, head + quantity, std::memory_order_relaxed))
+	    {
+		return producer::result::success;
+	    }
+	}
+	else if (static_cast<std::int32_t>(buffer_[head & mask_].sequence.load(std::memory_order_acquire) - head) < 0)
+	{
+	    return head - tail_.load(std::memory_order_acquire) >= capacity_
+		    ? producer::result::queue_full
+		    : producer::result::busy;
+	}
+	else
+	{
+	    head = head_.load(std::memory_order_relaxed);
+	}
     }
-    else
+}
+
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<std::uint32_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::claim_tail_run(uint32_t wanted, uint32_t& tail, uint32_t& quantity)
+{
+    tail = tail_.load(std::memory_order_relaxed);
+    while (true)
     {
-	return producer::result::beaten;
+	// only claim the run of slots that their producers have finished writing
+	quantity = 0U;
+	while (quantity < wanted && buffer_[(tail + quantity) & mask_].sequence.load(std::memory_order_acquire) == tail + quantity + 1U)
+	{
+	    ++quantity;
+	}
+	if (quantity != 0U)
+	{
+	    if (tail_.compare_exchange_weak(tail, tail + quantity, std::memory_order_relaxed))
+	    {
+		return consumer::result::success;
+	    }
+	}
+	else if (static_cast<std::int32_t>(buffer_[tail & mask_].sequence.load(std::memory_order_acquire) - (tail + 1U)) < 0)
+	{
+	    return head_.load(std::memory_order_acquire) == tail
+		    ? consumer::result::queue_empty
+		    : consumer::result::busy;
+	}
+	else
+	{
+	    tail = tail_.load(std::memory_order_relaxed);
+	}
     }
 }
 
-template <template <class type_t> class allocator_t>
-typename mpmc_producer<std::uint32_t, allocator_t>::result mpmc_ring_queue<std::uint32_t, allocator_t>::try_enqueue_move(value_type&& input)
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<std::uint32_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::try_enqueue_copy(value_type input)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    // for unsigned integrals nothing extra is needed to handle overflow
-    if (head - tail == buffer_.capacity())
+    uint32_t head = 0U;
+    node_type* slot = nullptr;
+    const typename producer::result result = claim_head(head, slot);
+    if (result == producer::result::success)
     {
-	return producer::result::queue_full;
+	slot->value.store(input, std::memory_order_relaxed);
+	slot->sequence.store(head + 1U, std::memory_order_release);
+	not_empty_.notify();
     }
-    else if (head_.compare_exchange_strong(head, head + 1, std::memory_order_release))
+    return result;
+}
+
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<std::uint32_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::try_enqueue_move(value_type&& input)
+{
+    uint32_t head = 0U;
+    node_type* slot = nullptr;
+    const typename producer::result result = claim_head(head, slot);
+    if (result == producer::result::success)
+    {
+	slot->value.store(input, std::memory_order_relaxed);
+	slot->sequence.store(head + 1U, std::memory_order_release);
+	not_empty_.notify();
+    }
+    return result;
+}
+
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<std::uint32_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::try_dequeue_copy(value_type& output)
+{
+    uint32_t tail = 0U;
+    node_type* slot = nullptr;
+    const typename consumer::result result = claim_tail(tail, slot);
+    if (result == consumer::result::success)
     {
-	buffer_[head % buffer_.capacity()].value.store(input, std::memory_order_release);
-	return producer::result::success;
+	output = slot->value.load(std::memory_order_relaxed);
+	slot->sequence.store(tail + capacity_, std::memory_order_release);
+	not_full_.notify();
     }
-    else
+    return result;
+}
+
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<std::uint32_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::try_dequeue_move(value_type& output)
+{
+    uint32_t tail = 0U;
+    node_type* slot = nullptr;
+    const typename consumer::result result = claim_tail(tail, slot);
+    if (result == consumer::result::success)
     {
-	return producer::result::beaten;
+	output = slot->value.load(std::memory_order_relaxed);
+	slot->sequence.store(tail + capacity_, std::memory_order_release);
+	not_full_.notify();
     }
+    return result;
 }
 
-template <template <class type_t> class allocator_t>
-typename mpmc_consumer<std::uint32_t, allocator_t>::result mpmc_ring_queue<std::uint32_t, allocator_t>::try_dequeue_copy(value_type& output)
+template <template <class type_t> class allocator_t, class wait_t>
+template <class iterator_t>
+typename mpmc_producer<std::uint32_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::try_enqueue_bulk(
+	iterator_t first,
+	iterator_t last,
+	uint32_t& count)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    if (head == tail)
+    count = 0U;
+    const uint32_t wanted = std::min<uint32_t>(capacity_, std::distance(first, last));
+    if (wanted == 0U)
     {
-	return consumer::result::queue_empty;
+	return capacity_ == 0U ? producer::result::queue_full : producer::result::success;
     }
-    else if (tail_.compare_exchange_strong(tail, tail + 1, std::memory_order_release))
+    uint32_t head = 0U;
+    uint32_t quantity = 0U;
+    const typename producer::result result = claim_head_run(wanted, head, quantity);
+    if (result != producer::result::success)
     {
-	output = buffer_[tail % buffer_.capacity()].value.load(std::memory_order_acquire);
-	return consumer::result::success;
+	return result;
     }
-    else
+    for (; count < quantity; ++count, ++first)
     {
-	return consumer::result::beaten;
+	node_type& slot = buffer_[(head + count) & mask_];
+	slot.value.store(*first, std::memory_order_relaxed);
+	slot.sequence.store(head + count + 1U, std::memory_order_release);
     }
+    not_empty_.notify();
+    return result;
 }
 
-template <template <class type_t> class allocator_t>
-typename mpmc_consumer<std::uint32_t, allocator_t>::result mpmc_ring_queue<std::uint32_t, allocator_t>::try_dequeue_move(value_type& output)
+template <template <class type_t> class allocator_t, class wait_t>
+template <class iterator_t>
+typename mpmc_consumer<std::uint32_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>::try_dequeue_bulk(
+	iterator_t output,
+	uint32_t limit,
+	uint32_t& count)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    if (head == tail)
+    count = 0U;
+    const uint32_t wanted = std::min<uint32_t>(capacity_, limit);
+    if (wanted == 0U)
     {
-	return consumer::result::queue_empty;
+	return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire)
+		? consumer::result::queue_empty
+		: consumer::result::success;
     }
-    else if (tail_.compare_exchange_strong(tail, tail + 1, std::memory_order_release))
+    uint32_t tail = 0U;
+    uint32_t quantity = 0U;
+    const typename consumer::result result = claim_tail_run(wanted, tail, quantity);
+    if (result != consumer::result::success)
     {
-	output = std::move(buffer_[tail % buffer_.capacity()].value.load(std::memory_order_acquire));
-	return consumer::result::success;
+	return result;
     }
-    else
+    for (; count < quantity; ++count, ++output)
     {
-	return consumer::result::beaten;
+	node_type& slot = buffer_[(tail + count) & mask_];
+	*output = slot.value.load(std::memory_order_relaxed);
+	slot.sequence.store(tail + count + capacity_, std::memory_order_release);
     }
+    not_full_.notify();
+    return result;
 }
-
-template <template <class type_t> class allocator_t>
-mpmc_ring_queue<std::uint64_t, allocator_t>::mpmc_ring_queue(uint32_t capacity)
+template <template <class type_t> class allocator_t, class wait_t>
+mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::mpmc_ring_queue(uint32_t capacity)
     :
 	mpmc_ring_queue(capacity, 0U)
 { }
 
-template <template <class type_t> class allocator_t>
-mpmc_ring_queue<std::uint64_t, allocator_t>::mpmc_ring_queue(uint32_t capacity, uint16_t handle_limit)
+template <template <class type_t> class allocator_t, class wait_t>
+mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::mpmc_ring_queue(uint32_t capacity, uint16_t handle_limit)
     :
-	buffer_(capacity),
+	// one slot cannot tell a published value from a free slot of the next lap
+	capacity_(std::max(calc_ring_capacity(capacity), capacity == 0U ? 0U : 2U)),
+	mask_(capacity_ == 0U ? 0U : capacity_ - 1U),
+	// an empty ring still gets one slot, whose sequence never lets anyone in
+	buffer_(capacity_ == 0U ? 1U : capacity_),
 	head_(0),
 	tail_(0),
 	producer_list_(handle_limit, key(), *this),
@@ -615,11 +1121,18 @@ mpmc_ring_queue<std::uint64_t, allocator_t>::mpmc_ring_queue(uint32_t capacity,
     {
 	throw std::invalid_argument("std::uint32_t is not atomic on this platform");
     }
+    // a slot is free for the producer whose head index matches its sequence
+    for (uint32_t index = 0U; index < buffer_.size(); ++index)
+    {
+	buffer_[index].sequence.store(capacity_ == 0U ? std::numeric_limits<uint32_t>::max() : index, std::memory_order_relaxed);
+    }
 }
 
-template <template <class type_t> class allocator_t>
-mpmc_ring_queue<std::uint64_t, allocator_t>::mpmc_ring_queue(const mpmc_ring_queue& other)
+template <template <class type_t> class allocator_t, class wait_t>
+mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::mpmc_ring_queue(const mpmc_ring_queue& other)
     :
+	capacity_(other.capacity_),
+	mask_(other.mask_),
 	buffer_(other.buffer_),
 	head_(other.head_.load()),
 	tail_(other.tail_.load()),
@@ -627,8 +1140,8 @@ mpmc_ring_queue<std::uint64_t, allocator_t>::mpmc_ring_queue(const mpmc_ring_que
 	consumer_list_(other.consumer_list_, this)
 { }
 
-template <template <class type_t> class allocator_t>
-mpmc_ring_queue<std::uint64_t, allocator_t>& mpmc_ring_queue<std::uint64_t, allocator_t>::operator=(const mpmc_ring_queue& other)
+template <template <class type_t> class allocator_t, class wait_t>
+mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>& mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::operator=(const mpmc_ring_queue& other)
 {
     if (this != &other && this->buffer_.size() == other.buffer_.size())
     {
@@ -639,8 +1152,8 @@ mpmc_ring_queue<std::uint64_t, allocator_t>& mpmc_ring_queue<std::uint64_t, allo
     return *this;
 }
 
-template <template <class type_t> class allocator_t>
-bool mpmc_ring_queue<std::uint64_t, allocator_t>::operator==(const mpmc_ring_queue& other) const
+template <template <class type_t> class allocator_t, class wait_t>
+bool mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::operator==(const mpmc_ring_queue& other) const
 {
     return this->buffer_ == other.buffer_
 	&& this->head_.load() == other.head_.load()
@@ -649,37 +1162,37 @@ bool mpmc_ring_queue<std::uint64_t, allocator_t>::operator==(const mpmc_ring_que
 	&& this->consumer_list_ == other.consumer_list_;
 }
 
-template <template <class type_t> class allocator_t>
+template <template <class type_t> class allocator_t, class wait_t>
 template <class handle_t>
-mpmc_ring_queue<std::uint64_t, allocator_t>::mpmc_ring_queue::handle_list<handle_t>::handle_list(
+mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::mpmc_ring_queue::handle_list<handle_t>::handle_list(
 	uint16_t limit,
 	const key& the_key,
-	mpmc_ring_queue<std::uint64_t, allocator_t>& queue)
+	mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>& queue)
     :
 	counter(0),
 	list(limit, handle_t(the_key, queue))
 { }
 
-template <template <class type_t> class allocator_t>
+template <template <class type_t> class allocator_t, class wait_t>
 template <class handle_t>
-mpmc_ring_queue<std::uint64_t, allocator_t>::mpmc_ring_queue::handle_list<handle_t>::handle_list(
+mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::mpmc_ring_queue::handle_list<handle_t>::handle_list(
 	const handle_list& other,
-	mpmc_ring_queue<std::uint64_t, allocator_t>* queue)
+	mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>* queue)
     :
 	counter(0),
 	list(other.list.size(), queue != nullptr ? static_cast<const handle_t&>(handle_t(key(), *queue)) : *(other.list.cbegin()))
 { }
 
-template <template <class type_t> class allocator_t>
+template <template <class type_t> class allocator_t, class wait_t>
 template <class handle_t>
-bool mpmc_ring_queue<std::uint64_t, allocator_t>::mpmc_ring_queue::handle_list<handle_t>::operator==(
+bool mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::mpmc_ring_queue::handle_list<handle_t>::operator==(
 	const handle_list& other) const
 {
     return this->list.size() == other.list.size();
 }
 
-template <template <class type_t> class allocator_t>
-typename mpmc_ring_queue<std::uint64_t, allocator_t>::producer& mpmc_ring_queue<std::uint64_t, allocator_t>::get_producer()
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::producer& mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::get_producer()
 {
     uint16_t count = 0;
     do
@@ -694,8 +1207,8 @@ typename mpmc_ring_queue<std::uint64_t, allocator_t>::producer& mpmc_ring_queue<
     return producer_list_.list[count];
 }
 
-template <template <class type_t> class allocator_t>
-typename mpmc_ring_queue<std::uint64_t, allocator_t>::consumer& mpmc_ring_queue<std::uint64_t, allocator_t>::get_consumer()
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::consumer& mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::get_consumer()
 {
     uint16_t count = 0;
     do
@@ -710,89 +1223,253 @@ typename mpmc_ring_queue<std::uint64_t, allocator_t>::consumer& mpmc_ring_queue<
     return consumer_list_.list[count];
 }
 
-template <template <class type_t> class allocator_t>
-typename mpmc_producer<std::uint64_t, allocator_t>::result mpmc_ring_queue<std::uint64_t, allocator_t>::try_enqueue_copy(value_type input)
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<std::uint64_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::claim_head(uint32_t& head, node_type*& slot)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    // for unsigned integrals nothing extra is needed to handle overflow
-    if (head - tail == buffer_.capacity())
+    head = head_.load(std::memory_order_relaxed);
+    while (true)
     {
-	return producer::result::queue_full;
+	slot = &buffer_[head & mask_];
+	// for unsigned integrals nothing extra is needed to handle overflow
+	const std::int32_t lap = static_cast<std::int32_t>(slot->sequence.load(std::memory_order_acquire) - head);
+	if (lap == 0)
+	{
+	    // on failure head is reloaded with the index another producer moved it to
+	    if (head_.compare_exchange_weak(head, head + 1U, std::memory_order_relaxed))
+	    {
+		return producer::result::success;
+	    }
+	}
+	else if (lap < 0)
+	{
+	    // the slot still holds the previous lap's value
+	    return head - tail_.load(std::memory_order_acquire) >= capacity_
+		    ? producer::result::queue_full
+		    : producer::result::busy;
+	}
+	else
+	{
+	    head = head_.load(std::memory_order_relaxed);
+	}
+    }
+}
+
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<std::uint64_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::claim_tail(uint32_t& tail, node_type*& slot)
+{
+    tail = tail_.load(std::memory_order_relaxed);
+    while (true)
+    {
+	slot = &buffer_[tail & mask_];
+	const std::int32_t lap = static_cast<std::int32_t>(slot->sequence.load(std::memory_order_acquire) - (tail + 1U));
+	if (lap == 0)
+	{
+	    if (tail_.compare_exchange_weak(tail, tail + 1U, std::memory_order_relaxed))
+	    {
+		return consumer::result::success;
+	    }
+	}
+	else if (lap < 0)
+	{
+	    // nothing has been published to the slot for this lap yet
+	    return head_.load(std::memory_order_acquire) == tail
+		    ? consumer::result::queue_empty
+		    : consumer::result::busy;
+	}
+	else
+	{
+	    tail = tail_.load(std::memory_order_relaxed);
+	}
+    }
+}
+
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<std::uint64_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::claim_head_run(uint32_t wanted, uint32_t& head, uint32_t& quantity)
+{
+    head = head_.load(std::memory_order_relaxed);
+    while (true)
+    {
+	// only reserve the run of slots that the consumers of the previous lap have finished with
+	quantity = 0U;
+	while (quantity < wanted && buffer_[(head + quantity) & mask_].sequence.load(std::memory_order_acquire) == head + quantity)
+	{
+	    ++quantity;
+	}
+	if (quantity != 0U)
+	{
+	    if (head_.compare_exchange_weak(head, head + quantity, std::memory_order_relaxed))
+	    {
+		return producer::result::success;
+	    }
+	}
+	else if (static_cast<std::int32_t>(buffer_[head & mask_].sequence.load(std::memory_order_acquire) - head) < 0)
+	{
+	    return head - tail_.load(std::memory_order_acquire) >= capacity_
+		    ? producer::result::queue_full
+		    : producer::result::busy;
+	}
+	else
+	{
+	    head = head_.load(std::memory_order_relaxed);
+	}
     }
-    else if (head_.compare_exchange_strong(head, head + 1, std::memory_order_release))
+}
+
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<std::uint64_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::claim_tail_run(uint32_t wanted, uint32_t& tail, uint32_t& quantity)
+{
+    tail = tail_.load(std::memory_order_relaxed);
+    while (true)
     {
-	buffer_[head % buffer_.capacity()].value.store(input, std::memory_order_release);
-	return producer::result::success;
+	// only claim the run of slots that their producers have finished writing
+	quantity = 0U;
+	while (quantity < wanted && buffer_[(tail + quantity) & mask_].sequence.load(std::memory_order_acquire) == tail + quantity + 1U)
+	{
+	    ++quantity;
+	}
+	if (quantity != 0U)
+	{
+	    if (tail_.compare_exchange_weak(tail, tail + quantity, std::memory_order_relaxed))
+	    {
+		return consumer::result::success;
+	    }
+	}
+	else if (static_cast<std::int32_t>(buffer_[tail & mask_].sequence.load(std::memory_order_acquire) - (tail + 1U)) < 0)
+	{
+	    return head_.load(std::memory_order_acquire) == tail
+		    ? consumer::result::queue_empty
+		    : consumer::result::busy;
+	}
+	else
+	{
+	    tail = tail_.load(std::memory_order_relaxed);
+	}
     }
-    else
+}
+
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<std::uint64_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::try_enqueue_copy(value_type input)
+{
+    uint32_t head = 0U;
+    node_type* slot = nullptr;
+    const typename producer::result result = claim_head(head, slot);
+    if (result == producer::result::success)
     {
-	return producer::result::beaten;
+	slot->value.store(input, std::memory_order_relaxed);
+	slot->sequence.store(head + 1U, std::memory_order_release);
+	not_empty_.notify();
     }
+    return result;
 }
 
-template <template <class type_t> class allocator_t>
-typename mpmc_producer<std::uint64_t, allocator_t>::result mpmc_ring_queue<std::uint64_t, allocator_t>::try_enqueue_move(value_type&& input)
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_producer<std::uint64_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::try_enqueue_move(value_type&& input)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    // for unsigned integrals nothing extra is needed to handle overflow
-    if (head - tail == buffer_.capacity())
+    uint32_t head = 0U;
+    node_type* slot = nullptr;
+    const typename producer::result result = claim_head(head, slot);
+    if (result == producer::result::success)
     {
-	return producer::result::queue_full;
+	slot->value.store(input, std::memory_order_relaxed);
+	slot->sequence.store(head + 1U, std::memory_order_release);
+	not_empty_.notify();
     }
-    else if (head_.compare_exchange_strong(head, head + 1, std::memory_order_release))
+    return result;
+}
+
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<std::uint64_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::try_dequeue_copy(value_type& output)
+{
+    uint32_t tail = 0U;
+    node_type* slot = nullptr;
+    const typename consumer::result result = claim_tail(tail, slot);
+    if (result == consumer::result::success)
     {
-	buffer_[head % buffer_.capacity()].value.store(input, std::memory_order_release);
-	return producer::result::success;
+	output = slot->value.load(std::memory_order_relaxed);
+	slot->sequence.store(tail + capacity_, std::memory_order_release);
+	not_full_.notify();
     }
-    else
+    return result;
+}
+
+template <template <class type_t> class allocator_t, class wait_t>
+typename mpmc_consumer<std::uint64_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::try_dequeue_move(value_type& output)
+{
+    uint32_t tail = 0U;
+    node_type* slot = nullptr;
+    const typename consumer::result result = claim_tail(tail, slot);
+    if (result == consumer::result::success)
     {
-	return producer::result::beaten;
+	output = slot->value.load(std::memory_order_relaxed);
+	slot->sequence.store(tail + capacity_, std::memory_order_release);
+	not_full_.notify();
     }
+    return result;
 }
 
-template <template <class type_t> class allocator_t>
-typename mpmc_consumer<std::uint64_t, allocator_t>::result mpmc_ring_queue<std::uint64_t, allocator_t>::try_dequeue_copy(value_type& output)
+template <template <class type_t> class allocator_t, class wait_t>
+template <class iterator_t>
+typename mpmc_producer<std::uint64_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::try_enqueue_bulk(
+	iterator_t first,
+	iterator_t last,
+	uint32_t& count)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    if (head == tail)
+    count = 0U;
+    const uint32_t wanted = std::min<uint32_t>(capacity_, std::distance(first, last));
+    if (wanted == 0U)
     {
-	return consumer::result::queue_empty;
+	return capacity_ == 0U ? producer::result::queue_full : producer::result::success;
     }
-    else if (tail_.compare_exchange_strong(tail, tail + 1, std::memory_order_release))
+    uint32_t head = 0U;
+    uint32_t quantity = 0U;
+    const typename producer::result result = claim_head_run(wanted, head, quantity);
+    if (result != producer::result::success)
     {
-	output = buffer_[tail % buffer_.capacity()].value.load(std::memory_order_acquire);
-	return consumer::result::success;
+	return result;
     }
-    else
+    for (; count < quantity; ++count, ++first)
     {
-	return consumer::result::beaten;
+	node_type& slot = buffer_[(head + count) & mask_];
+	slot.value.store(*first, std::memory_order_relaxed);
+	slot.sequence.store(head + count + 1U, std::memory_order_release);
     }
+    not_empty_.notify();
+    return result;
 }
 
-template <template <class type_t> class allocator_t>
-typename mpmc_consumer<std::uint64_t, allocator_t>::result mpmc_ring_queue<std::uint64_t, allocator_t>::try_dequeue_move(value_type& output)
+template <template <class type_t> class allocator_t, class wait_t>
+template <class iterator_t>
+typename mpmc_consumer<std::uint64_t, allocator_t, wait_t>::result mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>::try_dequeue_bulk(
+	iterator_t output,
+	uint32_t limit,
+	uint32_t& count)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    if (head == tail)
+    count = 0U;
+    const uint32_t wanted = std::min<uint32_t>(capacity_, limit);
+    if (wanted == 0U)
     {
-	return consumer::result::queue_empty;
+	return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire)
+		? consumer::result::queue_empty
+		: consumer::result::success;
     }
-    else if (tail_.compare_exchange_strong(tail, tail + 1, std::memory_order_release))
+    uint32_t tail = 0U;
+    uint32_t quantity = 0U;
+    const typename consumer::result result = claim_tail_run(wanted, tail, quantity);
+    if (result != consumer::result::success)
     {
-	output = std::move(buffer_[tail % buffer_.capacity()].value.load(std::memory_order_acquire));
-	return consumer::result::success;
+	return result;
     }
-    else
+    for (; count < quantity; ++count, ++output)
     {
-	return consumer::result::beaten;
+	node_type& slot = buffer_[(tail + count) & mask_];
+	*output = slot.value.load(std::memory_order_relaxed);
+	slot.sequence.store(tail + count + capacity_, std::memory_order_release);
     }
+    not_full_.notify();
+    return result;
 }
 
 } // namespace container
 } // namespace turbo
 
-#endif
+#endif
\ No newline at end of file
@@ -3,10 +3,13 @@
 
 #include <cstdint>
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
+#include <turbo/container/ring_capacity.hpp>
+#include <turbo/container/wait_strategy.hpp>
 #include <turbo/toolset/attribute.hpp>
 
 namespace turbo {
@@ -15,11 +18,6 @@ namespace container {
 template <class value_t>
 struct alignas(LEVEL1_DCACHE_LINESIZE) node
 {
-    enum class status : uint8_t
-    {
-	used,
-	unused
-    };
     inline node() noexcept;
     inline explicit node(const value_t& the_value);
     inline node(const node& other);
@@ -28,7 +26,14 @@ struct alignas(LEVEL1_DCACHE_LINESIZE) node
     node& operator=(const node& other);
     node& operator=(node&&) = delete;
     inline bool operator==(const node& other) const;
-    std::atomic<status> guard;
+    ///
+    /// Which lap of the ring may use the slot next, so that neither side can see it half written
+    ///
+    std::atomic<std::uint32_t> sequence;
+    ///
+    /// Set by a producer whose copy into the slot threw, so that consumers pass over it
+    ///
+    bool skipped;
     value_t value;
 };
 
@@ -43,18 +48,26 @@ struct alignas(LEVEL1_DCACHE_LINESIZE) atomic_node
     atomic_node& operator=(const atomic_node& other);
     atomic_node& operator=(atomic_node&&) = delete;
     inline bool operator==(const atomic_node& other) const;
+    ///
+    /// Which lap of the ring may use the slot next, so that neither side can see it half written
+    ///
+    std::atomic<std::uint32_t> sequence;
     std::atomic<value_t> value;
 };
 
-template <class value_t, template <class type_t> class allocator_t = std::allocator> class mpmc_key;
-template <class value_t, template <class type_t> class allocator_t = std::allocator> class mpmc_ring_queue;
+template <class value_t, template <class type_t> class allocator_t = std::allocator, class wait_t = spin_yield_wait<>> class mpmc_key;
+template <class value_t, template <class type_t> class allocator_t = std::allocator, class wait_t = spin_yield_wait<>> class mpmc_ring_queue;
 
-template <class value_t, template <class type_t> class allocator_t = std::allocator>
+template <class value_t, template <class type_t> class allocator_t = std::allocator, class wait_t = spin_yield_wait<>>
 class alignas(LEVEL1_DCACHE_LINESIZE) mpmc_producer
 {
 public:
     typedef value_t value_type;
-    typedef mpmc_key<value_t, allocator_t> key;
+    typedef mpmc_key<value_t, allocator_t, wait_t> key;
+    ///
+    /// A producer that loses a slot to another moves on to the next one instead of
+    /// returning beaten; busy means the consumer of the previous lap is still reading it
+    ///
     enum class result
     {
 	success,
@@ -62,26 +75,45 @@ public:
 	busy,
 	queue_full
     };
-    mpmc_producer(const key&, mpmc_ring_queue<value_t, allocator_t>& queue);
+    mpmc_producer(const key&, mpmc_ring_queue<value_t, allocator_t, wait_t>& queue);
     mpmc_producer(const mpmc_producer& other);
     ~mpmc_producer() = default;
     bool operator==(const mpmc_producer& other) const;
     result try_enqueue_copy(const value_t& input);
     result try_enqueue_move(value_t&& input);
+    template <class iterator_t>
+    result try_enqueue_bulk(iterator_t first, iterator_t last, uint32_t& count);
+    ///
+    /// Enqueues input, waiting for room as the queue's wait_t decides
+    ///
+    void enqueue_copy(const value_t& input);
+    void enqueue_move(value_t&& input);
+    ///
+    /// Enqueues input, waiting at most timeout for room; returns queue_full when the
+    /// timeout runs out
+    ///
+    template <class rep_t, class period_t>
+    result try_enqueue_copy_for(const value_t& input, const std::chrono::duration<rep_t, period_t>& timeout);
+    template <class rep_t, class period_t>
+    result try_enqueue_move_for(value_t&& input, const std::chrono::duration<rep_t, period_t>& timeout);
 private:
     mpmc_producer() = delete;
     mpmc_producer(mpmc_producer&&);
     mpmc_producer& operator=(const mpmc_producer&) = delete;
     mpmc_producer& operator=(mpmc_producer&&) = delete;
-    mpmc_ring_queue<value_t, allocator_t>& queue_;
+    mpmc_ring_queue<value_t, allocator_t, wait_t>& queue_;
 };
 
-template <class value_t, template <class type_t> class allocator_t = std::allocator>
+template <class value_t, template <class type_t> class allocator_t = std::allocator, class wait_t = spin_yield_wait<>>
 class alignas(LEVEL1_DCACHE_LINESIZE) mpmc_consumer
 {
 public:
     typedef value_t value_type;
-    typedef mpmc_key<value_t, allocator_t> key;
+    typedef mpmc_key<value_t, allocator_t, wait_t> key;
+    ///
+    /// A consumer that loses a slot to another moves on to the next one instead of
+    /// returning beaten; busy means the producer of the slot is still writing it
+    ///
     enum class result
     {
 	success,
@@ -89,48 +121,88 @@ public:
 	busy,
 	queue_empty
     };
-    mpmc_consumer(const key&, mpmc_ring_queue<value_t, allocator_t>& queue);
+    mpmc_consumer(const key&, mpmc_ring_queue<value_t, allocator_t, wait_t>& queue);
     mpmc_consumer(const mpmc_consumer& other);
     ~mpmc_consumer() = default;
     bool operator==(const mpmc_consumer& other) const;
     result try_dequeue_copy(value_t& output);
     result try_dequeue_move(value_t& output);
+    template <class iterator_t>
+    result try_dequeue_bulk(iterator_t output, uint32_t limit, uint32_t& count);
+    ///
+    /// Dequeues to output, waiting for a value as the queue's wait_t decides
+    ///
+    void dequeue_copy(value_t& output);
+    void dequeue_move(value_t& output);
+    ///
+    /// Dequeues to output, waiting at most timeout for a value; returns queue_empty when
+    /// the timeout runs out
+    ///
+    template <class rep_t, class period_t>
+    result try_dequeue_copy_for(value_t& output, const std::chrono::duration<rep_t, period_t>& timeout);
+    template <class rep_t, class period_t>
+    result try_dequeue_move_for(value_t& output, const std::chrono::duration<rep_t, period_t>& timeout);
 private:
     mpmc_consumer() = delete;
     mpmc_consumer(mpmc_consumer&&) = delete;
     mpmc_consumer& operator=(const mpmc_consumer&) = delete;
     mpmc_consumer& operator=(mpmc_consumer&&) = delete;
-    mpmc_ring_queue<value_t, allocator_t>& queue_;
+    mpmc_ring_queue<value_t, allocator_t, wait_t>& queue_;
 };
 
-template <class value_t, template <class type_t> class allocator_t>
+///
+/// Bounded queue where every slot carries a sequence number saying which lap of the
+/// ring may use it next. Producers and consumers claim a slot by advancing the head or
+/// tail index with a compare and swap and then publish it by bumping its sequence, so
+/// neither side ever reads a slot mid-write. The capacity is rounded up to a power of
+/// two, see calc_ring_capacity, and a queue that is not empty has at least two slots.
+///
+template <class value_t, template <class type_t> class allocator_t, class wait_t>
 class TURBO_SYMBOL_DECL mpmc_ring_queue
 {
 public:
     typedef value_t value_type;
     typedef node<value_t> node_type;
-    typedef mpmc_producer<value_t, allocator_t> producer;
-    typedef mpmc_consumer<value_t, allocator_t> consumer;
-    typedef mpmc_key<value_t, allocator_t> key;
+    typedef mpmc_producer<value_t, allocator_t, wait_t> producer;
+    typedef mpmc_consumer<value_t, allocator_t, wait_t> consumer;
+    typedef mpmc_key<value_t, allocator_t, wait_t> key;
+    typedef wait_t wait_type;
     mpmc_ring_queue(uint32_t capacity);
     mpmc_ring_queue(uint32_t capacity, uint16_t handle_limit);
     mpmc_ring_queue(const mpmc_ring_queue& other);
     ~mpmc_ring_queue() = default;
     mpmc_ring_queue& operator=(const mpmc_ring_queue& other);
     bool operator==(const mpmc_ring_queue& other) const;
+    inline uint32_t get_capacity() const { return capacity_; }
     producer& get_producer();
     consumer& get_consumer();
     typename producer::result try_enqueue_copy(const value_t& input);
     typename producer::result try_enqueue_move(value_t&& input);
     typename consumer::result try_dequeue_copy(value_t& output);
     typename consumer::result try_dequeue_move(value_t& output);
+    ///
+    /// Reserves a run of free slots with a single update of the head index and copies
+    /// as much of [first, last) as fits; count reports how many values were enqueued.
+    /// Pass move iterators to move the values in instead. Should a copy throw, the
+    /// slots not yet written are published as skipped before the exception propagates.
+    ///
+    template <class iterator_t>
+    typename producer::result try_enqueue_bulk(iterator_t first, iterator_t last, uint32_t& count);
+    ///
+    /// Claims a run of up to limit values with a single update of the tail index and
+    /// moves them to output; count reports how many values were dequeued
+    ///
+    template <class iterator_t>
+    typename consumer::result try_dequeue_bulk(iterator_t output, uint32_t limit, uint32_t& count);
 private:
+    friend class mpmc_producer<value_t, allocator_t, wait_t>;
+    friend class mpmc_consumer<value_t, allocator_t, wait_t>;
     typedef std::vector<value_t, allocator_t<value_t>> vector_type;
     template <class handle_t>
     struct handle_list
     {
-	handle_list(uint16_t limit, const key& the_key, mpmc_ring_queue<value_t, allocator_t>& queue);
-	handle_list(const handle_list& other, mpmc_ring_queue<value_t, allocator_t>* queue = nullptr);
+	handle_list(uint16_t limit, const key& the_key, mpmc_ring_queue<value_t, allocator_t, wait_t>& queue);
+	handle_list(const handle_list& other, mpmc_ring_queue<value_t, allocator_t, wait_t>* queue = nullptr);
 	handle_list(handle_list&& other) = delete;
 	~handle_list() = default;
 	bool operator==(const handle_list& other) const;
@@ -142,41 +214,88 @@ private:
     mpmc_ring_queue() = delete;
     mpmc_ring_queue(mpmc_ring_queue&&) = delete;
     mpmc_ring_queue& operator=(mpmc_ring_queue&&) = delete;
+    ///
+    /// Claims the slot at the head for the caller to write and then publish by storing
+    /// head + 1 to its sequence
+    ///
+    inline typename producer::result claim_head(uint32_t& head, node_type*& slot);
+    ///
+    /// Claims the slot at the tail for the caller to read and then release by storing
+    /// tail + capacity to its sequence
+    ///
+    inline typename consumer::result claim_tail(uint32_t& tail, node_type*& slot);
+    ///
+    /// Claims a run of up to wanted slots at the head, reporting its length in quantity
+    ///
+    inline typename producer::result claim_head_run(uint32_t wanted, uint32_t& head, uint32_t& quantity);
+    ///
+    /// Claims a run of up to wanted slots at the tail, reporting its length in quantity
+    ///
+    inline typename consumer::result claim_tail_run(uint32_t wanted, uint32_t& tail, uint32_t& quantity);
+    const uint32_t capacity_;
+    const uint32_t mask_;
     std::vector<node_type, allocator_t<node_type>> buffer_;
+    ///
+    /// Padding keeps each hot member off the cache lines of its neighbours without
+    /// over-aligning the queue, so that it can be a member of heap allocated objects
+    ///
+    std::uint8_t buffer_padding_[LEVEL1_DCACHE_LINESIZE];
     std::atomic<uint32_t> head_;
+    std::uint8_t head_padding_[LEVEL1_DCACHE_LINESIZE - sizeof(std::atomic<uint32_t>)];
     std::atomic<uint32_t> tail_;
-    handle_list<mpmc_producer<value_t, allocator_t>> producer_list_;
-    handle_list<mpmc_consumer<value_t, allocator_t>> consumer_list_;
+    std::uint8_t tail_padding_[LEVEL1_DCACHE_LINESIZE - sizeof(std::atomic<uint32_t>)];
+    wait_t not_empty_;
+    std::uint8_t not_empty_padding_[LEVEL1_DCACHE_LINESIZE];
+    wait_t not_full_;
+    std::uint8_t not_full_padding_[LEVEL1_DCACHE_LINESIZE];
+    handle_list<mpmc_producer<value_t, allocator_t, wait_t>> producer_list_;
+    handle_list<mpmc_consumer<value_t, allocator_t, wait_t>> consumer_list_;
 };
 
-template <template <class type_t> class allocator_t>
-class TURBO_SYMBOL_DECL mpmc_ring_queue<std::uint32_t, allocator_t>
+template <template <class type_t> class allocator_t, class wait_t>
+class TURBO_SYMBOL_DECL mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>
 {
 public:
     typedef std::uint32_t value_type;
     typedef atomic_node<std::uint32_t> node_type;
-    typedef mpmc_producer<std::uint32_t, allocator_t> producer;
-    typedef mpmc_consumer<std::uint32_t, allocator_t> consumer;
-    typedef mpmc_key<std::uint32_t, allocator_t> key;
+    typedef mpmc_producer<std::uint32_t, allocator_t, wait_t> producer;
+    typedef mpmc_consumer<std::uint32_t, allocator_t, wait_t> consumer;
+    typedef mpmc_key<std::uint32_t, allocator_t, wait_t> key;
+    typedef wait_t wait_type;
     mpmc_ring_queue(uint32_t capacity);
     mpmc_ring_queue(uint32_t capacity, uint16_t handle_limit);
     mpmc_ring_queue(const mpmc_ring_queue& other);
     ~mpmc_ring_queue() = default;
     mpmc_ring_queue& operator=(const mpmc_ring_queue& other);
     bool operator==(const mpmc_ring_queue& other) const;
+    inline uint32_t get_capacity() const { return capacity_; }
     producer& get_producer();
     consumer& get_consumer();
     typename producer::result try_enqueue_copy(value_type input);
     typename producer::result try_enqueue_move(value_type&& input);
     typename consumer::result try_dequeue_copy(value_type& output);
     typename consumer::result try_dequeue_move(value_type& output);
+    ///
+    /// Reserves a run of free slots with a single update of the head index and stores
+    /// as much of [first, last) as fits; count reports how many values were enqueued
+    ///
+    template <class iterator_t>
+    typename producer::result try_enqueue_bulk(iterator_t first, iterator_t last, uint32_t& count);
+    ///
+    /// Claims a run of up to limit values with a single update of the tail index and
+    /// writes them to output; count reports how many values were dequeued
+    ///
+    template <class iterator_t>
+    typename consumer::result try_dequeue_bulk(iterator_t output, uint32_t limit, uint32_t& count);
 private:
+    friend class mpmc_producer<std::uint32_t, allocator_t, wait_t>;
+    friend class mpmc_consumer<std::uint32_t, allocator_t, wait_t>;
     typedef std::vector<std::uint32_t, allocator_t<std::uint32_t>> vector_type;
     template <class handle_t>
     struct handle_list
     {
-	handle_list(uint16_t limit, const key& the_key, mpmc_ring_queue<std::uint32_t, allocator_t>& queue);
-	handle_list(const handle_list& other, mpmc_ring_queue<std::uint32_t, allocator_t>* queue = nullptr);
+	handle_list(uint16_t limit, const key& the_key, mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>& queue);
+	handle_list(const handle_list& other, mpmc_ring_queue<std::uint32_t, allocator_t, wait_t>* queue = nullptr);
 	~handle_list() = default;
 	bool operator==(const handle_list& other) const;
 	handle_list& operator=(const handle_list&) = delete;
@@ -187,41 +306,88 @@ private:
     mpmc_ring_queue() = delete;
     mpmc_ring_queue(mpmc_ring_queue&&) = delete;
     mpmc_ring_queue& operator=(mpmc_ring_queue&&) = delete;
+    ///
+    /// Claims the slot at the head for the caller to write and then publish by storing
+    /// head + 1 to its sequence
+    ///
+    inline typename producer::result claim_head(uint32_t& head, node_type*& slot);
+    ///
+    /// Claims the slot at the tail for the caller to read and then release by storing
+    /// tail + capacity to its sequence
+    ///
+    inline typename consumer::result claim_tail(uint32_t& tail, node_type*& slot);
+    ///
+    /// Claims a run of up to wanted slots at the head, reporting its length in quantity
+    ///
+    inline typename producer::result claim_head_run(uint32_t wanted, uint32_t& head, uint32_t& quantity);
+    ///
+    /// Claims a run of up to wanted slots at the tail, reporting its length in quantity
+    ///
+    inline typename consumer::result claim_tail_run(uint32_t wanted, uint32_t& tail, uint32_t& quantity);
+    const uint32_t capacity_;
+    const uint32_t mask_;
     std::vector<node_type, allocator_t<node_type>> buffer_;
+    ///
+    /// Padding keeps each hot member off the cache lines of its neighbours without
+    /// over-aligning the queue, so that it can be a member of heap allocated objects
+    ///
+    std::uint8_t buffer_padding_[LEVEL1_DCACHE_LINESIZE];
     std::atomic<uint32_t> head_;
+    std::uint8_t head_padding_[LEVEL1_DCACHE_LINESIZE - sizeof(std::atomic<uint32_t>)];
     std::atomic<uint32_t> tail_;
-    handle_list<mpmc_producer<std::uint32_t, allocator_t>> producer_list_;
-    handle_list<mpmc_consumer<std::uint32_t, allocator_t>> consumer_list_;
+    std::uint8_t tail_padding_[LEVEL1_DCACHE_LINESIZE - sizeof(std::atomic<uint32_t>)];
+    wait_t not_empty_;
+    std::uint8_t not_empty_padding_[LEVEL1_DCACHE_LINESIZE];
+    wait_t not_full_;
+    std::uint8_t not_full_padding_[LEVEL1_DCACHE_LINESIZE];
+    handle_list<mpmc_producer<std::uint32_t, allocator_t, wait_t>> producer_list_;
+    handle_list<mpmc_consumer<std::uint32_t, allocator_t, wait_t>> consumer_list_;
 };
 
-template <template <class type_t> class allocator_t>
-class TURBO_SYMBOL_DECL mpmc_ring_queue<std::uint64_t, allocator_t>
+template <template <class type_t> class allocator_t, class wait_t>
+class TURBO_SYMBOL_DECL mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>
 {
 public:
     typedef std::uint64_t value_type;
     typedef atomic_node<std::uint64_t> node_type;
-    typedef mpmc_producer<std::uint64_t, allocator_t> producer;
-    typedef mpmc_consumer<std::uint64_t, allocator_t> consumer;
-    typedef mpmc_key<std::uint64_t, allocator_t> key;
+    typedef mpmc_producer<std::uint64_t, allocator_t, wait_t> producer;
+    typedef mpmc_consumer<std::uint64_t, allocator_t, wait_t> consumer;
+    typedef mpmc_key<std::uint64_t, allocator_t, wait_t> key;
+    typedef wait_t wait_type;
     mpmc_ring_queue(uint32_t capacity);
     mpmc_ring_queue(uint32_t capacity, uint16_t handle_limit);
     mpmc_ring_queue(const mpmc_ring_queue& other);
     ~mpmc_ring_queue() = default;
     mpmc_ring_queue& operator=(const mpmc_ring_queue& other);
     bool operator==(const mpmc_ring_queue& other) const;
+    inline uint32_t get_capacity() const { return capacity_; }
     producer& get_producer();
     consumer& get_consumer();
     typename producer::result try_enqueue_copy(value_type input);
     typename producer::result try_enqueue_move(value_type&& input);
     typename consumer::result try_dequeue_copy(value_type& output);
     typename consumer::result try_dequeue_move(value_type& output);
+    ///
+    /// Reserves a run of free slots with a single update of the head index and stores
+    /// as much of [first, last) as fits; count reports how many values were enqueued
+    ///
+    template <class iterator_t>
+    typename producer::result try_enqueue_bulk(iterator_t first, iterator_t last, uint32_t& count);
+    ///
+    /// Claims a run of up to limit values with a single update of the tail index and
+    /// writes them to output; count reports how many values were dequeued
+    ///
+    template <class iterator_t>
+    typename consumer::result try_dequeue_bulk(iterator_t output, uint32_t limit, uint32_t& count);
 private:
+    friend class mpmc_producer<std::uint64_t, allocator_t, wait_t>;
+    friend class mpmc_consumer<std::uint64_t, allocator_t, wait_t>;
     typedef std::vector<std::uint64_t, allocator_t<std::uint64_t>> vector_type;
     template <class handle_t>
     struct handle_list
     {
-	handle_list(uint16_t limit, const key& the_key, mpmc_ring_queue<std::uint64_t, allocator_t>& queue);
-	handle_list(const handle_list& other, mpmc_ring_queue<std::uint64_t, allocator_t>* queue = nullptr);
+	handle_list(uint16_t limit, const key& the_key, mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>& queue);
+	handle_list(const handle_list& other, mpmc_ring_queue<std::uint64_t, allocator_t, wait_t>* queue = nullptr);
 	~handle_list() = default;
 	bool operator==(const handle_list& other) const;
 	handle_list& operator=(const handle_list&) = delete;
@@ -232,11 +398,42 @@ private:
     mpmc_ring_queue() = delete;
     mpmc_ring_queue(mpmc_ring_queue&&) = delete;
     mpmc_ring_queue& operator=(mpmc_ring_queue&&) = delete;
+    ///
+    /// Claims the slot at the head for the caller to write and then publish by storing
+    /// head + 1 to its sequence
+    ///
+    inline typename producer::result claim_head(uint32_t& head, node_type*& slot);
+    ///
+    /// Claims the slot at the tail for the caller to read and then release by storing
+    /// tail + capacity to its sequence
+    ///
+    inline typename consumer::result claim_tail(uint32_t& tail, node_type*& slot);
+    ///
+    /// Claims a run of up to wanted slots at the head, reporting its length in quantity
+    ///
+    inline typename producer::result claim_head_run(uint32_t wanted, uint32_t& head, uint32_t& quantity);
+    ///
+    /// Claims a run of up to wanted slots at the tail, reporting its length in quantity
+    ///
+    inline typename consumer::result claim_tail_run(uint32_t wanted, uint32_t& tail, uint32_t& quantity);
+    const uint32_t capacity_;
+    const uint32_t mask_;
     std::vector<node_type, allocator_t<node_type>> buffer_;
+    ///
+    /// Padding keeps each hot member off the cache lines of its neighbours without
+    /// over-aligning the queue, so that it can be a member of heap allocated objects
+    ///
+    std::uint8_t buffer_padding_[LEVEL1_DCACHE_LINESIZE];
     std::atomic<uint32_t> head_;
+    std::uint8_t head_padding_[LEVEL1_DCACHE_LINESIZE - sizeof(std::atomic<uint32_t>)];
     std::atomic<uint32_t> tail_;
-    handle_list<mpmc_producer<std::uint64_t, allocator_t>> producer_list_;
-    handle_list<mpmc_consumer<std::uint64_t, allocator_t>> consumer_list_;
+    std::uint8_t tail_padding_[LEVEL1_DCACHE_LINESIZE - sizeof(std::atomic<uint32_t>)];
+    wait_t not_empty_;
+    std::uint8_t not_empty_padding_[LEVEL1_DCACHE_LINESIZE];
+    wait_t not_full_;
+    std::uint8_t not_full_padding_[LEVEL1_DCACHE_LINESIZE];
+    handle_list<mpmc_producer<std::uint64_t, allocator_t, wait_t>> producer_list_;
+    handle_list<mpmc_consumer<std::uint64_t, allocator_t, wait_t>> consumer_list_;
 };
 
 } // namespace container
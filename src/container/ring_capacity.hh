@@ -0,0 +1,27 @@
+#ifndef TURBO_CONTAINER_RING_CAPACITY_HXX
+#define TURBO_CONTAINER_RING_CAPACITY_HXX
+
+#include <turbo/container/ring_capacity.hpp>
+#include <stdexcept>
+
+namespace turbo {
+namespace container {
+
+inline uint32_t calc_ring_capacity(uint32_t capacity)
+{
+    if (capacity > (1U << 31U))
+    {
+	throw std::invalid_argument("ring capacity cannot be more than 2^31");
+    }
+    uint32_t result = 1U;
+    while (result < capacity)
+    {
+	result <<= 1U;
+    }
+    return capacity == 0U ? 0U : result;
+}
+
+} // namespace container
+} // namespace turbo
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef TURBO_CONTAINER_RING_CAPACITY_HPP
+#define TURBO_CONTAINER_RING_CAPACITY_HPP
+
+#include <cstdint>
+
+namespace turbo {
+namespace container {
+
+///
+/// Rounds a requested capacity up to the power of two that a ring queue uses, so that
+/// indices map to slots with a mask; throws std::invalid_argument above 2^31
+///
+inline uint32_t calc_ring_capacity(uint32_t capacity);
+
+} // namespace container
+} // namespace turbo
+
+#endif
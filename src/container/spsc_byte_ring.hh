@@ -0,0 +1,216 @@
+#ifndef TURBO_CONTAINER_SPSC_BYTE_RING_HXX
+#define TURBO_CONTAINER_SPSC_BYTE_RING_HXX
+
+#include <turbo/container/spsc_byte_ring.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <turbo/container/ring_capacity.hh>
+#include <turbo/toolset/extension.hpp>
+
+namespace turbo {
+namespace container {
+
+template <class allocator_t>
+class spsc_byte_key
+{
+    spsc_byte_key() { }
+    friend class spsc_byte_ring<allocator_t>;
+};
+
+template <class allocator_t>
+constexpr std::uint32_t spsc_byte_ring<allocator_t>::record_alignment;
+
+template <class allocator_t>
+constexpr std::uint32_t spsc_byte_ring<allocator_t>::header_length;
+
+template <class allocator_t>
+constexpr std::uint32_t spsc_byte_ring<allocator_t>::skip_marker;
+
+template <class allocator_t>
+spsc_byte_producer<allocator_t>::spsc_byte_producer(const key&, spsc_byte_ring<allocator_t>& ring) :
+	ring_(ring),
+	head_(0U),
+	cached_tail_(0U),
+	reserved_(0U)
+{ }
+
+template <class allocator_t>
+inline std::uint32_t spsc_byte_producer<allocator_t>::get_free_count(std::uint32_t wanted)
+{
+    // for unsigned integrals nothing extra is needed to handle overflow
+    std::uint32_t available = ring_.capacity_ - (head_ - cached_tail_);
+    if (available < wanted)
+    {
+	cached_tail_ = ring_.tail_.load(std::memory_order_acquire);
+	available = ring_.capacity_ - (head_ - cached_tail_);
+    }
+    return available;
+}
+
+template <class allocator_t>
+typename spsc_byte_producer<allocator_t>::result spsc_byte_producer<allocator_t>::try_write(const void* data, std::uint32_t length)
+{
+    std::uint8_t* storage = reserve(length);
+    if (storage == nullptr)
+    {
+	return result::queue_full;
+    }
+    std::memcpy(storage, data, length);
+    commit(length);
+    return result::success;
+}
+
+template <class allocator_t>
+std::uint8_t* spsc_byte_producer<allocator_t>::reserve(std::uint32_t length)
+{
+    if (TURBO_UNLIKELY(length > ring_.get_max_message_length()))
+    {
+	throw std::invalid_argument("message is longer than the ring allows");
+    }
+    const std::uint32_t record = spsc_byte_ring<allocator_t>::calc_record_length(length);
+    const std::uint32_t contiguous = ring_.capacity_ - (head_ & ring_.mask_);
+    // a record that does not fit before the end of the ring starts again at the front
+    const std::uint32_t skip = record > contiguous ? contiguous : 0U;
+    if (get_free_count(skip + record) < skip + record)
+    {
+	return nullptr;
+    }
+    if (skip != 0U)
+    {
+	// published along with the record by the next commit
+	*reinterpret_cast<std::uint32_t*>(ring_.get_position(head_)) = spsc_byte_ring<allocator_t>::skip_marker;
+	head_ += skip;
+    }
+    reserved_ = length;
+    return ring_.get_position(head_) + spsc_byte_ring<allocator_t>::header_length;
+}
+
+template <class allocator_t>
+void spsc_byte_producer<allocator_t>::commit(std::uint32_t length)
+{
+    if (TURBO_UNLIKELY(length > reserved_))
+    {
+	throw std::invalid_argument("committed message is longer than the reserved storage");
+    }
+    *reinterpret_cast<std::uint32_t*>(ring_.get_position(head_)) = length;
+    head_ += spsc_byte_ring<allocator_t>::calc_record_length(length);
+    reserved_ = 0U;
+    ring_.head_.store(head_, std::memory_order_release);
+}
+
+template <class allocator_t>
+spsc_byte_consumer<allocator_t>::spsc_byte_consumer(const key&, spsc_byte_ring<allocator_t>& ring) :
+	ring_(ring),
+	tail_(0U),
+	cached_head_(0U)
+{ }
+
+template <class allocator_t>
+inline std::uint32_t spsc_byte_consumer<allocator_t>::get_used_count()
+{
+    std::uint32_t available = cached_head_ - tail_;
+    if (available == 0U)
+    {
+	cached_head_ = ring_.head_.load(std::memory_order_acquire);
+	available = cached_head_ - tail_;
+    }
+    return available;
+}
+
+template <class allocator_t>
+typename spsc_byte_consumer<allocator_t>::result spsc_byte_consumer<allocator_t>::try_read(
+	void* data,
+	std::uint32_t capacity,
+	std::uint32_t& length)
+{
+    const std::uint8_t* message = peek(length);
+    if (message == nullptr)
+    {
+	return result::queue_empty;
+    }
+    if (length > capacity)
+    {
+	return result::buffer_too_small;
+    }
+    std::memcpy(data, message, length);
+    release();
+    return result::success;
+}
+
+template <class allocator_t>
+const std::uint8_t* spsc_byte_consumer<allocator_t>::peek(std::uint32_t& length)
+{
+    while (get_used_count() != 0U)
+    {
+	const std::uint8_t* position = ring_.get_position(tail_);
+	const std::uint32_t header = *reinterpret_cast<const std::uint32_t*>(position);
+	if (header != spsc_byte_ring<allocator_t>::skip_marker)
+	{
+	    length = header;
+	    return position + spsc_byte_ring<allocator_t>::header_length;
+	}
+	// handed back to the producer by the next release
+	tail_ += ring_.capacity_ - (tail_ & ring_.mask_);
+    }
+    length = 0U;
+    return nullptr;
+}
+
+template <class allocator_t>
+void spsc_byte_consumer<allocator_t>::release()
+{
+    const std::uint32_t length = *reinterpret_cast<const std::uint32_t*>(ring_.get_position(tail_));
+    tail_ += spsc_byte_ring<allocator_t>::calc_record_length(length);
+    ring_.tail_.store(tail_, std::memory_order_release);
+}
+
+template <class allocator_t>
+spsc_byte_ring<allocator_t>::single_lock::single_lock()
+    :
+	mutex(),
+	lock(mutex, std::defer_lock)
+{ }
+
+template <class allocator_t>
+spsc_byte_ring<allocator_t>::spsc_byte_ring(std::uint32_t capacity) :
+	allocator_(),
+	capacity_(calc_ring_capacity(capacity)),
+	mask_(capacity_ - 1U),
+	buffer_(capacity_ < 4U * record_alignment ? nullptr : allocator_traits::allocate(allocator_, capacity_)),
+	head_(0U),
+	tail_(0U),
+	producer_(typename producer::key(), *this),
+	producer_lock_(),
+	consumer_(typename consumer::key(), *this),
+	consumer_lock_()
+{
+    if (buffer_ == nullptr)
+    {
+	throw std::invalid_argument("byte ring capacity must be at least 32 bytes");
+    }
+}
+
+template <class allocator_t>
+spsc_byte_ring<allocator_t>::~spsc_byte_ring()
+{
+    allocator_traits::deallocate(allocator_, buffer_, capacity_);
+}
+
+template <class allocator_t>
+typename spsc_byte_ring<allocator_t>::producer& spsc_byte_ring<allocator_t>::get_producer()
+{
+    producer_lock_.lock.try_lock();
+    return producer_;
+}
+
+template <class allocator_t>
+typename spsc_byte_ring<allocator_t>::consumer& spsc_byte_ring<allocator_t>::get_consumer()
+{
+    consumer_lock_.lock.try_lock();
+    return consumer_;
+}
+
+} // namespace container
+} // namespace turbo
+
+#endif
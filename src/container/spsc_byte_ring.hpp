@@ -0,0 +1,177 @@
+#ifndef TURBO_CONTAINER_SPSC_BYTE_RING_HPP
+#define TURBO_CONTAINER_SPSC_BYTE_RING_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <turbo/container/ring_capacity.hpp>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace container {
+
+template <class allocator_t = std::allocator<std::uint8_t>> class spsc_byte_key;
+
+template <class allocator_t = std::allocator<std::uint8_t>> class spsc_byte_ring;
+
+///
+/// Writes variable length messages into the ring. Each message is stored contiguously
+/// after a small length header; when it would not fit before the end of the ring the
+/// rest of the ring is marked as skipped and the message starts again at the front.
+///
+template <class allocator_t = std::allocator<std::uint8_t>>
+class TURBO_SYMBOL_DECL spsc_byte_producer
+{
+public:
+    typedef allocator_t allocator_type;
+    typedef spsc_byte_key<allocator_t> key;
+    enum class result
+    {
+	success,
+	queue_full
+    };
+    spsc_byte_producer(const key&, spsc_byte_ring<allocator_t>& ring);
+    ///
+    /// Copies length bytes from data into the ring as one message
+    ///
+    result try_write(const void* data, std::uint32_t length);
+    ///
+    /// Returns contiguous storage for a message of up to length bytes, or nullptr when
+    /// there is not enough room. Write the message into it and then call commit to
+    /// publish it. Throws std::invalid_argument when length is more than
+    /// spsc_byte_ring::get_max_message_length.
+    ///
+    std::uint8_t* reserve(std::uint32_t length);
+    ///
+    /// Publishes the first length bytes of the storage returned by the last reserve;
+    /// length must not be more than was reserved
+    ///
+    void commit(std::uint32_t length);
+private:
+    spsc_byte_producer() = delete;
+    spsc_byte_producer(const spsc_byte_producer&) = delete;
+    spsc_byte_producer(spsc_byte_producer&&) = delete;
+    spsc_byte_producer& operator=(const spsc_byte_producer&) = delete;
+    spsc_byte_producer& operator=(spsc_byte_producer&&) = delete;
+    inline std::uint32_t get_free_count(std::uint32_t wanted);
+    spsc_byte_ring<allocator_t>& ring_;
+    std::uint32_t head_;
+    std::uint32_t cached_tail_;
+    std::uint32_t reserved_;
+};
+
+///
+/// Reads the messages in the ring where they lie, without copying them out
+///
+template <class allocator_t = std::allocator<std::uint8_t>>
+class TURBO_SYMBOL_DECL spsc_byte_consumer
+{
+public:
+    typedef allocator_t allocator_type;
+    typedef spsc_byte_key<allocator_t> key;
+    enum class result
+    {
+	success,
+	queue_empty,
+	buffer_too_small
+    };
+    spsc_byte_consumer(const key&, spsc_byte_ring<allocator_t>& ring);
+    ///
+    /// Copies the oldest message to data and removes it from the ring; when it is longer
+    /// than capacity nothing is copied or removed. length reports the message length.
+    ///
+    result try_read(void* data, std::uint32_t capacity, std::uint32_t& length);
+    ///
+    /// Returns the oldest message without removing it, or nullptr when the ring is
+    /// empty; length reports the message length. The message stays valid until
+    /// release is called.
+    ///
+    const std::uint8_t* peek(std::uint32_t& length);
+    ///
+    /// Removes the message returned by peek and hands its bytes back to the producer
+    ///
+    void release();
+private:
+    spsc_byte_consumer() = delete;
+    spsc_byte_consumer(const spsc_byte_consumer&) = delete;
+    spsc_byte_consumer(spsc_byte_consumer&&) = delete;
+    spsc_byte_consumer& operator=(const spsc_byte_consumer&) = delete;
+    spsc_byte_consumer& operator=(spsc_byte_consumer&&) = delete;
+    inline std::uint32_t get_used_count();
+    spsc_byte_ring<allocator_t>& ring_;
+    std::uint32_t tail_;
+    std::uint32_t cached_head_;
+};
+
+///
+/// Bounded ring of variable length messages for exactly one producer thread and one
+/// consumer thread, so memory use follows the bytes in flight rather than the largest
+/// message. Messages are padded to a multiple of record_alignment and the capacity in
+/// bytes is rounded up to a power of two, see calc_ring_capacity; it must come to at
+/// least 32 bytes or the constructor throws std::invalid_argument.
+///
+template <class allocator_t>
+class TURBO_SYMBOL_DECL spsc_byte_ring
+{
+public:
+    typedef allocator_t allocator_type;
+    typedef spsc_byte_producer<allocator_t> producer;
+    typedef spsc_byte_consumer<allocator_t> consumer;
+    static constexpr std::uint32_t record_alignment = 8U;
+    spsc_byte_ring(std::uint32_t capacity);
+    ~spsc_byte_ring();
+    inline std::uint32_t get_capacity() const
+    {
+	return capacity_;
+    }
+    ///
+    /// The longest message that is guaranteed to fit, which is a little under half of
+    /// the capacity so that a message never has to wait for a skip larger than itself
+    ///
+    inline std::uint32_t get_max_message_length() const
+    {
+	return capacity_ / 2U - header_length;
+    }
+    producer& get_producer();
+    consumer& get_consumer();
+private:
+    typedef std::allocator_traits<allocator_t> allocator_traits;
+    friend class spsc_byte_producer<allocator_t>;
+    friend class spsc_byte_consumer<allocator_t>;
+    static constexpr std::uint32_t header_length = record_alignment;
+    static constexpr std::uint32_t skip_marker = UINT32_MAX;
+    struct single_lock
+    {
+	single_lock();
+	std::mutex mutex;
+	std::unique_lock<std::mutex> lock;
+    };
+    spsc_byte_ring(const spsc_byte_ring&) = delete;
+    spsc_byte_ring(spsc_byte_ring&&) = delete;
+    spsc_byte_ring& operator=(const spsc_byte_ring&) = delete;
+    spsc_byte_ring& operator=(spsc_byte_ring&&) = delete;
+    static inline std::uint32_t calc_record_length(std::uint32_t message_length)
+    {
+	return (header_length + message_length + record_alignment - 1U) & ~(record_alignment - 1U);
+    }
+    inline std::uint8_t* get_position(std::uint32_t index) const
+    {
+	return buffer_ + (index & mask_);
+    }
+    allocator_t allocator_;
+    const std::uint32_t capacity_;
+    const std::uint32_t mask_;
+    std::uint8_t* const buffer_;
+    alignas(LEVEL1_DCACHE_LINESIZE) std::atomic<std::uint32_t> head_;
+    alignas(LEVEL1_DCACHE_LINESIZE) std::atomic<std::uint32_t> tail_;
+    alignas(LEVEL1_DCACHE_LINESIZE) producer producer_;
+    alignas(LEVEL1_DCACHE_LINESIZE) single_lock producer_lock_;
+    alignas(LEVEL1_DCACHE_LINESIZE) consumer consumer_;
+    alignas(LEVEL1_DCACHE_LINESIZE) single_lock consumer_lock_;
+};
+
+} // namespace container
+} // namespace turbo
+
+#endif
@@ -2,138 +2,325 @@
 #define TURBO_CONTAINER_SPSC_RING_QUEUE_HXX
 
 #include <turbo/container/spsc_ring_queue.hpp>
+#include <algorithm>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
+#include <turbo/algorithm/recovery.hh>
+#include <turbo/container/ring_capacity.hh>
+#include <turbo/container/wait_strategy.hh>
 
 namespace turbo {
 namespace container {
 
-template <class value_t, class allocator_t>
+template <class value_t, class allocator_t, class wait_t>
 class spsc_key
 {
     spsc_key() { }
-    friend class spsc_ring_queue<value_t, allocator_t>;
+    friend class spsc_ring_queue<value_t, allocator_t, wait_t>;
 };
 
-template <class value_t, class allocator_t>
-spsc_producer<value_t, allocator_t>::spsc_producer(
-		const key&,
-		std::vector<value_t, allocator_t>& buffer,
-		std::atomic<uint32_t>& head,
-		std::atomic<uint32_t>& tail) :
-	buffer_(buffer),
-	head_(head),
-	tail_(tail)
+template <class value_t, class allocator_t, class wait_t>
+spsc_producer<value_t, allocator_t, wait_t>::spsc_producer(const key&, spsc_ring_queue<value_t, allocator_t, wait_t>& queue) :
+	queue_(queue),
+	head_(0U),
+	cached_tail_(0U)
 { }
 
-template <class value_t, class allocator_t>
-typename spsc_producer<value_t, allocator_t>::result spsc_producer<value_t, allocator_t>::try_enqueue_copy(const value_t& input)
+template <class value_t, class allocator_t, class wait_t>
+inline uint32_t spsc_producer<value_t, allocator_t, wait_t>::get_free_count(uint32_t wanted)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
     // for unsigned integrals nothing extra is needed to handle overflow
-    if (head - tail == buffer_.capacity())
+    uint32_t available = queue_.capacity_ - (head_ - cached_tail_);
+    if (available < wanted)
     {
-	return result::queue_full;
+	cached_tail_ = queue_.tail_.load(std::memory_order_acquire);
+	available = queue_.capacity_ - (head_ - cached_tail_);
     }
-    buffer_[head % buffer_.capacity()] = input;
-    if (head_.compare_exchange_strong(head, head + 1, std::memory_order_release))
+    return available;
+}
+
+template <class value_t, class allocator_t, class wait_t>
+typename spsc_producer<value_t, allocator_t, wait_t>::result spsc_producer<value_t, allocator_t, wait_t>::try_enqueue_copy(const value_t& input)
+{
+    if (get_free_count(1U) == 0U)
     {
-	return result::success;
+	return result::queue_full;
     }
-    else
+    spsc_ring_queue<value_t, allocator_t, wait_t>::allocator_traits::construct(queue_.allocator_, queue_.get_slot(head_), input);
+    queue_.head_.store(++head_, std::memory_order_release);
+    queue_.not_empty_.notify();
+    return result::success;
+}
+
+template <class value_t, class allocator_t, class wait_t>
+typename spsc_producer<value_t, allocator_t, wait_t>::result spsc_producer<value_t, allocator_t, wait_t>::try_enqueue_move(value_t&& input)
+{
+    if (get_free_count(1U) == 0U)
     {
-	return result::failure;
+	return result::queue_full;
     }
+    spsc_ring_queue<value_t, allocator_t, wait_t>::allocator_traits::construct(queue_.allocator_, queue_.get_slot(head_), std::move(input));
+    queue_.head_.store(++head_, std::memory_order_release);
+    queue_.not_empty_.notify();
+    return result::success;
 }
 
-template <class value_t, class allocator_t>
-typename spsc_producer<value_t, allocator_t>::result spsc_producer<value_t, allocator_t>::try_enqueue_move(value_t&& input)
+template <class value_t, class allocator_t, class wait_t>
+template <class iterator_t>
+typename spsc_producer<value_t, allocator_t, wait_t>::result spsc_producer<value_t, allocator_t, wait_t>::try_enqueue_bulk(
+	iterator_t first,
+	iterator_t last,
+	uint32_t& count)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    // for unsigned integrals nothing extra is needed to handle overflow
-    if (head - tail == buffer_.capacity())
+    count = 0U;
+    const uint32_t wanted = std::distance(first, last);
+    const uint32_t available = get_free_count(wanted);
+    if (available == 0U)
     {
 	return result::queue_full;
     }
-    buffer_[head % buffer_.capacity()] = std::move(input);
-    if (head_.compare_exchange_strong(head, head + 1, std::memory_order_release))
+    const uint32_t quantity = std::min(available, wanted);
+    turbo::algorithm::recovery::try_and_ensure(
+    [&] ()
     {
-	return result::success;
-    }
-    else
+	for (; count < quantity; ++count, ++first)
+	{
+	    spsc_ring_queue<value_t, allocator_t, wait_t>::allocator_traits::construct(queue_.allocator_, queue_.get_slot(head_ + count), *first);
+	}
+    },
+    [&] ()
     {
-	return result::failure;
-    }
+	// should a construction throw, still publish the values written before it
+	head_ += count;
+	queue_.head_.store(head_, std::memory_order_release);
+	queue_.not_empty_.notify();
+    });
+    return result::success;
+}
+
+template <class value_t, class allocator_t, class wait_t>
+void* spsc_producer<value_t, allocator_t, wait_t>::reserve()
+{
+    return get_free_count(1U) == 0U ? nullptr : queue_.get_slot(head_);
 }
 
-template <class value_t, class allocator_t>
-spsc_consumer<value_t, allocator_t>::spsc_consumer(
-		const key&,
-		std::vector<value_t, allocator_t>& buffer,
-		std::atomic<uint32_t>& head,
-		std::atomic<uint32_t>& tail) :
-	buffer_(buffer),
-	head_(head),
-	tail_(tail)
+template <class value_t, class allocator_t, class wait_t>
+void spsc_producer<value_t, allocator_t, wait_t>::commit()
+{
+    queue_.head_.store(++head_, std::memory_order_release);
+    queue_.not_empty_.notify();
+}
+
+template <class value_t, class allocator_t, class wait_t>
+void spsc_producer<value_t, allocator_t, wait_t>::enqueue_copy(const value_t& input)
+{
+    queue_.not_full_.wait([&] () -> bool
+    {
+	return try_enqueue_copy(input) == result::success;
+    });
+}
+
+template <class value_t, class allocator_t, class wait_t>
+void spsc_producer<value_t, allocator_t, wait_t>::enqueue_move(value_t&& input)
+{
+    queue_.not_full_.wait([&] () -> bool
+    {
+	return try_enqueue_move(std::move(input)) == result::success;
+    });
+}
+
+template <class value_t, class allocator_t, class wait_t>
+template <class rep_t, class period_t>
+typename spsc_producer<value_t, allocator_t, wait_t>::result spsc_producer<value_t, allocator_t, wait_t>::try_enqueue_copy_for(
+	const value_t& input,
+	const std::chrono::duration<rep_t, period_t>& timeout)
+{
+    const bool enqueued = queue_.not_full_.wait_until([&] () -> bool
+    {
+	return try_enqueue_copy(input) == result::success;
+    },
+    wait_t::clock_type::now() + std::chrono::duration_cast<typename wait_t::clock_type::duration>(timeout));
+    return enqueued ? result::success : result::queue_full;
+}
+
+template <class value_t, class allocator_t, class wait_t>
+template <class rep_t, class period_t>
+typename spsc_producer<value_t, allocator_t, wait_t>::result spsc_producer<value_t, allocator_t, wait_t>::try_enqueue_move_for(
+	value_t&& input,
+	const std::chrono::duration<rep_t, period_t>& timeout)
+{
+    const bool enqueued = queue_.not_full_.wait_until([&] () -> bool
+    {
+	return try_enqueue_move(std::move(input)) == result::success;
+    },
+    wait_t::clock_type::now() + std::chrono::duration_cast<typename wait_t::clock_type::duration>(timeout));
+    return enqueued ? result::success : result::queue_full;
+}
+
+template <class value_t, class allocator_t, class wait_t>
+spsc_consumer<value_t, allocator_t, wait_t>::spsc_consumer(const key&, spsc_ring_queue<value_t, allocator_t, wait_t>& queue) :
+	queue_(queue),
+	tail_(0U),
+	cached_head_(0U)
 { }
 
-template <class value_t, class allocator_t>
-typename spsc_consumer<value_t, allocator_t>::result spsc_consumer<value_t, allocator_t>::try_dequeue_copy(value_t& output)
+template <class value_t, class allocator_t, class wait_t>
+inline uint32_t spsc_consumer<value_t, allocator_t, wait_t>::get_used_count(uint32_t wanted)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    if (head == tail)
+    uint32_t available = cached_head_ - tail_;
+    if (available < wanted)
     {
-	return result::queue_empty;
+	cached_head_ = queue_.head_.load(std::memory_order_acquire);
+	available = cached_head_ - tail_;
     }
-    output = buffer_[tail % buffer_.capacity()];
-    if (tail_.compare_exchange_strong(tail, tail + 1, std::memory_order_release))
+    return available;
+}
+
+template <class value_t, class allocator_t, class wait_t>
+typename spsc_consumer<value_t, allocator_t, wait_t>::result spsc_consumer<value_t, allocator_t, wait_t>::try_dequeue_copy(value_t& output)
+{
+    if (get_used_count(1U) == 0U)
     {
-	return result::success;
+	return result::queue_empty;
     }
-    else
+    value_t* slot = queue_.get_slot(tail_);
+    output = *slot;
+    spsc_ring_queue<value_t, allocator_t, wait_t>::allocator_traits::destroy(queue_.allocator_, slot);
+    queue_.tail_.store(++tail_, std::memory_order_release);
+    queue_.not_full_.notify();
+    return result::success;
+}
+
+template <class value_t, class allocator_t, class wait_t>
+typename spsc_consumer<value_t, allocator_t, wait_t>::result spsc_consumer<value_t, allocator_t, wait_t>::try_dequeue_move(value_t& output)
+{
+    if (get_used_count(1U) == 0U)
     {
-	return result::failure;
+	return result::queue_empty;
     }
+    value_t* slot = queue_.get_slot(tail_);
+    output = std::move(*slot);
+    spsc_ring_queue<value_t, allocator_t, wait_t>::allocator_traits::destroy(queue_.allocator_, slot);
+    queue_.tail_.store(++tail_, std::memory_order_release);
+    queue_.not_full_.notify();
+    return result::success;
 }
 
-template <class value_t, class allocator_t>
-typename spsc_consumer<value_t, allocator_t>::result spsc_consumer<value_t, allocator_t>::try_dequeue_move(value_t& output)
+template <class value_t, class allocator_t, class wait_t>
+template <class iterator_t>
+typename spsc_consumer<value_t, allocator_t, wait_t>::result spsc_consumer<value_t, allocator_t, wait_t>::try_dequeue_bulk(
+	iterator_t output,
+	uint32_t limit,
+	uint32_t& count)
 {
-    uint32_t head = head_.load(std::memory_order_acquire);
-    uint32_t tail = tail_.load(std::memory_order_acquire);
-    if (head == tail)
+    count = 0U;
+    const uint32_t available = get_used_count(limit);
+    if (available == 0U)
     {
 	return result::queue_empty;
     }
-    output = std::move(buffer_[tail % buffer_.capacity()]);
-    if (tail_.compare_exchange_strong(tail, tail + 1, std::memory_order_release))
+    const uint32_t quantity = std::min(available, limit);
+    turbo::algorithm::recovery::try_and_ensure(
+    [&] ()
     {
-	return result::success;
-    }
-    else
+	for (; count < quantity; ++count, ++output)
+	{
+	    value_t* slot = queue_.get_slot(tail_ + count);
+	    *output = std::move(*slot);
+	    spsc_ring_queue<value_t, allocator_t, wait_t>::allocator_traits::destroy(queue_.allocator_, slot);
+	}
+    },
+    [&] ()
     {
-	return result::failure;
-    }
+	// should an assignment throw, still release the values read before it
+	tail_ += count;
+	queue_.tail_.store(tail_, std::memory_order_release);
+	queue_.not_full_.notify();
+    });
+    return result::success;
 }
 
-template <class value_t, class allocator_t>
-spsc_ring_queue<value_t, allocator_t>::single_lock::single_lock()
+template <class value_t, class allocator_t, class wait_t>
+value_t* spsc_consumer<value_t, allocator_t, wait_t>::peek()
+{
+    return get_used_count(1U) == 0U ? nullptr : queue_.get_slot(tail_);
+}
+
+template <class value_t, class allocator_t, class wait_t>
+void spsc_consumer<value_t, allocator_t, wait_t>::release()
+{
+    spsc_ring_queue<value_t, allocator_t, wait_t>::allocator_traits::destroy(queue_.allocator_, queue_.get_slot(tail_));
+    queue_.tail_.store(++tail_, std::memory_order_release);
+    queue_.not_full_.notify();
+}
+
+template <class value_t, class allocator_t, class wait_t>
+void spsc_consumer<value_t, allocator_t, wait_t>::dequeue_copy(value_t& output)
+{
+    queue_.not_empty_.wait([&] () -> bool
+    {
+	return try_dequeue_copy(output) == result::success;
+    });
+}
+
+template <class value_t, class allocator_t, class wait_t>
+void spsc_consumer<value_t, allocator_t, wait_t>::dequeue_move(value_t& output)
+{
+    queue_.not_empty_.wait([&] () -> bool
+    {
+	return try_dequeue_move(output) == result::success;
+    });
+}
+
+template <class value_t, class allocator_t, class wait_t>
+template <class rep_t, class period_t>
+typename spsc_consumer<value_t, allocator_t, wait_t>::result spsc_consumer<value_t, allocator_t, wait_t>::try_dequeue_copy_for(
+	value_t& output,
+	const std::chrono::duration<rep_t, period_t>& timeout)
+{
+    const bool dequeued = queue_.not_empty_.wait_until([&] () -> bool
+    {
+	return try_dequeue_copy(output) == result::success;
+    },
+    wait_t::clock_type::now() + std::chrono::duration_cast<typename wait_t::clock_type::duration>(timeout));
+    return dequeued ? result::success : result::queue_empty;
+}
+
+template <class value_t, class allocator_t, class wait_t>
+template <class rep_t, class period_t>
+typename spsc_consumer<value_t, allocator_t, wait_t>::result spsc_consumer<value_t, allocator_t, wait_t>::try_dequeue_move_for(
+	value_t& output,
+	const std::chrono::duration<rep_t, period_t>& timeout)
+{
+    const bool dequeued = queue_.not_empty_.wait_until([&] () -> bool
+    {
+	return try_dequeue_move(output) == result::success;
+    },
+    wait_t::clock_type::now() + std::chrono::duration_cast<typename wait_t::clock_type::duration>(timeout));
+    return dequeued ? result::success : result::queue_empty;
+}
+
+template <class value_t, class allocator_t, class wait_t>
+spsc_ring_queue<value_t, allocator_t, wait_t>::single_lock::single_lock()
     :
 	mutex(),
 	lock(mutex, std::defer_lock)
 { }
 
-template <class value_t, class allocator_t>
-spsc_ring_queue<value_t, allocator_t>::spsc_ring_queue(uint32_t capacity) :
-	buffer_(capacity),
-	head_(0),
-	tail_(0),
-	producer_(typename producer::key(), buffer_, head_, tail_),
+template <class value_t, class allocator_t, class wait_t>
+spsc_ring_queue<value_t, allocator_t, wait_t>::spsc_ring_queue(uint32_t capacity) :
+	allocator_(),
+	capacity_(calc_ring_capacity(capacity)),
+	mask_(capacity_ - 1U),
+	buffer_(capacity_ == 0U ? nullptr : allocator_traits::allocate(allocator_, capacity_)),
+	head_(0U),
+	tail_(0U),
+	not_empty_(),
+	not_full_(),
+	producer_(typename producer::key(), *this),
 	producer_lock_(),
-	consumer_(typename consumer::key(), buffer_, head_, tail_),
+	consumer_(typename consumer::key(), *this),
 	consumer_lock_()
 {
     // TODO: when a constexpr version of is_lock_free is available do this check as a static_assert
@@ -143,15 +330,29 @@ spsc_ring_queue<value_t, allocator_t>::spsc_ring_queue(uint32_t capacity) :
     }
 }
 
-template <class value_t, class allocator_t>
-typename spsc_ring_queue<value_t, allocator_t>::producer& spsc_ring_queue<value_t, allocator_t>::get_producer()
+template <class value_t, class allocator_t, class wait_t>
+spsc_ring_queue<value_t, allocator_t, wait_t>::~spsc_ring_queue()
+{
+    const uint32_t head = head_.load(std::memory_order_acquire);
+    for (uint32_t index = tail_.load(std::memory_order_acquire); index != head; ++index)
+    {
+	allocator_traits::destroy(allocator_, get_slot(index));
+    }
+    if (buffer_ != nullptr)
+    {
+	allocator_traits::deallocate(allocator_, buffer_, capacity_);
+    }
+}
+
+template <class value_t, class allocator_t, class wait_t>
+typename spsc_ring_queue<value_t, allocator_t, wait_t>::producer& spsc_ring_queue<value_t, allocator_t, wait_t>::get_producer()
 {
     producer_lock_.lock.try_lock();
     return producer_;
 }
 
-template <class value_t, class allocator_t>
-typename spsc_ring_queue<value_t, allocator_t>::consumer& spsc_ring_queue<value_t, allocator_t>::get_consumer()
+template <class value_t, class allocator_t, class wait_t>
+typename spsc_ring_queue<value_t, allocator_t, wait_t>::consumer& spsc_ring_queue<value_t, allocator_t, wait_t>::get_consumer()
 {
     consumer_lock_.lock.try_lock();
     return consumer_;
@@ -3,53 +3,103 @@
 
 #include <cstdint>
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <vector>
+#include <turbo/container/ring_capacity.hpp>
+#include <turbo/container/wait_strategy.hpp>
 #include <turbo/toolset/attribute.hpp>
 
 namespace turbo {
 namespace container {
 
-template <class value_t, class allocator_t = std::allocator<value_t>> class spsc_key;
+template <class value_t, class allocator_t = std::allocator<value_t>, class wait_t = spin_yield_wait<>> class spsc_key;
 
-template <class value_t, class allocator_t = std::allocator<value_t>>
+template <class value_t, class allocator_t = std::allocator<value_t>, class wait_t = spin_yield_wait<>> class spsc_ring_queue;
+
+///
+/// Only the producer moves the head, so it keeps its own copy of it along with the last
+/// tail it saw, and only loads the shared tail again when the queue looks full
+///
+template <class value_t, class allocator_t = std::allocator<value_t>, class wait_t = spin_yield_wait<>>
 class TURBO_SYMBOL_DECL spsc_producer
 {
 public:
     typedef value_t value_type;
     typedef allocator_t allocator_type;
-    typedef spsc_key<value_t, allocator_t> key;
+    typedef spsc_key<value_t, allocator_t, wait_t> key;
+    ///
+    /// failure is kept for source compatibility; nothing else moves the head so an
+    /// enqueue never fails for any reason other than a full queue
+    ///
     enum class result
     {
 	success,
 	failure,
 	queue_full
     };
-    spsc_producer(const key&,
-		    std::vector<value_t, allocator_t>& buffer,
-		    std::atomic<uint32_t>& head,
-		    std::atomic<uint32_t>& tail);
+    spsc_producer(const key&, spsc_ring_queue<value_t, allocator_t, wait_t>& queue);
     result try_enqueue_copy(const value_t& input);
     result try_enqueue_move(value_t&& input);
+    ///
+    /// Copies as much of [first, last) as fits and publishes it with a single update of
+    /// the head index; count reports how many values were enqueued. Pass move iterators
+    /// to move the values in instead.
+    ///
+    template <class iterator_t>
+    result try_enqueue_bulk(iterator_t first, iterator_t last, uint32_t& count);
+    ///
+    /// Returns uninitialised storage for the next value, or nullptr when the queue is
+    /// full. Construct a value_t in it and then call commit to publish it; until then
+    /// reserve keeps returning the same slot.
+    ///
+    void* reserve();
+    ///
+    /// Publishes the value constructed in the storage returned by reserve
+    ///
+    void commit();
+    ///
+    /// Enqueues input, waiting for room as the queue's wait_t decides
+    ///
+    void enqueue_copy(const value_t& input);
+    void enqueue_move(value_t&& input);
+    ///
+    /// Enqueues input, waiting at most timeout for room; returns queue_full when the
+    /// timeout runs out
+    ///
+    template <class rep_t, class period_t>
+    result try_enqueue_copy_for(const value_t& input, const std::chrono::duration<rep_t, period_t>& timeout);
+    template <class rep_t, class period_t>
+    result try_enqueue_move_for(value_t&& input, const std::chrono::duration<rep_t, period_t>& timeout);
 private:
-    std::vector<value_t, allocator_t>& buffer_;
-    std::atomic<uint32_t>& head_;
-    std::atomic<uint32_t>& tail_;
+    spsc_producer() = delete;
+    spsc_producer(const spsc_producer&) = delete;
+    spsc_producer(spsc_producer&&) = delete;
+    spsc_producer& operator=(const spsc_producer&) = delete;
+    spsc_producer& operator=(spsc_producer&&) = delete;
+    inline uint32_t get_free_count(uint32_t wanted);
+    spsc_ring_queue<value_t, allocator_t, wait_t>& queue_;
+    uint32_t head_;
+    uint32_t cached_tail_;
 };
 
-template <class value_t, class allocator_t = std::allocator<value_t>>
+///
+/// Only the consumer moves the tail, so it keeps its own copy of it along with the last
+/// head it saw, and only loads the shared head again when the queue looks empty
+///
+template <class value_t, class allocator_t = std::allocator<value_t>, class wait_t = spin_yield_wait<>>
 class TURBO_SYMBOL_DECL spsc_consumer
 {
 public:
     typedef value_t value_type;
     typedef allocator_t allocator_type;
-    typedef spsc_key<value_t, allocator_t> key;
-    spsc_consumer(const key&,
-		    std::vector<value_t, allocator_t>& buffer,
-		    std::atomic<uint32_t>& head,
-		    std::atomic<uint32_t>& tail);
+    typedef spsc_key<value_t, allocator_t, wait_t> key;
+    spsc_consumer(const key&, spsc_ring_queue<value_t, allocator_t, wait_t>& queue);
+    ///
+    /// failure is kept for source compatibility; nothing else moves the tail so a
+    /// dequeue never fails for any reason other than an empty queue
+    ///
     enum class result
     {
 	success,
@@ -58,34 +108,96 @@ public:
     };
     result try_dequeue_copy(value_t& output);
     result try_dequeue_move(value_t& output);
+    ///
+    /// Moves up to limit values to output and releases their slots with a single update
+    /// of the tail index; count reports how many values were dequeued
+    ///
+    template <class iterator_t>
+    result try_dequeue_bulk(iterator_t output, uint32_t limit, uint32_t& count);
+    ///
+    /// Returns the oldest value in the queue without removing it, or nullptr when the
+    /// queue is empty. The value stays valid until release is called.
+    ///
+    value_t* peek();
+    ///
+    /// Destroys the value returned by peek and hands its slot back to the producer
+    ///
+    void release();
+    ///
+    /// Dequeues to output, waiting for a value as the queue's wait_t decides
+    ///
+    void dequeue_copy(value_t& output);
+    void dequeue_move(value_t& output);
+    ///
+    /// Dequeues to output, waiting at most timeout for a value; returns queue_empty when
+    /// the timeout runs out
+    ///
+    template <class rep_t, class period_t>
+    result try_dequeue_copy_for(value_t& output, const std::chrono::duration<rep_t, period_t>& timeout);
+    template <class rep_t, class period_t>
+    result try_dequeue_move_for(value_t& output, const std::chrono::duration<rep_t, period_t>& timeout);
 private:
-    std::vector<value_t, allocator_t>& buffer_;
-    std::atomic<uint32_t>& head_;
-    std::atomic<uint32_t>& tail_;
+    spsc_consumer() = delete;
+    spsc_consumer(const spsc_consumer&) = delete;
+    spsc_consumer(spsc_consumer&&) = delete;
+    spsc_consumer& operator=(const spsc_consumer&) = delete;
+    spsc_consumer& operator=(spsc_consumer&&) = delete;
+    inline uint32_t get_used_count(uint32_t wanted);
+    spsc_ring_queue<value_t, allocator_t, wait_t>& queue_;
+    uint32_t tail_;
+    uint32_t cached_head_;
 };
 
-template <class value_t, class allocator_t = std::allocator<value_t>>
+///
+/// Bounded queue for exactly one producer thread and one consumer thread. Values are
+/// constructed in place in raw storage when enqueued and destroyed when dequeued. The
+/// capacity is rounded up to a power of two, see calc_ring_capacity. wait_t selects
+/// what the blocking operations of the handles do while they wait, see
+/// wait_strategy.hpp.
+///
+template <class value_t, class allocator_t, class wait_t>
 class TURBO_SYMBOL_DECL spsc_ring_queue
 {
 public:
     typedef value_t value_type;
     typedef allocator_t allocator_type;
-    typedef spsc_producer<value_t, allocator_t> producer;
-    typedef spsc_consumer<value_t, allocator_t> consumer;
+    typedef wait_t wait_type;
+    typedef spsc_producer<value_t, allocator_t, wait_t> producer;
+    typedef spsc_consumer<value_t, allocator_t, wait_t> consumer;
     spsc_ring_queue(uint32_t capacity);
+    ~spsc_ring_queue();
+    inline uint32_t get_capacity() const
+    {
+	return capacity_;
+    }
     producer& get_producer();
     consumer& get_consumer();
 private:
-    typedef std::vector<value_t, allocator_t> vector_type;
+    typedef std::allocator_traits<allocator_t> allocator_traits;
+    friend class spsc_producer<value_t, allocator_t, wait_t>;
+    friend class spsc_consumer<value_t, allocator_t, wait_t>;
     struct single_lock
     {
 	single_lock();
 	std::mutex mutex;
 	std::unique_lock<std::mutex> lock;
     };
-    alignas(LEVEL1_DCACHE_LINESIZE) std::vector<value_t, allocator_t> buffer_;
+    spsc_ring_queue(const spsc_ring_queue&) = delete;
+    spsc_ring_queue(spsc_ring_queue&&) = delete;
+    spsc_ring_queue& operator=(const spsc_ring_queue&) = delete;
+    spsc_ring_queue& operator=(spsc_ring_queue&&) = delete;
+    inline value_t* get_slot(uint32_t index) const
+    {
+	return buffer_ + (index & mask_);
+    }
+    allocator_t allocator_;
+    const uint32_t capacity_;
+    const uint32_t mask_;
+    value_t* const buffer_;
     alignas(LEVEL1_DCACHE_LINESIZE) std::atomic<uint32_t> head_;
     alignas(LEVEL1_DCACHE_LINESIZE) std::atomic<uint32_t> tail_;
+    alignas(LEVEL1_DCACHE_LINESIZE) wait_t not_empty_;
+    alignas(LEVEL1_DCACHE_LINESIZE) wait_t not_full_;
     alignas(LEVEL1_DCACHE_LINESIZE) producer producer_;
     alignas(LEVEL1_DCACHE_LINESIZE) single_lock producer_lock_;
     alignas(LEVEL1_DCACHE_LINESIZE) consumer consumer_;
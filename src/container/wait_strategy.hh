@@ -0,0 +1,207 @@
+#ifndef TURBO_CONTAINER_WAIT_STRATEGY_HXX
+#define TURBO_CONTAINER_WAIT_STRATEGY_HXX
+
+#include <turbo/container/wait_strategy.hpp>
+#include <climits>
+#include <thread>
+#include <turbo/toolset/extension.hpp>
+#include <turbo/toolset/intrinsic.hpp>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace turbo {
+namespace container {
+
+template <class attempt_t>
+void spin_wait::wait(attempt_t attempt)
+{
+    while (!attempt())
+    {
+	turbo::toolset::cpu_relax();
+    }
+}
+
+template <class attempt_t>
+bool spin_wait::wait_until(attempt_t attempt, clock_type::time_point deadline)
+{
+    while (!attempt())
+    {
+	if (clock_type::now() >= deadline)
+	{
+	    return attempt();
+	}
+	turbo::toolset::cpu_relax();
+    }
+    return true;
+}
+
+template <std::uint32_t spin_limit>
+template <class attempt_t>
+void spin_yield_wait<spin_limit>::wait(attempt_t attempt)
+{
+    for (std::uint32_t spin = 0U; !attempt(); ++spin)
+    {
+	if (spin < spin_limit)
+	{
+	    turbo::toolset::cpu_relax();
+	}
+	else
+	{
+	    std::this_thread::yield();
+	}
+    }
+}
+
+template <std::uint32_t spin_limit>
+template <class attempt_t>
+bool spin_yield_wait<spin_limit>::wait_until(attempt_t attempt, clock_type::time_point deadline)
+{
+    for (std::uint32_t spin = 0U; !attempt(); ++spin)
+    {
+	if (clock_type::now() >= deadline)
+	{
+	    return attempt();
+	}
+	if (spin < spin_limit)
+	{
+	    turbo::toolset::cpu_relax();
+	}
+	else
+	{
+	    std::this_thread::yield();
+	}
+    }
+    return true;
+}
+
+template <std::uint32_t spin_limit>
+spin_park_wait<spin_limit>::spin_park_wait()
+    :
+	epoch_(0U),
+	sleepers_(0U),
+	woken_(false)
+{ }
+
+template <std::uint32_t spin_limit>
+spin_park_wait<spin_limit>::spin_park_wait(const spin_park_wait&)
+    :
+	epoch_(0U),
+	sleepers_(0U),
+	woken_(false)
+{ }
+
+template <std::uint32_t spin_limit>
+spin_park_wait<spin_limit>& spin_park_wait<spin_limit>::operator=(const spin_park_wait&)
+{
+    // sleepers belong to the queue they wait on, so there is nothing to copy
+    return *this;
+}
+
+template <std::uint32_t spin_limit>
+template <class attempt_t>
+void spin_park_wait<spin_limit>::wait(attempt_t attempt)
+{
+    for (std::uint32_t spin = 0U; spin < spin_limit; ++spin)
+    {
+	if (attempt())
+	{
+	    return;
+	}
+	turbo::toolset::cpu_relax();
+    }
+    park(attempt, nullptr);
+}
+
+template <std::uint32_t spin_limit>
+template <class attempt_t>
+bool spin_park_wait<spin_limit>::wait_until(attempt_t attempt, clock_type::time_point deadline)
+{
+    for (std::uint32_t spin = 0U; spin < spin_limit; ++spin)
+    {
+	if (attempt())
+	{
+	    return true;
+	}
+	turbo::toolset::cpu_relax();
+    }
+    return park(attempt, &deadline);
+}
+
+template <std::uint32_t spin_limit>
+template <class attempt_t>
+bool spin_park_wait<spin_limit>::park(attempt_t attempt, const clock_type::time_point* deadline)
+{
+    for (;;)
+    {
+	const std::uint32_t epoch = epoch_.load(std::memory_order_acquire);
+	sleepers_.fetch_add(1U, std::memory_order_seq_cst);
+	woken_.store(false, std::memory_order_seq_cst);
+	// pairs with the fence in notify: either this attempt sees the other side's
+	// update or notify sees this thread registered as a sleeper
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (attempt())
+	{
+	    sleepers_.fetch_sub(1U, std::memory_order_relaxed);
+	    return true;
+	}
+	const bool in_time = sleep(epoch, deadline);
+	sleepers_.fetch_sub(1U, std::memory_order_relaxed);
+	if (!in_time)
+	{
+	    return attempt();
+	}
+	if (attempt())
+	{
+	    return true;
+	}
+    }
+}
+
+template <std::uint32_t spin_limit>
+inline void spin_park_wait<spin_limit>::notify()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (TURBO_UNLIKELY(sleepers_.load(std::memory_order_relaxed) != 0U)
+	    && !woken_.exchange(true, std::memory_order_seq_cst))
+    {
+	epoch_.fetch_add(1U, std::memory_order_release);
+#if defined(__linux__) && defined(SYS_futex)
+	::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+    }
+}
+
+template <std::uint32_t spin_limit>
+inline bool spin_park_wait<spin_limit>::sleep(std::uint32_t epoch, const clock_type::time_point* deadline)
+{
+#if defined(__linux__) && defined(SYS_futex)
+    struct timespec timeout = { 0, 0 };
+    if (deadline != nullptr)
+    {
+	const clock_type::duration remaining = *deadline - clock_type::now();
+	if (remaining <= clock_type::duration::zero())
+	{
+	    return false;
+	}
+	const std::chrono::nanoseconds nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining);
+	timeout.tv_sec = static_cast<time_t>(nanoseconds.count() / 1000000000);
+	timeout.tv_nsec = static_cast<long>(nanoseconds.count() % 1000000000);
+    }
+    // returns straight away when epoch_ has already moved on
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE, epoch,
+	    deadline == nullptr ? nullptr : &timeout, nullptr, 0);
+#else
+    (void)epoch;
+    std::this_thread::yield();
+#endif
+    return deadline == nullptr || clock_type::now() < *deadline;
+}
+
+} // namespace container
+} // namespace turbo
+
+#endif
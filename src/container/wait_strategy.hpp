@@ -0,0 +1,88 @@
+#ifndef TURBO_CONTAINER_WAIT_STRATEGY_HPP
+#define TURBO_CONTAINER_WAIT_STRATEGY_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace container {
+
+///
+/// A wait strategy decides what a blocking queue operation does while it cannot make
+/// progress. wait and wait_until keep calling attempt until it returns true, the latter
+/// giving up at deadline; notify is called by the other side of the queue every time it
+/// makes room or publishes a value.
+///
+
+///
+/// Retries without ever giving up the processor; lowest latency, but a waiting thread
+/// keeps its core busy
+///
+class TURBO_SYMBOL_DECL spin_wait
+{
+public:
+    typedef std::chrono::steady_clock clock_type;
+    template <class attempt_t>
+    void wait(attempt_t attempt);
+    template <class attempt_t>
+    bool wait_until(attempt_t attempt, clock_type::time_point deadline);
+    inline void notify() { }
+};
+
+///
+/// Spins for spin_limit attempts and then yields the processor between attempts
+///
+template <std::uint32_t spin_limit = 128U>
+class TURBO_SYMBOL_DECL spin_yield_wait
+{
+public:
+    typedef std::chrono::steady_clock clock_type;
+    template <class attempt_t>
+    void wait(attempt_t attempt);
+    template <class attempt_t>
+    bool wait_until(attempt_t attempt, clock_type::time_point deadline);
+    inline void notify() { }
+};
+
+///
+/// Spins for spin_limit attempts and then sleeps on a futex until notified. Waiters
+/// register before their last attempt, so notify only makes a system call when a thread
+/// is asleep and has not been woken yet; otherwise it costs a fence and a load. Where
+/// futexes are not available sleeping falls back to yielding.
+///
+template <std::uint32_t spin_limit = 128U>
+class TURBO_SYMBOL_DECL spin_park_wait
+{
+public:
+    typedef std::chrono::steady_clock clock_type;
+    spin_park_wait();
+    spin_park_wait(const spin_park_wait&);
+    spin_park_wait& operator=(const spin_park_wait&);
+    template <class attempt_t>
+    void wait(attempt_t attempt);
+    template <class attempt_t>
+    bool wait_until(attempt_t attempt, clock_type::time_point deadline);
+    inline void notify();
+private:
+    template <class attempt_t>
+    bool park(attempt_t attempt, const clock_type::time_point* deadline);
+    ///
+    /// Sleeps until epoch_ moves away from epoch or deadline passes, returning false
+    /// once the deadline has passed
+    ///
+    inline bool sleep(std::uint32_t epoch, const clock_type::time_point* deadline);
+    alignas(LEVEL1_DCACHE_LINESIZE) std::atomic<std::uint32_t> epoch_;
+    std::atomic<std::uint32_t> sleepers_;
+    ///
+    /// Set by the notify that wakes the sleepers, so that the notifies that follow before
+    /// they run again skip the system call
+    ///
+    std::atomic<bool> woken_;
+};
+
+} // namespace container
+} // namespace turbo
+
+#endif
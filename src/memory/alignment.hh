@@ -17,11 +17,10 @@ std::size_t calc_total_aligned_size(std::size_t value_size, std::size_t value_al
     }
     else
     {
-	double exponent = std::log2(value_alignment);
-	if (static_cast<double>(static_cast<std::int64_t>(exponent)) == exponent)
+	if ((value_alignment & (value_alignment - 1U)) == 0U)
 	{
 	    // Avoid the cost of division if alignment is a power of 2
-	    return ((value_size + value_alignment) >> static_cast<std::uint64_t>(exponent)) * value_alignment * quantity;
+	    return ((value_size + value_alignment) & ~(value_alignment - 1U)) * quantity;
 	}
 	else
 	{
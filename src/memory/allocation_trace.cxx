@@ -0,0 +1,304 @@
+#include "allocation_trace.hpp"
+#include "allocation_trace.hh"
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <turbo/toolset/extension.hpp>
+
+namespace turbo {
+namespace memory {
+
+namespace {
+
+static_assert(sizeof(trace_event) == 24U, "trace_event is part of the file format and must not change size");
+
+struct file_header
+{
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t event_size;
+};
+
+std::atomic<std::uint64_t>& get_next_serial()
+{
+    static std::atomic<std::uint64_t> serial(1U);
+    return serial;
+}
+
+///
+/// Set while a thread is inside the recorder, so that allocations the recorder makes
+/// itself are not recorded
+///
+bool& is_recording()
+{
+    thread_local bool recording = false;
+    return recording;
+}
+
+class recording_guard
+{
+public:
+    inline recording_guard() { is_recording() = true; }
+    inline ~recording_guard() { is_recording() = false; }
+};
+
+} // anonymous namespace
+
+trace_error::trace_error(const std::string& what)
+    :
+	runtime_error(what)
+{ }
+
+trace_error::trace_error(const char* what)
+    :
+	runtime_error(what)
+{ }
+
+const std::uint64_t trace_recorder::file_magic;
+const std::uint32_t trace_recorder::file_version;
+const std::size_t trace_recorder::buffer_capacity;
+std::atomic<trace_recorder*> trace_recorder::active_(nullptr);
+
+trace_recorder::trace_recorder(const std::string& path)
+    :
+	serial_(get_next_serial().fetch_add(1U, std::memory_order_relaxed)),
+	epoch_(std::chrono::steady_clock::now()),
+	file_mutex_(),
+	file_(std::fopen(path.c_str(), "wb")),
+	buffers_mutex_(),
+	buffers_(),
+	event_count_(0U)
+{
+    if (TURBO_UNLIKELY(file_ == nullptr))
+    {
+	throw trace_error(std::string("unable to create trace file: ") + std::strerror(errno));
+    }
+    const file_header header { file_magic, file_version, static_cast<std::uint32_t>(sizeof(trace_event)) };
+    if (TURBO_UNLIKELY(std::fwrite(&header, sizeof(header), 1U, file_) != 1U))
+    {
+	std::fclose(file_);
+	throw trace_error("unable to write trace file header");
+    }
+}
+
+trace_recorder::~trace_recorder() noexcept
+{
+    stop();
+    flush();
+    std::fclose(file_);
+}
+
+void trace_recorder::start()
+{
+    active_.store(this, std::memory_order_release);
+}
+
+void trace_recorder::stop()
+{
+    trace_recorder* expected = this;
+    active_.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+}
+
+void trace_recorder::flush()
+{
+    recording_guard guard;
+    std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+    for (auto&& buffer : buffers_)
+    {
+	std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+	write(*buffer);
+    }
+    std::lock_guard<std::mutex> file_lock(file_mutex_);
+    std::fflush(file_);
+}
+
+void trace_recorder::record(trace_event::kind_type kind, std::size_t size, const void* pointer)
+{
+    if (is_recording())
+    {
+	return;
+    }
+    recording_guard guard;
+    const std::uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch_).count();
+    thread_buffer& buffer = get_local_buffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back(trace_event {
+	    timestamp,
+	    reinterpret_cast<std::uintptr_t>(pointer),
+	    static_cast<std::uint32_t>(std::min<std::size_t>(size, std::numeric_limits<std::uint32_t>::max())),
+	    buffer.thread,
+	    kind,
+	    0U });
+    event_count_.fetch_add(1U, std::memory_order_relaxed);
+    if (buffer_capacity <= buffer.events.size())
+    {
+	write(buffer);
+    }
+}
+
+trace_recorder::thread_buffer& trace_recorder::get_local_buffer()
+{
+    // keyed by serial rather than address, as a new recorder can reuse a destroyed one's address
+    thread_local std::uint64_t owner = 0U;
+    thread_local thread_buffer* buffer = nullptr;
+    if (TURBO_UNLIKELY(owner != serial_))
+    {
+	std::unique_ptr<thread_buffer> fresh(new thread_buffer());
+	fresh->events.reserve(buffer_capacity);
+	std::lock_guard<std::mutex> lock(buffers_mutex_);
+	fresh->thread = static_cast<std::uint16_t>(buffers_.size());
+	buffer = fresh.get();
+	buffers_.push_back(std::move(fresh));
+	owner = serial_;
+    }
+    return *buffer;
+}
+
+void trace_recorder::write(thread_buffer& buffer)
+{
+    if (buffer.events.empty())
+    {
+	return;
+    }
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    std::fwrite(buffer.events.data(), sizeof(trace_event), buffer.events.size(), file_);
+    buffer.events.clear();
+}
+
+const std::uint64_t trace_reader::reorder_window;
+
+trace_reader::trace_reader(const std::string& path)
+    :
+	events_(),
+	thread_count_(0U),
+	id_count_(0U),
+	dropped_frees_(0U),
+	peak_live_bytes_(0U)
+{
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(path.c_str(), "rb"), &std::fclose);
+    if (TURBO_UNLIKELY(!file))
+    {
+	throw trace_error(std::string("unable to open trace file: ") + std::strerror(errno));
+    }
+    file_header header;
+    if (TURBO_UNLIKELY(std::fread(&header, sizeof(header), 1U, file.get()) != 1U
+	    || header.magic != trace_recorder::file_magic
+	    || header.version != trace_recorder::file_version
+	    || header.event_size != sizeof(trace_event)))
+    {
+	throw trace_error("not a trace file or an unsupported version");
+    }
+    trace_event event;
+    while (std::fread(&event, sizeof(event), 1U, file.get()) == 1U)
+    {
+	events_.push_back(event);
+    }
+    normalise();
+}
+
+void trace_reader::normalise()
+{
+    typedef trace_event::kind_type kind_type;
+    std::stable_sort(events_.begin(), events_.end(), [] (const trace_event& left, const trace_event& right) -> bool
+    {
+	return left.timestamp < right.timestamp;
+    });
+    // address to the index of the allocation that currently owns it
+    std::unordered_map<std::uint64_t, std::size_t> live;
+    // address to the index of a free that arrived before any allocation of it
+    std::unordered_map<std::uint64_t, std::size_t> early_frees;
+    std::vector<bool> keep(events_.size(), true);
+    for (std::size_t index = 0U; index < events_.size(); ++index)
+    {
+	trace_event& event = events_[index];
+	thread_count_ = std::max<std::size_t>(thread_count_, event.thread + 1U);
+	const std::uint64_t address = event.pointer_id;
+	if (event.kind == kind_type::allocate)
+	{
+	    // an address allocated again without a free is a leak; the old id is simply never freed
+	    event.pointer_id = id_count_++;
+	    auto early = early_frees.find(address);
+	    if (early != early_frees.end())
+	    {
+		trace_event& free_event = events_[early->second];
+		if (event.timestamp - free_event.timestamp <= reorder_window)
+		{
+		    free_event.timestamp = event.timestamp;
+		    free_event.pointer_id = event.pointer_id;
+		    free_event.size = event.size;
+		    live.erase(address);
+		}
+		else
+		{
+		    keep[early->second] = false;
+		    ++dropped_frees_;
+		    live[address] = index;
+		}
+		early_frees.erase(early);
+	    }
+	    else
+	    {
+		live[address] = index;
+	    }
+	}
+	else
+	{
+	    auto owner = live.find(address);
+	    if (owner != live.end())
+	    {
+		event.pointer_id = events_[owner->second].pointer_id;
+		event.size = events_[owner->second].size;
+		live.erase(owner);
+	    }
+	    else
+	    {
+		auto previous = early_frees.find(address);
+		if (previous != early_frees.end())
+		{
+		    keep[previous->second] = false;
+		    ++dropped_frees_;
+		}
+		early_frees[address] = index;
+	    }
+	}
+    }
+    for (auto&& early : early_frees)
+    {
+	keep[early.second] = false;
+	++dropped_frees_;
+    }
+    std::vector<trace_event> kept;
+    kept.reserve(events_.size() - dropped_frees_);
+    for (std::size_t index = 0U; index < events_.size(); ++index)
+    {
+	if (keep[index])
+	{
+	    kept.push_back(events_[index]);
+	}
+    }
+    // moved frees now share their allocation's timestamp and have to follow it
+    std::stable_sort(kept.begin(), kept.end(), [] (const trace_event& left, const trace_event& right) -> bool
+    {
+	return left.timestamp < right.timestamp
+		|| (left.timestamp == right.timestamp && left.kind == kind_type::allocate && right.kind == kind_type::free);
+    });
+    events_.swap(kept);
+    std::uint64_t live_bytes = 0U;
+    for (const trace_event& event : events_)
+    {
+	if (event.kind == kind_type::allocate)
+	{
+	    live_bytes += event.size;
+	    peak_live_bytes_ = std::max(peak_live_bytes_, live_bytes);
+	}
+	else
+	{
+	    live_bytes -= event.size;
+	}
+    }
+}
+
+} // namespace memory
+} // namespace turbo
@@ -0,0 +1,42 @@
+#ifndef TURBO_MEMORY_ALLOCATION_TRACE_HXX
+#define TURBO_MEMORY_ALLOCATION_TRACE_HXX
+
+#include <turbo/memory/allocation_trace.hpp>
+
+namespace turbo {
+namespace memory {
+
+#if defined(TURBO_MEMORY_TRACE)
+
+void trace_allocate(std::size_t size, const void* pointer)
+{
+    trace_recorder* recorder = trace_recorder::get_active();
+    if (recorder != nullptr && pointer != nullptr)
+    {
+	recorder->record_allocate(size, pointer);
+    }
+}
+
+void trace_free(std::size_t size, const void* pointer)
+{
+    trace_recorder* recorder = trace_recorder::get_active();
+    if (recorder != nullptr && pointer != nullptr)
+    {
+	recorder->record_free(size, pointer);
+    }
+}
+
+#else
+
+void trace_allocate(std::size_t, const void*)
+{ }
+
+void trace_free(std::size_t, const void*)
+{ }
+
+#endif
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef TURBO_MEMORY_ALLOCATION_TRACE_HPP
+#define TURBO_MEMORY_ALLOCATION_TRACE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace memory {
+
+class trace_error : public std::runtime_error
+{
+public:
+    explicit trace_error(const std::string& what);
+    explicit trace_error(const char* what);
+};
+
+///
+/// One record of a trace file. Frees may have a size of 0 when the allocator does
+/// not know it; trace_reader fills it in from the matching allocation.
+///
+struct TURBO_SYMBOL_DECL trace_event
+{
+    enum class kind_type : std::uint8_t
+    {
+	allocate,
+	free
+    };
+    ///
+    /// Nanoseconds since the recorder was created
+    ///
+    std::uint64_t timestamp;
+    ///
+    /// The address as recorded, or a unique id once loaded by trace_reader
+    ///
+    std::uint64_t pointer_id;
+    std::uint32_t size;
+    std::uint16_t thread;
+    kind_type kind;
+    std::uint8_t reserved;
+};
+
+///
+/// Writes allocate and free events to a binary trace file. Each thread fills a buffer
+/// of its own, so recording only takes an uncontended lock until the buffer is full and
+/// is written out.
+///
+/// concurrent_sized_slab and untyped_allocator report to the started recorder when
+/// built with TURBO_MEMORY_TRACE defined; anything else can call record_allocate and
+/// record_free itself. Allocations made by the recorder while it records, e.g. when a
+/// replacement malloc is being traced, are not recorded. Record frees before the
+/// memory is released and allocations after it is acquired, so that a recycled
+/// address is always recorded in order. Stop the recorder before destroying it while
+/// other threads are still allocating.
+///
+class TURBO_SYMBOL_DECL trace_recorder
+{
+public:
+    static const std::uint64_t file_magic = 0x6f6272747261636bULL;
+    static const std::uint32_t file_version = 1U;
+    static const std::size_t buffer_capacity = 4096U;
+    ///
+    /// Throws trace_error if the file cannot be created
+    ///
+    explicit trace_recorder(const std::string& path);
+    ~trace_recorder() noexcept;
+    ///
+    /// Makes this the recorder the allocator hooks report to, replacing any other
+    ///
+    void start();
+    void stop();
+    static inline trace_recorder* get_active()
+    {
+	return active_.load(std::memory_order_acquire);
+    }
+    inline void record_allocate(std::size_t size, const void* pointer)
+    {
+	record(trace_event::kind_type::allocate, size, pointer);
+    }
+    inline void record_free(std::size_t size, const void* pointer)
+    {
+	record(trace_event::kind_type::free, size, pointer);
+    }
+    ///
+    /// Writes out every thread's buffer
+    ///
+    void flush();
+    inline std::uint64_t get_event_count() const
+    {
+	return event_count_.load(std::memory_order_relaxed);
+    }
+private:
+    struct thread_buffer
+    {
+	std::mutex mutex;
+	std::uint16_t thread;
+	std::vector<trace_event> events;
+    };
+    trace_recorder() = delete;
+    trace_recorder(const trace_recorder&) = delete;
+    trace_recorder(trace_recorder&&) = delete;
+    trace_recorder& operator=(const trace_recorder&) = delete;
+    trace_recorder& operator=(trace_recorder&&) = delete;
+    void record(trace_event::kind_type kind, std::size_t size, const void* pointer);
+    thread_buffer& get_local_buffer();
+    ///
+    /// The caller holds the buffer's mutex
+    ///
+    void write(thread_buffer& buffer);
+    static std::atomic<trace_recorder*> active_;
+    const std::uint64_t serial_;
+    const std::chrono::steady_clock::time_point epoch_;
+    std::mutex file_mutex_;
+    std::FILE* file_;
+    std::mutex buffers_mutex_;
+    std::vector<std::unique_ptr<thread_buffer>> buffers_;
+    std::atomic<std::uint64_t> event_count_;
+};
+
+///
+/// Loads a trace file for replay. Events are put in timestamp order and every
+/// allocation gets a unique id, which its free shares, so recycled addresses do not
+/// alias. A free recorded just before the allocation of its address, because the
+/// allocating thread was descheduled before recording, is moved after it; frees of
+/// addresses that were never allocated during the trace are dropped.
+///
+class TURBO_SYMBOL_DECL trace_reader
+{
+public:
+    ///
+    /// How far before an allocation an unmatched free of the same address can be and
+    /// still be taken as its free
+    ///
+    static const std::uint64_t reorder_window = 1000000U;
+    ///
+    /// Throws trace_error if the file cannot be read or is not a trace
+    ///
+    explicit trace_reader(const std::string& path);
+    inline const std::vector<trace_event>& get_events() const { return events_; }
+    inline std::size_t get_thread_count() const { return thread_count_; }
+    inline std::uint64_t get_id_count() const { return id_count_; }
+    inline std::uint64_t get_dropped_frees() const { return dropped_frees_; }
+    ///
+    /// The most bytes allocated and not yet freed at any point in the trace
+    ///
+    inline std::uint64_t get_peak_live_bytes() const { return peak_live_bytes_; }
+private:
+    trace_reader() = delete;
+    void normalise();
+    std::vector<trace_event> events_;
+    std::size_t thread_count_;
+    std::uint64_t id_count_;
+    std::uint64_t dropped_frees_;
+    std::uint64_t peak_live_bytes_;
+};
+
+///
+/// Hooks for the allocators, which do nothing unless TURBO_MEMORY_TRACE is defined
+///
+inline void trace_allocate(std::size_t size, const void* pointer);
+inline void trace_free(std::size_t size, const void* pointer);
+
+} // namespace memory
+} // namespace turbo
+
+#endif
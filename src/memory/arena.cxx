@@ -0,0 +1,83 @@
+#include "arena.hpp"
+#include "arena.hh"
+#include <algorithm>
+#include <limits>
+
+namespace turbo {
+namespace memory {
+
+const std::size_t arena::default_chunk_size;
+
+arena::arena()
+    :
+	arena(default_chunk_size)
+{ }
+
+arena::arena(std::size_t chunk_size)
+    :
+	chunk_size_(chunk_size),
+	chunks_(),
+	current_(0U),
+	offset_(0U)
+{
+    if (TURBO_UNLIKELY(chunk_size_ == 0U))
+    {
+	throw invalid_size_error("chunk size cannot be 0");
+    }
+}
+
+std::size_t arena::get_used_size() const
+{
+    std::size_t used = offset_;
+    for (std::size_t index = 0U; index < current_ && index < chunks_.size(); ++index)
+    {
+	used += chunks_[index].size;
+    }
+    return used;
+}
+
+void arena::rewind(const mark& position)
+{
+    if (position.chunk_ < current_ || (position.chunk_ == current_ && position.offset_ <= offset_))
+    {
+	current_ = position.chunk_;
+	offset_ = position.offset_;
+    }
+}
+
+void arena::release()
+{
+    chunks_.clear();
+    current_ = 0U;
+    offset_ = 0U;
+}
+
+void* arena::allocate_slow(std::size_t size, std::size_t alignment)
+{
+    if (size == 0U || alignment == 0U || (alignment & (alignment - 1U)) != 0U)
+    {
+	return nullptr;
+    }
+    if (TURBO_UNLIKELY(size > std::numeric_limits<std::size_t>::max() - alignment))
+    {
+	throw out_of_memory_error("arena allocation is too large");
+    }
+    // new storage is only aligned for fundamental types, so leave room to align the value
+    const std::size_t needed = size + alignment - 1U;
+    std::size_t next = chunks_.empty() ? 0U : current_ + 1U;
+    if (next >= chunks_.size() || chunks_[next].size < needed)
+    {
+	// chunks kept from before a rewind stay in order after the new one
+	const std::size_t length = std::max(chunk_size_, needed);
+	chunks_.insert(chunks_.begin() + next, chunk { std::unique_ptr<std::uint8_t[]>(new std::uint8_t[length]), length });
+    }
+    current_ = next;
+    offset_ = 0U;
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunks_[current_].storage.get());
+    const std::uintptr_t aligned = (base + alignment - 1U) & ~(alignment - 1U);
+    offset_ = aligned - base + size;
+    return reinterpret_cast<void*>(aligned);
+}
+
+} // namespace memory
+} // namespace turbo
@@ -0,0 +1,29 @@
+#ifndef TURBO_MEMORY_ARENA_HXX
+#define TURBO_MEMORY_ARENA_HXX
+
+#include <turbo/memory/arena.hpp>
+#include <turbo/toolset/extension.hpp>
+
+namespace turbo {
+namespace memory {
+
+void* arena::allocate(std::size_t size, std::size_t alignment)
+{
+    if (TURBO_LIKELY(current_ < chunks_.size()))
+    {
+	const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunks_[current_].storage.get());
+	const std::uintptr_t aligned = (base + offset_ + alignment - 1U) & ~(alignment - 1U);
+	const std::size_t end = aligned - base + size;
+	if (TURBO_LIKELY(size != 0U && alignment != 0U && (alignment & (alignment - 1U)) == 0U && end <= chunks_[current_].size && end > offset_))
+	{
+	    offset_ = end;
+	    return reinterpret_cast<void*>(aligned);
+	}
+    }
+    return allocate_slow(size, alignment);
+}
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef TURBO_MEMORY_ARENA_HPP
+#define TURBO_MEMORY_ARENA_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <turbo/memory/block.hpp>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace memory {
+
+class TURBO_SYMBOL_DECL arena_tester;
+
+///
+/// A monotonic bump pointer allocator with the same typed interface as the slabs, for
+/// scratch structures that are built up and then thrown away as a whole. Values are
+/// carved out of chunks in order and deallocate does nothing; memory is only reclaimed
+/// by rewinding to a mark, which is O(1), or by releasing every chunk at once. Chunks
+/// are kept on rewind so that the next round of allocations reuses them.
+///
+/// Destructors are never run by the arena. An arena is not thread safe.
+///
+class TURBO_SYMBOL_DECL arena
+{
+public:
+    typedef std::size_t size_type;
+    ///
+    /// A position in the arena to rewind to; it is invalidated by release
+    ///
+    class mark
+    {
+    public:
+	inline bool operator==(const mark& other) const { return chunk_ == other.chunk_ && offset_ == other.offset_; }
+	inline bool operator!=(const mark& other) const { return !(*this == other); }
+	friend class arena;
+    private:
+	inline mark(std::size_t chunk, std::size_t offset) : chunk_(chunk), offset_(offset) { }
+	std::size_t chunk_;
+	std::size_t offset_;
+    };
+    static const std::size_t default_chunk_size = 64U << 10U;
+    arena();
+    explicit arena(std::size_t chunk_size);
+    ~arena() = default;
+    inline std::size_t get_chunk_size() const { return chunk_size_; }
+    inline std::size_t get_chunk_count() const { return chunks_.size(); }
+    ///
+    /// Bytes handed out since the arena was created or last rewound or released, including padding
+    ///
+    std::size_t get_used_size() const;
+    template <class value_t>
+    inline value_t* allocate(size_type quantity)
+    {
+	return static_cast<value_t*>(allocate(sizeof(value_t) * quantity, alignof(value_t)));
+    }
+    template <class value_t>
+    inline value_t* allocate()
+    {
+	return allocate<value_t>(1U);
+    }
+    template <class value_t>
+    inline value_t* allocate(const value_t*)
+    {
+	return allocate<value_t>(1U);
+    }
+    template <class value_t>
+    inline value_t* allocate(size_type quantity, const value_t*)
+    {
+	return allocate<value_t>(quantity);
+    }
+    template <class value_t>
+    inline void deallocate(value_t*, size_type)
+    { }
+    template <class value_t>
+    inline void deallocate(value_t*)
+    { }
+    ///
+    /// Returns size bytes aligned to alignment, which must be a power of 2, or nullptr
+    /// if size is 0 or alignment is not a power of 2
+    ///
+    inline void* allocate(std::size_t size, std::size_t alignment);
+    inline mark get_mark() const { return mark(current_, offset_); }
+    ///
+    /// Gives back everything allocated after the mark was taken
+    ///
+    void rewind(const mark& position);
+    ///
+    /// Gives back everything but keeps the chunks for reuse
+    ///
+    inline void reset() { rewind(mark(0U, 0U)); }
+    ///
+    /// Gives back everything and frees every chunk
+    ///
+    void release();
+    friend class arena_tester;
+private:
+    struct chunk
+    {
+	std::unique_ptr<std::uint8_t[]> storage;
+	std::size_t size;
+    };
+    arena(const arena&) = delete;
+    arena(arena&&) = delete;
+    arena& operator=(const arena&) = delete;
+    arena& operator=(arena&&) = delete;
+    ///
+    /// Moves to the next chunk that can hold the allocation, adding one if needed
+    ///
+    void* allocate_slow(std::size_t size, std::size_t alignment);
+    std::size_t chunk_size_;
+    std::vector<chunk> chunks_;
+    std::size_t current_;
+    std::size_t offset_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -1,16 +1,306 @@
 #include "block.hpp"
 #include "block.hh"
+#include "index_stack.hpp"
 #include <cstring>
 #include <algorithm>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #include <turbo/algorithm/recovery.hpp>
 #include <turbo/algorithm/recovery.hh>
 #include <turbo/memory/alignment.hpp>
+#include <turbo/memory/epoch.hpp>
+#include <turbo/memory/epoch.hh>
+#include <turbo/memory/page_map.hpp>
+#include <turbo/memory/page_map.hh>
+#include <turbo/memory/slab_statistics.hh>
 #include <turbo/container/mpmc_ring_queue.hh>
 #include <turbo/toolset/extension.hpp>
 
 namespace turbo {
 namespace memory {
 
+namespace {
+
+typedef page_map<block> block_map_type;
+
+///
+/// Every block registers the pages of its storage here so that the owner of an
+/// address can be found without searching. The map is deliberately never destroyed
+/// so that blocks with static storage duration can still deregister at exit.
+///
+block_map_type& get_block_map()
+{
+    static block_map_type* map = new block_map_type();
+    return *map;
+}
+
+///
+/// Readers of every block_list are pinned here while they walk a list, so that trim
+/// knows when the blocks it unlinked are no longer reachable; it is never destroyed
+/// for the same reason as the block map
+///
+epoch_domain& get_list_domain()
+{
+    static epoch_domain* domain = new epoch_domain();
+    return *domain;
+}
+
+///
+/// The default huge page size on x86-64 and most aarch64 kernels
+///
+const std::size_t huge_page_size = static_cast<std::size_t>(1U) << 21U;
+
+inline std::size_t round_up(std::size_t length, std::size_t alignment)
+{
+    return ((length + alignment - 1U) / alignment) * alignment;
+}
+
+inline std::uint8_t* align_to(std::uint8_t* storage, std::size_t alignment)
+{
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(storage);
+    const std::uintptr_t mask = alignment - 1U;
+    return reinterpret_cast<std::uint8_t*>((address + mask) & ~mask);
+}
+
+///
+/// A page that heap blocks too small to be worth whole pages are carved out of. The
+/// owner of every granule is recorded so that owners are still found in constant time.
+///
+struct shared_page
+{
+    static const std::size_t granule_size = LEVEL1_DCACHE_LINESIZE;
+    static const std::size_t granule_count = block_map_type::page_size / granule_size;
+    explicit shared_page(std::uint8_t* storage);
+    inline block* find(const void* address) const
+    {
+	const std::size_t offset = static_cast<const std::uint8_t*>(address) - page;
+	return owners[offset / granule_size].load(std::memory_order_acquire);
+    }
+    void assign(const std::uint8_t* region, std::size_t length, block* owner);
+    std::uint8_t* const page;
+    std::array<std::atomic<block*>, granule_count> owners;
+    std::size_t used; // guarded by the mutex of shared_page_pool
+    std::size_t live; // guarded by the mutex of shared_page_pool
+};
+
+shared_page::shared_page(std::uint8_t* storage)
+    :
+	page(storage),
+	used(0U),
+	live(0U)
+{
+    for (auto&& owner : owners)
+    {
+	owner.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+void shared_page::assign(const std::uint8_t* region, std::size_t length, block* owner)
+{
+    const std::size_t first = (region - page) / granule_size;
+    const std::size_t last = first + (length / granule_size);
+    for (std::size_t index = first; index < last; ++index)
+    {
+	owners[index].store(owner, std::memory_order_release);
+    }
+}
+
+typedef page_map<shared_page> shared_page_map_type;
+
+///
+/// Never destroyed for the same reason as the block map
+///
+shared_page_map_type& get_shared_page_map()
+{
+    static shared_page_map_type* map = new shared_page_map_type();
+    return *map;
+}
+
+///
+/// Regions are carved from the most recently mapped shared page, and a page is
+/// unmapped once every region carved from it has been released. Blocks are created
+/// rarely enough that a mutex is fine here.
+///
+class shared_page_pool
+{
+public:
+    shared_page_pool();
+    std::uint8_t* carve(std::size_t length, std::size_t alignment);
+    void release(std::uint8_t* region);
+private:
+    void unmap(shared_page* page);
+    std::mutex mutex_;
+    shared_page* current_;
+};
+
+shared_page_pool::shared_page_pool()
+    :
+	current_(nullptr)
+{ }
+
+std::uint8_t* shared_page_pool::carve(std::size_t length, std::size_t alignment)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (current_ == nullptr || round_up(current_->used, alignment) + length > block_map_type::page_size)
+    {
+	void* storage = ::mmap(nullptr, block_map_type::page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (TURBO_UNLIKELY(storage == MAP_FAILED))
+	{
+	    return nullptr;
+	}
+	std::unique_ptr<shared_page> page(new shared_page(static_cast<std::uint8_t*>(storage)));
+	if (TURBO_UNLIKELY(!get_shared_page_map().insert(storage, block_map_type::page_size, page.get())))
+	{
+	    ::munmap(storage, block_map_type::page_size);
+	    return nullptr;
+	}
+	if (current_ != nullptr && current_->live == 0U)
+	{
+	    unmap(current_);
+	}
+	current_ = page.release();
+    }
+    std::uint8_t* region = current_->page + round_up(current_->used, alignment);
+    current_->used = (region - current_->page) + length;
+    ++current_->live;
+    return region;
+}
+
+void shared_page_pool::release(std::uint8_t* region)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    shared_page* page = get_shared_page_map().find(region);
+    if (TURBO_LIKELY(page != nullptr) && --page->live == 0U)
+    {
+	if (page == current_)
+	{
+	    // keep the page for the next small block rather than mapping another
+	    page->used = 0U;
+	}
+	else
+	{
+	    unmap(page);
+	}
+    }
+}
+
+void shared_page_pool::unmap(shared_page* page)
+{
+    get_shared_page_map().erase(page->page, block_map_type::page_size);
+    ::munmap(page->page, block_map_type::page_size);
+    delete page;
+}
+
+///
+/// Never destroyed for the same reason as the block map
+///
+shared_page_pool& get_shared_page_pool()
+{
+    static shared_page_pool* pool = new shared_page_pool();
+    return *pool;
+}
+
+///
+/// Heap storage up to this size is carved out of shared pages
+///
+const std::size_t shared_region_limit = block_map_type::page_size / 4U;
+
+///
+/// Binds the pages of a region to a NUMA node. The system call is made directly so
+/// there is no dependency on libnuma. Returns false where the kernel or the node does
+/// not support it, leaving the region with the default first touch placement.
+///
+bool bind_to_node(void* region, std::size_t length, int node)
+{
+#ifdef SYS_mbind
+    const int mpol_bind = 2; // MPOL_BIND from linux/mempolicy.h
+    const std::size_t word_bits = std::numeric_limits<unsigned long>::digits;
+    std::vector<unsigned long> mask(node / word_bits + 1U, 0UL);
+    mask[node / word_bits] |= 1UL << (node % word_bits);
+    // the kernel expects one more than the number of bits in the mask
+    return ::syscall(SYS_mbind, region, length, mpol_bind, mask.data(), mask.size() * word_bits + 1U, 0U) == 0;
+#else
+    return false;
+#endif
+}
+
+static_assert(std::is_same<block::capacity_type, index_stack::index_type>::value, "the index stack has to hold any index of a block");
+
+using index_stack::empty_index;
+using index_stack::pack_top;
+using index_stack::top_index;
+using index_stack::top_tag;
+using index_stack::next_link;
+
+///
+/// Output iterator that converts the free list indices it is assigned into the
+/// addresses of the values they refer to
+///
+class address_writer
+{
+public:
+    typedef std::output_iterator_tag iterator_category;
+    typedef void value_type;
+    typedef void difference_type;
+    typedef void pointer;
+    typedef void reference;
+    inline address_writer(std::uint8_t* base, std::size_t value_size, void** output)
+	:
+	    base_(base),
+	    value_size_(value_size),
+	    output_(output)
+    { }
+    inline address_writer& operator*() { return *this; }
+    inline address_writer& operator++() { ++output_; return *this; }
+    inline address_writer& operator=(block::capacity_type index)
+    {
+	*output_ = &(base_[index * value_size_]);
+	return *this;
+    }
+private:
+    std::uint8_t* base_;
+    std::size_t value_size_;
+    void** output_;
+};
+
+///
+/// Input iterator that converts the addresses it reads into the free list indices
+/// of the values they point to
+///
+class index_reader
+{
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef block::capacity_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const block::capacity_type* pointer;
+    typedef block::capacity_type reference;
+    inline index_reader(const std::uint8_t* base, std::size_t value_size, void** input)
+	:
+	    base_(base),
+	    value_size_(value_size),
+	    input_(input)
+    { }
+    inline reference operator*() const
+    {
+	return static_cast<block::capacity_type>((static_cast<std::uint8_t*>(*input_) - base_) / value_size_);
+    }
+    inline index_reader& operator++() { ++input_; return *this; }
+    inline difference_type operator-(const index_reader& other) const { return input_ - other.input_; }
+private:
+    const std::uint8_t* base_;
+    std::size_t value_size_;
+    void** input_;
+};
+
+} // anonymous namespace
+
 out_of_memory_error::out_of_memory_error(const std::string& what)
     :
 	runtime_error(what)
@@ -51,24 +341,223 @@ invalid_pointer_error::invalid_pointer_error(const char* what)
 	invalid_argument(what)
 { }
 
+const int storage_policy::any_node;
+
+storage_policy::storage_policy()
+    :
+	storage_policy(backing::heap, false)
+{ }
+
+storage_policy::storage_policy(backing from, bool prefault_pages)
+    :
+	storage_policy(from, prefault_pages, any_node)
+{ }
+
+storage_policy::storage_policy(backing from, bool prefault_pages, int numa_node)
+    :
+	source(from),
+	prefault(prefault_pages),
+	node(numa_node < 0 ? any_node : numa_node)
+{ }
+
+bool storage_policy::operator==(const storage_policy& other) const
+{
+    return source == other.source && prefault == other.prefault && node == other.node;
+}
+
+void block::storage_deleter::operator()(std::uint8_t* storage) const
+{
+    if (is_shared_)
+    {
+	get_shared_page_pool().release(storage);
+    }
+    else if (mapped_length_ == 0U)
+    {
+	delete[] storage;
+    }
+    else
+    {
+	::munmap(storage, mapped_length_);
+    }
+}
+
+block::storage_type block::acquire_storage(storage_policy& policy, std::size_t region_size, std::size_t region_alignment)
+{
+    typedef storage_policy::backing backing;
+    if (policy.source == backing::heap && region_alignment < block_map_type::page_size)
+    {
+	std::uint8_t* region = get_shared_page_pool().carve(region_size, region_alignment);
+	if (TURBO_UNLIKELY(region == nullptr))
+	{
+	    throw out_of_memory_error("unable to map shared page");
+	}
+	return storage_type(region, storage_deleter(0U, true));
+    }
+    else if (policy.source == backing::heap)
+    {
+	return storage_type(new std::uint8_t[region_size + region_alignment]);
+    }
+    const bool is_bound = policy.node != storage_policy::any_node;
+    // pages faulted in by MAP_POPULATE ignore any advice or binding given after the mapping is made
+    const int populate = (policy.prefault && !is_bound) ? MAP_POPULATE : 0;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    storage_type result;
+    std::uint8_t* region = nullptr;
+    bool is_populated = false;
+#ifdef MAP_HUGETLB
+    if (policy.source == backing::explicit_huge_page)
+    {
+	const std::size_t length = round_up(region_size, huge_page_size);
+	void* storage = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB | populate, -1, 0);
+	if (storage != MAP_FAILED)
+	{
+	    result = storage_type(static_cast<std::uint8_t*>(storage), storage_deleter(length, false));
+	    region = result.get();
+	    is_populated = populate != 0;
+	}
+	// otherwise no huge pages are reserved so fall back to transparent huge pages
+    }
+#endif
+    if (!result)
+    {
+	// over map huge page backed storage so that the region can start on a huge page boundary
+	const std::size_t length = policy.source == backing::mapped ? region_size : round_up(region_size, huge_page_size) + huge_page_size;
+	void* storage = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags | (policy.source == backing::mapped ? populate : 0), -1, 0);
+	if (TURBO_UNLIKELY(storage == MAP_FAILED))
+	{
+	    throw out_of_memory_error("unable to map storage");
+	}
+	result = storage_type(static_cast<std::uint8_t*>(storage), storage_deleter(length, false));
+	if (policy.source == backing::mapped)
+	{
+	    region = result.get();
+	    is_populated = populate != 0;
+	}
+	else
+	{
+	    region = align_to(result.get(), huge_page_size);
+#ifdef MADV_HUGEPAGE
+	    // only advice, when transparent huge pages are disabled the region keeps standard pages
+	    ::madvise(region, round_up(region_size, huge_page_size), MADV_HUGEPAGE);
+#endif
+	}
+    }
+    if (is_bound && !bind_to_node(region, region_size, policy.node))
+    {
+	// the storage is usable but its placement is whatever first touch gives it
+	policy.node = storage_policy::any_node;
+    }
+    if (policy.prefault && !is_populated)
+    {
+	for (std::size_t offset = 0U; offset < region_size; offset += block_map_type::page_size)
+	{
+	    region[offset] = 0U;
+	}
+    }
+    return result;
+}
+
+std::size_t block::calc_region_alignment(const storage_policy& policy, std::size_t usable_size, std::size_t alignment)
+{
+    switch (policy.source)
+    {
+	case storage_policy::backing::heap:
+	{
+	    if (usable_size > shared_region_limit)
+	    {
+		return block_map_type::page_size;
+	    }
+	    // a copy keeps the offset of the base within the region, so the region has to
+	    // be aligned at least as well as the values are
+	    std::size_t region_alignment = shared_page::granule_size;
+	    while (region_alignment < alignment && region_alignment < block_map_type::page_size)
+	    {
+		region_alignment <<= 1U;
+	    }
+	    return region_alignment;
+	}
+	case storage_policy::backing::transparent_huge_page:
+	case storage_policy::backing::explicit_huge_page:
+	{
+	    return huge_page_size;
+	}
+	default:
+	{
+	    return block_map_type::page_size;
+	}
+    }
+}
+
+std::size_t block::calc_region_size(std::size_t usable_size, std::size_t region_alignment)
+{
+    // shared regions are padded to whole granules and the rest to whole pages, so no
+    // two blocks ever share a granule
+    return round_up(usable_size, region_alignment < block_map_type::page_size ? shared_page::granule_size : block_map_type::page_size);
+}
+
+void block::register_region()
+{
+    if (region_alignment_ < block_map_type::page_size)
+    {
+	get_shared_page_map().find(region_)->assign(region_, region_size_, this);
+    }
+    else
+    {
+	get_block_map().insert(region_, region_size_, this);
+    }
+}
+
+void block::deregister_region()
+{
+    if (region_alignment_ < block_map_type::page_size)
+    {
+	get_shared_page_map().find(region_)->assign(region_, region_size_, nullptr);
+    }
+    else
+    {
+	get_block_map().erase(region_, region_size_);
+    }
+}
+
 block::block(std::size_t value_size, capacity_type capacity)
     :
 	block(value_size, capacity, alignof(void*))
 { }
 
 block::block(std::size_t value_size, capacity_type capacity, std::size_t alignment)
+    :
+	block(value_size, capacity, alignment, free_list_mode::ring_queue)
+{ }
+
+block::block(std::size_t value_size, capacity_type capacity, std::size_t alignment, free_list_mode mode)
+    :
+	block(value_size, capacity, alignment, mode, storage_policy())
+{ }
+
+block::block(std::size_t value_size, capacity_type capacity, std::size_t alignment, free_list_mode mode, const storage_policy& storage)
     :
 	value_size_(value_size),
 	capacity_(capacity),
 	usable_size_(capacity == 0U ? 0U : value_size_ * (capacity_ + 1)), // need extra in case of bad alignment
-	storage_(capacity == 0U ? nullptr : new std::uint8_t[usable_size_]),
-	base_(capacity == 0U ? nullptr : &(storage_[0])),
-	free_list_(capacity)
+	region_size_(capacity == 0U ? 0U : calc_region_size(usable_size_, calc_region_alignment(storage, usable_size_, alignment))),
+	region_alignment_(calc_region_alignment(storage, usable_size_, alignment)),
+	policy_(storage),
+	storage_(capacity == 0U ? nullptr : acquire_storage(policy_, region_size_, region_alignment_)),
+	region_(capacity == 0U ? nullptr : align_to(&(storage_[0]), region_alignment_)),
+	base_(region_),
+	free_list_(mode == free_list_mode::index_stack ? 0U : capacity),
+	mode_(mode),
+	stack_top_(pack_top(0U, empty_index)),
+	list_(nullptr)
 {
     if (TURBO_UNLIKELY(value_size_ == 0))
     {
 	throw invalid_size_error("value size cannot be 0");
     }
+    if (TURBO_UNLIKELY(mode_ == free_list_mode::index_stack && value_size_ < sizeof(capacity_type)))
+    {
+	throw invalid_size_error("value size is too small to hold a free list index");
+    }
     if (capacity_ == 0U)
     {
 	return;
@@ -77,7 +566,11 @@ block::block(std::size_t value_size, capacity_type capacity, std::size_t alignme
     {
 	throw out_of_memory_error("insufficient space in heap");
     }
-    std::fill_n(base_, usable_size_, 0U);
+    if (policy_.source == storage_policy::backing::heap)
+    {
+	// mapped storage is already zeroed and filling it would fault in every page
+	std::fill_n(base_, usable_size_, 0U);
+    }
     void* tmp = base_;
     if (TURBO_UNLIKELY(!turbo::memory::align(alignment, value_size_, tmp, usable_size_)))
     {
@@ -92,10 +585,26 @@ block::block(std::size_t value_size, capacity_type capacity, std::size_t alignme
     else
     {
 	capacity_ = capacity;
-	for (capacity_type index = 0; index < capacity_; ++index)
+	if (mode_ == free_list_mode::index_stack)
+	{
+	    if (TURBO_UNLIKELY(reinterpret_cast<std::uintptr_t>(base_) % alignof(capacity_type) != 0U || value_size_ % alignof(capacity_type) != 0U))
+	    {
+		throw invalid_alignment_error("values are not aligned well enough to hold a free list index");
+	    }
+	    for (capacity_type index = 0; index < capacity_; ++index)
+	    {
+		next_link(base_, value_size_, index).store(index + 1U < capacity_ ? index + 1U : empty_index, std::memory_order_relaxed);
+	    }
+	    stack_top_.store(pack_top(0U, 0U), std::memory_order_release);
+	}
+	else
 	{
-	    free_list_.try_enqueue_copy(index);
+	    for (capacity_type index = 0; index < capacity_; ++index)
+	    {
+		free_list_.try_enqueue_copy(index);
+	    }
 	}
+	register_region();
     }
 }
 
@@ -104,13 +613,29 @@ block::block(const block& other)
 	value_size_(other.value_size_),
 	capacity_(other.capacity_),
 	usable_size_(other.usable_size_),
-	storage_(capacity_ == 0U ? nullptr : new std::uint8_t[usable_size_]),
-	base_(capacity_ == 0U ? nullptr : &(storage_[0])),
-	free_list_(other.free_list_)
+	region_size_(other.region_size_),
+	region_alignment_(other.region_alignment_),
+	policy_(other.policy_),
+	storage_(other.is_empty() ? nullptr : acquire_storage(policy_, region_size_, region_alignment_)),
+	region_(other.is_empty() ? nullptr : align_to(&(storage_[0]), region_alignment_)),
+	base_(other.is_empty() ? nullptr : region_ + (other.base_ - other.region_)),
+	free_list_(other.free_list_),
+	mode_(other.mode_),
+	stack_top_(other.stack_top_.load(std::memory_order_acquire)),
+	list_(nullptr)
 {
     if (storage_.get() != nullptr)
     {
-	std::copy_n(&(other.storage_[0]), usable_size_, &(this->storage_[0]));
+	std::copy_n(other.base_, usable_size_, this->base_);
+	register_region();
+    }
+}
+
+block::~block() noexcept
+{
+    if (region_ != nullptr)
+    {
+	deregister_region();
     }
 }
 
@@ -119,13 +644,15 @@ block& block::operator=(const block& other)
     if (this != &other
 	    && this->value_size_ == other.value_size_
 	    && this->capacity_ == other.capacity_
-	    && this->usable_size_ == other.usable_size_)
+	    && this->usable_size_ == other.usable_size_
+	    && this->mode_ == other.mode_)
     {
 	if (this->storage_.get() != nullptr && other.storage_.get() != nullptr)
 	{
-	    std::copy_n(&(other.storage_[0]), this->usable_size_, &(this->storage_[0]));
+	    std::copy_n(other.base_, this->usable_size_, this->base_);
 	}
 	this->free_list_ = other.free_list_;
+	this->stack_top_.store(other.stack_top_.load(std::memory_order_acquire), std::memory_order_release);
     }
     return *this;
 }
@@ -135,8 +662,10 @@ bool block::operator==(const block& other) const
     return this->value_size_ == other.value_size_
 	&& this->capacity_ == other.capacity_
 	&& this->usable_size_ == other.usable_size_
-	&& std::memcmp(this->storage_.get(), other.storage_.get(), usable_size_) == 0
-	&& this->free_list_ == other.free_list_;
+	&& std::memcmp(this->base_, other.base_, usable_size_) == 0
+	&& this->free_list_ == other.free_list_
+	&& this->mode_ == other.mode_
+	&& this->stack_top_.load(std::memory_order_acquire) == other.stack_top_.load(std::memory_order_acquire);
 }
 
 void* block::allocate()
@@ -148,6 +677,10 @@ void* block::allocate()
     {
 	return nullptr;
     }
+    else if (mode_ == free_list_mode::index_stack)
+    {
+	return pop_stack();
+    }
     tar::retry_with_random_backoff([&] () -> tar::try_state
     {
 	switch (free_list_.try_dequeue_copy(reservation))
@@ -165,6 +698,7 @@ void* block::allocate()
 	    }
 	    default:
 	    {
+		count_retry();
 		return tar::try_state::retry;
 	    }
 	}
@@ -185,7 +719,11 @@ void block::free(void* pointer)
 	throw invalid_pointer_error("address points to the middle of a value");
     }
     std::size_t offset = diff / value_size_;
-    if (offset < (usable_size_ / value_size_))
+    if (offset < capacity_ && mode_ == free_list_mode::index_stack)
+    {
+	push_stack(static_cast<capacity_type>(offset));
+    }
+    else if (offset < capacity_)
     {
 	tar::retry_with_random_backoff([&] () -> tar::try_state
 	{
@@ -202,6 +740,7 @@ void block::free(void* pointer)
 		}
 		default:
 		{
+		    count_retry();
 		    return tar::try_state::retry;
 		}
 	    }
@@ -213,6 +752,231 @@ void block::free(void* pointer)
     }
 }
 
+std::size_t block::allocate_bulk(void** output, std::size_t quantity)
+{
+    namespace tar = turbo::algorithm::recovery;
+    std::size_t total = 0U;
+    bool exhausted = is_empty() || output == nullptr;
+    if (!exhausted && mode_ == free_list_mode::index_stack)
+    {
+	return pop_stack_bulk(output, quantity);
+    }
+    while (!exhausted && total < quantity)
+    {
+	const std::uint32_t limit = static_cast<std::uint32_t>(std::min<std::size_t>(quantity - total, std::numeric_limits<std::uint32_t>::max()));
+	std::uint32_t count = 0U;
+	tar::retry_with_random_backoff([&] () -> tar::try_state
+	{
+	    switch (free_list_.try_dequeue_bulk(address_writer(base_, value_size_, output + total), limit, count))
+	    {
+		case free_list_type::consumer::result::queue_empty:
+		{
+		    // no free blocks available
+		    exhausted = true;
+		    return tar::try_state::done;
+		}
+		case free_list_type::consumer::result::success:
+		{
+		    return tar::try_state::done;
+		}
+		default:
+		{
+		    count_retry();
+		    return tar::try_state::retry;
+		}
+	    }
+	});
+	total += count;
+    }
+    return total;
+}
+
+void block::free_bulk(void** input, std::size_t quantity)
+{
+    namespace tar = turbo::algorithm::recovery;
+    if (is_empty() || input == nullptr)
+    {
+	return;
+    }
+    // validate everything first so that nothing is released when an address is bad
+    for (std::size_t index = 0U; index < quantity; ++index)
+    {
+	if (input[index] == nullptr)
+	{
+	    continue;
+	}
+	std::size_t diff = static_cast<std::uint8_t*>(input[index]) - base_;
+	if (diff % value_size_ != 0)
+	{
+	    throw invalid_pointer_error("address points to the middle of a value");
+	}
+	else if ((diff / value_size_) >= capacity_)
+	{
+	    throw invalid_pointer_error("given address does not come from this block");
+	}
+    }
+    std::size_t first = 0U;
+    while (first < quantity)
+    {
+	if (input[first] == nullptr)
+	{
+	    ++first;
+	    continue;
+	}
+	std::size_t last = first + 1U;
+	while (last < quantity && input[last] != nullptr && last - first < std::numeric_limits<std::uint32_t>::max())
+	{
+	    ++last;
+	}
+	if (mode_ == free_list_mode::index_stack)
+	{
+	    push_stack_bulk(input + first, last - first);
+	    first = last;
+	}
+	bool full = false;
+	while (!full && first < last)
+	{
+	    std::uint32_t count = 0U;
+	    tar::retry_with_random_backoff([&] () -> tar::try_state
+	    {
+		switch (free_list_.try_enqueue_bulk(index_reader(base_, value_size_, input + first), index_reader(base_, value_size_, input + last), count))
+		{
+		    case free_list_type::producer::result::queue_full:
+		    {
+			// log a warning?
+			full = true;
+			return tar::try_state::done;
+		    }
+		    case free_list_type::producer::result::success:
+		    {
+			return tar::try_state::done;
+		    }
+		    default:
+		    {
+			count_retry();
+			return tar::try_state::retry;
+		    }
+		}
+	    });
+	    first += count;
+	}
+	first = last;
+    }
+}
+
+void* block::pop_stack()
+{
+    namespace tar = turbo::algorithm::recovery;
+    void* result = nullptr;
+    tar::retry_with_random_backoff([&] () -> tar::try_state
+    {
+	capacity_type index = empty_index;
+	if (index_stack::try_pop(stack_top_, base_, value_size_, index))
+	{
+	    // no free blocks available when the stack was empty
+	    result = index == empty_index ? nullptr : &(base_[index * value_size_]);
+	    return tar::try_state::done;
+	}
+	else
+	{
+	    count_retry();
+	    return tar::try_state::retry;
+	}
+    });
+    return result;
+}
+
+void block::push_stack(capacity_type index)
+{
+    namespace tar = turbo::algorithm::recovery;
+    tar::retry_with_random_backoff([&] () -> tar::try_state
+    {
+	if (index_stack::try_push(stack_top_, base_, value_size_, index, index))
+	{
+	    return tar::try_state::done;
+	}
+	else
+	{
+	    count_retry();
+	    return tar::try_state::retry;
+	}
+    });
+}
+
+std::size_t block::pop_stack_bulk(void** output, std::size_t quantity)
+{
+    namespace tar = turbo::algorithm::recovery;
+    std::size_t count = 0U;
+    tar::retry_with_random_backoff([&] () -> tar::try_state
+    {
+	count = 0U;
+	std::uint64_t top = stack_top_.load(std::memory_order_acquire);
+	capacity_type index = top_index(top);
+	while (count < quantity && index != empty_index)
+	{
+	    if (TURBO_UNLIKELY(index >= capacity_))
+	    {
+		// followed a stale link from a value that has since been handed out
+		count_retry();
+		return tar::try_state::retry;
+	    }
+	    output[count++] = &(base_[index * value_size_]);
+	    index = next_link(base_, value_size_, index).load(std::memory_order_relaxed);
+	}
+	if (count == 0U || stack_top_.compare_exchange_strong(top, pack_top(top_tag(top) + 1U, index), std::memory_order_acq_rel))
+	{
+	    return tar::try_state::done;
+	}
+	else
+	{
+	    count_retry();
+	    return tar::try_state::retry;
+	}
+    });
+    return count;
+}
+
+void block::push_stack_bulk(void** input, std::size_t quantity)
+{
+    namespace tar = turbo::algorithm::recovery;
+    index_reader reader(base_, value_size_, input);
+    const capacity_type first = *reader;
+    capacity_type last = first;
+    // the values are still owned by the caller so they can be chained without synchronisation
+    for (std::size_t count = 1U; count < quantity; ++count)
+    {
+	const capacity_type next = *(++reader);
+	next_link(base_, value_size_, last).store(next, std::memory_order_relaxed);
+	last = next;
+    }
+    tar::retry_with_random_backoff([&] () -> tar::try_state
+    {
+	if (index_stack::try_push(stack_top_, base_, value_size_, first, last))
+	{
+	    return tar::try_state::done;
+	}
+	else
+	{
+	    count_retry();
+	    return tar::try_state::retry;
+	}
+    });
+}
+
+block* block::find_owner(const void* pointer)
+{
+    block* owner = get_block_map().find(pointer);
+    if (owner == nullptr)
+    {
+	const shared_page* page = get_shared_page_map().find(pointer);
+	if (page != nullptr)
+	{
+	    owner = page->find(pointer);
+	}
+    }
+    return owner;
+}
+
 block_config::block_config()
     :
 	block_config(0U, 0U, 0U, 0U)
@@ -229,11 +993,17 @@ block_config::block_config(std::size_t size, capacity_type initial, capacity_typ
 { }
 
 block_config::block_config(std::size_t size, capacity_type initial, capacity_type contingency, std::size_t growth)
+    :
+	block_config(size, initial, contingency, growth, storage_policy())
+{ }
+
+block_config::block_config(std::size_t size, capacity_type initial, capacity_type contingency, std::size_t growth, const storage_policy& policy)
     :
 	block_size(size),
 	initial_capacity(initial),
 	contingency_capacity(contingency),
-	growth_factor(growth < 2U ? 2U : growth)
+	growth_factor(growth < 2U ? 2U : growth),
+	storage(policy)
 {
     if (block_size != 0U && initial_capacity == 0U && contingency_capacity == 0U)
     {
@@ -250,7 +1020,8 @@ bool block_config::operator==(const block_config& other) const
 {
     return block_size == other.block_size
 	    && initial_capacity == other.initial_capacity
-	    && growth_factor == other.growth_factor;
+	    && growth_factor == other.growth_factor
+	    && storage == other.storage;
 }
 
 block_list::iterator::iterator()
@@ -404,9 +1175,9 @@ typename block_list::const_iterator::block_type* block_list::const_iterator::ope
     }
 }
 
-block_list::node::node(std::size_t value_size, block::capacity_type capacity)
+block_list::node::node(std::size_t value_size, block::capacity_type capacity, const storage_policy& storage)
     :
-	block_(value_size, capacity, value_size),
+	block_(value_size, capacity, value_size, block::free_list_mode::ring_queue, storage),
 	next_(nullptr)
 { }
 
@@ -460,13 +1231,27 @@ block_list::block_list(std::size_t value_size, block::capacity_type initial, blo
 { }
 
 block_list::block_list(std::size_t value_size, block::capacity_type initial, block::capacity_type contingency, std::size_t growth_factor)
+    :
+	block_list(value_size, initial, contingency, growth_factor, storage_policy())
+{ }
+
+block_list::block_list(
+	std::size_t value_size,
+	block::capacity_type initial,
+	block::capacity_type contingency,
+	std::size_t growth_factor,
+	const storage_policy& storage)
     :
 	value_size_(value_size),
 	growth_factor_(growth_factor),
 	contingency_capacity_(contingency),
 	list_size_(1U),
-	first_(value_size, initial)
+	storage_(storage),
+	statistics_(),
+	trim_mutex_(),
+	first_(value_size, initial, storage_)
 {
+    first_.mutate_block().list_ = this;
     if (value_size == 0U)
     {
 	throw std::invalid_argument("block_list - the value size argument cannot be 0");
@@ -483,8 +1268,13 @@ block_list::block_list(const block_config& config)
 	growth_factor_(config.growth_factor),
 	contingency_capacity_(config.contingency_capacity),
 	list_size_(1U),
-	first_(config.block_size, config.initial_capacity)
-{ }
+	storage_(config.storage),
+	statistics_(),
+	trim_mutex_(),
+	first_(config.block_size, config.initial_capacity, storage_)
+{
+    first_.mutate_block().list_ = this;
+}
 
 block_list::block_list(const block_list& other)
     :
@@ -492,8 +1282,12 @@ block_list::block_list(const block_list& other)
 	growth_factor_(other.growth_factor_),
 	contingency_capacity_(other.contingency_capacity_),
 	list_size_(other.list_size_),
+	storage_(other.storage_),
+	statistics_(),
+	trim_mutex_(),
 	first_(other.first_)
 {
+    first_.mutate_block().list_ = this;
     auto this_iter = this->begin();
     auto other_iter = other.cbegin();
     // first_ has already been copied, so skip it
@@ -549,44 +1343,197 @@ bool block_list::operator==(const block_list& other) const
 	&& is_list_matching;
 }
 
+bucket_statistics block_list::get_statistics() const
+{
+    return statistics_.snapshot(value_size_);
+}
+
 std::unique_ptr<block_list::node> block_list::create_node(block::capacity_type capacity) const
 {
-    return std::move(std::unique_ptr<block_list::node>(new block_list::node(value_size_, capacity)));
+    std::unique_ptr<block_list::node> result(new block_list::node(value_size_, capacity, storage_));
+    // nodes are only ever linked into the list that made them
+    result->mutate_block().list_ = const_cast<block_list*>(this);
+    return result;
 }
 
 std::unique_ptr<block_list::node> block_list::clone_node(const node& other) const
 {
-    return std::move(std::unique_ptr<block_list::node>(new block_list::node(other)));
+    std::unique_ptr<block_list::node> result(new block_list::node(other));
+    // nodes are only ever linked into the list that made them
+    result->mutate_block().list_ = const_cast<block_list*>(this);
+    return result;
 }
 
 void* block_list::allocate()
 {
-    void* allocation = nullptr;
-    for (auto iter = begin(); allocation == nullptr; ++iter)
+    // trim never releases the first block, so only walking past it needs a pin
+    void* allocation = first_.mutate_block().allocate();
+    if (TURBO_LIKELY(allocation != nullptr))
     {
-	allocation = iter->allocate();
-	if (allocation == nullptr && iter.is_last())
+	statistics_.record_allocate(1U);
+	return allocation;
+    }
+    epoch_domain::guard guard(get_list_domain().get_local());
+    for (auto iter = begin(); allocation == nullptr; )
+    {
+	// the block at iter is full
+	if (iter.is_last())
 	{
-	    block::capacity_type capacity = iter->is_empty() ?
-		    contingency_capacity_ :
-		    iter->get_capacity() * get_growth_factor();
-	    iter.try_append(std::move(create_node(capacity)));
-	    ++list_size_;
+	    grow(iter);
 	}
+	++iter;
+	allocation = iter->allocate();
     }
+    statistics_.record_allocate(1U);
     return allocation;
 }
 
+std::size_t block_list::allocate_bulk(void** output, std::size_t quantity)
+{
+    std::size_t total = first_.mutate_block().allocate_bulk(output, quantity);
+    if (TURBO_LIKELY(total == quantity))
+    {
+	statistics_.record_allocate(total);
+	return total;
+    }
+    epoch_domain::guard guard(get_list_domain().get_local());
+    for (auto iter = begin(); total < quantity; )
+    {
+	// the block at iter is full
+	if (iter.is_last())
+	{
+	    grow(iter);
+	}
+	++iter;
+	total += iter->allocate_bulk(output + total, quantity - total);
+    }
+    statistics_.record_allocate(total);
+    return total;
+}
+
+void block_list::grow(iterator& last)
+{
+    block::capacity_type capacity = last->is_empty() ?
+	    contingency_capacity_ :
+	    last->get_capacity() * get_growth_factor();
+    last.try_append(std::move(create_node(capacity)));
+    ++list_size_;
+    statistics_.record_append();
+}
+
 void block_list::free(void* pointer)
 {
+    block* owner = block::find_owner(pointer);
+    if (TURBO_LIKELY(owner != nullptr))
+    {
+	if (owner->get_value_size() == value_size_)
+	{
+	    owner->free(pointer);
+	    statistics_.record_free(1U);
+	}
+	return;
+    }
+    // the address could not be represented in the page map, so search the list
+    epoch_domain::guard guard(get_list_domain().get_local());
     for (auto&& block : *this)
     {
 	if (block.in_range(pointer))
 	{
 	    block.free(pointer);
+	    statistics_.record_free(1U);
+	    break;
+	}
+    }
+}
+
+void block_list::free_bulk(void** input, std::size_t quantity)
+{
+    std::size_t first = 0U;
+    while (first < quantity)
+    {
+	block* owner = block::find_owner(input[first]);
+	std::size_t last = first + 1U;
+	while (last < quantity && block::find_owner(input[last]) == owner)
+	{
+	    ++last;
+	}
+	if (TURBO_LIKELY(owner != nullptr))
+	{
+	    if (owner->get_value_size() == value_size_)
+	    {
+		owner->free_bulk(input + first, last - first);
+		statistics_.record_free(std::count_if(input + first, input + last, [] (void* pointer) -> bool
+		{
+		    return pointer != nullptr;
+		}));
+	    }
+	}
+	else
+	{
+	    for (std::size_t index = first; index < last; ++index)
+	    {
+		free(input[index]);
+	    }
+	}
+	first = last;
+    }
+}
+
+void block_list::splice(node* orphan)
+{
+    node* last = &first_;
+    node* next = nullptr;
+    while (!last->mutate_next().compare_exchange_weak(next, orphan, std::memory_order_acq_rel))
+    {
+	if (next != nullptr)
+	{
+	    last = next;
+	    next = nullptr;
+	}
+    }
+}
+
+std::size_t block_list::trim()
+{
+    std::lock_guard<std::mutex> lock(trim_mutex_);
+    std::vector<node*> chain;
+    for (node* current = first_.get_next().load(std::memory_order_acquire); current != nullptr; current = current->get_next().load(std::memory_order_acquire))
+    {
+	chain.push_back(current);
+    }
+    // take every value of each trailing block so that nothing can allocate from it while it is unlinked
+    std::size_t first_trimmed = chain.size();
+    std::vector<void*> seized;
+    while (first_trimmed != 0U)
+    {
+	block& candidate = chain[first_trimmed - 1U]->mutate_block();
+	seized.resize(candidate.get_capacity());
+	const std::size_t count = candidate.allocate_bulk(seized.data(), seized.size());
+	if (count != seized.size())
+	{
+	    candidate.free_bulk(seized.data(), count);
 	    break;
 	}
+	--first_trimmed;
+    }
+    if (first_trimmed == chain.size())
+    {
+	return 0U;
+    }
+    node* predecessor = (first_trimmed == 0U) ? &first_ : chain[first_trimmed - 1U];
+    node* expected = chain[first_trimmed];
+    predecessor->mutate_next().compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+    get_list_domain().synchronize();
+    // an allocate that was already inside the unlinked blocks may have appended a new block to them
+    node* orphan = chain.back()->mutate_next().exchange(nullptr, std::memory_order_acq_rel);
+    if (orphan != nullptr)
+    {
+	splice(orphan);
     }
+    delete chain[first_trimmed];
+    const std::size_t released = chain.size() - first_trimmed;
+    list_size_ -= released;
+    return released;
 }
 
 } // namespace memory
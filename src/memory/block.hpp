@@ -2,9 +2,13 @@
 #define TURBO_MEMORY_BLOCK_HPP
 
 #include <cstdint>
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <turbo/container/mpmc_ring_queue.hpp>
+#include <turbo/memory/slab_statistics.hpp>
 #include <turbo/toolset/attribute.hpp>
 
 namespace turbo {
@@ -38,21 +42,69 @@ public:
     explicit invalid_pointer_error(const char* what);
 };
 
+///
+/// Where a block gets its storage from. Anything other than heap maps the storage
+/// directly, optionally asking for huge pages and for every page to be faulted in
+/// up front so that steady state use pays no page faults. Mapped storage can also be
+/// bound to a NUMA node; the node is ignored for heap storage, and a block whose
+/// storage could not be bound reports any_node instead.
+///
+struct TURBO_SYMBOL_DECL storage_policy
+{
+    enum class backing
+    {
+	heap,
+	mapped,
+	transparent_huge_page,
+	explicit_huge_page // falls back to transparent huge pages when none are reserved
+    };
+    static const int any_node = -1;
+    storage_policy();
+    storage_policy(backing from, bool prefault_pages);
+    storage_policy(backing from, bool prefault_pages, int numa_node);
+    bool operator==(const storage_policy& other) const;
+    inline bool operator!=(const storage_policy& other) const { return !(*this == other); }
+    backing source;
+    bool prefault;
+    int node;
+};
+
+class block_list;
+
 class TURBO_SYMBOL_DECL block
 {
 public:
     typedef std::uint32_t capacity_type;
+    ///
+    /// ring_queue keeps free indices in a separate FIFO queue; index_stack threads
+    /// them through the free values themselves as a LIFO stack, which needs no side
+    /// allocation and hands back the most recently freed value first
+    ///
+    enum class free_list_mode
+    {
+	ring_queue,
+	index_stack
+    };
     block(std::size_t value_size, capacity_type capacity);
     block(std::size_t value_size, capacity_type capacity, std::size_t alignment);
+    block(std::size_t value_size, capacity_type capacity, std::size_t alignment, free_list_mode mode);
+    block(std::size_t value_size, capacity_type capacity, std::size_t alignment, free_list_mode mode, const storage_policy& storage);
     block(const block& other);
-    ~block() = default;
+    ~block() noexcept;
     block& operator=(const block& other);
     bool operator==(const block& other) const;
     inline std::size_t get_value_size() const { return value_size_; }
     inline std::size_t get_capacity() const { return capacity_; }
     inline std::size_t get_usable_size() const { return usable_size_; }
     inline const void* get_base_address() const { return base_; }
+    inline free_list_mode get_free_list_mode() const { return mode_; }
+    inline const storage_policy& get_storage_policy() const { return policy_; }
     inline bool is_empty() const { return storage_.get() == nullptr; }
+    ///
+    /// The list this block is a node of, or nullptr for a block on its own
+    ///
+    inline const block_list* get_list() const { return list_; }
+    inline block_list* mutate_list() { return list_; }
     inline bool in_range(const void* pointer) const
     {
 	if (is_empty())
@@ -66,17 +118,68 @@ public:
     }
     void* allocate();
     void free(void* pointer);
+    ///
+    /// Claims up to quantity free values with a single update of the free list and writes
+    /// their addresses to output; returns how many were allocated
+    ///
+    std::size_t allocate_bulk(void** output, std::size_t quantity);
+    ///
+    /// Returns every non-null address in input to the free list, reserving the space
+    /// for each run with a single update
+    ///
+    void free_bulk(void** input, std::size_t quantity);
+    ///
+    /// Finds the block whose storage contains the given address in constant time,
+    /// or nullptr if the address does not belong to any block
+    ///
+    static block* find_owner(const void* pointer);
 private:
     typedef turbo::container::mpmc_ring_queue<capacity_type> free_list_type;
+    class storage_deleter
+    {
+    public:
+	inline storage_deleter() : mapped_length_(0U), is_shared_(false) { }
+	inline storage_deleter(std::size_t mapped_length, bool is_shared) : mapped_length_(mapped_length), is_shared_(is_shared) { }
+	void operator()(std::uint8_t* storage) const;
+    private:
+	std::size_t mapped_length_;
+	bool is_shared_;
+    };
+    typedef std::unique_ptr<std::uint8_t[], storage_deleter> storage_type;
+    ///
+    /// Resets the node of the policy when the storage could not be bound to it
+    ///
+    static storage_type acquire_storage(storage_policy& policy, std::size_t region_size, std::size_t region_alignment);
+    ///
+    /// Heap storage small enough to share a page is only aligned as much as its values
+    /// need; everything else starts on a page or huge page boundary
+    ///
+    static std::size_t calc_region_alignment(const storage_policy& policy, std::size_t usable_size, std::size_t alignment);
+    static std::size_t calc_region_size(std::size_t usable_size, std::size_t region_alignment);
+    void register_region();
+    void deregister_region();
     block() = delete;
     block(block&&) = delete;
     block& operator=(block&&) = delete;
+    void* pop_stack();
+    void push_stack(capacity_type index);
+    std::size_t pop_stack_bulk(void** output, std::size_t quantity);
+    void push_stack_bulk(void** input, std::size_t quantity);
     std::size_t value_size_;
     std::size_t capacity_;
     std::size_t usable_size_;
-    std::unique_ptr<std::uint8_t[]> storage_;
+    std::size_t region_size_;
+    std::size_t region_alignment_;
+    storage_policy policy_;
+    storage_type storage_;
+    std::uint8_t* region_;
     std::uint8_t* base_;
     free_list_type free_list_;
+    free_list_mode mode_;
+    // index of the top of the stack in the low half, a tag that changes with every update in the high half
+    std::atomic<std::uint64_t> stack_top_;
+    block_list* list_;
+    friend class block_list;
 };
 
 typedef std::uint32_t capacity_type;
@@ -87,12 +190,14 @@ struct TURBO_SYMBOL_DECL block_config
     block_config(std::size_t size, capacity_type capacity);
     block_config(std::size_t size, capacity_type capacity, capacity_type contingency);
     block_config(std::size_t size, capacity_type capacity, capacity_type contingency, std::size_t growth);
+    block_config(std::size_t size, capacity_type capacity, capacity_type contingency, std::size_t growth, const storage_policy& policy);
     bool operator<(const block_config& other) const;
     bool operator==(const block_config& other) const;
     std::size_t block_size;
     capacity_type initial_capacity;
     capacity_type contingency_capacity;
     std::size_t growth_factor;
+    storage_policy storage;
 };
 
 class TURBO_SYMBOL_DECL block_list
@@ -170,6 +275,7 @@ public:
     block_list(std::size_t value_size, block::capacity_type initial);
     block_list(std::size_t value_size, block::capacity_type initial, block::capacity_type contingency);
     block_list(std::size_t value_size, block::capacity_type initial, block::capacity_type contingency, std::size_t growth_factor);
+    block_list(std::size_t value_size, block::capacity_type initial, block::capacity_type contingency, std::size_t growth_factor, const storage_policy& storage);
     block_list(const block_config& config); // allow implicit conversion
     block_list(const block_list& other);
     ~block_list() noexcept = default;
@@ -179,6 +285,7 @@ public:
     inline std::size_t get_growth_factor() const { return growth_factor_; }
     inline std::size_t get_contingency_capacity() const { return contingency_capacity_; }
     inline std::size_t get_list_size() const { return list_size_; }
+    inline const storage_policy& get_storage_policy() const { return storage_; }
     inline iterator begin() noexcept { return iterator(&first_); }
     inline iterator end() noexcept { return iterator(); }
     inline const_iterator cbegin() const noexcept { return const_iterator(&first_); }
@@ -187,11 +294,24 @@ public:
     std::unique_ptr<node> clone_node(const node& other) const;
     void* allocate();
     void free(void* pointer);
+    std::size_t allocate_bulk(void** output, std::size_t quantity);
+    void free_bulk(void** input, std::size_t quantity);
+    ///
+    /// Counts are only gathered when built with TURBO_MEMORY_STATISTICS defined
+    ///
+    bucket_statistics get_statistics() const;
+    ///
+    /// Releases the trailing blocks whose values are all free, except the first block.
+    /// Concurrent allocate and free calls are safe; nodes are only deleted once every
+    /// allocate or free that could still be looking at them has finished.
+    /// Returns the number of blocks released.
+    ///
+    std::size_t trim();
 private:
     class node
     {
     public:
-	node(std::size_t value_size, block::capacity_type capacity);
+	node(std::size_t value_size, block::capacity_type capacity, const storage_policy& storage);
 	node(const node& other);
 	~node() noexcept;
 	node& operator=(const node& other);
@@ -211,10 +331,15 @@ private:
     block_list() = delete;
     block_list(block_list&&) = delete;
     block_list& operator=(block_list&&) = delete;
+    void grow(iterator& last);
+    void splice(node* orphan);
     std::size_t value_size_;
     std::size_t growth_factor_;
     block::capacity_type contingency_capacity_;
     std::size_t list_size_;
+    storage_policy storage_;
+    list_statistics statistics_;
+    std::mutex trim_mutex_;
     node first_;
 };
 
@@ -0,0 +1,277 @@
+#include "epoch.hpp"
+#include "epoch.hh"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <turbo/toolset/extension.hpp>
+
+namespace turbo {
+namespace memory {
+
+namespace {
+
+std::atomic<std::uint64_t> next_domain_id(1U);
+
+///
+/// Domains are tracked by id so a thread exiting after a domain was destroyed
+/// does not touch the destroyed domain; both are leaked to stay valid during static destruction
+///
+std::mutex& live_domain_mutex()
+{
+    static std::mutex* mutex = new std::mutex();
+    return *mutex;
+}
+
+std::unordered_set<std::uint64_t>& live_domains()
+{
+    static std::unordered_set<std::uint64_t>* domains = new std::unordered_set<std::uint64_t>();
+    return *domains;
+}
+
+struct local_registration
+{
+    std::uint64_t id;
+    epoch_domain* domain;
+    epoch_domain::participant* record;
+};
+
+///
+/// The registration get_local found last on this thread, and whether this thread's
+/// registry has been destroyed. Both are trivially destructible and initial exec, so
+/// reading them never allocates or runs a constructor, which matters when the preload
+/// library allocates while an exiting thread's thread locals are being destroyed.
+///
+__attribute__((tls_model("initial-exec"))) thread_local local_registration cached_registration = {0U, nullptr, nullptr};
+__attribute__((tls_model("initial-exec"))) thread_local bool is_registry_destroyed = false;
+
+class local_registry
+{
+public:
+    local_registry() = default;
+    ~local_registry() noexcept
+    {
+	is_registry_destroyed = true;
+	cached_registration = local_registration{0U, nullptr, nullptr};
+	std::lock_guard<std::mutex> lock(live_domain_mutex());
+	for (auto&& registration : registrations)
+	{
+	    if (live_domains().count(registration.id) != 0U)
+	    {
+		registration.domain->unregister_thread(*registration.record);
+	    }
+	}
+    }
+    std::vector<local_registration> registrations;
+};
+
+thread_local local_registry local_registrations;
+
+} // anonymous namespace
+
+const std::uint64_t epoch_domain::participant::pinned_flag;
+
+const std::size_t epoch_domain::collect_threshold;
+
+epoch_domain::participant::participant(epoch_domain& domain)
+    :
+	domain_(domain),
+	state_(0U),
+	in_use_(true),
+	next_(nullptr),
+	nesting_(0U),
+	retired_count_(0U),
+	retire_lists_()
+{ }
+
+void epoch_domain::participant::retire(void* pointer, reclaim_function reclaimer, void* context)
+{
+    if (pointer == nullptr)
+    {
+	return;
+    }
+    // the pointer has already been unlinked, so only readers pinned at or before this epoch can hold it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::uint64_t epoch = domain_.epoch_.load(std::memory_order_acquire);
+    retire_list& list = retire_lists_[epoch % retire_lists_.size()];
+    if (list.epoch != epoch)
+    {
+	// everything in the slot is from at least 3 epochs ago
+	reclaim(list);
+	list.epoch = epoch;
+    }
+    list.nodes.push_back(retired{pointer, reclaimer, context});
+    ++retired_count_;
+    if (retired_count_ >= collect_threshold && !is_pinned())
+    {
+	collect();
+    }
+}
+
+std::size_t epoch_domain::participant::collect()
+{
+    if (!is_pinned())
+    {
+	domain_.try_advance();
+    }
+    const std::uint64_t epoch = domain_.epoch_.load(std::memory_order_acquire);
+    std::size_t count = 0U;
+    for (auto&& list : retire_lists_)
+    {
+	if (list.epoch + 2U <= epoch)
+	{
+	    count += reclaim(list);
+	}
+    }
+    return count;
+}
+
+std::size_t epoch_domain::participant::reclaim(retire_list& list)
+{
+    std::vector<retired> nodes;
+    nodes.swap(list.nodes);
+    for (auto&& node : nodes)
+    {
+	node.reclaim(node.context, node.pointer);
+    }
+    retired_count_ -= nodes.size();
+    return nodes.size();
+}
+
+std::size_t epoch_domain::participant::reclaim_all()
+{
+    std::size_t count = 0U;
+    for (auto&& list : retire_lists_)
+    {
+	count += reclaim(list);
+    }
+    return count;
+}
+
+epoch_domain::epoch_domain()
+    :
+	id_(next_domain_id.fetch_add(1U, std::memory_order_relaxed)),
+	epoch_(0U),
+	participants_(nullptr)
+{
+    std::lock_guard<std::mutex> lock(live_domain_mutex());
+    live_domains().insert(id_);
+}
+
+epoch_domain::~epoch_domain() noexcept
+{
+    {
+	std::lock_guard<std::mutex> lock(live_domain_mutex());
+	live_domains().erase(id_);
+    }
+    participant* record = participants_.load(std::memory_order_acquire);
+    while (record != nullptr)
+    {
+	participant* next = record->next_;
+	record->reclaim_all();
+	delete record;
+	record = next;
+    }
+}
+
+epoch_domain::participant& epoch_domain::register_thread()
+{
+    for (participant* record = participants_.load(std::memory_order_acquire); record != nullptr; record = record->next_)
+    {
+	bool expected = false;
+	if (!record->in_use_.load(std::memory_order_relaxed)
+		&& record->in_use_.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed))
+	{
+	    return *record;
+	}
+    }
+    participant* record = new participant(*this);
+    participant* head = participants_.load(std::memory_order_acquire);
+    do
+    {
+	record->next_ = head;
+    }
+    while (!participants_.compare_exchange_weak(head, record, std::memory_order_acq_rel, std::memory_order_acquire));
+    return *record;
+}
+
+void epoch_domain::unregister_thread(participant& record)
+{
+    if (record.is_pinned())
+    {
+	throw std::invalid_argument("epoch_domain::unregister_thread - participant is still pinned");
+    }
+    // whatever cannot be reclaimed yet stays with the record until it is reused or the domain is destroyed
+    record.collect();
+    record.in_use_.store(false, std::memory_order_release);
+}
+
+epoch_domain::participant& epoch_domain::get_local()
+{
+    if (TURBO_LIKELY(cached_registration.id == id_))
+    {
+	return *cached_registration.record;
+    }
+    if (TURBO_UNLIKELY(is_registry_destroyed))
+    {
+	// nothing is left to unregister this record, so it stays in use for good
+	participant& record = register_thread();
+	cached_registration = local_registration{id_, this, &record};
+	return record;
+    }
+    std::vector<local_registration>& registrations = local_registrations.registrations;
+    for (auto&& registration : registrations)
+    {
+	if (registration.id == id_)
+	{
+	    cached_registration = registration;
+	    return *registration.record;
+	}
+    }
+    participant& record = register_thread();
+    // an id is never reused, so registrations of destroyed domains can be safely dropped
+    {
+	std::lock_guard<std::mutex> lock(live_domain_mutex());
+	registrations.erase(std::remove_if(registrations.begin(), registrations.end(), [] (const local_registration& registration) -> bool
+	{
+	    return live_domains().count(registration.id) == 0U;
+	}), registrations.end());
+    }
+    registrations.push_back(local_registration{id_, this, &record});
+    cached_registration = registrations.back();
+    return record;
+}
+
+void epoch_domain::synchronize()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::uint64_t target = epoch_.load(std::memory_order_acquire) + 2U;
+    while (epoch_.load(std::memory_order_acquire) < target)
+    {
+	if (!try_advance())
+	{
+	    std::this_thread::yield();
+	}
+    }
+}
+
+bool epoch_domain::try_advance()
+{
+    std::uint64_t epoch = epoch_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (participant* record = participants_.load(std::memory_order_acquire); record != nullptr; record = record->next_)
+    {
+	const std::uint64_t state = record->state_.load(std::memory_order_acquire);
+	if ((state & participant::pinned_flag) != 0U && (state >> 1U) != epoch)
+	{
+	    return false;
+	}
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return epoch_.compare_exchange_strong(epoch, epoch + 1U, std::memory_order_acq_rel, std::memory_order_acquire);
+}
+
+} // namespace memory
+} // namespace turbo
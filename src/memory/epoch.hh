@@ -0,0 +1,72 @@
+#ifndef TURBO_MEMORY_EPOCH_HXX
+#define TURBO_MEMORY_EPOCH_HXX
+
+#include <turbo/memory/epoch.hpp>
+
+namespace turbo {
+namespace memory {
+
+namespace epoch_reclaim {
+
+template <class value_t>
+void delete_value(void*, void* pointer)
+{
+    delete static_cast<value_t*>(pointer);
+}
+
+template <class allocator_t, class value_t>
+void deallocate_value(void* context, void* pointer)
+{
+    value_t* value = static_cast<value_t*>(pointer);
+    value->~value_t();
+    static_cast<allocator_t*>(context)->deallocate(value);
+}
+
+} // namespace epoch_reclaim
+
+epoch_domain::guard::guard(participant& owner)
+    :
+	owner_(owner)
+{
+    owner_.pin();
+}
+
+epoch_domain::guard::~guard() noexcept
+{
+    owner_.unpin();
+}
+
+void epoch_domain::participant::pin()
+{
+    if (nesting_++ == 0U)
+    {
+	state_.store((domain_.epoch_.load(std::memory_order_relaxed) << 1U) | pinned_flag, std::memory_order_relaxed);
+	// pairs with the fence in try_advance: either the advance sees this pin or this reader sees every unlink made before it
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+void epoch_domain::participant::unpin()
+{
+    if (--nesting_ == 0U)
+    {
+	state_.store(state_.load(std::memory_order_relaxed) & ~pinned_flag, std::memory_order_release);
+    }
+}
+
+template <class value_t>
+void epoch_domain::participant::retire(value_t* pointer)
+{
+    retire(pointer, &epoch_reclaim::delete_value<value_t>, nullptr);
+}
+
+template <class allocator_t, class value_t>
+void epoch_domain::participant::retire(allocator_t& allocator, value_t* pointer)
+{
+    retire(pointer, &epoch_reclaim::deallocate_value<allocator_t, value_t>, &allocator);
+}
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef TURBO_MEMORY_EPOCH_HPP
+#define TURBO_MEMORY_EPOCH_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <atomic>
+#include <vector>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace memory {
+
+///
+/// Epoch based reclamation. Threads register as participants of a domain and pin
+/// themselves while they read shared nodes; a node that has been unlinked is retired
+/// rather than freed, and is only reclaimed once every participant that could still
+/// hold it has unpinned. The global epoch only advances when every pinned participant
+/// has observed the current epoch, so anything retired in epoch E is safe to reclaim
+/// once the global epoch reaches E + 2.
+///
+/// Retired nodes are kept per participant and reclaimed in batches, either by the
+/// participant's own collect calls or when the domain is destroyed.
+///
+class TURBO_SYMBOL_DECL epoch_domain
+{
+public:
+    typedef void (*reclaim_function)(void* context, void* pointer);
+    class participant;
+    ///
+    /// Pins a participant for the lifetime of the guard
+    ///
+    class TURBO_SYMBOL_DECL guard
+    {
+    public:
+	explicit inline guard(participant& owner);
+	inline ~guard() noexcept;
+    private:
+	guard() = delete;
+	guard(const guard&) = delete;
+	guard(guard&&) = delete;
+	guard& operator=(const guard&) = delete;
+	guard& operator=(guard&&) = delete;
+	participant& owner_;
+    };
+    ///
+    /// The per thread record of a domain; it must only be used by the thread that registered it
+    ///
+    class TURBO_SYMBOL_DECL participant
+    {
+    public:
+	inline void pin();
+	inline void unpin();
+	inline bool is_pinned() const { return nesting_ != 0U; }
+	inline std::size_t get_retired_count() const { return retired_count_; }
+	void retire(void* pointer, reclaim_function reclaimer, void* context);
+	///
+	/// Retires a node that was made with new
+	///
+	template <class value_t>
+	inline void retire(value_t* pointer);
+	///
+	/// Retires a node that was allocated from a turbo allocator; it is destroyed and
+	/// returned with the allocator's deallocate when it is reclaimed
+	///
+	template <class allocator_t, class value_t>
+	inline void retire(allocator_t& allocator, value_t* pointer);
+	///
+	/// Tries to advance the epoch and reclaims everything retired by this participant that
+	/// is now safe; returns how many nodes were reclaimed
+	///
+	std::size_t collect();
+	friend class epoch_domain;
+    private:
+	struct retired
+	{
+	    void* pointer;
+	    reclaim_function reclaim;
+	    void* context;
+	};
+	struct retire_list
+	{
+	    std::uint64_t epoch;
+	    std::vector<retired> nodes;
+	};
+	static const std::uint64_t pinned_flag = 1U;
+	explicit participant(epoch_domain& domain);
+	participant() = delete;
+	participant(const participant&) = delete;
+	participant(participant&&) = delete;
+	participant& operator=(const participant&) = delete;
+	participant& operator=(participant&&) = delete;
+	std::size_t reclaim(retire_list& list);
+	std::size_t reclaim_all();
+	epoch_domain& domain_;
+	std::atomic<std::uint64_t> state_;
+	std::atomic<bool> in_use_;
+	participant* next_;
+	std::uint32_t nesting_;
+	std::size_t retired_count_;
+	std::array<retire_list, 3U> retire_lists_;
+    };
+    static const std::size_t collect_threshold = 64U;
+    epoch_domain();
+    ///
+    /// Reclaims everything still retired; no participant may be pinned
+    ///
+    ~epoch_domain() noexcept;
+    inline std::uint64_t get_epoch() const { return epoch_.load(std::memory_order_acquire); }
+    participant& register_thread();
+    void unregister_thread(participant& record);
+    ///
+    /// The calling thread's participant, registered on first use and unregistered
+    /// when the thread exits. Repeated calls for the same domain are a thread local
+    /// load and compare.
+    ///
+    participant& get_local();
+    ///
+    /// Blocks until every participant that was pinned when this was called has unpinned;
+    /// nodes unlinked before the call can then be freed directly. The calling thread
+    /// must not be pinned in this domain.
+    ///
+    void synchronize();
+private:
+    epoch_domain(const epoch_domain&) = delete;
+    epoch_domain(epoch_domain&&) = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+    epoch_domain& operator=(epoch_domain&&) = delete;
+    bool try_advance();
+    std::uint64_t id_;
+    std::atomic<std::uint64_t> epoch_;
+    std::atomic<participant*> participants_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+#endif
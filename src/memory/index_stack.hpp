@@ -0,0 +1,80 @@
+#ifndef TURBO_MEMORY_INDEX_STACK_HPP
+#define TURBO_MEMORY_INDEX_STACK_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <limits>
+
+namespace turbo {
+namespace memory {
+
+///
+/// The lock free stack of value indices that block::free_list_mode::index_stack and
+/// shared_sized_slab thread through their free values. The top is a single 64 bit word
+/// holding the index of the top value in the low half and a tag that changes with
+/// every update in the high half, against ABA. While a value is free its first bytes
+/// hold the index of the next free value.
+///
+/// Only for the translation units of this library, so it is not published.
+///
+namespace index_stack {
+
+typedef std::uint32_t index_type;
+
+const index_type empty_index = std::numeric_limits<index_type>::max();
+
+inline std::uint64_t pack_top(index_type tag, index_type index)
+{
+    return (static_cast<std::uint64_t>(tag) << 32U) | index;
+}
+
+inline index_type top_index(std::uint64_t top)
+{
+    return static_cast<index_type>(top);
+}
+
+inline index_type top_tag(std::uint64_t top)
+{
+    return static_cast<index_type>(top >> 32U);
+}
+
+inline std::atomic<index_type>& next_link(std::uint8_t* values, std::size_t value_size, index_type index)
+{
+    return *reinterpret_cast<std::atomic<index_type>*>(&(values[index * value_size]));
+}
+
+///
+/// One attempt at taking the top value; false if another thread changed the top first.
+/// On success index is the value taken, or empty_index if the stack was empty.
+///
+inline bool try_pop(std::atomic<std::uint64_t>& top, std::uint8_t* values, std::size_t value_size, index_type& index)
+{
+    std::uint64_t expected = top.load(std::memory_order_acquire);
+    index = top_index(expected);
+    if (index == empty_index)
+    {
+	return true;
+    }
+    // the link is stale if another thread won the top in the meantime, but then the tag differs and the exchange fails
+    const index_type next = next_link(values, value_size, index).load(std::memory_order_relaxed);
+    return top.compare_exchange_strong(expected, pack_top(top_tag(expected) + 1U, next), std::memory_order_acq_rel);
+}
+
+///
+/// One attempt at pushing a chain of values that the caller owns and has already
+/// linked from first to last; false if another thread changed the top first
+///
+inline bool try_push(std::atomic<std::uint64_t>& top, std::uint8_t* values, std::size_t value_size, index_type first, index_type last)
+{
+    std::uint64_t expected = top.load(std::memory_order_acquire);
+    next_link(values, value_size, last).store(top_index(expected), std::memory_order_relaxed);
+    return top.compare_exchange_strong(expected, pack_top(top_tag(expected) + 1U, first), std::memory_order_acq_rel);
+}
+
+} // namespace index_stack
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,223 @@
+#include "large_object.hpp"
+#include <algorithm>
+#include <limits>
+#include <sys/mman.h>
+#include <turbo/toolset/extension.hpp>
+
+namespace turbo {
+namespace memory {
+
+const std::size_t large_object_tier::page_size;
+
+large_object_config::large_object_config()
+    :
+	large_object_config(static_cast<std::size_t>(64U) << 20U, std::chrono::seconds(1))
+{ }
+
+large_object_config::large_object_config(std::size_t chunk, duration delay)
+    :
+	chunk_size(chunk),
+	release_delay(delay)
+{ }
+
+bool large_object_config::operator==(const large_object_config& other) const
+{
+    return chunk_size == other.chunk_size && release_delay == other.release_delay;
+}
+
+large_object_tier::large_object_tier(const large_object_config& config)
+    :
+	config_(config),
+	mutex_(),
+	chunks_(),
+	mapped_size_(0U),
+	free_spans_(),
+	size_index_(),
+	used_spans_(),
+	idle_queue_()
+{ }
+
+large_object_tier::~large_object_tier() noexcept
+{
+    for (auto&& chunk : chunks_)
+    {
+	::munmap(chunk.first, chunk.second);
+    }
+}
+
+void* large_object_tier::allocate(std::size_t size)
+{
+    if (TURBO_UNLIKELY(size == 0U || size > std::numeric_limits<std::size_t>::max() - page_size))
+    {
+	return nullptr;
+    }
+    const std::size_t pages = calc_pages(size);
+    std::lock_guard<std::mutex> lock(mutex_);
+    release_idle(clock_type::now());
+    auto fit = size_index_.lower_bound(pages);
+    if (fit == size_index_.end())
+    {
+	if (!map_chunk(pages))
+	{
+	    return nullptr;
+	}
+	fit = size_index_.lower_bound(pages);
+    }
+    const std::uintptr_t address = fit->second;
+    auto iter = free_spans_.find(address);
+    const span best = iter->second;
+    erase_free(iter);
+    if (best.pages > pages)
+    {
+	// the tail keeps its history, so it is still released on the original schedule
+	const std::uintptr_t tail = address + pages * page_size;
+	free_spans_.emplace(tail, span { best.pages - pages, best.freed_at, best.released });
+	size_index_.emplace(best.pages - pages, tail);
+	if (!best.released)
+	{
+	    idle_queue_.emplace_back(best.freed_at, tail);
+	}
+    }
+    used_spans_.emplace(address, pages);
+    return reinterpret_cast<void*>(address);
+}
+
+void large_object_tier::deallocate(void* pointer)
+{
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pointer);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = used_spans_.find(address);
+    if (iter == used_spans_.end())
+    {
+	return;
+    }
+    const clock_type::time_point now = clock_type::now();
+    insert_free(address, span { iter->second, now, false });
+    used_spans_.erase(iter);
+    release_idle(now);
+}
+
+bool large_object_tier::owns(const void* pointer) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return used_spans_.find(reinterpret_cast<std::uintptr_t>(pointer)) != used_spans_.cend();
+}
+
+std::size_t large_object_tier::usable_size(const void* pointer) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = used_spans_.find(reinterpret_cast<std::uintptr_t>(pointer));
+    return iter == used_spans_.cend() ? 0U : iter->second * page_size;
+}
+
+void large_object_tier::release_idle()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    release_idle(clock_type::now());
+}
+
+std::size_t large_object_tier::get_mapped_size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return mapped_size_;
+}
+
+std::size_t large_object_tier::get_cached_pages() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t pages = 0U;
+    for (auto&& free_span : free_spans_)
+    {
+	pages += free_span.second.pages;
+    }
+    return pages;
+}
+
+std::size_t large_object_tier::get_released_pages() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t pages = 0U;
+    for (auto&& free_span : free_spans_)
+    {
+	pages += free_span.second.released ? free_span.second.pages : 0U;
+    }
+    return pages;
+}
+
+void large_object_tier::insert_free(std::uintptr_t address, span free_span)
+{
+    auto next = free_spans_.find(address + free_span.pages * page_size);
+    if (next != free_spans_.end())
+    {
+	free_span.pages += next->second.pages;
+	free_span.freed_at = std::max(free_span.freed_at, next->second.freed_at);
+	free_span.released = free_span.released && next->second.released;
+	erase_free(next);
+    }
+    auto previous = free_spans_.lower_bound(address);
+    if (previous != free_spans_.begin())
+    {
+	--previous;
+	if (previous->first + previous->second.pages * page_size == address)
+	{
+	    address = previous->first;
+	    free_span.pages += previous->second.pages;
+	    free_span.freed_at = std::max(free_span.freed_at, previous->second.freed_at);
+	    free_span.released = free_span.released && previous->second.released;
+	    erase_free(previous);
+	}
+    }
+    free_spans_.emplace(address, free_span);
+    size_index_.emplace(free_span.pages, address);
+    if (!free_span.released)
+    {
+	idle_queue_.emplace_back(free_span.freed_at, address);
+    }
+}
+
+void large_object_tier::erase_free(free_map_type::iterator iter)
+{
+    auto range = size_index_.equal_range(iter->second.pages);
+    for (auto entry = range.first; entry != range.second; ++entry)
+    {
+	if (entry->second == iter->first)
+	{
+	    size_index_.erase(entry);
+	    break;
+	}
+    }
+    free_spans_.erase(iter);
+}
+
+bool large_object_tier::map_chunk(std::size_t pages)
+{
+    const std::size_t length = std::max(calc_pages(config_.chunk_size), pages) * page_size;
+    void* chunk = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (TURBO_UNLIKELY(chunk == MAP_FAILED))
+    {
+	return false;
+    }
+    chunks_.emplace_back(chunk, length);
+    mapped_size_ += length;
+    // nothing has been faulted in yet, so a fresh chunk counts as released
+    insert_free(reinterpret_cast<std::uintptr_t>(chunk), span { length / page_size, clock_type::now(), true });
+    return true;
+}
+
+void large_object_tier::release_idle(clock_type::time_point now)
+{
+    while (!idle_queue_.empty() && now - idle_queue_.front().first >= config_.release_delay)
+    {
+	auto iter = free_spans_.find(idle_queue_.front().second);
+	// skip entries for spans that have been reused or merged since
+	if (iter != free_spans_.end() && !iter->second.released && iter->second.freed_at == idle_queue_.front().first)
+	{
+	    ::madvise(reinterpret_cast<void*>(iter->first), iter->second.pages * page_size, MADV_DONTNEED);
+	    iter->second.released = true;
+	}
+	idle_queue_.pop_front();
+    }
+}
+
+} // namespace memory
+} // namespace turbo
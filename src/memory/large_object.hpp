@@ -0,0 +1,119 @@
+#ifndef TURBO_MEMORY_LARGE_OBJECT_HPP
+#define TURBO_MEMORY_LARGE_OBJECT_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace memory {
+
+struct TURBO_SYMBOL_DECL large_object_config
+{
+    typedef std::chrono::steady_clock::duration duration;
+    large_object_config();
+    large_object_config(std::size_t chunk, duration delay);
+    bool operator==(const large_object_config& other) const;
+    inline bool operator!=(const large_object_config& other) const { return !(*this == other); }
+    ///
+    /// How much address space is mapped at a time; larger requests get a chunk of their own
+    ///
+    std::size_t chunk_size;
+    ///
+    /// How long a free span stays resident before its pages are given back to the OS
+    ///
+    duration release_delay;
+};
+
+///
+/// Serves requests too big for any slab bucket as whole pages carved out of mapped
+/// chunks. Freed spans are cached and merged with free neighbours, and a request
+/// takes the smallest cached span that fits. Spans that stay free for longer than the
+/// release delay have their pages returned with MADV_DONTNEED; the address space is
+/// kept, so reusing them only costs the page faults. Idle spans are only checked
+/// during allocate, deallocate and release_idle calls.
+///
+/// Chunks are only unmapped when the tier is destroyed.
+///
+class TURBO_SYMBOL_DECL large_object_tier
+{
+public:
+    typedef std::chrono::steady_clock clock_type;
+    static const std::size_t page_size = 4096U;
+    explicit large_object_tier(const large_object_config& config);
+    ~large_object_tier() noexcept;
+    inline const large_object_config& get_config() const { return config_; }
+    ///
+    /// Returns page aligned storage for size bytes, rounded up to whole pages, or
+    /// nullptr if size is 0 or no more address space can be mapped
+    ///
+    void* allocate(std::size_t size);
+    ///
+    /// Ignores addresses that were not returned by allocate
+    ///
+    void deallocate(void* pointer);
+    bool owns(const void* pointer) const;
+    ///
+    /// The rounded up size of an allocation, or 0 if the tier does not own the address
+    ///
+    std::size_t usable_size(const void* pointer) const;
+    ///
+    /// Returns the pages of every span that has been free for longer than the release delay
+    ///
+    void release_idle();
+    std::size_t get_mapped_size() const;
+    ///
+    /// Pages held in free spans, including released ones
+    ///
+    std::size_t get_cached_pages() const;
+    std::size_t get_released_pages() const;
+private:
+    struct span
+    {
+	std::size_t pages;
+	clock_type::time_point freed_at;
+	bool released;
+    };
+    typedef std::map<std::uintptr_t, span> free_map_type;
+    typedef std::multimap<std::size_t, std::uintptr_t> size_index_type;
+    large_object_tier() = delete;
+    large_object_tier(const large_object_tier&) = delete;
+    large_object_tier(large_object_tier&&) = delete;
+    large_object_tier& operator=(const large_object_tier&) = delete;
+    large_object_tier& operator=(large_object_tier&&) = delete;
+    static inline std::size_t calc_pages(std::size_t size)
+    {
+	return (size + page_size - 1U) / page_size;
+    }
+    ///
+    /// Caches a free span, merging it with any free neighbours
+    ///
+    void insert_free(std::uintptr_t address, span free_span);
+    void erase_free(free_map_type::iterator iter);
+    bool map_chunk(std::size_t pages);
+    void release_idle(clock_type::time_point now);
+    large_object_config config_;
+    mutable std::mutex mutex_;
+    std::vector<std::pair<void*, std::size_t>> chunks_;
+    std::size_t mapped_size_;
+    free_map_type free_spans_;
+    size_index_type size_index_;
+    std::unordered_map<std::uintptr_t, std::size_t> used_spans_;
+    ///
+    /// Free spans in the order they were freed; entries for spans that have since
+    /// been reused or merged are skipped when they reach the front
+    ///
+    std::deque<std::pair<clock_type::time_point, std::uintptr_t>> idle_queue_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,83 @@
+#include "magazine_cache.hpp"
+#include "magazine_cache.hh"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <turbo/memory/block.hh>
+#include <turbo/memory/slab_allocator.hh>
+
+namespace turbo {
+namespace memory {
+
+magazine_cache::magazine::magazine(capacity_type depth)
+    :
+	depth_(depth),
+	count_(0U),
+	rounds_(new void*[depth])
+{ }
+
+magazine_cache::magazine::magazine(magazine&& other)
+    :
+	depth_(other.depth_),
+	count_(other.count_),
+	rounds_(std::move(other.rounds_))
+{
+    other.count_ = 0U;
+}
+
+magazine_cache::magazine_cache(concurrent_sized_slab& slab, capacity_type depth)
+    :
+	slab_(slab),
+	depth_(depth),
+	magazine_map_()
+{
+    if (depth_ == 0U)
+    {
+	throw std::invalid_argument("magazine_cache - the depth argument cannot be 0");
+    }
+    magazine_map_.reserve(slab_.block_map_.size());
+    for (std::size_t bucket = 0U; bucket < slab_.block_map_.size(); ++bucket)
+    {
+	magazine_map_.emplace_back(depth_);
+    }
+}
+
+magazine_cache::~magazine_cache() noexcept
+{
+    try
+    {
+	flush();
+    }
+    catch (...)
+    {
+	// Do nothing
+    }
+}
+
+void magazine_cache::flush()
+{
+    for (std::size_t bucket = 0U; bucket < magazine_map_.size(); ++bucket)
+    {
+	drain(bucket, magazine_map_[bucket].get_count());
+    }
+}
+
+void magazine_cache::refill(std::size_t bucket)
+{
+    magazine& local = magazine_map_[bucket];
+    block_list& list = slab_.block_map_[bucket];
+    const capacity_type target = std::min<capacity_type>((depth_ + 1U) / 2U, depth_ - local.get_count());
+    local.load(static_cast<capacity_type>(list.allocate_bulk(local.get_top(), target)));
+}
+
+void magazine_cache::drain(std::size_t bucket, capacity_type quantity)
+{
+    magazine& local = magazine_map_[bucket];
+    block_list& list = slab_.block_map_[bucket];
+    const capacity_type target = std::min<capacity_type>(quantity, local.get_count());
+    local.unload(target);
+    list.free_bulk(local.get_top(), target);
+}
+
+} // namespace memory
+} // namespace turbo
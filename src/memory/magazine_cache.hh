@@ -0,0 +1,67 @@
+#ifndef TURBO_MEMORY_MAGAZINE_CACHE_HXX
+#define TURBO_MEMORY_MAGAZINE_CACHE_HXX
+
+#include <turbo/memory/magazine_cache.hpp>
+#include <turbo/memory/alignment.hpp>
+#include <turbo/memory/alignment.hh>
+#include <turbo/memory/allocation_trace.hh>
+#include <turbo/memory/slab_allocator.hh>
+#include <turbo/toolset/extension.hpp>
+
+namespace turbo {
+namespace memory {
+
+void* magazine_cache::allocate(std::size_t value_size, std::size_t value_alignment, capacity_type quantity)
+{
+    const std::size_t total_size = calc_total_aligned_size(value_size, value_alignment, quantity);
+    const std::size_t bucket = slab_.find_block_bucket(total_size);
+    if (TURBO_UNLIKELY(value_size == 0U || quantity == 0U))
+    {
+	return nullptr;
+    }
+    else if (TURBO_UNLIKELY(magazine_map_.size() <= bucket))
+    {
+	// beyond the buckets, so it is up to the slab's large object tier
+	return slab_.allocate(value_size, value_alignment, quantity, nullptr);
+    }
+    magazine& local = magazine_map_[bucket];
+    if (TURBO_UNLIKELY(local.is_empty()))
+    {
+	refill(bucket);
+	if (local.is_empty())
+	{
+	    return nullptr;
+	}
+    }
+    void* result = local.pop();
+    trace_allocate(total_size, result);
+    return result;
+}
+
+void magazine_cache::deallocate(std::size_t value_size, std::size_t value_alignment, void* pointer, capacity_type quantity)
+{
+    const std::size_t total_size = calc_total_aligned_size(value_size, value_alignment, quantity);
+    const std::size_t bucket = slab_.find_block_bucket(total_size);
+    if (TURBO_UNLIKELY(pointer == nullptr))
+    {
+	return;
+    }
+    else if (TURBO_UNLIKELY(magazine_map_.size() <= bucket))
+    {
+	slab_.deallocate(value_size, value_alignment, pointer, quantity);
+	return;
+    }
+    // recorded before the slot is cached, so its next allocation is always recorded after
+    trace_free(total_size, pointer);
+    magazine& local = magazine_map_[bucket];
+    if (TURBO_UNLIKELY(local.is_full()))
+    {
+	drain(bucket, (depth_ + 1U) / 2U);
+    }
+    local.push(pointer);
+}
+
+} // namespace memory
+} // namespace turbo
+
+#endif
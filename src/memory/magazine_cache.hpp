@@ -0,0 +1,108 @@
+#ifndef TURBO_MEMORY_MAGAZINE_CACHE_HPP
+#define TURBO_MEMORY_MAGAZINE_CACHE_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <turbo/memory/block.hpp>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace memory {
+
+class TURBO_SYMBOL_DECL magazine_cache_tester;
+
+///
+/// An opt-in cache that sits in front of a concurrent_sized_slab and is owned by a single thread.
+/// Every size bucket of the slab gets a bounded magazine of free slots; allocate and deallocate
+/// only touch the magazine, which is refilled from and flushed back to the slab in batches of
+/// half its depth. Any slots still held are returned to the slab on destruction.
+///
+/// Every hit is traced like an allocation or free from the slab itself. Sizes beyond the
+/// largest bucket go straight to the slab, and so to its large object tier if it has one.
+/// The slab's per bucket statistics count the batches that move between it and the
+/// magazines, not the individual hits.
+///
+/// A magazine_cache is not thread safe; create one per thread that uses the slab.
+///
+class TURBO_SYMBOL_DECL magazine_cache
+{
+public:
+    magazine_cache(concurrent_sized_slab& slab, capacity_type depth);
+    ~magazine_cache() noexcept;
+    inline capacity_type get_depth() const { return depth_; }
+    inline concurrent_sized_slab& get_slab() { return slab_; }
+    template <class value_t>
+    inline value_t* allocate(capacity_type quantity)
+    {
+	return static_cast<value_t*>(allocate(sizeof(value_t), alignof(value_t), quantity));
+    }
+    template <class value_t>
+    inline value_t* allocate()
+    {
+	return allocate<value_t>(1U);
+    }
+    template <class value_t>
+    inline void deallocate(value_t* pointer, capacity_type quantity)
+    {
+	deallocate(sizeof(value_t), alignof(value_t), pointer, quantity);
+    }
+    template <class value_t>
+    inline void deallocate(value_t* pointer)
+    {
+	deallocate(pointer, 1U);
+    }
+    inline void* malloc(std::size_t size)
+    {
+	return allocate(size, size, 1U);
+    }
+    inline void free(void* ptr, std::size_t size)
+    {
+	deallocate(size, size, ptr, 1U);
+    }
+    void flush();
+    friend class magazine_cache_tester;
+private:
+    class magazine
+    {
+    public:
+	explicit magazine(capacity_type depth);
+	magazine(magazine&& other);
+	~magazine() = default;
+	inline bool is_empty() const { return count_ == 0U; }
+	inline bool is_full() const { return count_ == depth_; }
+	inline capacity_type get_count() const { return count_; }
+	inline void* pop() { return rounds_[--count_]; }
+	inline void push(void* pointer) { rounds_[count_++] = pointer; }
+	inline void** get_top() { return &(rounds_[count_]); }
+	inline void load(capacity_type quantity) { count_ += quantity; }
+	inline void unload(capacity_type quantity) { count_ -= quantity; }
+    private:
+	magazine() = delete;
+	magazine(const magazine&) = delete;
+	magazine& operator=(const magazine&) = delete;
+	magazine& operator=(magazine&&) = delete;
+	capacity_type depth_;
+	capacity_type count_;
+	std::unique_ptr<void*[]> rounds_;
+    };
+    magazine_cache() = delete;
+    magazine_cache(const magazine_cache&) = delete;
+    magazine_cache(magazine_cache&&) = delete;
+    magazine_cache& operator=(const magazine_cache&) = delete;
+    magazine_cache& operator=(magazine_cache&&) = delete;
+    inline void* allocate(std::size_t value_size, std::size_t value_alignment, capacity_type quantity);
+    inline void deallocate(std::size_t value_size, std::size_t value_alignment, void* pointer, capacity_type quantity);
+    void refill(std::size_t bucket);
+    void drain(std::size_t bucket, capacity_type quantity);
+    concurrent_sized_slab& slab_;
+    capacity_type depth_;
+    std::vector<magazine> magazine_map_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,120 @@
+#include "numa_slab.hpp"
+#include "numa_slab.hh"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <turbo/memory/block.hh>
+
+namespace turbo {
+namespace memory {
+
+namespace {
+
+///
+/// Parses the kernel's list format, e.g. "0-3,8,10-11"
+///
+std::vector<std::size_t> parse_index_list(const std::string& text)
+{
+    std::vector<std::size_t> result;
+    std::istringstream input(text);
+    std::string range;
+    while (std::getline(input, range, ','))
+    {
+	if (range.empty() || range == "\n")
+	{
+	    continue;
+	}
+	const std::size_t separator = range.find('-');
+	const std::size_t first = std::strtoul(range.c_str(), nullptr, 10);
+	const std::size_t last = separator == std::string::npos ? first : std::strtoul(range.c_str() + separator + 1U, nullptr, 10);
+	for (std::size_t index = first; index <= last; ++index)
+	{
+	    result.push_back(index);
+	}
+    }
+    return result;
+}
+
+std::vector<std::size_t> read_index_list(const std::string& path)
+{
+    std::ifstream file(path);
+    std::string text;
+    if (file && std::getline(file, text))
+    {
+	return parse_index_list(text);
+    }
+    return std::vector<std::size_t>();
+}
+
+const std::string node_path("/sys/devices/system/node/");
+
+} // anonymous namespace
+
+numa_sized_slab::numa_sized_slab(block::capacity_type contingency_capacity, const std::vector<block_config>& config)
+    :
+	numa_sized_slab(contingency_capacity, config, detect_nodes())
+{ }
+
+numa_sized_slab::numa_sized_slab(block::capacity_type contingency_capacity, const std::vector<block_config>& config, const std::vector<int>& nodes)
+    :
+	slab_map_(),
+	node_ids_(nodes),
+	cpu_node_map_()
+{
+    if (nodes.empty())
+    {
+	throw std::invalid_argument("numa_sized_slab - the nodes argument cannot be empty");
+    }
+    if (std::any_of(nodes.cbegin(), nodes.cend(), [] (int node) -> bool { return node < 0; }))
+    {
+	throw std::invalid_argument("numa_sized_slab - the nodes argument cannot contain negative node IDs");
+    }
+    slab_map_.reserve(nodes.size());
+    if (nodes.size() == 1U)
+    {
+	slab_map_.emplace_back(new concurrent_sized_slab(contingency_capacity, config));
+	return;
+    }
+    for (std::size_t index = 0U; index < nodes.size(); ++index)
+    {
+	const int node = nodes[index];
+	std::vector<block_config> node_config(config);
+	for (auto&& entry : node_config)
+	{
+	    // heap storage cannot be bound to a node
+	    if (entry.storage.source == storage_policy::backing::heap)
+	    {
+		entry.storage.source = storage_policy::backing::mapped;
+	    }
+	    entry.storage.node = node;
+	}
+	slab_map_.emplace_back(new concurrent_sized_slab(contingency_capacity, node_config));
+	for (std::size_t cpu : read_index_list(node_path + "node" + std::to_string(node) + "/cpulist"))
+	{
+	    if (cpu_node_map_.size() <= cpu)
+	    {
+		cpu_node_map_.resize(cpu + 1U, 0U);
+	    }
+	    cpu_node_map_[cpu] = index;
+	}
+    }
+}
+
+std::vector<int> numa_sized_slab::detect_nodes()
+{
+    const std::vector<std::size_t> online(read_index_list(node_path + "online"));
+    if (online.empty())
+    {
+	return std::vector<int>(1U, 0);
+    }
+    return std::vector<int>(online.cbegin(), online.cend());
+}
+
+std::size_t numa_sized_slab::detect_node_count()
+{
+    return detect_nodes().size();
+}
+
+} // namespace memory
+} // namespace turbo
@@ -0,0 +1,25 @@
+#ifndef TURBO_MEMORY_NUMA_SLAB_HXX
+#define TURBO_MEMORY_NUMA_SLAB_HXX
+
+#include <turbo/memory/numa_slab.hpp>
+#include <sched.h>
+#include <turbo/memory/slab_allocator.hh>
+#include <turbo/toolset/extension.hpp>
+
+namespace turbo {
+namespace memory {
+
+std::size_t numa_sized_slab::find_current_node() const
+{
+    const int cpu = ::sched_getcpu();
+    if (TURBO_UNLIKELY(cpu < 0 || cpu_node_map_.size() <= static_cast<std::size_t>(cpu)))
+    {
+	return 0U;
+    }
+    return cpu_node_map_[cpu];
+}
+
+} // namespace memory
+} // namespace turbo
+
+#endif
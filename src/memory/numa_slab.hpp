@@ -0,0 +1,92 @@
+#ifndef TURBO_MEMORY_NUMA_SLAB_HPP
+#define TURBO_MEMORY_NUMA_SLAB_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include <turbo/memory/block.hpp>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace memory {
+
+///
+/// Keeps a concurrent_sized_slab per NUMA node with storage bound to that node, and
+/// serves every allocation from the slab of the node the calling thread is running on.
+/// Deallocation always returns memory to the block that owns it, so values freed on
+/// another node go back to their home node.
+///
+/// Slabs are only built for the nodes the system lists as online, which need not be
+/// numbered contiguously. Where the system reports a single node, or none at all,
+/// this is a plain concurrent_sized_slab with no binding.
+///
+class TURBO_SYMBOL_DECL numa_sized_slab
+{
+public:
+    numa_sized_slab(block::capacity_type contingency_capacity, const std::vector<block_config>& config);
+    numa_sized_slab(block::capacity_type contingency_capacity, const std::vector<block_config>& config, const std::vector<int>& nodes);
+    ~numa_sized_slab() = default;
+    inline std::size_t get_node_count() const { return slab_map_.size(); }
+    ///
+    /// The slabs are indexed by their position in the node list, not by node ID
+    ///
+    inline concurrent_sized_slab& get_node_slab(std::size_t index) { return *(slab_map_[index]); }
+    inline int get_node_id(std::size_t index) const { return node_ids_[index]; }
+    inline std::size_t find_current_node() const;
+    template <class value_t>
+    inline value_t* allocate(capacity_type quantity)
+    {
+	return slab_map_[find_current_node()]->allocate<value_t>(quantity);
+    }
+    template <class value_t>
+    inline value_t* allocate()
+    {
+	return allocate<value_t>(1U);
+    }
+    template <class value_t>
+    inline void deallocate(value_t* pointer, capacity_type quantity)
+    {
+	// the owning block is found by address, so this reaches the home node from any slab
+	slab_map_[find_current_node()]->deallocate(pointer, quantity);
+    }
+    template <class value_t>
+    inline void deallocate(value_t* pointer)
+    {
+	deallocate(pointer, 1U);
+    }
+    inline void* malloc(std::size_t size)
+    {
+	return slab_map_[find_current_node()]->malloc(size);
+    }
+    inline void free(void* ptr, std::size_t size)
+    {
+	slab_map_[find_current_node()]->free(ptr, size);
+    }
+    ///
+    /// The IDs of the NUMA nodes the system lists as online, or just node 0 if that is
+    /// unknown
+    ///
+    static std::vector<int> detect_nodes();
+    ///
+    /// The number of NUMA nodes the system lists as online, or 1 if that is unknown
+    ///
+    static std::size_t detect_node_count();
+private:
+    typedef std::vector<std::unique_ptr<concurrent_sized_slab>> slab_map_type;
+    numa_sized_slab() = delete;
+    numa_sized_slab(const numa_sized_slab&) = delete;
+    numa_sized_slab(numa_sized_slab&&) = delete;
+    numa_sized_slab& operator=(const numa_sized_slab&) = delete;
+    numa_sized_slab& operator=(numa_sized_slab&&) = delete;
+    slab_map_type slab_map_;
+    std::vector<int> node_ids_;
+    std::vector<std::size_t> cpu_node_map_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+#endif
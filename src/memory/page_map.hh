@@ -0,0 +1,182 @@
+#ifndef TURBO_MEMORY_PAGE_MAP_HXX
+#define TURBO_MEMORY_PAGE_MAP_HXX
+
+#include <turbo/memory/page_map.hpp>
+#include <memory>
+#include <turbo/toolset/extension.hpp>
+
+namespace turbo {
+namespace memory {
+
+template <class v>
+const std::size_t page_map<v>::page_shift;
+
+template <class v>
+const std::size_t page_map<v>::page_size;
+
+template <class v>
+const std::size_t page_map<v>::address_bits;
+
+template <class v>
+const std::size_t page_map<v>::key_bits;
+
+template <class v>
+const std::size_t page_map<v>::leaf_bits;
+
+template <class v>
+const std::size_t page_map<v>::middle_bits;
+
+template <class v>
+const std::size_t page_map<v>::root_bits;
+
+template <class v>
+page_map<v>::leaf_node::leaf_node()
+{
+    for (auto&& value : values)
+    {
+	value.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template <class v>
+page_map<v>::middle_node::middle_node()
+{
+    for (auto&& child : children)
+    {
+	child.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template <class v>
+page_map<v>::middle_node::~middle_node() noexcept
+{
+    for (auto&& child : children)
+    {
+	delete child.load(std::memory_order_acquire);
+    }
+}
+
+template <class v>
+page_map<v>::page_map()
+{
+    for (auto&& child : root_)
+    {
+	child.store(nullptr, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+template <class v>
+page_map<v>::~page_map() noexcept
+{
+    for (auto&& child : root_)
+    {
+	delete child.load(std::memory_order_acquire);
+    }
+}
+
+template <class v>
+std::uintptr_t page_map<v>::root_index(std::uintptr_t key)
+{
+    return key >> (middle_bits + leaf_bits);
+}
+
+template <class v>
+std::uintptr_t page_map<v>::middle_index(std::uintptr_t key)
+{
+    return (key >> leaf_bits) & ((static_cast<std::uintptr_t>(1U) << middle_bits) - 1U);
+}
+
+template <class v>
+std::uintptr_t page_map<v>::leaf_index(std::uintptr_t key)
+{
+    return key & ((static_cast<std::uintptr_t>(1U) << leaf_bits) - 1U);
+}
+
+template <class v>
+typename page_map<v>::leaf_node* page_map<v>::acquire_leaf(std::uintptr_t key)
+{
+    std::atomic<middle_node*>& root_slot = root_[root_index(key)];
+    middle_node* middle = root_slot.load(std::memory_order_acquire);
+    if (middle == nullptr)
+    {
+	std::unique_ptr<middle_node> fresh(new middle_node());
+	if (root_slot.compare_exchange_strong(middle, fresh.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+	{
+	    middle = fresh.release();
+	}
+    }
+    std::atomic<leaf_node*>& middle_slot = middle->children[middle_index(key)];
+    leaf_node* leaf = middle_slot.load(std::memory_order_acquire);
+    if (leaf == nullptr)
+    {
+	std::unique_ptr<leaf_node> fresh(new leaf_node());
+	if (middle_slot.compare_exchange_strong(leaf, fresh.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+	{
+	    leaf = fresh.release();
+	}
+    }
+    return leaf;
+}
+
+template <class v>
+bool page_map<v>::insert(const void* address, std::size_t length, v* value)
+{
+    const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(address);
+    const std::uintptr_t last = first + length - 1U;
+    if (TURBO_UNLIKELY(length == 0U || last < first || (last >> page_shift) >> key_bits != 0U))
+    {
+	return false;
+    }
+    for (std::uintptr_t key = first >> page_shift; key <= (last >> page_shift); ++key)
+    {
+	acquire_leaf(key)->values[leaf_index(key)].store(value, std::memory_order_release);
+    }
+    return true;
+}
+
+template <class v>
+void page_map<v>::erase(const void* address, std::size_t length)
+{
+    const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(address);
+    const std::uintptr_t last = first + length - 1U;
+    if (TURBO_UNLIKELY(length == 0U || last < first || (last >> page_shift) >> key_bits != 0U))
+    {
+	return;
+    }
+    for (std::uintptr_t key = first >> page_shift; key <= (last >> page_shift); ++key)
+    {
+	middle_node* middle = root_[root_index(key)].load(std::memory_order_acquire);
+	leaf_node* leaf = (middle == nullptr) ? nullptr : middle->children[middle_index(key)].load(std::memory_order_acquire);
+	if (leaf != nullptr)
+	{
+	    leaf->values[leaf_index(key)].store(nullptr, std::memory_order_release);
+	}
+    }
+}
+
+template <class v>
+v* page_map<v>::find(const void* address) const
+{
+    const std::uintptr_t key = reinterpret_cast<std::uintptr_t>(address) >> page_shift;
+    if (TURBO_UNLIKELY(key >> key_bits != 0U))
+    {
+	return nullptr;
+    }
+    middle_node* middle = root_[root_index(key)].load(std::memory_order_acquire);
+    if (middle == nullptr)
+    {
+	return nullptr;
+    }
+    leaf_node* leaf = middle->children[middle_index(key)].load(std::memory_order_acquire);
+    if (leaf == nullptr)
+    {
+	return nullptr;
+    }
+    return leaf->values[leaf_index(key)].load(std::memory_order_acquire);
+}
+
+} // namespace memory
+} // namespace turbo
+
+#endif
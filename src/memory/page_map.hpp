@@ -0,0 +1,66 @@
+#ifndef TURBO_MEMORY_PAGE_MAP_HPP
+#define TURBO_MEMORY_PAGE_MAP_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace memory {
+
+///
+/// A three level radix tree mapping each page of the address space to a value.
+/// Lookups are wait free and cost three dependent loads; inserts publish new interior
+/// nodes with a single compare and swap so they can run concurrently with lookups.
+/// Interior nodes are only released when the map is destroyed.
+///
+/// Addresses beyond the mapped address width are not representable, so insert
+/// reports failure for them and find always returns nullptr.
+///
+template <class value_t>
+class TURBO_SYMBOL_DECL page_map
+{
+public:
+    typedef value_t value_type;
+    static const std::size_t page_shift = 12U;
+    static const std::size_t page_size = static_cast<std::size_t>(1U) << page_shift;
+    static const std::size_t address_bits = std::numeric_limits<std::uintptr_t>::digits < 48 ? std::numeric_limits<std::uintptr_t>::digits : 48U;
+    static const std::size_t key_bits = address_bits - page_shift;
+    static const std::size_t leaf_bits = key_bits / 3U;
+    static const std::size_t middle_bits = key_bits / 3U;
+    static const std::size_t root_bits = key_bits - leaf_bits - middle_bits;
+    page_map();
+    ~page_map() noexcept;
+    bool insert(const void* address, std::size_t length, value_t* value);
+    void erase(const void* address, std::size_t length);
+    inline value_t* find(const void* address) const;
+private:
+    struct leaf_node
+    {
+	leaf_node();
+	std::array<std::atomic<value_t*>, static_cast<std::size_t>(1U) << leaf_bits> values;
+    };
+    struct middle_node
+    {
+	middle_node();
+	~middle_node() noexcept;
+	std::array<std::atomic<leaf_node*>, static_cast<std::size_t>(1U) << middle_bits> children;
+    };
+    page_map(const page_map&) = delete;
+    page_map(page_map&&) = delete;
+    page_map& operator=(const page_map&) = delete;
+    page_map& operator=(page_map&&) = delete;
+    static inline std::uintptr_t root_index(std::uintptr_t key);
+    static inline std::uintptr_t middle_index(std::uintptr_t key);
+    static inline std::uintptr_t leaf_index(std::uintptr_t key);
+    leaf_node* acquire_leaf(std::uintptr_t key);
+    std::array<std::atomic<middle_node*>, static_cast<std::size_t>(1U) << root_bits> root_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+#endif
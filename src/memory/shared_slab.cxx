@@ -0,0 +1,344 @@
+#include "shared_slab.hpp"
+#include "index_stack.hpp"
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <turbo/memory/size_class.hh>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/toolset/extension.hpp>
+
+namespace turbo {
+namespace memory {
+
+namespace {
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+	"free lists shared between processes need address free atomics");
+
+const std::uint64_t segment_magic = 0x74626f736c616231ULL;
+const std::size_t page_size = 4096U;
+
+using index_stack::empty_index;
+using index_stack::pack_top;
+using index_stack::next_link;
+
+inline std::size_t round_up(std::size_t size, std::size_t multiple)
+{
+    return ((size + multiple - 1U) / multiple) * multiple;
+}
+
+std::string describe_errno(const char* what)
+{
+    return std::string(what) + ": " + std::strerror(errno);
+}
+
+} // anonymous namespace
+
+segment_error::segment_error(const std::string& what)
+    :
+	runtime_error(what)
+{ }
+
+segment_error::segment_error(const char* what)
+    :
+	runtime_error(what)
+{ }
+
+///
+/// Every field is written before the magic is published, so a process that maps the
+/// segment while it is still being set up sees a zero magic and refuses it
+///
+struct shared_sized_slab::segment_header
+{
+    std::atomic<std::uint64_t> magic;
+    std::uint64_t segment_size;
+    std::uint64_t first_size;
+    std::uint64_t bucket_count;
+};
+
+struct alignas(LEVEL1_DCACHE_LINESIZE) shared_sized_slab::bucket_header
+{
+    std::uint64_t value_size;
+    std::uint64_t capacity;
+    std::uint64_t values_offset;
+    // index of the top of the stack in the low half, a tag that changes with every update in the high half
+    alignas(LEVEL1_DCACHE_LINESIZE) std::atomic<std::uint64_t> top;
+};
+
+shared_sized_slab::shared_sized_slab(const std::string& name, const std::vector<block_config>& config)
+    :
+	descriptor_(create_descriptor(name)),
+	base_(nullptr),
+	segment_size_(0U),
+	size_classes_()
+{
+    try
+    {
+	create(config);
+    }
+    catch (...)
+    {
+	::close(descriptor_);
+	::shm_unlink(name.c_str());
+	throw;
+    }
+}
+
+shared_sized_slab::shared_sized_slab(const std::vector<block_config>& config)
+    :
+	descriptor_(create_descriptor(std::string())),
+	base_(nullptr),
+	segment_size_(0U),
+	size_classes_()
+{
+    try
+    {
+	create(config);
+    }
+    catch (...)
+    {
+	::close(descriptor_);
+	throw;
+    }
+}
+
+shared_sized_slab::shared_sized_slab(const std::string& name)
+    :
+	descriptor_(::shm_open(name.c_str(), O_RDWR, 0)),
+	base_(nullptr),
+	segment_size_(0U),
+	size_classes_()
+{
+    if (TURBO_UNLIKELY(descriptor_ == -1))
+    {
+	throw segment_error(describe_errno("unable to open shared memory segment"));
+    }
+    try
+    {
+	attach();
+    }
+    catch (...)
+    {
+	::close(descriptor_);
+	throw;
+    }
+}
+
+shared_sized_slab::shared_sized_slab(int descriptor)
+    :
+	descriptor_(descriptor),
+	base_(nullptr),
+	segment_size_(0U),
+	size_classes_()
+{
+    try
+    {
+	attach();
+    }
+    catch (...)
+    {
+	::close(descriptor_);
+	throw;
+    }
+}
+
+shared_sized_slab::~shared_sized_slab() noexcept
+{
+    if (base_ != nullptr)
+    {
+	::munmap(base_, segment_size_);
+    }
+    ::close(descriptor_);
+}
+
+void shared_sized_slab::unlink(const std::string& name)
+{
+    ::shm_unlink(name.c_str());
+}
+
+std::size_t shared_sized_slab::get_bucket_count() const
+{
+    return header().bucket_count;
+}
+
+std::size_t shared_sized_slab::get_value_size(std::size_t bucket) const
+{
+    return bucket_at(bucket).value_size;
+}
+
+std::size_t shared_sized_slab::get_capacity(std::size_t bucket) const
+{
+    return bucket_at(bucket).capacity;
+}
+
+void* shared_sized_slab::allocate(std::size_t size)
+{
+    if (TURBO_UNLIKELY(size == 0U))
+    {
+	return nullptr;
+    }
+    // a bucket that is full, or a filler bucket calibrate added without values, falls
+    // through to the next bucket with room
+    for (std::size_t bucket_index = size_classes_->find_bucket(size); bucket_index < header().bucket_count; ++bucket_index)
+    {
+	bucket_header& bucket = bucket_at(bucket_index);
+	std::uint8_t* values = base_ + bucket.values_offset;
+	index_stack::index_type index = empty_index;
+	while (!index_stack::try_pop(bucket.top, values, bucket.value_size, index)) { }
+	if (index != empty_index)
+	{
+	    return values + index * bucket.value_size;
+	}
+    }
+    return nullptr;
+}
+
+void shared_sized_slab::free(void* pointer)
+{
+    if (pointer == nullptr)
+    {
+	return;
+    }
+    const std::uint8_t* address = static_cast<const std::uint8_t*>(pointer);
+    for (std::size_t bucket_index = 0U; bucket_index < header().bucket_count; ++bucket_index)
+    {
+	bucket_header& bucket = bucket_at(bucket_index);
+	std::uint8_t* values = base_ + bucket.values_offset;
+	if (values <= address && address < values + bucket.capacity * bucket.value_size)
+	{
+	    const std::size_t diff = address - values;
+	    if (TURBO_UNLIKELY(diff % bucket.value_size != 0U))
+	    {
+		throw invalid_pointer_error("address points to the middle of a value");
+	    }
+	    const index_stack::index_type index = static_cast<index_stack::index_type>(diff / bucket.value_size);
+	    while (!index_stack::try_push(bucket.top, values, bucket.value_size, index, index)) { }
+	    return;
+	}
+    }
+    throw invalid_pointer_error("given address does not come from this shared_sized_slab");
+}
+
+int shared_sized_slab::create_descriptor(const std::string& name)
+{
+    int descriptor = -1;
+    if (name.empty())
+    {
+#ifdef MFD_CLOEXEC
+	// no MFD_CLOEXEC, so that spawned children inherit the segment
+	descriptor = ::memfd_create("turbo_shared_sized_slab", 0U);
+#else
+	errno = ENOSYS;
+#endif
+    }
+    else
+    {
+	descriptor = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    }
+    if (TURBO_UNLIKELY(descriptor == -1))
+    {
+	throw segment_error(describe_errno("unable to create shared memory segment"));
+    }
+    return descriptor;
+}
+
+void shared_sized_slab::create(const std::vector<block_config>& config)
+{
+    if (TURBO_UNLIKELY(config.empty()))
+    {
+	throw invalid_size_error("shared_sized_slab needs at least one bucket");
+    }
+    // the segment never grows, so the contingency given to calibrate is ignored
+    const std::vector<block_config> buckets(calibrate(1U, config));
+    if (TURBO_UNLIKELY(buckets.front().block_size < sizeof(index_stack::index_type)))
+    {
+	throw invalid_size_error("value size is too small to hold a free list index");
+    }
+    std::vector<std::uint64_t> values_offsets;
+    std::size_t offset = round_up(round_up(sizeof(segment_header), alignof(bucket_header)) + buckets.size() * sizeof(bucket_header), page_size);
+    for (const block_config& bucket : buckets)
+    {
+	if (TURBO_UNLIKELY(bucket.initial_capacity == empty_index))
+	{
+	    throw invalid_size_error("capacity is too big for a free list index");
+	}
+	values_offsets.push_back(offset);
+	offset += round_up(bucket.block_size * bucket.initial_capacity, page_size);
+    }
+    if (TURBO_UNLIKELY(::ftruncate(descriptor_, static_cast<off_t>(offset)) != 0))
+    {
+	throw segment_error(describe_errno("unable to size shared memory segment"));
+    }
+    void* base = ::mmap(nullptr, offset, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor_, 0);
+    if (TURBO_UNLIKELY(base == MAP_FAILED))
+    {
+	throw segment_error(describe_errno("unable to map shared memory segment"));
+    }
+    base_ = static_cast<std::uint8_t*>(base);
+    segment_size_ = offset;
+    size_classes_.reset(new size_class_table(buckets.front().block_size, 1U));
+    segment_header& head = header();
+    head.segment_size = segment_size_;
+    head.first_size = buckets.front().block_size;
+    head.bucket_count = buckets.size();
+    for (std::size_t bucket_index = 0U; bucket_index < buckets.size(); ++bucket_index)
+    {
+	bucket_header& bucket = bucket_at(bucket_index);
+	bucket.value_size = buckets[bucket_index].block_size;
+	bucket.capacity = buckets[bucket_index].initial_capacity;
+	bucket.values_offset = values_offsets[bucket_index];
+	std::uint8_t* values = base_ + bucket.values_offset;
+	for (index_stack::index_type index = 0U; index < bucket.capacity; ++index)
+	{
+	    next_link(values, bucket.value_size, index).store(index + 1U < bucket.capacity ? index + 1U : empty_index, std::memory_order_relaxed);
+	}
+	bucket.top.store(pack_top(0U, bucket.capacity == 0U ? empty_index : 0U), std::memory_order_relaxed);
+    }
+    head.magic.store(segment_magic, std::memory_order_release);
+}
+
+void shared_sized_slab::attach()
+{
+    struct stat status;
+    if (TURBO_UNLIKELY(::fstat(descriptor_, &status) != 0))
+    {
+	throw segment_error(describe_errno("unable to query shared memory segment"));
+    }
+    if (TURBO_UNLIKELY(static_cast<std::size_t>(status.st_size) < sizeof(segment_header)))
+    {
+	throw segment_error("shared memory segment is not initialised");
+    }
+    void* base = ::mmap(nullptr, status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor_, 0);
+    if (TURBO_UNLIKELY(base == MAP_FAILED))
+    {
+	throw segment_error(describe_errno("unable to map shared memory segment"));
+    }
+    base_ = static_cast<std::uint8_t*>(base);
+    segment_size_ = status.st_size;
+    const segment_header& head = header();
+    if (TURBO_UNLIKELY(head.magic.load(std::memory_order_acquire) != segment_magic || head.segment_size != segment_size_))
+    {
+	::munmap(base_, segment_size_);
+	base_ = nullptr;
+	throw segment_error("shared memory segment is not initialised");
+    }
+    size_classes_.reset(new size_class_table(head.first_size, 1U));
+}
+
+shared_sized_slab::segment_header& shared_sized_slab::header() const
+{
+    return *reinterpret_cast<segment_header*>(base_);
+}
+
+shared_sized_slab::bucket_header& shared_sized_slab::bucket_at(std::size_t bucket) const
+{
+    // the bucket headers follow the segment header, starting on the next cache line
+    return reinterpret_cast<bucket_header*>(base_ + round_up(sizeof(segment_header), alignof(bucket_header)))[bucket];
+}
+
+} // namespace memory
+} // namespace turbo
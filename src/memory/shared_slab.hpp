@@ -0,0 +1,128 @@
+#ifndef TURBO_MEMORY_SHARED_SLAB_HPP
+#define TURBO_MEMORY_SHARED_SLAB_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <turbo/memory/block.hpp>
+#include <turbo/memory/size_class.hpp>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace memory {
+
+class segment_error : public std::runtime_error
+{
+public:
+    explicit segment_error(const std::string& what);
+    explicit segment_error(const char* what);
+};
+
+///
+/// A sized slab whose whole state, values and free lists alike, lives in one shared
+/// memory segment, so every process that maps the segment can allocate from it and
+/// free to it. The segment is either named, through shm_open, or anonymous, through
+/// memfd_create, in which case children reach it through the inherited descriptor.
+///
+/// Each process maps the segment at a different address, so values are handed
+/// between processes as offsets from the start of the segment.
+///
+/// Buckets are the power of 2 size classes of calibrate and never grow, so a size
+/// whose bucket is full, or is a filler bucket without values, is served by the next
+/// bucket with room. Each free list is a stack of value indices threaded through the
+/// free values, with a tag against ABA, as in block::free_list_mode::index_stack. A
+/// process that dies while holding values leaks them.
+///
+class TURBO_SYMBOL_DECL shared_sized_slab
+{
+public:
+    typedef std::uint64_t offset_type;
+    ///
+    /// Offset 0 is the segment header, so it never refers to a value
+    ///
+    static const offset_type null_offset = 0U;
+    ///
+    /// Creates a named segment, failing if the name is already taken; only the
+    /// initial capacity of each config is used
+    ///
+    shared_sized_slab(const std::string& name, const std::vector<block_config>& config);
+    ///
+    /// Creates an anonymous segment whose descriptor is inherited across fork and exec
+    ///
+    explicit shared_sized_slab(const std::vector<block_config>& config);
+    ///
+    /// Maps a named segment created by another shared_sized_slab
+    ///
+    explicit shared_sized_slab(const std::string& name);
+    ///
+    /// Maps the segment behind a descriptor, e.g. one inherited from the creating process;
+    /// the slab takes ownership of the descriptor
+    ///
+    explicit shared_sized_slab(int descriptor);
+    ///
+    /// Unmaps the segment; a named segment stays until unlink is called
+    ///
+    ~shared_sized_slab() noexcept;
+    static void unlink(const std::string& name);
+    inline int get_descriptor() const { return descriptor_; }
+    inline std::size_t get_segment_size() const { return segment_size_; }
+    std::size_t get_bucket_count() const;
+    std::size_t get_value_size(std::size_t bucket) const;
+    std::size_t get_capacity(std::size_t bucket) const;
+    ///
+    /// nullptr if size has no bucket or no bucket from its size class up has room
+    ///
+    void* allocate(std::size_t size);
+    ///
+    /// Throws invalid_pointer_error if the address does not point to a value in the segment
+    ///
+    void free(void* pointer);
+    template <class value_t>
+    inline value_t* allocate()
+    {
+	return static_cast<value_t*>(allocate(sizeof(value_t)));
+    }
+    inline bool owns(const void* pointer) const
+    {
+	return base_ < static_cast<const std::uint8_t*>(pointer) && static_cast<const std::uint8_t*>(pointer) < base_ + segment_size_;
+    }
+    inline offset_type to_offset(const void* pointer) const
+    {
+	return owns(pointer) ? static_cast<offset_type>(static_cast<const std::uint8_t*>(pointer) - base_) : null_offset;
+    }
+    inline void* from_offset(offset_type offset) const
+    {
+	return (offset == null_offset || offset >= segment_size_) ? nullptr : base_ + offset;
+    }
+    template <class value_t>
+    inline value_t* from_offset(offset_type offset) const
+    {
+	return static_cast<value_t*>(from_offset(offset));
+    }
+private:
+    struct segment_header;
+    struct bucket_header;
+    shared_sized_slab() = delete;
+    shared_sized_slab(const shared_sized_slab&) = delete;
+    shared_sized_slab(shared_sized_slab&&) = delete;
+    shared_sized_slab& operator=(const shared_sized_slab&) = delete;
+    shared_sized_slab& operator=(shared_sized_slab&&) = delete;
+    static int create_descriptor(const std::string& name);
+    void create(const std::vector<block_config>& config);
+    void attach();
+    inline segment_header& header() const;
+    inline bucket_header& bucket_at(std::size_t bucket) const;
+    int descriptor_;
+    std::uint8_t* base_;
+    std::size_t segment_size_;
+    std::unique_ptr<size_class_table> size_classes_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,50 @@
+#include "size_class.hpp"
+#include "size_class.hh"
+#include <algorithm>
+#include <stdexcept>
+
+namespace turbo {
+namespace memory {
+
+const std::size_t size_class_table::small_limit;
+
+const std::size_t size_class_table::max_classes_per_doubling;
+
+size_class_table::size_class_table(std::size_t first_size, std::size_t classes_per_doubling)
+    :
+	shift_(calc_shift(classes_per_doubling)),
+	first_number_(class_number(first_size, shift_)),
+	small_buckets_()
+{
+    for (std::size_t size = 0U; size < small_buckets_.size(); ++size)
+    {
+	const std::size_t number = class_number(size, shift_);
+	const std::size_t bucket = number <= first_number_ ? 0U : number - first_number_;
+	// buckets past the table's range are beyond any slab anyway
+	small_buckets_[size] = static_cast<std::uint8_t>(std::min<std::size_t>(bucket, std::numeric_limits<std::uint8_t>::max()));
+    }
+}
+
+bool size_class_table::operator==(const size_class_table& other) const
+{
+    return this->shift_ == other.shift_ && this->first_number_ == other.first_number_;
+}
+
+std::size_t size_class_table::calc_shift(std::size_t classes_per_doubling)
+{
+    if (classes_per_doubling == 0U
+	    || classes_per_doubling > max_classes_per_doubling
+	    || (classes_per_doubling & (classes_per_doubling - 1U)) != 0U)
+    {
+	throw std::invalid_argument("size_class_table - classes per doubling must be a power of 2 no greater than 16");
+    }
+    std::size_t shift = 0U;
+    while ((static_cast<std::size_t>(1U) << shift) < classes_per_doubling)
+    {
+	++shift;
+    }
+    return shift;
+}
+
+} // namespace memory
+} // namespace turbo
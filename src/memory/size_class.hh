@@ -0,0 +1,55 @@
+#ifndef TURBO_MEMORY_SIZE_CLASS_HXX
+#define TURBO_MEMORY_SIZE_CLASS_HXX
+
+#include <turbo/memory/size_class.hpp>
+#include <limits>
+#include <turbo/toolset/extension.hpp>
+#include <turbo/toolset/intrinsic.hpp>
+
+namespace turbo {
+namespace memory {
+
+std::size_t size_class_table::find_bucket(std::size_t size) const
+{
+    if (TURBO_LIKELY(size <= small_limit))
+    {
+	return small_buckets_[size];
+    }
+    const std::size_t number = class_number(size, shift_);
+    return number <= first_number_ ? 0U : number - first_number_;
+}
+
+std::size_t size_class_table::get_bucket_size(std::size_t bucket) const
+{
+    return class_size(first_number_ + bucket, shift_);
+}
+
+std::size_t size_class_table::class_number(std::size_t size, std::size_t shift)
+{
+    // classes are ceilings, so classify the largest size the class below cannot hold
+    const std::uint64_t last = size == 0U ? 0U : size - 1U;
+    if (last < (static_cast<std::uint64_t>(1U) << shift))
+    {
+	// below classes_per_doubling every size is its own class
+	return last;
+    }
+    const std::uint64_t exponent = std::numeric_limits<std::uint64_t>::digits - 1U - turbo::toolset::count_leading_zero(last);
+    return ((exponent - shift) << shift) + (last >> (exponent - shift));
+}
+
+std::size_t size_class_table::class_size(std::size_t number, std::size_t shift)
+{
+    const std::size_t classes = static_cast<std::size_t>(1U) << shift;
+    if (number < classes)
+    {
+	return number + 1U;
+    }
+    const std::size_t exponent = shift + ((number - classes) >> shift);
+    const std::size_t step = (number - classes) & (classes - 1U);
+    return (static_cast<std::size_t>(1U) << exponent) + ((step + 1U) << (exponent - shift));
+}
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef TURBO_MEMORY_SIZE_CLASS_HPP
+#define TURBO_MEMORY_SIZE_CLASS_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace memory {
+
+///
+/// Maps allocation sizes to the buckets of a slab. Every doubling of size is split into
+/// classes_per_doubling evenly spaced classes, so with 4 classes per doubling the classes
+/// after 8 are 10, 12, 14, 16, 20, 24, 28, 32, 40 and so on, and with 1 they are the
+/// powers of 2. Sizes up to small_limit are classified with a single table load and
+/// larger sizes with a count of leading zeros.
+///
+/// A class slot is only aligned to the largest power of 2 that divides its size.
+///
+class TURBO_SYMBOL_DECL size_class_table
+{
+public:
+    static const std::size_t small_limit = 1024U;
+    static const std::size_t max_classes_per_doubling = 16U;
+    ///
+    /// The first bucket is the class holding first_size; classes_per_doubling must be
+    /// a power of 2 no greater than max_classes_per_doubling
+    ///
+    size_class_table(std::size_t first_size, std::size_t classes_per_doubling);
+    bool operator==(const size_class_table& other) const;
+    inline std::size_t get_classes_per_doubling() const { return static_cast<std::size_t>(1U) << shift_; }
+    ///
+    /// The bucket of the smallest class that can hold size; sizes below the first class map to bucket 0
+    ///
+    inline std::size_t find_bucket(std::size_t size) const;
+    inline std::size_t get_bucket_size(std::size_t bucket) const;
+    ///
+    /// Numbers every class of the given granularity from 0, which holds size 1
+    ///
+    static inline std::size_t class_number(std::size_t size, std::size_t shift);
+    static inline std::size_t class_size(std::size_t number, std::size_t shift);
+    static std::size_t calc_shift(std::size_t classes_per_doubling);
+private:
+    size_class_table() = delete;
+    std::size_t shift_;
+    std::size_t first_number_;
+    std::array<std::uint8_t, small_limit + 1U> small_buckets_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+#endif
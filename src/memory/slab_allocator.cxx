@@ -5,7 +5,10 @@
 #include <stdexcept>
 #include <turbo/memory/alignment.hpp>
 #include <turbo/memory/alignment.hh>
+#include <turbo/memory/allocation_trace.hh>
 #include <turbo/memory/block.hh>
+#include <turbo/memory/size_class.hpp>
+#include <turbo/memory/size_class.hh>
 #include <turbo/toolset/extension.hpp>
 
 namespace turbo {
@@ -13,25 +16,43 @@ namespace memory {
 
 concurrent_sized_slab::concurrent_sized_slab(capacity_type contingency_capacity, const std::vector<block_config>& config)
     :
-	concurrent_sized_slab(calibrate(contingency_capacity, config))
+	concurrent_sized_slab(contingency_capacity, config, 1U)
 { }
 
-concurrent_sized_slab::concurrent_sized_slab(const std::vector<block_config>& config)
+concurrent_sized_slab::concurrent_sized_slab(capacity_type contingency_capacity, const std::vector<block_config>& config, std::size_t classes_per_doubling)
     :
-	smallest_block_exponent_(std::llround(std::log2(config.cbegin()->block_size))),
-	block_map_(config.cbegin(), config.cend())
+	concurrent_sized_slab(calibrate(contingency_capacity, config, classes_per_doubling), classes_per_doubling)
+{ }
+
+concurrent_sized_slab::concurrent_sized_slab(
+	capacity_type contingency_capacity,
+	const std::vector<block_config>& config,
+	std::size_t classes_per_doubling,
+	const large_object_config& large_config)
+    :
+	concurrent_sized_slab(contingency_capacity, config, classes_per_doubling)
+{
+    large_objects_.reset(new large_object_tier(large_config));
+}
+
+concurrent_sized_slab::concurrent_sized_slab(const std::vector<block_config>& config, std::size_t classes_per_doubling)
+    :
+	size_classes_(config.cbegin()->block_size, classes_per_doubling),
+	block_map_(config.cbegin(), config.cend()),
+	large_objects_()
 { }
 
 concurrent_sized_slab::concurrent_sized_slab(const concurrent_sized_slab& other)
     :
-	smallest_block_exponent_(other.smallest_block_exponent_),
-	block_map_(other.block_map_)
+	size_classes_(other.size_classes_),
+	block_map_(other.block_map_),
+	large_objects_(other.large_objects_ ? new large_object_tier(other.large_objects_->get_config()) : nullptr)
 { }
 
 concurrent_sized_slab& concurrent_sized_slab::operator=(const concurrent_sized_slab& other)
 {
     if (this != &other
-	    && this->smallest_block_exponent_ == other.smallest_block_exponent_
+	    && this->size_classes_ == other.size_classes_
 	    && this->block_map_.size() == other.block_map_.size())
     {
 	std::copy_n(other.block_map_.cbegin(), this->block_map_.size(), this->block_map_.begin());
@@ -41,7 +62,7 @@ concurrent_sized_slab& concurrent_sized_slab::operator=(const concurrent_sized_s
 
 bool concurrent_sized_slab::operator==(const concurrent_sized_slab& other) const
 {
-    return this->smallest_block_exponent_ == other.smallest_block_exponent_ && this->block_map_ == other.block_map_;
+    return this->size_classes_ == other.size_classes_ && this->block_map_ == other.block_map_;
 }
 
 const std::vector<block_config> concurrent_sized_slab::get_block_config() const
@@ -53,47 +74,118 @@ const std::vector<block_config> concurrent_sized_slab::get_block_config() const
 		list.get_value_size(),
 		list.cbegin()->get_capacity(),
 		list.get_contingency_capacity(),
-		list.get_growth_factor());
+		list.get_growth_factor(),
+		list.get_storage_policy());
     }
     return std::move(output);
 }
 
 void* concurrent_sized_slab::allocate(std::size_t value_size, std::size_t value_alignment, capacity_type quantity, const void*)
 {
-    const std::size_t bucket = find_block_bucket(calc_total_aligned_size(value_size, value_alignment, quantity));
-    if (TURBO_LIKELY(value_size != 0U && quantity != 0U && bucket < block_map_.size()))
+    const std::size_t total_size = calc_total_aligned_size(value_size, value_alignment, quantity);
+    const std::size_t bucket = find_block_bucket(total_size);
+    if (TURBO_UNLIKELY(value_size == 0U || quantity == 0U))
     {
-	return block_map_[bucket].allocate();
+	return nullptr;
     }
-    else
+    void* result = nullptr;
+    if (TURBO_LIKELY(bucket < block_map_.size()))
     {
-	return nullptr;
+	result = block_map_[bucket].allocate();
+    }
+    else if (large_objects_)
+    {
+	result = large_objects_->allocate(total_size);
     }
+    trace_allocate(total_size, result);
+    return result;
 }
 
 void concurrent_sized_slab::deallocate(std::size_t value_size, std::size_t value_alignment, void* pointer, capacity_type quantity)
 {
-    const std::size_t bucket = find_block_bucket(calc_total_aligned_size(value_size, value_alignment, quantity));
+    const std::size_t total_size = calc_total_aligned_size(value_size, value_alignment, quantity);
+    const std::size_t bucket = find_block_bucket(total_size);
+    // recorded before the slot is released, so its next allocation is always recorded after
+    trace_free(total_size, pointer);
     if (TURBO_LIKELY(bucket < block_map_.size()))
     {
-	for (auto&& block : block_map_[bucket])
+	block_map_[bucket].free(pointer);
+    }
+    else if (large_objects_)
+    {
+	large_objects_->deallocate(pointer);
+    }
+}
+
+std::vector<bucket_statistics> concurrent_sized_slab::get_statistics() const
+{
+    std::vector<bucket_statistics> output;
+    for (const block_list& list: block_map_)
+    {
+	output.push_back(list.get_statistics());
+    }
+    return output;
+}
+
+std::size_t concurrent_sized_slab::trim()
+{
+    std::size_t released = 0U;
+    for (block_list& list: block_map_)
+    {
+	released += list.trim();
+    }
+    if (large_objects_)
+    {
+	large_objects_->release_idle();
+    }
+    return released;
+}
+
+std::size_t concurrent_sized_slab::allocate_bulk(std::size_t size, void** output, std::size_t quantity)
+{
+    const std::size_t bucket = find_block_bucket(calc_total_aligned_size(size, size, 1U));
+    if (TURBO_LIKELY(size != 0U && bucket < block_map_.size()))
+    {
+	const std::size_t allocated = block_map_[bucket].allocate_bulk(output, quantity);
+	for (std::size_t index = 0U; index < allocated; ++index)
 	{
-	    if (block.in_range(pointer))
-	    {
-		block.free(pointer);
-		break;
-	    }
+	    trace_allocate(size, output[index]);
+	}
+	return allocated;
+    }
+    else
+    {
+	return 0U;
+    }
+}
+
+void concurrent_sized_slab::free_bulk(std::size_t size, void** input, std::size_t quantity)
+{
+    const std::size_t bucket = find_block_bucket(calc_total_aligned_size(size, size, 1U));
+    if (TURBO_LIKELY(bucket < block_map_.size()))
+    {
+	for (std::size_t index = 0U; index < quantity; ++index)
+	{
+	    trace_free(size, input[index]);
 	}
+	block_map_[bucket].free_bulk(input, quantity);
     }
 }
 
 std::vector<block_config> calibrate(block::capacity_type contingency_capacity, const std::vector<block_config>& config)
 {
+    return calibrate(contingency_capacity, config, 1U);
+}
+
+std::vector<block_config> calibrate(block::capacity_type contingency_capacity, const std::vector<block_config>& config, std::size_t classes_per_doubling)
+{
+    const std::size_t shift = size_class_table::calc_shift(classes_per_doubling);
     std::vector<block_config> sorted(config);
     std::stable_sort(sorted.begin(), sorted.end());
     if (TURBO_LIKELY(!sorted.empty()))
     {
-	std::size_t desired_size = std::llround(std::pow(2U, std::ceil(std::log2(sorted.cbegin()->block_size))));
+	std::size_t desired_number = size_class_table::class_number(sorted.cbegin()->block_size, shift);
+	std::size_t desired_size = size_class_table::class_size(desired_number, shift);
 	std::vector<block_config> result;
 	auto current_step = sorted.cbegin();
 	do
@@ -105,7 +197,7 @@ std::vector<block_config> calibrate(block::capacity_type contingency_capacity, c
 	    if (next_step == current_step)
 	    {
 		// no configuration set for this particular desired size
-		result.emplace_back(desired_size, 0U, contingency_capacity);
+		result.emplace_back(desired_size, 0U, contingency_capacity, 2U, current_step->storage);
 	    }
 	    else
 	    {
@@ -118,10 +210,11 @@ std::vector<block_config> calibrate(block::capacity_type contingency_capacity, c
 			desired_size,
 			total_capacity,
 			contingency_capacity,
-			std::llround(std::pow(2U, std::ceil(std::log2(current_step->growth_factor)))));
+			std::llround(std::pow(2U, std::ceil(std::log2(current_step->growth_factor)))),
+			current_step->storage);
 		current_step = next_step;
 	    }
-	    desired_size *= 2U;
+	    desired_size = size_class_table::class_size(++desired_number, shift);
 	}
 	while (current_step != sorted.cend());
 	return std::move(result);
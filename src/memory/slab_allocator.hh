@@ -9,7 +9,10 @@
 #include <turbo/algorithm/recovery.hpp>
 #include <turbo/memory/alignment.hpp>
 #include <turbo/memory/alignment.hh>
+#include <turbo/memory/allocation_trace.hh>
 #include <turbo/memory/block.hh>
+#include <turbo/memory/size_class.hh>
+#include <turbo/memory/slab_ptr.hh>
 #include <turbo/toolset/extension.hpp>
 #include <turbo/container/mpmc_ring_queue.hh>
 
@@ -49,32 +52,16 @@ block_list& concurrent_sized_slab::at(std::size_t size)
 
 std::size_t concurrent_sized_slab::find_block_bucket(std::size_t allocation_size) const
 {
-    std::size_t allocation_exponent = std::llround(std::ceil(std::log2(allocation_size)));
-    if (allocation_size == 0U || allocation_exponent < smallest_block_exponent_)
-    {
-	// to prevent underflow error
-	return 0U;
-    }
-    else
-    {
-	return allocation_exponent - smallest_block_exponent_;
-    }
+    return size_classes_.find_bucket(allocation_size);
 }
 
 template <class value_t, class ...args_t>
 std::pair<make_result, slab_unique_ptr<value_t>> concurrent_sized_slab::make_unique(args_t&&... args)
 {
-    value_t* result = allocate<value_t>();
+    value_t* result = in_configured_range(sizeof(value_t)) ? allocate<value_t>() : nullptr;
     if (result != nullptr)
     {
-	return std::make_pair(
-		make_result::success,
-		slab_unique_ptr<value_t>(
-			new (result) value_t(std::forward<args_t>(args)...),
-			std::bind(
-				static_cast<void (concurrent_sized_slab::*)(value_t*)>(&concurrent_sized_slab::unmake<value_t>),
-				this,
-				std::placeholders::_1)));
+	return std::make_pair(make_result::success, slab_unique_ptr<value_t>(new (result) value_t(std::forward<args_t>(args)...)));
     }
     else
     {
@@ -83,33 +70,20 @@ std::pair<make_result, slab_unique_ptr<value_t>> concurrent_sized_slab::make_uni
 }
 
 template <class value_t, class... args_t>
-std::pair<make_result, std::shared_ptr<value_t>> concurrent_sized_slab::make_shared(args_t&&... args)
+std::pair<make_result, slab_shared_ptr<value_t>> concurrent_sized_slab::make_shared(args_t&&... args)
 {
-    value_t* result = allocate<value_t>();
+    typedef typename slab_shared_ptr<value_t>::node_type node_type;
+    node_type* result = in_configured_range(sizeof(node_type)) ? allocate<node_type>() : nullptr;
     if (result != nullptr)
     {
-	return std::make_pair(
-		make_result::success,
-		std::shared_ptr<value_t>(
-			new (result) value_t(std::forward<args_t>(args)...),
-			std::bind(
-				static_cast<void (concurrent_sized_slab::*)(value_t*)>(&concurrent_sized_slab::unmake<value_t>),
-				this,
-				std::placeholders::_1)));
+	return std::make_pair(make_result::success, slab_shared_ptr<value_t>(new (result) node_type(std::forward<args_t>(args)...)));
     }
     else
     {
-	return std::make_pair(make_result::slab_full, std::shared_ptr<value_t>());
+	return std::make_pair(make_result::slab_full, slab_shared_ptr<value_t>());
     }
 }
 
-template <class value_t>
-void concurrent_sized_slab::unmake(value_t* pointer)
-{
-    pointer->~value_t();
-    deallocate(pointer);
-}
-
 template <class value_t>
 std::size_t default_type_index_policy::get_index()
 {
@@ -153,14 +127,9 @@ std::pair<make_result, slab_unique_ptr<value_t>> concurrent_typed_slab<t>::make_
     value_t* result = allocate<value_t>();
     if (result != nullptr)
     {
-	return std::make_pair(
-		make_result::success,
-		slab_unique_ptr<value_t>(
-			new (result) value_t(std::forward<args_t>(args)...),
-			std::bind(
-				static_cast<void (concurrent_typed_slab<t>::*)(value_t*)>(&concurrent_typed_slab<t>::unmake<value_t>),
-				this,
-				std::placeholders::_1)));
+	// the handle traces the free
+	trace_allocate(sizeof(value_t), result);
+	return std::make_pair(make_result::success, slab_unique_ptr<value_t>(new (result) value_t(std::forward<args_t>(args)...)));
     }
     else
     {
@@ -170,32 +139,28 @@ std::pair<make_result, slab_unique_ptr<value_t>> concurrent_typed_slab<t>::make_
 
 template <class t>
 template <class value_t, class... args_t>
-std::pair<make_result, std::shared_ptr<value_t>> concurrent_typed_slab<t>::make_shared(args_t&&... args)
+std::pair<make_result, slab_shared_ptr<value_t>> concurrent_typed_slab<t>::make_shared(args_t&&... args)
 {
-    value_t* result = allocate<value_t>();
-    if (result != nullptr)
+    typedef typename slab_shared_ptr<value_t>::node_type node_type;
+    const std::size_t bucket = type_index_policy::template get_index<node_type>();
+    if (TURBO_LIKELY(bucket < block_map_.size() && sizeof(node_type) <= block_map_[bucket].get_value_size()))
     {
-	return std::make_pair(
-		make_result::success,
-		std::shared_ptr<value_t>(
-			new (result) value_t(std::forward<args_t>(args)...),
-			std::bind(
-				static_cast<void (concurrent_typed_slab<t>::*)(value_t*)>(&concurrent_typed_slab<t>::unmake<value_t>),
-				this,
-				std::placeholders::_1)));
-    }
-    else
-    {
-	return std::make_pair(make_result::slab_full, std::shared_ptr<value_t>());
+	node_type* result = static_cast<node_type*>(block_map_[bucket].allocate());
+	if (result != nullptr)
+	{
+	    trace_allocate(sizeof(node_type), result);
+	    return std::make_pair(make_result::success, slab_shared_ptr<value_t>(new (result) node_type(std::forward<args_t>(args)...)));
+	}
     }
+    return std::make_pair(make_result::slab_full, slab_shared_ptr<value_t>());
 }
 
 template <class t>
 template <class value_t>
-void concurrent_typed_slab<t>::unmake(value_t* pointer)
+bool concurrent_typed_slab<t>::in_configured_range() const
 {
-    pointer->~value_t();
-    deallocate(pointer);
+    const std::size_t bucket = type_index_policy::template get_index<value_t>();
+    return bucket < block_map_.size() && sizeof(value_t) <= block_map_[bucket].get_value_size();
 }
 
 template <class t>
@@ -13,14 +13,14 @@
 #include <vector>
 #include <turbo/container/mpmc_ring_queue.hpp>
 #include <turbo/memory/block.hpp>
+#include <turbo/memory/large_object.hpp>
+#include <turbo/memory/size_class.hpp>
+#include <turbo/memory/slab_ptr.hpp>
 #include <turbo/toolset/attribute.hpp>
 
 namespace turbo {
 namespace memory {
 
-template <class value_t>
-using slab_unique_ptr = std::unique_ptr<value_t, std::function<void (value_t*)>>;
-
 enum class make_result
 {
     success,
@@ -28,6 +28,7 @@ enum class make_result
 };
 
 class TURBO_SYMBOL_DECL concurrent_sized_slab_tester;
+class TURBO_SYMBOL_DECL magazine_cache;
 
 class TURBO_SYMBOL_DECL concurrent_sized_slab
 {
@@ -35,12 +36,43 @@ private:
     typedef std::vector<block_list> block_map_type;
 public:
     typedef block_map_type::iterator iterator;
+    typedef block_map_type::const_iterator const_iterator;
     concurrent_sized_slab(block::capacity_type contingency_capacity, const std::vector<block_config>& config);
+    ///
+    /// Splits every doubling of size into classes_per_doubling buckets instead of one,
+    /// see size_class_table
+    ///
+    concurrent_sized_slab(block::capacity_type contingency_capacity, const std::vector<block_config>& config, std::size_t classes_per_doubling);
+    ///
+    /// Also serves allocations bigger than the largest bucket from a large_object_tier
+    /// instead of failing them. Large objects are not part of copies; a copy gets an
+    /// empty tier with the same config.
+    ///
+    concurrent_sized_slab(
+	    block::capacity_type contingency_capacity,
+	    const std::vector<block_config>& config,
+	    std::size_t classes_per_doubling,
+	    const large_object_config& large_config);
     concurrent_sized_slab(const concurrent_sized_slab& other);
     ~concurrent_sized_slab() = default;
     concurrent_sized_slab& operator=(const concurrent_sized_slab& other);
     bool operator==(const concurrent_sized_slab& other) const;
     const std::vector<block_config> get_block_config() const;
+    inline std::size_t get_classes_per_doubling() const { return size_classes_.get_classes_per_doubling(); }
+    ///
+    /// nullptr unless the slab was made with a large_object_config
+    ///
+    inline large_object_tier* get_large_object_tier() const { return large_objects_.get(); }
+    ///
+    /// Snapshot of every bucket's counters, which are only gathered when built with
+    /// TURBO_MEMORY_STATISTICS defined
+    ///
+    std::vector<bucket_statistics> get_statistics() const;
+    ///
+    /// Releases the empty trailing blocks of every bucket, see block_list::trim, and
+    /// the pages of idle large objects
+    ///
+    std::size_t trim();
     inline iterator begin()
     {
 	return block_map_.begin();
@@ -49,10 +81,25 @@ public:
     {
 	return block_map_.end();
     }
+    inline const_iterator cbegin() const
+    {
+	return block_map_.cbegin();
+    }
+    inline const_iterator cend() const
+    {
+	return block_map_.cend();
+    }
+    ///
+    /// Only serves values that fit a bucket, never the large object tier, because the
+    /// returned handles free through block::find_owner
+    ///
     template <class value_t, class... args_t>
     std::pair<make_result, slab_unique_ptr<value_t>> make_unique(args_t&&... args);
+    ///
+    /// Needs a bucket big enough for slab_shared_ptr<value_t>::node_type
+    ///
     template <class value_t, class... args_t>
-    std::pair<make_result, std::shared_ptr<value_t>> make_shared(args_t&&... args);
+    std::pair<make_result, slab_shared_ptr<value_t>> make_shared(args_t&&... args);
     template <class value_t>
     inline value_t* allocate(capacity_type quantity, const value_t* hint)
     {
@@ -91,26 +138,37 @@ public:
     {
 	return deallocate(size, size, ptr, 1U);
     }
+    ///
+    /// Allocates up to quantity values of the given size from one bucket, writing
+    /// their addresses to output; returns how many were allocated
+    ///
+    std::size_t allocate_bulk(std::size_t size, void** output, std::size_t quantity);
+    void free_bulk(std::size_t size, void** input, std::size_t quantity);
     inline bool in_configured_range(std::size_t value_size) const;
     inline const block_list& at(std::size_t size) const;
     inline block_list& at(std::size_t size);
     friend class concurrent_sized_slab_tester;
+    friend class magazine_cache;
 private:
     concurrent_sized_slab() = delete;
-    concurrent_sized_slab(const std::vector<block_config>& config);
+    concurrent_sized_slab(const std::vector<block_config>& config, std::size_t classes_per_doubling);
     concurrent_sized_slab(concurrent_sized_slab&&) = delete;
     concurrent_sized_slab& operator=(concurrent_sized_slab&&) = delete;
     inline std::size_t find_block_bucket(std::size_t allocation_size) const;
     void* allocate(std::size_t value_size, std::size_t value_alignment, capacity_type quantity, const void* hint);
     void deallocate(std::size_t value_size, std::size_t value_alignment, void* pointer, capacity_type quantity);
-    template <class value_t>
-    inline void unmake(value_t* pointer);
-    std::size_t smallest_block_exponent_;
+    size_class_table size_classes_;
     block_map_type block_map_;
+    std::unique_ptr<large_object_tier> large_objects_;
 };
 
 std::vector<block_config> calibrate(block::capacity_type contingency_capacity, const std::vector<block_config>& config);
 
+///
+/// Merges the config into one bucket per size class, filling any gaps between classes
+///
+std::vector<block_config> calibrate(block::capacity_type contingency_capacity, const std::vector<block_config>& config, std::size_t classes_per_doubling);
+
 struct default_type_index_policy
 {
     template <class value_t>
@@ -140,8 +198,12 @@ public:
     }
     template <class value_t, class... args_t>
     std::pair<make_result, slab_unique_ptr<value_t>> make_unique(args_t&&... args);
+    ///
+    /// Uses the bucket the type index policy gives slab_shared_ptr<value_t>::node_type,
+    /// which is bigger than value_t because it holds the reference count too
+    ///
     template <class value_t, class... args_t>
-    std::pair<make_result, std::shared_ptr<value_t>> make_shared(args_t&&... args);
+    std::pair<make_result, slab_shared_ptr<value_t>> make_shared(args_t&&... args);
     template <class value_t>
     inline value_t* allocate(const value_t* hint);
     template <class value_t>
@@ -151,6 +213,11 @@ public:
     }
     template <class value_t>
     inline void deallocate(value_t* pointer);
+    ///
+    /// Whether value_t has a bucket whose values are big enough to hold it
+    ///
+    template <class value_t>
+    inline bool in_configured_range() const;
     template <class value_t>
     inline const block_list& at() const;
     template <class value_t>
@@ -159,8 +226,6 @@ private:
     concurrent_typed_slab() = delete;
     concurrent_typed_slab(concurrent_typed_slab&&) = delete;
     concurrent_typed_slab& operator=(concurrent_typed_slab&&) = delete;
-    template <class value_t>
-    inline void unmake(value_t* pointer);
     block_map_type block_map_;
 };
 
@@ -0,0 +1,45 @@
+#ifndef TURBO_MEMORY_SLAB_PTR_HXX
+#define TURBO_MEMORY_SLAB_PTR_HXX
+
+#include <turbo/memory/slab_ptr.hpp>
+#include <turbo/memory/allocation_trace.hh>
+#include <turbo/memory/block.hpp>
+
+namespace turbo {
+namespace memory {
+
+template <class value_t>
+void slab_deleter<value_t>::operator()(value_t* pointer) const
+{
+    if (pointer == nullptr)
+    {
+	return;
+    }
+    pointer->~value_t();
+    // recorded before the slot is released, so its next allocation is always recorded after
+    trace_free(sizeof(value_t), pointer);
+    block* owner = block::find_owner(pointer);
+    if (owner != nullptr && owner->mutate_list() != nullptr)
+    {
+	owner->mutate_list()->free(pointer);
+    }
+    else if (owner != nullptr)
+    {
+	owner->free(pointer);
+    }
+}
+
+template <class value_t>
+void slab_shared_ptr<value_t>::release() noexcept
+{
+    if (node_ != nullptr && node_->count.fetch_sub(1U, std::memory_order_acq_rel) == 1U)
+    {
+	slab_deleter<node_type>()(node_);
+    }
+    node_ = nullptr;
+}
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef TURBO_MEMORY_SLAB_PTR_HPP
+#define TURBO_MEMORY_SLAB_PTR_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace turbo {
+namespace memory {
+
+class concurrent_sized_slab;
+
+template <class type_index_t>
+class concurrent_typed_slab;
+
+template <class... types_t>
+class typed_slab;
+
+///
+/// Destroys a value and returns its slot through the list of the block that owns it,
+/// which is found through block::find_owner, so the deleter needs no state and the
+/// free is counted and traced like any other free from the bucket. It does not convert
+/// from the deleter of another type, since a base could sit at an offset inside the
+/// derived slot and would be destroyed without virtual dispatch.
+///
+template <class value_t>
+struct slab_deleter
+{
+    inline slab_deleter() noexcept = default;
+    template <class other_t>
+    slab_deleter(const slab_deleter<other_t>&) = delete;
+    void operator()(value_t* pointer) const;
+};
+
+///
+/// Has the same size as a raw pointer
+///
+template <class value_t>
+using slab_unique_ptr = std::unique_ptr<value_t, slab_deleter<value_t>>;
+
+///
+/// A pointer sized shared handle to a value in a slab. The reference count sits in the
+/// slab slot next to the value, so a slab bucket has to be big enough for node_type
+/// rather than for value_t. There are no weak references, and the handle cannot be
+/// converted to a handle of another type.
+///
+template <class value_t>
+class slab_shared_ptr
+{
+public:
+    typedef value_t element_type;
+    struct node_type
+    {
+	template <class... args_t>
+	inline explicit node_type(args_t&&... args)
+	    :
+		count(1U),
+		value(std::forward<args_t>(args)...)
+	{ }
+	std::atomic<std::uint32_t> count;
+	value_t value;
+    };
+    inline slab_shared_ptr() noexcept : node_(nullptr) { }
+    inline slab_shared_ptr(std::nullptr_t) noexcept : node_(nullptr) { }
+    inline slab_shared_ptr(const slab_shared_ptr& other) noexcept
+	:
+	    node_(other.node_)
+    {
+	acquire();
+    }
+    inline slab_shared_ptr(slab_shared_ptr&& other) noexcept
+	:
+	    node_(other.node_)
+    {
+	other.node_ = nullptr;
+    }
+    inline ~slab_shared_ptr() noexcept
+    {
+	release();
+    }
+    inline slab_shared_ptr& operator=(const slab_shared_ptr& other) noexcept
+    {
+	slab_shared_ptr(other).swap(*this);
+	return *this;
+    }
+    inline slab_shared_ptr& operator=(slab_shared_ptr&& other) noexcept
+    {
+	slab_shared_ptr(std::move(other)).swap(*this);
+	return *this;
+    }
+    inline bool operator==(const slab_shared_ptr& other) const noexcept { return node_ == other.node_; }
+    inline bool operator!=(const slab_shared_ptr& other) const noexcept { return !(*this == other); }
+    inline explicit operator bool() const noexcept { return node_ != nullptr; }
+    inline value_t& operator*() const noexcept { return node_->value; }
+    inline value_t* operator->() const noexcept { return &(node_->value); }
+    inline value_t* get() const noexcept { return node_ == nullptr ? nullptr : &(node_->value); }
+    ///
+    /// Only a hint while other threads are copying or dropping handles
+    ///
+    inline std::uint32_t use_count() const noexcept
+    {
+	return node_ == nullptr ? 0U : node_->count.load(std::memory_order_relaxed);
+    }
+    inline void swap(slab_shared_ptr& other) noexcept
+    {
+	std::swap(node_, other.node_);
+    }
+    inline void reset() noexcept
+    {
+	slab_shared_ptr().swap(*this);
+    }
+    friend class concurrent_sized_slab;
+    template <class type_index_t>
+    friend class concurrent_typed_slab;
+    template <class... types_t>
+    friend class typed_slab;
+private:
+    ///
+    /// Takes over a node that has just been constructed with a count of 1
+    ///
+    explicit inline slab_shared_ptr(node_type* node) noexcept : node_(node) { }
+    inline void acquire() noexcept
+    {
+	if (node_ != nullptr)
+	{
+	    node_->count.fetch_add(1U, std::memory_order_relaxed);
+	}
+    }
+    void release() noexcept;
+    node_type* node_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,86 @@
+#include "slab_statistics.hpp"
+#include "slab_statistics.hh"
+
+namespace turbo {
+namespace memory {
+
+const std::size_t sharded_counter::shard_count;
+
+static_assert(sizeof(sharded_counter) == sharded_counter::shard_count * LEVEL1_DCACHE_LINESIZE, "shards of sharded_counter must be exactly one cache line apart");
+
+bucket_statistics::bucket_statistics()
+    :
+	value_size(0U),
+	allocations(0U),
+	frees(0U),
+	live_objects(0),
+	high_water_mark(0),
+	contingency_appends(0U),
+	cas_retries(0U)
+{ }
+
+sharded_counter::sharded_counter()
+{
+    for (auto&& shard : shards_)
+    {
+	shard.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::int64_t sharded_counter::sum() const
+{
+    std::int64_t result = 0;
+    for (auto&& shard : shards_)
+    {
+	result += shard.value.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+#if defined(TURBO_MEMORY_STATISTICS)
+
+const std::uint32_t list_statistics::sample_period;
+
+list_statistics::list_statistics()
+    :
+	allocations_(),
+	frees_(),
+	cas_retries_(),
+	contingency_appends_(0U),
+	high_water_mark_(0)
+{ }
+
+void list_statistics::sample_high_water_mark() const
+{
+    const std::int64_t live = allocations_.sum() - frees_.sum();
+    std::int64_t mark = high_water_mark_.load(std::memory_order_relaxed);
+    while (mark < live && !high_water_mark_.compare_exchange_weak(mark, live, std::memory_order_relaxed)) { }
+}
+
+bucket_statistics list_statistics::snapshot(std::size_t value_size) const
+{
+    sample_high_water_mark();
+    bucket_statistics result;
+    result.value_size = value_size;
+    result.allocations = static_cast<std::uint64_t>(allocations_.sum());
+    result.frees = static_cast<std::uint64_t>(frees_.sum());
+    result.live_objects = static_cast<std::int64_t>(result.allocations - result.frees);
+    result.high_water_mark = high_water_mark_.load(std::memory_order_relaxed);
+    result.contingency_appends = contingency_appends_.load(std::memory_order_relaxed);
+    result.cas_retries = static_cast<std::uint64_t>(cas_retries_.sum());
+    return result;
+}
+
+#else
+
+bucket_statistics list_statistics::snapshot(std::size_t value_size) const
+{
+    bucket_statistics result;
+    result.value_size = value_size;
+    return result;
+}
+
+#endif
+
+} // namespace memory
+} // namespace turbo
@@ -0,0 +1,83 @@
+#ifndef TURBO_MEMORY_SLAB_STATISTICS_HXX
+#define TURBO_MEMORY_SLAB_STATISTICS_HXX
+
+#include <turbo/memory/slab_statistics.hpp>
+
+namespace turbo {
+namespace memory {
+
+std::size_t sharded_counter::get_shard_index()
+{
+    static std::atomic<std::size_t> next_index(0U);
+    thread_local std::size_t index = next_index.fetch_add(1U, std::memory_order_relaxed) % shard_count;
+    return index;
+}
+
+void sharded_counter::add(std::int64_t delta)
+{
+    shards_[get_shard_index()].value.fetch_add(delta, std::memory_order_relaxed);
+}
+
+#if defined(TURBO_MEMORY_STATISTICS)
+
+inline std::uint64_t& get_retry_count()
+{
+    thread_local std::uint64_t count = 0U;
+    return count;
+}
+
+void count_retry()
+{
+    ++get_retry_count();
+}
+
+std::uint64_t take_retry_count()
+{
+    const std::uint64_t count = get_retry_count();
+    get_retry_count() = 0U;
+    return count;
+}
+
+void list_statistics::record_allocate(std::size_t quantity)
+{
+    thread_local std::size_t tick = 0U;
+    allocations_.add(static_cast<std::int64_t>(quantity));
+    tick += quantity;
+    if (sample_period <= tick)
+    {
+	tick = 0U;
+	sample_high_water_mark();
+    }
+    const std::uint64_t retries = take_retry_count();
+    if (retries != 0U)
+    {
+	cas_retries_.add(static_cast<std::int64_t>(retries));
+    }
+}
+
+void list_statistics::record_free(std::size_t quantity)
+{
+    frees_.add(static_cast<std::int64_t>(quantity));
+    const std::uint64_t retries = take_retry_count();
+    if (retries != 0U)
+    {
+	cas_retries_.add(static_cast<std::int64_t>(retries));
+    }
+}
+
+#else
+
+void count_retry()
+{ }
+
+std::uint64_t take_retry_count()
+{
+    return 0U;
+}
+
+#endif
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef TURBO_MEMORY_SLAB_STATISTICS_HPP
+#define TURBO_MEMORY_SLAB_STATISTICS_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <atomic>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace memory {
+
+///
+/// Point in time view of the activity of one block_list, i.e. one slab bucket.
+/// Everything except value_size stays 0 unless TURBO_MEMORY_STATISTICS is defined.
+///
+struct TURBO_SYMBOL_DECL bucket_statistics
+{
+    bucket_statistics();
+    std::size_t value_size;
+    std::uint64_t allocations;
+    std::uint64_t frees;
+    std::int64_t live_objects;
+    std::int64_t high_water_mark;
+    std::uint64_t contingency_appends;
+    std::uint64_t cas_retries;
+};
+
+///
+/// A counter split into cache line sized shards so that threads incrementing it
+/// concurrently rarely touch the same line; reading it sums every shard. The shards
+/// are padded rather than aligned so that nothing holding a counter needs an over
+/// aligned allocation.
+///
+class TURBO_SYMBOL_DECL sharded_counter
+{
+public:
+    static const std::size_t shard_count = 16U;
+    sharded_counter();
+    inline void add(std::int64_t delta);
+    std::int64_t sum() const;
+private:
+    struct shard
+    {
+	std::atomic<std::int64_t> value;
+	std::uint8_t padding[LEVEL1_DCACHE_LINESIZE - sizeof(std::atomic<std::int64_t>)];
+    };
+    sharded_counter(const sharded_counter&) = delete;
+    sharded_counter(sharded_counter&&) = delete;
+    sharded_counter& operator=(const sharded_counter&) = delete;
+    sharded_counter& operator=(sharded_counter&&) = delete;
+    static inline std::size_t get_shard_index();
+    std::array<shard, shard_count> shards_;
+};
+
+///
+/// Blocks record every compare and swap they have to retry against the calling
+/// thread; the next block_list operation on that thread collects the count
+///
+inline void count_retry();
+inline std::uint64_t take_retry_count();
+
+#if defined(TURBO_MEMORY_STATISTICS)
+
+///
+/// The counters kept by each block_list. The high water mark is sampled every
+/// sample_period allocations per thread and whenever a snapshot is taken, so it can
+/// undershoot a short lived peak.
+///
+class TURBO_SYMBOL_DECL list_statistics
+{
+public:
+    static const std::uint32_t sample_period = 64U;
+    list_statistics();
+    inline void record_allocate(std::size_t quantity);
+    inline void record_free(std::size_t quantity);
+    inline void record_append() { contingency_appends_.fetch_add(1U, std::memory_order_relaxed); }
+    bucket_statistics snapshot(std::size_t value_size) const;
+private:
+    list_statistics(const list_statistics&) = delete;
+    list_statistics(list_statistics&&) = delete;
+    list_statistics& operator=(const list_statistics&) = delete;
+    list_statistics& operator=(list_statistics&&) = delete;
+    void sample_high_water_mark() const;
+    sharded_counter allocations_;
+    sharded_counter frees_;
+    sharded_counter cas_retries_;
+    std::atomic<std::uint64_t> contingency_appends_;
+    mutable std::atomic<std::int64_t> high_water_mark_;
+};
+
+#else
+
+class TURBO_SYMBOL_DECL list_statistics
+{
+public:
+    inline void record_allocate(std::size_t) { }
+    inline void record_free(std::size_t) { }
+    inline void record_append() { }
+    bucket_statistics snapshot(std::size_t value_size) const;
+};
+
+#endif
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef TURBO_MEMORY_SLAB_STD_ALLOCATOR_HXX
+#define TURBO_MEMORY_SLAB_STD_ALLOCATOR_HXX
+
+#include <turbo/memory/slab_std_allocator.hpp>
+#include <limits>
+#include <new>
+#include <turbo/memory/block.hpp>
+#include <turbo/memory/large_object.hpp>
+#include <turbo/memory/slab_allocator.hh>
+#include <turbo/toolset/extension.hpp>
+
+namespace turbo {
+namespace memory {
+
+template <class value_t>
+value_t* slab_std_policy<concurrent_sized_slab>::allocate(concurrent_sized_slab& slab, std::size_t quantity)
+{
+    if (TURBO_UNLIKELY(quantity > std::numeric_limits<block::capacity_type>::max()))
+    {
+	return nullptr;
+    }
+    // arrays go to the bucket of their total size, or to the large object tier if there is one
+    return slab.template allocate<value_t>(static_cast<block::capacity_type>(quantity));
+}
+
+template <class value_t>
+bool slab_std_policy<concurrent_sized_slab>::deallocate(concurrent_sized_slab& slab, value_t* pointer, std::size_t quantity)
+{
+    large_object_tier* tier = slab.get_large_object_tier();
+    if (block::find_owner(pointer) != nullptr || (tier != nullptr && tier->owns(pointer)))
+    {
+	slab.template deallocate<value_t>(pointer, static_cast<block::capacity_type>(quantity));
+	return true;
+    }
+    return false;
+}
+
+template <class type_index_t>
+template <class value_t>
+value_t* slab_std_policy<concurrent_typed_slab<type_index_t>>::allocate(concurrent_typed_slab<type_index_t>& slab, std::size_t quantity)
+{
+    // a typed slab only holds single values
+    if (quantity != 1U || !slab.template in_configured_range<value_t>())
+    {
+	return nullptr;
+    }
+    return slab.template allocate<value_t>();
+}
+
+template <class type_index_t>
+template <class value_t>
+bool slab_std_policy<concurrent_typed_slab<type_index_t>>::deallocate(concurrent_typed_slab<type_index_t>& slab, value_t* pointer, std::size_t quantity)
+{
+    if (quantity == 1U && block::find_owner(pointer) != nullptr)
+    {
+	slab.template deallocate<value_t>(pointer);
+	return true;
+    }
+    return false;
+}
+
+template <class value_t, class slab_t>
+value_t* slab_std_allocator<value_t, slab_t>::allocate(size_type quantity)
+{
+    if (TURBO_UNLIKELY(quantity > max_size()))
+    {
+	throw std::bad_alloc();
+    }
+    if (TURBO_LIKELY(slab_ != nullptr && quantity != 0U))
+    {
+	value_t* result = slab_std_policy<slab_t>::template allocate<value_t>(*slab_, quantity);
+	if (TURBO_LIKELY(result != nullptr))
+	{
+	    return result;
+	}
+    }
+    return static_cast<value_t*>(::operator new(quantity * sizeof(value_t)));
+}
+
+template <class value_t, class slab_t>
+void slab_std_allocator<value_t, slab_t>::deallocate(value_t* pointer, size_type quantity) noexcept
+{
+    if (pointer == nullptr)
+    {
+	return;
+    }
+    if (slab_ == nullptr || !slab_std_policy<slab_t>::template deallocate<value_t>(*slab_, pointer, quantity))
+    {
+	::operator delete(pointer);
+    }
+}
+
+} // namespace memory
+} // namespace turbo
+
+#endif
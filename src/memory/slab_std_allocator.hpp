@@ -0,0 +1,106 @@
+#ifndef TURBO_MEMORY_SLAB_STD_ALLOCATOR_HPP
+#define TURBO_MEMORY_SLAB_STD_ALLOCATOR_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/toolset/attribute.hpp>
+
+namespace turbo {
+namespace memory {
+
+///
+/// How slab_std_allocator talks to each kind of slab; allocate returns nullptr and
+/// deallocate returns false when the slab cannot serve the request
+///
+template <class slab_t>
+struct slab_std_policy;
+
+template <>
+struct slab_std_policy<concurrent_sized_slab>
+{
+    template <class value_t>
+    static inline value_t* allocate(concurrent_sized_slab& slab, std::size_t quantity);
+    template <class value_t>
+    static inline bool deallocate(concurrent_sized_slab& slab, value_t* pointer, std::size_t quantity);
+};
+
+template <class type_index_t>
+struct slab_std_policy<concurrent_typed_slab<type_index_t>>
+{
+    template <class value_t>
+    static inline value_t* allocate(concurrent_typed_slab<type_index_t>& slab, std::size_t quantity);
+    template <class value_t>
+    static inline bool deallocate(concurrent_typed_slab<type_index_t>& slab, value_t* pointer, std::size_t quantity);
+};
+
+///
+/// A stateful C++11 allocator that lets standard containers, and the allocator_t
+/// parameters of turbo's containers, draw from a slab. Rebound copies share the slab,
+/// so node and bucket allocations of a container all land in it. Requests the slab
+/// cannot serve, because the size has no bucket or the bucket is full, fall back to
+/// the global operator new; deallocate finds where each address came from.
+///
+/// A default constructed allocator has no slab and always falls back, which lets
+/// containers that default construct their allocator still compile. For those, alias
+/// the allocator to a slab bound one; see test/memory/slab_std_allocator_test.cxx.
+///
+template <class value_t, class slab_t = concurrent_sized_slab>
+class slab_std_allocator
+{
+public:
+    typedef value_t value_type;
+    typedef slab_t slab_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef value_t* pointer;
+    typedef const value_t* const_pointer;
+    typedef value_t& reference;
+    typedef const value_t& const_reference;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+    template <class other_t>
+    struct rebind
+    {
+	typedef slab_std_allocator<other_t, slab_t> other;
+    };
+    inline slab_std_allocator() noexcept : slab_(nullptr) { }
+    explicit inline slab_std_allocator(slab_t& slab) noexcept : slab_(&slab) { }
+    inline slab_std_allocator(const slab_std_allocator& other) noexcept = default;
+    template <class other_t>
+    inline slab_std_allocator(const slab_std_allocator<other_t, slab_t>& other) noexcept : slab_(other.get_slab()) { }
+    inline slab_std_allocator& operator=(const slab_std_allocator& other) noexcept = default;
+    inline slab_t* get_slab() const noexcept { return slab_; }
+    ///
+    /// Throws std::bad_alloc if neither the slab nor the fallback can serve the request
+    ///
+    value_t* allocate(size_type quantity);
+    inline value_t* allocate(size_type quantity, const void*)
+    {
+	return allocate(quantity);
+    }
+    void deallocate(value_t* pointer, size_type quantity) noexcept;
+    inline size_type max_size() const noexcept
+    {
+	return static_cast<size_type>(-1) / sizeof(value_t);
+    }
+    template <class other_t>
+    inline bool operator==(const slab_std_allocator<other_t, slab_t>& other) const noexcept
+    {
+	return slab_ == other.get_slab();
+    }
+    template <class other_t>
+    inline bool operator!=(const slab_std_allocator<other_t, slab_t>& other) const noexcept
+    {
+	return slab_ != other.get_slab();
+    }
+private:
+    slab_t* slab_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+#endif
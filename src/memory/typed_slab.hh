@@ -0,0 +1,118 @@
+#ifndef TURBO_MEMORY_TYPED_SLAB_HXX
+#define TURBO_MEMORY_TYPED_SLAB_HXX
+
+#include <turbo/memory/typed_slab.hpp>
+#include <algorithm>
+#include <turbo/memory/allocation_trace.hh>
+#include <turbo/memory/block.hh>
+#include <turbo/memory/slab_ptr.hh>
+
+namespace turbo {
+namespace memory {
+
+template <class... t>
+const std::size_t typed_slab<t...>::type_count;
+
+template <class... t>
+constexpr std::array<std::size_t, sizeof...(t)> typed_slab<t...>::value_sizes;
+
+template <class... t>
+typed_slab<t...>::typed_slab(block::capacity_type initial_capacity, block::capacity_type contingency_capacity)
+    :
+	typed_slab(
+		[&] () -> std::array<block::capacity_type, sizeof...(t)>
+		{
+		    std::array<block::capacity_type, sizeof...(t)> capacities;
+		    capacities.fill(initial_capacity);
+		    return capacities;
+		}(),
+		contingency_capacity)
+{ }
+
+template <class... t>
+typed_slab<t...>::typed_slab(const std::array<block::capacity_type, sizeof...(t)>& initial_capacities, block::capacity_type contingency_capacity)
+    :
+	block_map_()
+{
+    const std::vector<block_config> config(make_config(initial_capacities, contingency_capacity));
+    block_map_.reserve(config.size());
+    for (const block_config& bucket : config)
+    {
+	block_map_.emplace_back(bucket);
+    }
+}
+
+template <class... t>
+typed_slab<t...>::typed_slab(const typed_slab& other)
+    :
+	block_map_(other.block_map_)
+{ }
+
+template <class... t>
+typed_slab<t...>& typed_slab<t...>::operator=(const typed_slab& other)
+{
+    if (this != &other)
+    {
+	std::copy_n(other.block_map_.cbegin(), this->block_map_.size(), this->block_map_.begin());
+    }
+    return *this;
+}
+
+template <class... t>
+bool typed_slab<t...>::operator==(const typed_slab& other) const
+{
+    return this->block_map_ == other.block_map_;
+}
+
+template <class... t>
+template <class value_t, class... args_t>
+std::pair<make_result, slab_unique_ptr<value_t>> typed_slab<t...>::make_unique(args_t&&... args)
+{
+    value_t* result = allocate<value_t>();
+    if (result != nullptr)
+    {
+	// the handle traces the free
+	trace_allocate(sizeof(value_t), result);
+	return std::make_pair(make_result::success, slab_unique_ptr<value_t>(new (result) value_t(std::forward<args_t>(args)...)));
+    }
+    else
+    {
+	return std::make_pair(make_result::slab_full, slab_unique_ptr<value_t>());
+    }
+}
+
+template <class... t>
+template <class value_t, class... args_t>
+std::pair<make_result, slab_shared_ptr<value_t>> typed_slab<t...>::make_shared(args_t&&... args)
+{
+    typedef typename slab_shared_ptr<value_t>::node_type node_type;
+    node_type* result = allocate<node_type>();
+    if (result != nullptr)
+    {
+	trace_allocate(sizeof(node_type), result);
+	return std::make_pair(make_result::success, slab_shared_ptr<value_t>(new (result) node_type(std::forward<args_t>(args)...)));
+    }
+    else
+    {
+	return std::make_pair(make_result::slab_full, slab_shared_ptr<value_t>());
+    }
+}
+
+template <class... t>
+std::vector<block_config> typed_slab<t...>::make_config(
+	const std::array<block::capacity_type, sizeof...(t)>& initial_capacities,
+	block::capacity_type contingency_capacity)
+{
+    std::vector<block_config> config;
+    config.reserve(sizeof...(t));
+    for (std::size_t bucket = 0U; bucket < sizeof...(t); ++bucket)
+    {
+	config.emplace_back(value_sizes[bucket], initial_capacities[bucket], contingency_capacity);
+    }
+    return config;
+}
+
+} // namespace memory
+} // namespace turbo
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef TURBO_MEMORY_TYPED_SLAB_HPP
+#define TURBO_MEMORY_TYPED_SLAB_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <turbo/memory/block.hpp>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/memory/slab_ptr.hpp>
+#include <turbo/type_utility/type_list.hpp>
+
+namespace turbo {
+namespace memory {
+
+///
+/// Whether a slot made for slot_t can hold a value_t
+///
+template <class value_t, class slot_t>
+struct fits_slot : std::integral_constant<bool, sizeof(value_t) == sizeof(slot_t) && alignof(value_t) <= alignof(slot_t)>
+{ };
+
+///
+/// A slab with one bucket per listed type, sized for that type. The bucket of a type is
+/// resolved at compile time, so allocate and deallocate go straight to their block_list
+/// with no range check; using a type that has no bucket does not compile.
+///
+/// There is no separate alignment setting: block_list aligns the values of a block to
+/// the value size, and sizeof of a type is always a multiple of its alignof, so every
+/// slot is aligned for its type.
+///
+/// A type that is not listed uses the first listed type it fits, see fits_slot, which
+/// lets a container's private node types be served by placeholder slots, e.g.
+/// std::aligned_storage<node_sizes[0], node_alignments[0]>::type
+///
+template <class... types_t>
+class TURBO_SYMBOL_DECL typed_slab
+{
+private:
+    typedef std::vector<block_list> block_map_type;
+public:
+    typedef block_map_type::iterator iterator;
+    typedef block_map_type::const_iterator const_iterator;
+    static const std::size_t type_count = sizeof...(types_t);
+    static constexpr std::array<std::size_t, sizeof...(types_t)> value_sizes
+    {
+	{ sizeof(types_t)... }
+    };
+    template <class value_t>
+    struct bucket_of : std::integral_constant<std::size_t,
+	    turbo::type_utility::index_of<value_t, types_t...>::value < sizeof...(types_t)
+		? turbo::type_utility::index_of<value_t, types_t...>::value
+		: turbo::type_utility::find_first<fits_slot, value_t, types_t...>::value>
+    {
+	static_assert(bucket_of::value < sizeof...(types_t), "typed_slab has no bucket for this type");
+    };
+    ///
+    /// Every bucket starts with the same capacity
+    ///
+    typed_slab(block::capacity_type initial_capacity, block::capacity_type contingency_capacity);
+    typed_slab(const std::array<block::capacity_type, sizeof...(types_t)>& initial_capacities, block::capacity_type contingency_capacity);
+    typed_slab(const typed_slab& other);
+    ~typed_slab() = default;
+    typed_slab& operator=(const typed_slab& other);
+    bool operator==(const typed_slab& other) const;
+    inline iterator begin()
+    {
+	return block_map_.begin();
+    }
+    inline iterator end()
+    {
+	return block_map_.end();
+    }
+    inline const_iterator cbegin() const
+    {
+	return block_map_.cbegin();
+    }
+    inline const_iterator cend() const
+    {
+	return block_map_.cend();
+    }
+    template <class value_t, class... args_t>
+    std::pair<make_result, slab_unique_ptr<value_t>> make_unique(args_t&&... args);
+    ///
+    /// Needs slab_shared_ptr<value_t>::node_type, or a slot it fits, in the type list
+    ///
+    template <class value_t, class... args_t>
+    std::pair<make_result, slab_shared_ptr<value_t>> make_shared(args_t&&... args);
+    template <class value_t>
+    inline value_t* allocate()
+    {
+	return static_cast<value_t*>(at<value_t>().allocate());
+    }
+    template <class value_t>
+    inline value_t* allocate(const value_t*)
+    {
+	return allocate<value_t>();
+    }
+    template <class value_t>
+    inline void deallocate(value_t* pointer)
+    {
+	at<value_t>().free(pointer);
+    }
+    template <class value_t>
+    inline const block_list& at() const
+    {
+	return block_map_[bucket_of<value_t>::value];
+    }
+    template <class value_t>
+    inline block_list& at()
+    {
+	return block_map_[bucket_of<value_t>::value];
+    }
+private:
+    typed_slab() = delete;
+    typed_slab(typed_slab&&) = delete;
+    typed_slab& operator=(typed_slab&&) = delete;
+    static std::vector<block_config> make_config(
+	    const std::array<block::capacity_type, sizeof...(types_t)>& initial_capacities,
+	    block::capacity_type contingency_capacity);
+    block_map_type block_map_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+#endif
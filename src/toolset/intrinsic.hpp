@@ -67,6 +67,18 @@ inline std::uint32_t count_leading_zero(std::uint16_t input)
 	    - std::numeric_limits<std::uint32_t>::digits;
 }
 
+///
+/// Hints to the processor that the caller is spinning on a value another thread writes
+///
+inline void cpu_relax()
+{
+#if defined( _WIN32) && defined(_MSC_VER)
+    _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#endif
+}
+
 } // namespace toolset
 } // namespace turbo
 
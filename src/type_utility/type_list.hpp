@@ -0,0 +1,50 @@
+#ifndef TURBO_TYPE_UTILITY_TYPE_LIST_HPP
+#define TURBO_TYPE_UTILITY_TYPE_LIST_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace turbo {
+namespace type_utility {
+
+///
+/// Index of the first type in types_t for which predicate_t<value_t, type>::value is
+/// true, or sizeof...(types_t) if there is none
+///
+template <template <class, class> class predicate_t, class value_t, class... types_t>
+struct find_first;
+
+template <template <class, class> class predicate_t, class value_t>
+struct find_first<predicate_t, value_t> : std::integral_constant<std::size_t, 0U>
+{ };
+
+template <template <class, class> class predicate_t, class value_t, class head_t, class... tail_t>
+struct find_first<predicate_t, value_t, head_t, tail_t...>
+    : std::integral_constant<std::size_t, predicate_t<value_t, head_t>::value ? 0U : 1U + find_first<predicate_t, value_t, tail_t...>::value>
+{ };
+
+///
+/// Index of value_t in types_t, or sizeof...(types_t) if it is not listed
+///
+template <class value_t, class... types_t>
+using index_of = find_first<std::is_same, value_t, types_t...>;
+
+template <std::size_t index, class... types_t>
+struct type_at;
+
+template <class head_t, class... tail_t>
+struct type_at<0U, head_t, tail_t...>
+{
+    typedef head_t type;
+};
+
+template <std::size_t index, class head_t, class... tail_t>
+struct type_at<index, head_t, tail_t...>
+{
+    typedef typename type_at<index - 1U, tail_t...>::type type;
+};
+
+} // namespace type_utility
+} // namespace turbo
+
+#endif
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <malloc.h>
+#include <turbo/cinterop/malloc_preload.hpp>
+#include <turbo/memory/block.hpp>
+
+namespace tci = turbo::cinterop;
+namespace tme = turbo::memory;
+
+///
+/// This test links against the preload library, so every allocation in the process,
+/// including those made by gtest and the standard library, goes through it
+///
+
+TEST(malloc_preload_test, malloc_basic)
+{
+    void* small1 = std::malloc(24U);
+    ASSERT_NE(nullptr, small1) << "Small allocation failed";
+    EXPECT_NE(nullptr, tme::block::find_owner(small1)) << "Small allocation did not come from a slab";
+    EXPECT_EQ(32U, malloc_usable_size(small1)) << "Small allocation has the wrong usable size";
+    EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(small1) % 16U) << "Small allocation is not aligned for every fundamental type";
+    std::memset(small1, 0xAB, 24U);
+    void* large1 = std::malloc(1U << 20U);
+    ASSERT_NE(nullptr, large1) << "Large allocation failed";
+    EXPECT_EQ(nullptr, tme::block::find_owner(large1)) << "Large allocation did not fall through to the system allocator";
+    EXPECT_LE(1U << 20U, malloc_usable_size(large1)) << "Large allocation has the wrong usable size";
+    std::free(small1);
+    std::free(large1);
+    std::free(nullptr);
+}
+
+TEST(malloc_preload_test, calloc_basic)
+{
+    for (std::size_t round = 0U; round < 64U; ++round)
+    {
+	// dirty some slots so that calloc has to clear a reused one
+	void* dirty = std::malloc(64U);
+	std::memset(dirty, 0xFF, 64U);
+	std::free(dirty);
+	unsigned char* clean = static_cast<unsigned char*>(std::calloc(8U, 8U));
+	ASSERT_NE(nullptr, clean) << "calloc failed";
+	for (std::size_t index = 0U; index < 64U; ++index)
+	{
+	    ASSERT_EQ(0U, clean[index]) << "calloc returned memory that is not zeroed";
+	}
+	std::free(clean);
+    }
+    EXPECT_EQ(nullptr, std::calloc(static_cast<std::size_t>(1U) << 62U, 16U)) << "calloc did not detect an overflowing size";
+}
+
+TEST(malloc_preload_test, realloc_basic)
+{
+    char* buffer = static_cast<char*>(std::realloc(nullptr, 10U));
+    ASSERT_NE(nullptr, buffer) << "realloc of nullptr failed";
+    std::strcpy(buffer, "abcdefghi");
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffer);
+    char* same = static_cast<char*>(std::realloc(buffer, 12U));
+    ASSERT_NE(nullptr, same) << "realloc within the same size class failed";
+    EXPECT_EQ(address, reinterpret_cast<std::uintptr_t>(same)) << "realloc within the same size class moved the allocation";
+    buffer = static_cast<char*>(std::realloc(same, 1000U));
+    ASSERT_NE(nullptr, buffer) << "realloc to a larger size class failed";
+    EXPECT_STREQ("abcdefghi", buffer) << "realloc to a larger size class lost the content";
+    buffer = static_cast<char*>(std::realloc(buffer, 1U << 20U));
+    ASSERT_NE(nullptr, buffer) << "realloc beyond the slabs failed";
+    EXPECT_EQ(nullptr, tme::block::find_owner(buffer)) << "realloc beyond the slabs did not fall through";
+    EXPECT_STREQ("abcdefghi", buffer) << "realloc beyond the slabs lost the content";
+    buffer = static_cast<char*>(std::realloc(buffer, 20U));
+    ASSERT_NE(nullptr, buffer) << "realloc back into the slabs failed";
+    EXPECT_STREQ("abcdefghi", buffer) << "realloc back into the slabs lost the content";
+    std::free(buffer);
+}
+
+TEST(malloc_preload_test, nested_section)
+{
+    void* slab1 = std::malloc(24U);
+    std::memset(slab1, 0, 24U);
+    ASSERT_NE(nullptr, tme::block::find_owner(slab1)) << "Small allocation did not come from a slab";
+    EXPECT_FALSE(tci::is_in_slab_section()) << "A section is open outside of the allocation functions";
+    {
+	tci::slab_section outer;
+	// free opens a section of its own around the slab
+	std::free(slab1);
+	EXPECT_TRUE(tci::is_in_slab_section()) << "Closing the inner section closed the outer one";
+	void* system1 = std::malloc(24U);
+	ASSERT_NE(nullptr, system1) << "Allocation inside a section failed";
+	EXPECT_EQ(nullptr, tme::block::find_owner(system1)) << "Allocation inside a section re-entered the slabs";
+	std::free(system1);
+    }
+    EXPECT_FALSE(tci::is_in_slab_section()) << "Closing the outer section did not restore the state";
+    void* slab2 = std::malloc(24U);
+    EXPECT_NE(nullptr, tme::block::find_owner(slab2)) << "Allocation after the section did not come from a slab";
+    std::free(slab2);
+}
+
+TEST(malloc_preload_test, aligned_basic)
+{
+    for (std::size_t alignment : { 8U, 16U, 64U, 256U, 4096U, 16384U })
+    {
+	void* pointer1 = nullptr;
+	ASSERT_EQ(0, posix_memalign(&pointer1, alignment, 40U)) << "posix_memalign failed for alignment " << alignment;
+	EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(pointer1) % alignment) << "posix_memalign ignored alignment " << alignment;
+	void* pointer2 = aligned_alloc(alignment, alignment * 2U);
+	ASSERT_NE(nullptr, pointer2) << "aligned_alloc failed for alignment " << alignment;
+	EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(pointer2) % alignment) << "aligned_alloc ignored alignment " << alignment;
+	void* pointer3 = memalign(alignment, 3U);
+	ASSERT_NE(nullptr, pointer3) << "memalign failed for alignment " << alignment;
+	EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(pointer3) % alignment) << "memalign ignored alignment " << alignment;
+	std::free(pointer1);
+	std::free(pointer2);
+	std::free(pointer3);
+    }
+    void* pointer4 = nullptr;
+    EXPECT_EQ(EINVAL, posix_memalign(&pointer4, 24U, 40U)) << "posix_memalign accepted an alignment that is not a power of 2";
+}
+
+TEST(malloc_preload_test, parallel_use)
+{
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0U; index < 4U; ++index)
+    {
+	threads.emplace_back([index] () -> void
+	{
+	    std::vector<std::unique_ptr<std::string>> strings;
+	    for (std::size_t count = 0U; count < 20000U; ++count)
+	    {
+		strings.emplace_back(new std::string(16U + (count * 7U + index) % 2000U, 'a' + index));
+		if (count % 3U == 0U)
+		{
+		    strings.erase(strings.begin() + (count % strings.size()));
+		}
+	    }
+	    for (auto&& value : strings)
+	    {
+		EXPECT_EQ(static_cast<char>('a' + index), (*value)[value->size() - 1U]) << "A string was overwritten";
+	    }
+	});
+    }
+    for (auto&& thread : threads)
+    {
+	thread.join();
+    }
+}
@@ -7,7 +7,9 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace turbo {
 namespace cinterop {
@@ -235,3 +237,99 @@ TEST(untyped_allocator_test, copy_assignent_additional_allocation)
     EXPECT_TRUE(std::equal(expected2a.cbegin(), expected2a.cend(), address2->cbegin()))
 	    << "Copy assignment from snapshot did not restore the allocator to the original state";
 }
+
+TEST(untyped_allocator_test, owns_basic)
+{
+    tci::untyped_allocator allocator1(1U, { {sizeof(record), 1U}, {sizeof(ipv4_address), 1U} });
+    tci::untyped_allocator allocator2(1U, { {sizeof(record), 1U}, {sizeof(ipv4_address), 1U} });
+    record* record1 = static_cast<record*>(allocator1.malloc(sizeof(record)));
+    ASSERT_NE(nullptr, record1) << "Unexpected malloc failure";
+    // the contingency block is only created by this malloc
+    record* record2 = static_cast<record*>(allocator1.malloc(sizeof(record)));
+    ASSERT_NE(nullptr, record2) << "Unexpected malloc failure";
+    EXPECT_TRUE(allocator1.owns(record1)) << "Allocator does not own its own allocation";
+    EXPECT_TRUE(allocator1.owns(record2)) << "Allocator does not own an allocation from a grown block";
+    EXPECT_EQ(sizeof(record), allocator1.usable_size(record2)) << "Unexpected usable size";
+    EXPECT_FALSE(allocator2.owns(record1)) << "Allocator owns another allocator's allocation";
+    EXPECT_EQ(0U, allocator2.usable_size(record1)) << "Usable size found for another allocator's allocation";
+    allocator2.free(record1);
+    record* record3 = static_cast<record*>(allocator2.malloc(sizeof(record)));
+    EXPECT_NE(record1, record3) << "Allocator freed another allocator's allocation";
+}
+
+TEST(untyped_allocator_test, parallel_use)
+{
+    tci::untyped_allocator allocator1(16U, { {sizeof(record), 16U}, {sizeof(ipv4_address), 16U} });
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0U; index < 4U; ++index)
+    {
+	threads.emplace_back([&allocator1, index] () -> void
+	{
+	    std::vector<record*> records;
+	    for (std::size_t round = 0U; round < 2000U; ++round)
+	    {
+		record* record1 = static_cast<record*>(allocator1.malloc(sizeof(record)));
+		ASSERT_NE(nullptr, record1) << "Unexpected malloc failure";
+		new (record1) record(static_cast<uint16_t>(index), static_cast<uint32_t>(round), 0U);
+		records.push_back(record1);
+		if (round % 3U == 2U)
+		{
+		    record* last = records.back();
+		    records.pop_back();
+		    allocator1.free(last);
+		}
+	    }
+	    for (record* record1 : records)
+	    {
+		EXPECT_EQ(index, record1->first) << "A record was overwritten by another thread";
+		allocator1.free(record1);
+	    }
+	});
+    }
+    for (auto&& thread : threads)
+    {
+	thread.join();
+    }
+    EXPECT_LT(2U, allocator1.get_block_count()) << "Allocator did not grow";
+}
+
+TEST(untyped_allocator_test, realloc_basic)
+{
+    tci::untyped_allocator allocator1(2U, { {16U, 2U}, {32U, 2U}, {64U, 2U} });
+    std::uint8_t* buffer1 = static_cast<std::uint8_t*>(allocator1.realloc(nullptr, 10U));
+    ASSERT_NE(nullptr, buffer1) << "Realloc of nullptr did not allocate";
+    std::fill_n(buffer1, 10U, 7U);
+    EXPECT_EQ(buffer1, allocator1.realloc(buffer1, 16U)) << "Realloc within the size class moved the allocation";
+    std::fill_n(buffer1, 16U, 7U);
+    std::uint8_t* buffer2 = static_cast<std::uint8_t*>(allocator1.realloc(buffer1, 40U));
+    ASSERT_NE(nullptr, buffer2) << "Realloc to a larger class failed";
+    EXPECT_NE(buffer1, buffer2) << "Realloc to a larger class did not move the allocation";
+    EXPECT_EQ(64U, allocator1.usable_size(buffer2)) << "Realloc picked the wrong size class";
+    EXPECT_TRUE(std::all_of(buffer2, buffer2 + 16U, [] (std::uint8_t value) -> bool { return value == 7U; })) << "Realloc did not copy the contents";
+    EXPECT_EQ(nullptr, allocator1.realloc(buffer2, 128U)) << "Realloc succeeded for an unsupported size";
+    EXPECT_EQ(64U, allocator1.usable_size(buffer2)) << "Failed realloc released the original allocation";
+    std::uint8_t* buffer3 = static_cast<std::uint8_t*>(allocator1.realloc(buffer2, 8U));
+    ASSERT_NE(nullptr, buffer3) << "Realloc to a smaller class failed";
+    EXPECT_EQ(16U, allocator1.usable_size(buffer3)) << "Realloc did not shrink to the smaller class";
+    EXPECT_TRUE(std::all_of(buffer3, buffer3 + 8U, [] (std::uint8_t value) -> bool { return value == 7U; })) << "Realloc did not copy the contents";
+    EXPECT_EQ(nullptr, allocator1.realloc(&buffer3, 8U)) << "Realloc succeeded for memory the allocator does not own";
+}
+
+TEST(untyped_allocator_test, aligned_alloc_basic)
+{
+    tci::untyped_allocator allocator1(2U, { {32U, 4U}, {64U, 4U}, {128U, 4U}, {256U, 4U} });
+    EXPECT_EQ(nullptr, allocator1.aligned_alloc(0U, 16U)) << "Aligned allocation succeeded for a zero alignment";
+    EXPECT_EQ(nullptr, allocator1.aligned_alloc(24U, 16U)) << "Aligned allocation succeeded for an alignment that is not a power of 2";
+    EXPECT_EQ(nullptr, allocator1.aligned_alloc(512U, 16U)) << "Aligned allocation succeeded without a suitably aligned class";
+    for (std::size_t alignment : { 8U, 16U, 32U, 64U, 128U, 256U })
+    {
+	for (std::size_t count = 0U; count < 8U; ++count)
+	{
+	    void* value1 = allocator1.aligned_alloc(alignment, 20U);
+	    ASSERT_NE(nullptr, value1) << "Aligned allocation failed for alignment " << alignment;
+	    EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(value1) % alignment) << "Allocation is not aligned to " << alignment;
+	}
+    }
+    void* value2 = allocator1.memalign(128U, 20U);
+    EXPECT_EQ(128U, allocator1.usable_size(value2)) << "Aligned allocation skipped the smallest suitably aligned class";
+}
@@ -69,3 +69,23 @@ TEST(concurrent_unordered_map_test, erase_basic)
     EXPECT_EQ(person_age_map::erase_result::key_not_found, map1.erase("c"))
 	    << "Non-existing key detection failed";
 }
+
+TEST(concurrent_unordered_map_test, emplace_node_size)
+{
+    typedef tco::concurrent_unordered_map<std::uint32_t, std::uint32_t> id_map;
+    static_assert(sizeof(id_map::value_type) == 8U, "value_type should exactly fill a power of 2 bucket");
+    // the reference count pushes the node past a bucket sized for the value alone
+    turbo::memory::concurrent_sized_slab allocator1(16U, { {sizeof(id_map::value_type), 32U} });
+    id_map map1(allocator1);
+    EXPECT_EQ(id_map::emplace_result::allocator_full, map1.try_emplace(std::make_tuple(1U), std::make_tuple(10U)))
+	    << "Emplace succeeded without a bucket for the node";
+    turbo::memory::concurrent_sized_slab allocator2(16U, { {sizeof(id_map::node_type), 32U} });
+    id_map map2(allocator2);
+    EXPECT_EQ(id_map::emplace_result::success, map2.try_emplace(std::make_tuple(1U), std::make_tuple(10U)))
+	    << "Emplace failed";
+    EXPECT_EQ(id_map::emplace_result::success, map2.try_emplace(std::make_tuple(2U), std::make_tuple(20U)))
+	    << "Emplace failed";
+    auto iter2 = map2.find(2U);
+    ASSERT_NE(map2.end(), iter2) << "Could not find just emplaced value";
+    EXPECT_EQ(20U, (*iter2)->second) << "Find returned the wrong value";
+}
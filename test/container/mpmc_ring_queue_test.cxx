@@ -3,12 +3,16 @@
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <stdexcept>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 #include <turbo/algorithm/recovery.hpp>
 #include <turbo/algorithm/recovery.hh>
 
@@ -802,3 +806,397 @@ TEST(mpmc_ring_queue_test, overflow)
     ASSERT_NE(consumer1.try_dequeue_copy(actual), uint_queue::consumer::result::queue_empty) << "Queue should not be empty";
     EXPECT_EQ(consumer1.try_dequeue_copy(actual), uint_queue::consumer::result::queue_empty) << "Queue should be empty";
 }
+
+TEST(mpmc_ring_queue_test, bulk_basic)
+{
+    typedef tco::mpmc_ring_queue<uint32_t> uint_queue;
+
+    uint_queue queue1(4, 2);
+    std::array<uint32_t, 6> input1 { {1U, 2U, 3U, 4U, 5U, 6U} };
+    uint32_t count1 = 0U;
+    ASSERT_EQ(uint_queue::producer::result::success, queue1.try_enqueue_bulk(input1.cbegin(), input1.cbegin() + 3, count1)) << "Bulk enqueue failed";
+    EXPECT_EQ(3U, count1) << "Bulk enqueue did not enqueue the whole range";
+    ASSERT_EQ(uint_queue::producer::result::success, queue1.try_enqueue_bulk(input1.cbegin() + 3, input1.cend(), count1)) << "Bulk enqueue failed";
+    EXPECT_EQ(1U, count1) << "Bulk enqueue did not stop at the queue capacity";
+    EXPECT_EQ(uint_queue::producer::result::queue_full, queue1.try_enqueue_bulk(input1.cbegin() + 4, input1.cend(), count1)) << "Queue should be full";
+    EXPECT_EQ(0U, count1) << "Bulk enqueue into a full queue reported values enqueued";
+    std::array<uint32_t, 6> output1 { {0U, 0U, 0U, 0U, 0U, 0U} };
+    ASSERT_EQ(uint_queue::consumer::result::success, queue1.try_dequeue_bulk(output1.begin(), 2U, count1)) << "Bulk dequeue failed";
+    EXPECT_EQ(2U, count1) << "Bulk dequeue did not stop at the limit";
+    ASSERT_EQ(uint_queue::consumer::result::success, queue1.try_dequeue_bulk(output1.begin() + 2, 6U, count1)) << "Bulk dequeue failed";
+    EXPECT_EQ(2U, count1) << "Bulk dequeue did not stop when the queue emptied";
+    for (std::size_t index = 0U; index < 4U; ++index)
+    {
+	EXPECT_EQ(input1[index], output1[index]) << "Values were not dequeued in the order they were enqueued";
+    }
+    EXPECT_EQ(uint_queue::consumer::result::queue_empty, queue1.try_dequeue_bulk(output1.begin(), 6U, count1)) << "Queue should be empty";
+
+    typedef tco::mpmc_ring_queue<uint64_t> ulong_queue;
+
+    ulong_queue queue2(4, 2);
+    std::array<uint64_t, 3> input2 { {7U, 8U, 9U} };
+    uint64_t single2 = 0U;
+    uint32_t count2 = 0U;
+    ASSERT_EQ(ulong_queue::producer::result::success, queue2.try_enqueue_copy(input2[0])) << "Enqueue failed";
+    ASSERT_EQ(ulong_queue::producer::result::success, queue2.try_enqueue_bulk(input2.cbegin() + 1, input2.cend(), count2)) << "Bulk enqueue failed";
+    EXPECT_EQ(2U, count2) << "Bulk enqueue did not enqueue the whole range";
+    ASSERT_EQ(ulong_queue::consumer::result::success, queue2.try_dequeue_copy(single2)) << "Dequeue failed";
+    EXPECT_EQ(input2[0], single2) << "Value enqueued singly was not dequeued first";
+    std::array<uint64_t, 2> output2 { {0U, 0U} };
+    ASSERT_EQ(ulong_queue::consumer::result::success, queue2.try_dequeue_bulk(output2.begin(), 2U, count2)) << "Bulk dequeue failed";
+    EXPECT_EQ(2U, count2) << "Bulk dequeue did not dequeue everything";
+    EXPECT_EQ(input2[1], output2[0]) << "Values were not dequeued in the order they were enqueued";
+    EXPECT_EQ(input2[2], output2[1]) << "Values were not dequeued in the order they were enqueued";
+}
+
+TEST(mpmc_ring_queue_test, capacity_rounding)
+{
+    typedef tco::mpmc_ring_queue<std::string> string_queue;
+    typedef tco::mpmc_ring_queue<uint32_t> uint_queue;
+
+    EXPECT_EQ(0U, tco::calc_ring_capacity(0U)) << "Empty capacity was rounded up";
+    EXPECT_EQ(1U, tco::calc_ring_capacity(1U)) << "Power of two capacity was changed";
+    EXPECT_EQ(8U, tco::calc_ring_capacity(5U)) << "Capacity was not rounded up to a power of two";
+    EXPECT_EQ(1U << 31U, tco::calc_ring_capacity((1U << 30U) + 1U)) << "Largest capacity was not rounded up";
+    EXPECT_THROW(tco::calc_ring_capacity((1U << 31U) + 1U), std::invalid_argument) << "Capacity beyond 2^31 was accepted";
+
+    string_queue queue1(5U, 1U);
+    EXPECT_EQ(8U, queue1.get_capacity()) << "Queue capacity was not rounded up";
+    for (uint32_t count = 0U; count < 8U; ++count)
+    {
+	ASSERT_EQ(string_queue::producer::result::success, queue1.try_enqueue_copy(std::to_string(count))) << "Queue should not be full";
+    }
+    EXPECT_EQ(string_queue::producer::result::queue_full, queue1.try_enqueue_copy("full")) << "Queue should be full";
+    std::string actual1;
+    for (uint32_t count = 0U; count < 8U; ++count)
+    {
+	ASSERT_EQ(string_queue::consumer::result::success, queue1.try_dequeue_copy(actual1)) << "Queue should not be empty";
+	EXPECT_EQ(std::to_string(count), actual1) << "Values were not dequeued in the order they were enqueued";
+    }
+    EXPECT_EQ(string_queue::consumer::result::queue_empty, queue1.try_dequeue_copy(actual1)) << "Queue should be empty";
+
+    uint_queue queue2(0U, 1U);
+    uint32_t actual2 = 0U;
+    uint32_t count2 = 0U;
+    std::array<uint32_t, 2> input2 { {1U, 2U} };
+    EXPECT_EQ(uint_queue::producer::result::queue_full, queue2.try_enqueue_copy(1U)) << "Empty queue accepted a value";
+    EXPECT_EQ(uint_queue::producer::result::queue_full, queue2.try_enqueue_bulk(input2.cbegin(), input2.cend(), count2)) << "Empty queue accepted values";
+    EXPECT_EQ(uint_queue::consumer::result::queue_empty, queue2.try_dequeue_copy(actual2)) << "Empty queue returned a value";
+    EXPECT_EQ(uint_queue::consumer::result::queue_empty, queue2.try_dequeue_bulk(input2.begin(), 2U, count2)) << "Empty queue returned values";
+}
+
+TEST(mpmc_ring_queue_test, single_slot)
+{
+    typedef tco::mpmc_ring_queue<std::string> string_queue;
+    typedef tco::mpmc_ring_queue<uint32_t> uint_queue;
+
+    string_queue queue1(1, 2);
+    EXPECT_EQ(2U, queue1.get_capacity()) << "Single slot queue was not given a second slot";
+    EXPECT_EQ(string_queue::producer::result::success, queue1.try_enqueue_copy("abc")) << "Enqueue into an empty queue failed";
+    EXPECT_EQ(string_queue::producer::result::success, queue1.try_enqueue_copy("def")) << "Enqueue into a queue with room failed";
+    EXPECT_EQ(string_queue::producer::result::queue_full, queue1.try_enqueue_copy("ghi")) << "Queue should be full";
+    std::string output1;
+    ASSERT_EQ(string_queue::consumer::result::success, queue1.try_dequeue_copy(output1)) << "Dequeue failed";
+    EXPECT_EQ(std::string("abc"), output1) << "A value was overwritten";
+    uint_queue queue2(1, 2);
+    EXPECT_EQ(uint_queue::producer::result::success, queue2.try_enqueue_copy(1U)) << "Enqueue into an empty queue failed";
+    EXPECT_EQ(uint_queue::producer::result::success, queue2.try_enqueue_copy(2U)) << "Enqueue into a queue with room failed";
+    EXPECT_EQ(uint_queue::producer::result::queue_full, queue2.try_enqueue_copy(3U)) << "Queue should be full";
+    uint32_t output2 = 0U;
+    ASSERT_EQ(uint_queue::consumer::result::success, queue2.try_dequeue_copy(output2)) << "Dequeue failed";
+    EXPECT_EQ(1U, output2) << "A value was overwritten";
+}
+
+TEST(mpmc_ring_queue_test, parallel_never_beaten)
+{
+    typedef tco::mpmc_ring_queue<uint32_t> uint_queue;
+    const uint32_t thread_count = 4U;
+    const uint32_t per_thread = 20000U;
+
+    uint_queue queue1(64U, thread_count);
+    std::atomic<uint32_t> beaten1(0U);
+    std::atomic<uint64_t> sum1(0U);
+    std::vector<std::thread> threads;
+    for (uint32_t thread = 0U; thread < thread_count; ++thread)
+    {
+	threads.emplace_back([&, thread] ()
+	{
+	    uint_queue::producer& producer = queue1.get_producer();
+	    for (uint32_t count = 0U; count < per_thread;)
+	    {
+		const uint_queue::producer::result result = producer.try_enqueue_copy(thread * per_thread + count);
+		if (result == uint_queue::producer::result::success)
+		{
+		    ++count;
+		}
+		else if (result == uint_queue::producer::result::beaten)
+		{
+		    beaten1.fetch_add(1U);
+		}
+		else
+		{
+		    std::this_thread::yield();
+		}
+	    }
+	});
+	threads.emplace_back([&] ()
+	{
+	    uint_queue::consumer& consumer = queue1.get_consumer();
+	    uint32_t value = 0U;
+	    for (uint32_t count = 0U; count < per_thread;)
+	    {
+		const uint_queue::consumer::result result = consumer.try_dequeue_copy(value);
+		if (result == uint_queue::consumer::result::success)
+		{
+		    sum1.fetch_add(value);
+		    ++count;
+		}
+		else if (result == uint_queue::consumer::result::beaten)
+		{
+		    beaten1.fetch_add(1U);
+		}
+		else
+		{
+		    std::this_thread::yield();
+		}
+	    }
+	});
+    }
+    for (std::thread& thread : threads)
+    {
+	thread.join();
+    }
+    const uint64_t total = static_cast<uint64_t>(thread_count) * per_thread;
+    EXPECT_EQ(total * (total - 1U) / 2U, sum1.load()) << "Values were lost or duplicated";
+    EXPECT_EQ(0U, beaten1.load()) << "A producer or consumer reported losing a slot";
+}
+
+TEST(mpmc_ring_queue_test, bulk_handles)
+{
+    typedef tco::mpmc_ring_queue<std::string> string_queue;
+
+    string_queue queue1(4U, 1U);
+    string_queue::producer& producer1 = queue1.get_producer();
+    string_queue::consumer& consumer1 = queue1.get_consumer();
+    std::array<std::string, 6> input1 { {"a", "b", "c", "d", "e", "f"} };
+    uint32_t count1 = 0U;
+    ASSERT_EQ(string_queue::producer::result::success, producer1.try_enqueue_bulk(input1.cbegin(), input1.cend(), count1)) << "Bulk enqueue failed";
+    EXPECT_EQ(4U, count1) << "Bulk enqueue did not stop at the queue capacity";
+    EXPECT_EQ(string_queue::producer::result::queue_full, producer1.try_enqueue_bulk(input1.cbegin() + 4, input1.cend(), count1)) << "Queue should be full";
+    EXPECT_EQ(0U, count1) << "Bulk enqueue into a full queue reported values enqueued";
+    std::array<std::string, 6> output1;
+    ASSERT_EQ(string_queue::consumer::result::success, consumer1.try_dequeue_bulk(output1.begin(), 3U, count1)) << "Bulk dequeue failed";
+    EXPECT_EQ(3U, count1) << "Bulk dequeue did not stop at the limit";
+    // wraps around the end of the ring
+    ASSERT_EQ(string_queue::producer::result::success, producer1.try_enqueue_bulk(input1.cbegin() + 4, input1.cend(), count1)) << "Bulk enqueue failed";
+    EXPECT_EQ(2U, count1) << "Bulk enqueue did not enqueue the whole range";
+    ASSERT_EQ(string_queue::consumer::result::success, consumer1.try_dequeue_bulk(output1.begin() + 3, 6U, count1)) << "Bulk dequeue failed";
+    EXPECT_EQ(3U, count1) << "Bulk dequeue did not stop when the queue emptied";
+    EXPECT_EQ(input1, output1) << "Values were not dequeued in the order they were enqueued";
+    EXPECT_EQ(string_queue::consumer::result::queue_empty, consumer1.try_dequeue_bulk(output1.begin(), 6U, count1)) << "Queue should be empty";
+
+    typedef tco::mpmc_ring_queue<std::unique_ptr<std::string>> unique_queue;
+    unique_queue queue2(4U, 1U);
+    std::array<std::unique_ptr<std::string>, 2> input2 { {std::unique_ptr<std::string>(new std::string("x")), std::unique_ptr<std::string>(new std::string("y"))} };
+    uint32_t count2 = 0U;
+    ASSERT_EQ(unique_queue::producer::result::success, queue2.try_enqueue_bulk(std::make_move_iterator(input2.begin()), std::make_move_iterator(input2.end()), count2)) << "Bulk move enqueue failed";
+    EXPECT_EQ(2U, count2) << "Bulk move enqueue did not enqueue the whole range";
+    EXPECT_FALSE(input2[0]) << "Value was not moved into the queue";
+    std::array<std::unique_ptr<std::string>, 2> output2;
+    ASSERT_EQ(unique_queue::consumer::result::success, queue2.try_dequeue_bulk(output2.begin(), 2U, count2)) << "Bulk dequeue failed";
+    ASSERT_TRUE(output2[0] && output2[1]) << "Values were not moved out of the queue";
+    EXPECT_EQ("x", *output2[0]) << "Values were not dequeued in the order they were enqueued";
+    EXPECT_EQ("y", *output2[1]) << "Values were not dequeued in the order they were enqueued";
+}
+
+namespace {
+
+///
+/// Throws when a poisoned value is assigned to it
+///
+struct fragile
+{
+    fragile() : value(0), poisoned(false) { }
+    fragile(int the_value, bool is_poisoned) : value(the_value), poisoned(is_poisoned) { }
+    fragile(const fragile& other) = default;
+    fragile& operator=(const fragile& other)
+    {
+	if (other.poisoned)
+	{
+	    throw std::runtime_error("poisoned value");
+	}
+	value = other.value;
+	poisoned = false;
+	return *this;
+    }
+    int value;
+    bool poisoned;
+};
+
+} // anonymous namespace
+
+TEST(mpmc_ring_queue_test, throwing_enqueue)
+{
+    typedef tco::mpmc_ring_queue<fragile> fragile_queue;
+
+    fragile_queue queue1(4U, 1U);
+    std::array<fragile, 4> input1 { {fragile(1, false), fragile(2, false), fragile(3, true), fragile(4, false)} };
+    uint32_t count1 = 0U;
+    EXPECT_THROW(queue1.try_enqueue_bulk(input1.cbegin(), input1.cend(), count1), std::runtime_error) << "Bulk enqueue swallowed the exception";
+    EXPECT_EQ(2U, count1) << "Bulk enqueue did not count the values written before the exception";
+    std::array<fragile, 4> output1;
+    ASSERT_EQ(fragile_queue::consumer::result::success, queue1.try_dequeue_bulk(output1.begin(), 4U, count1)) << "Bulk dequeue failed";
+    EXPECT_EQ(2U, count1) << "Bulk dequeue returned the slots skipped by the failed enqueue";
+    EXPECT_EQ(1, output1[0].value) << "Values were not dequeued in the order they were enqueued";
+    EXPECT_EQ(2, output1[1].value) << "Values were not dequeued in the order they were enqueued";
+    EXPECT_EQ(fragile_queue::consumer::result::queue_empty, queue1.try_dequeue_bulk(output1.begin(), 4U, count1)) << "Skipped slots were not given back";
+    EXPECT_THROW(queue1.try_enqueue_copy(fragile(5, true)), std::runtime_error) << "Enqueue swallowed the exception";
+    fragile output2;
+    EXPECT_EQ(fragile_queue::consumer::result::queue_empty, queue1.try_dequeue_copy(output2)) << "Dequeue returned the slot skipped by the failed enqueue";
+    // every slot is usable again
+    ASSERT_EQ(fragile_queue::producer::result::success, queue1.try_enqueue_bulk(input1.cbegin(), input1.cbegin() + 2, count1)) << "Bulk enqueue failed";
+    ASSERT_EQ(fragile_queue::producer::result::success, queue1.try_enqueue_copy(fragile(6, false))) << "Enqueue failed";
+    ASSERT_EQ(fragile_queue::producer::result::success, queue1.try_enqueue_copy(fragile(7, false))) << "Enqueue failed";
+    EXPECT_EQ(fragile_queue::producer::result::queue_full, queue1.try_enqueue_copy(fragile(8, false))) << "Queue should be full";
+    ASSERT_EQ(fragile_queue::consumer::result::success, queue1.try_dequeue_bulk(output1.begin(), 4U, count1)) << "Bulk dequeue failed";
+    EXPECT_EQ(4U, count1) << "Bulk dequeue did not return every value";
+    EXPECT_EQ(7, output1[3].value) << "Values were not dequeued in the order they were enqueued";
+}
+
+TEST(mpmc_ring_queue_test, parallel_bulk)
+{
+    typedef tco::mpmc_ring_queue<uint64_t> ulong_queue;
+    const uint32_t thread_count = 3U;
+    const uint32_t per_thread = 30000U;
+    const uint32_t batch = 16U;
+
+    ulong_queue queue1(64U, thread_count);
+    std::atomic<uint64_t> sum1(0U);
+    std::atomic<uint64_t> received1(0U);
+    const uint64_t total = static_cast<uint64_t>(thread_count) * per_thread;
+    std::vector<std::thread> threads;
+    for (uint32_t thread = 0U; thread < thread_count; ++thread)
+    {
+	threads.emplace_back([&, thread] ()
+	{
+	    ulong_queue::producer& producer = queue1.get_producer();
+	    std::array<uint64_t, batch> input;
+	    for (uint32_t sent = 0U; sent < per_thread;)
+	    {
+		const uint32_t wanted = std::min(batch, per_thread - sent);
+		for (uint32_t index = 0U; index < wanted; ++index)
+		{
+		    input[index] = static_cast<uint64_t>(thread) * per_thread + sent + index;
+		}
+		uint32_t count = 0U;
+		producer.try_enqueue_bulk(input.cbegin(), input.cbegin() + wanted, count);
+		sent += count;
+		if (count == 0U)
+		{
+		    std::this_thread::yield();
+		}
+	    }
+	});
+	threads.emplace_back([&] ()
+	{
+	    ulong_queue::consumer& consumer = queue1.get_consumer();
+	    std::array<uint64_t, batch> output;
+	    while (received1.load() < total)
+	    {
+		uint32_t count = 0U;
+		consumer.try_dequeue_bulk(output.begin(), batch, count);
+		for (uint32_t index = 0U; index < count; ++index)
+		{
+		    sum1.fetch_add(output[index]);
+		}
+		received1.fetch_add(count);
+		if (count == 0U)
+		{
+		    std::this_thread::yield();
+		}
+	    }
+	});
+    }
+    for (std::thread& thread : threads)
+    {
+	thread.join();
+    }
+    EXPECT_EQ(total, received1.load()) << "Values were lost or duplicated";
+    EXPECT_EQ(total * (total - 1U) / 2U, sum1.load()) << "Values were lost or duplicated";
+}
+
+TEST(mpmc_ring_queue_test, blocking_park)
+{
+    typedef tco::mpmc_ring_queue<uint64_t, std::allocator, tco::spin_park_wait<>> ulong_queue;
+    const uint64_t per_thread = 20000U;
+    const uint32_t thread_count = 2U;
+
+    ulong_queue queue1(16, thread_count * 2U);
+    std::atomic<uint64_t> sum1(0U);
+    std::vector<std::thread> threads;
+    for (uint32_t index = 0U; index < thread_count; ++index)
+    {
+	ulong_queue::producer& producer = queue1.get_producer();
+	threads.emplace_back([&producer, index, per_thread] ()
+	{
+	    for (uint64_t value = index * per_thread; value < (index + 1U) * per_thread; ++value)
+	    {
+		producer.enqueue_copy(value);
+	    }
+	});
+	ulong_queue::consumer& consumer = queue1.get_consumer();
+	threads.emplace_back([&consumer, &sum1, per_thread] ()
+	{
+	    for (uint64_t count = 0U; count < per_thread; ++count)
+	    {
+		uint64_t value = 0U;
+		consumer.dequeue_copy(value);
+		sum1 += value;
+	    }
+	});
+    }
+    for (std::thread& thread: threads)
+    {
+	thread.join();
+    }
+    const uint64_t total = per_thread * thread_count;
+    EXPECT_EQ(total * (total - 1U) / 2U, sum1.load()) << "Values were lost or duplicated";
+}
+
+TEST(mpmc_ring_queue_test, timed_park)
+{
+    typedef tco::mpmc_ring_queue<std::string, std::allocator, tco::spin_park_wait<>> string_queue;
+    typedef tco::mpmc_ring_queue<uint32_t, std::allocator, tco::spin_park_wait<>> uint_queue;
+
+    string_queue queue1(2, 2);
+    string_queue::producer& producer1 = queue1.get_producer();
+    string_queue::consumer& consumer1 = queue1.get_consumer();
+    std::string output1;
+    EXPECT_EQ(string_queue::consumer::result::queue_empty, consumer1.try_dequeue_copy_for(output1, std::chrono::milliseconds(10))) << "Timed dequeue from an empty queue succeeded";
+    ASSERT_EQ(string_queue::producer::result::success, producer1.try_enqueue_copy_for("abc", std::chrono::milliseconds(10))) << "Timed enqueue into an empty queue failed";
+    ASSERT_EQ(string_queue::producer::result::success, producer1.try_enqueue_move_for(std::string("xyz"), std::chrono::milliseconds(10))) << "Timed enqueue into a queue with room failed";
+    EXPECT_EQ(string_queue::producer::result::queue_full, producer1.try_enqueue_move_for(std::string("def"), std::chrono::milliseconds(10))) << "Timed enqueue into a full queue succeeded";
+    std::thread consumer_thread([&] ()
+    {
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	consumer1.dequeue_move(output1);
+    });
+    // the consumer makes room while this waits
+    EXPECT_EQ(string_queue::producer::result::success, producer1.try_enqueue_copy_for("def", std::chrono::seconds(10))) << "Timed enqueue was not woken by a dequeue";
+    consumer_thread.join();
+    EXPECT_EQ(std::string("abc"), output1) << "Dequeue did not return the oldest value";
+
+    uint_queue queue2(2, 2);
+    uint_queue::producer& producer2 = queue2.get_producer();
+    uint_queue::consumer& consumer2 = queue2.get_consumer();
+    uint32_t output2 = 0U;
+    EXPECT_EQ(uint_queue::consumer::result::queue_empty, consumer2.try_dequeue_move_for(output2, std::chrono::milliseconds(10))) << "Timed dequeue from an empty queue succeeded";
+    std::thread producer_thread([&] ()
+    {
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	producer2.enqueue_copy(7U);
+    });
+    EXPECT_EQ(uint_queue::consumer::result::success, consumer2.try_dequeue_copy_for(output2, std::chrono::seconds(10))) << "Timed dequeue was not woken by an enqueue";
+    producer_thread.join();
+    EXPECT_EQ(7U, output2) << "Timed dequeue returned the wrong value";
+}
@@ -0,0 +1,168 @@
+#include <turbo/container/spsc_byte_ring.hpp>
+#include <turbo/container/spsc_byte_ring.hh>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tco = turbo::container;
+
+namespace {
+
+typedef tco::spsc_byte_ring<> byte_ring;
+
+std::string read_string(byte_ring::consumer& consumer)
+{
+    std::uint32_t length = 0U;
+    const std::uint8_t* message = consumer.peek(length);
+    if (message == nullptr)
+    {
+	return std::string();
+    }
+    std::string result(reinterpret_cast<const char*>(message), length);
+    consumer.release();
+    return result;
+}
+
+} // anonymous namespace
+
+TEST(spsc_byte_ring_test, invalid_capacity)
+{
+    EXPECT_THROW(byte_ring ring1(0U), std::invalid_argument) << "Empty ring was accepted";
+    EXPECT_THROW(byte_ring ring2(16U), std::invalid_argument) << "Ring too small for any message was accepted";
+    byte_ring ring3(100U);
+    EXPECT_EQ(128U, ring3.get_capacity()) << "Capacity was not rounded up to a power of two";
+    EXPECT_EQ(56U, ring3.get_max_message_length()) << "Unexpected maximum message length";
+}
+
+TEST(spsc_byte_ring_test, write_read_basic)
+{
+    byte_ring ring1(128U);
+    byte_ring::producer& producer1 = ring1.get_producer();
+    byte_ring::consumer& consumer1 = ring1.get_consumer();
+    std::uint32_t length1 = 0U;
+    EXPECT_EQ(nullptr, consumer1.peek(length1)) << "Ring should be empty";
+    const std::string input1("hello");
+    const std::string input2;
+    const std::string input3("a message of 30 characters ...");
+    ASSERT_EQ(byte_ring::producer::result::success, producer1.try_write(input1.data(), input1.size())) << "Write failed";
+    ASSERT_EQ(byte_ring::producer::result::success, producer1.try_write(input2.data(), input2.size())) << "Write of an empty message failed";
+    ASSERT_EQ(byte_ring::producer::result::success, producer1.try_write(input3.data(), input3.size())) << "Write failed";
+    char output1[64];
+    ASSERT_EQ(byte_ring::consumer::result::success, consumer1.try_read(output1, sizeof(output1), length1)) << "Read failed";
+    EXPECT_EQ(input1, std::string(output1, length1)) << "Read did not return the oldest message";
+    ASSERT_EQ(byte_ring::consumer::result::success, consumer1.try_read(output1, sizeof(output1), length1)) << "Read of an empty message failed";
+    EXPECT_EQ(0U, length1) << "Empty message came back with a length";
+    ASSERT_EQ(byte_ring::consumer::result::buffer_too_small, consumer1.try_read(output1, 8U, length1)) << "Read into a short buffer succeeded";
+    EXPECT_EQ(input3.size(), length1) << "Short buffer read did not report the message length";
+    EXPECT_EQ(input3, read_string(consumer1)) << "Message was removed by a read into a short buffer";
+    EXPECT_EQ(byte_ring::consumer::result::queue_empty, consumer1.try_read(output1, sizeof(output1), length1)) << "Ring should be empty";
+}
+
+TEST(spsc_byte_ring_test, full_ring)
+{
+    byte_ring ring1(64U);
+    byte_ring::producer& producer1 = ring1.get_producer();
+    byte_ring::consumer& consumer1 = ring1.get_consumer();
+    const char input1[8] = "1234567";
+    // each record takes 16 bytes with its header
+    for (int count = 0; count < 4; ++count)
+    {
+	ASSERT_EQ(byte_ring::producer::result::success, producer1.try_write(input1, sizeof(input1))) << "Write to a ring with room failed";
+    }
+    EXPECT_EQ(byte_ring::producer::result::queue_full, producer1.try_write(input1, sizeof(input1))) << "Ring should be full";
+    EXPECT_EQ(nullptr, producer1.reserve(1U)) << "Ring should be full";
+    EXPECT_THROW(producer1.reserve(ring1.get_max_message_length() + 1U), std::invalid_argument) << "Oversized message was accepted";
+    read_string(consumer1);
+    EXPECT_EQ(byte_ring::producer::result::success, producer1.try_write(input1, sizeof(input1))) << "Write after a read failed";
+}
+
+TEST(spsc_byte_ring_test, wrap_with_skip)
+{
+    byte_ring ring1(128U);
+    byte_ring::producer& producer1 = ring1.get_producer();
+    byte_ring::consumer& consumer1 = ring1.get_consumer();
+    // 112 bytes used, leaving 16 contiguous bytes before the end of the ring
+    const std::string input1(48U, 'a');
+    for (int count = 0; count < 2; ++count)
+    {
+	ASSERT_EQ(byte_ring::producer::result::success, producer1.try_write(input1.data(), input1.size())) << "Write failed";
+	EXPECT_EQ(input1, read_string(consumer1)) << "Read returned the wrong message";
+    }
+    // a 24 byte message needs a 32 byte record, so it goes to the front of the ring
+    const std::string input2(24U, 'b');
+    std::uint8_t* storage1 = producer1.reserve(input2.size());
+    ASSERT_NE(nullptr, storage1) << "Reserve on an empty ring failed";
+    std::memcpy(storage1, input2.data(), input2.size());
+    producer1.commit(input2.size());
+    std::uint32_t length1 = 0U;
+    const std::uint8_t* message1 = consumer1.peek(length1);
+    ASSERT_NE(nullptr, message1) << "Message after a skip was not found";
+    EXPECT_EQ(input2, std::string(reinterpret_cast<const char*>(message1), length1)) << "Message after a skip was corrupted";
+    EXPECT_EQ(storage1, message1) << "Message was not read where it was written";
+    consumer1.release();
+    std::uint32_t length2 = 0U;
+    EXPECT_EQ(nullptr, consumer1.peek(length2)) << "Ring should be empty";
+}
+
+TEST(spsc_byte_ring_test, commit_shorter)
+{
+    byte_ring ring1(128U);
+    byte_ring::producer& producer1 = ring1.get_producer();
+    byte_ring::consumer& consumer1 = ring1.get_consumer();
+    std::uint8_t* storage1 = producer1.reserve(48U);
+    ASSERT_NE(nullptr, storage1) << "Reserve on an empty ring failed";
+    std::memcpy(storage1, "abc", 3U);
+    EXPECT_THROW(producer1.commit(49U), std::invalid_argument) << "Commit beyond the reserved storage was accepted";
+    producer1.commit(3U);
+    const std::string input1("def");
+    ASSERT_EQ(byte_ring::producer::result::success, producer1.try_write(input1.data(), input1.size())) << "Write failed";
+    EXPECT_EQ(std::string("abc"), read_string(consumer1)) << "Shortened message was not read back";
+    EXPECT_EQ(input1, read_string(consumer1)) << "Message after a shortened message was not read back";
+}
+
+TEST(spsc_byte_ring_test, async_mixed_sizes)
+{
+    const std::uint32_t total = 100000U;
+    byte_ring ring1(4096U);
+    byte_ring::producer& producer1 = ring1.get_producer();
+    byte_ring::consumer& consumer1 = ring1.get_consumer();
+    std::thread producer_thread([&] ()
+    {
+	for (std::uint32_t sequence = 0U; sequence < total; ++sequence)
+	{
+	    const std::uint32_t length = sizeof(sequence) + sequence % 1500U;
+	    std::uint8_t* storage = nullptr;
+	    while ((storage = producer1.reserve(length)) == nullptr)
+	    {
+		std::this_thread::yield();
+	    }
+	    std::memcpy(storage, &sequence, sizeof(sequence));
+	    std::memset(storage + sizeof(sequence), static_cast<int>(sequence & 0xFFU), length - sizeof(sequence));
+	    producer1.commit(length);
+	}
+    });
+    bool intact1 = true;
+    for (std::uint32_t expected = 0U; expected < total; ++expected)
+    {
+	std::uint32_t length = 0U;
+	const std::uint8_t* message = nullptr;
+	while ((message = consumer1.peek(length)) == nullptr)
+	{
+	    std::this_thread::yield();
+	}
+	std::uint32_t sequence = 0U;
+	std::memcpy(&sequence, message, sizeof(sequence));
+	intact1 = intact1 && sequence == expected && length == sizeof(sequence) + expected % 1500U;
+	for (std::uint32_t index = sizeof(sequence); intact1 && index < length; ++index)
+	{
+	    intact1 = message[index] == (expected & 0xFFU);
+	}
+	consumer1.release();
+    }
+    producer_thread.join();
+    EXPECT_TRUE(intact1) << "Messages were lost, reordered or corrupted";
+}
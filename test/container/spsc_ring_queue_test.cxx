@@ -1,10 +1,13 @@
 #include <turbo/container/spsc_ring_queue.hpp>
 #include <turbo/container/spsc_ring_queue.hh>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
 #include <array>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <new>
 #include <string>
 #include <thread>
 #include <turbo/algorithm/recovery.hpp>
@@ -507,3 +510,217 @@ TEST(spsc_ring_queue_test, overflow)
     ASSERT_NE(consumer1.try_dequeue_copy(actual), uint_queue::consumer::result::queue_empty) << "Queue should not be empty";
     EXPECT_EQ(consumer1.try_dequeue_copy(actual), uint_queue::consumer::result::queue_empty) << "Queue should be empty";
 }
+
+TEST(spsc_ring_queue_test, bulk_basic)
+{
+    typedef tco::spsc_ring_queue<std::string> string_queue;
+
+    string_queue queue1(4);
+    string_queue::producer& producer1 = queue1.get_producer();
+    string_queue::consumer& consumer1 = queue1.get_consumer();
+    std::array<std::string, 6> input1 { {"a", "b", "c", "d", "e", "f"} };
+    uint32_t count1 = 0U;
+    ASSERT_EQ(string_queue::producer::result::success, producer1.try_enqueue_bulk(input1.cbegin(), input1.cend(), count1)) << "Bulk enqueue failed";
+    EXPECT_EQ(4U, count1) << "Bulk enqueue did not stop at the queue capacity";
+    EXPECT_EQ(string_queue::producer::result::queue_full, producer1.try_enqueue_bulk(input1.cbegin() + 4, input1.cend(), count1)) << "Queue should be full";
+    EXPECT_EQ(0U, count1) << "Bulk enqueue into a full queue reported values enqueued";
+    std::array<std::string, 6> output1;
+    ASSERT_EQ(string_queue::consumer::result::success, consumer1.try_dequeue_bulk(output1.begin(), 3U, count1)) << "Bulk dequeue failed";
+    EXPECT_EQ(3U, count1) << "Bulk dequeue did not stop at the limit";
+    // wraps around the end of the ring
+    ASSERT_EQ(string_queue::producer::result::success, producer1.try_enqueue_bulk(input1.cbegin() + 4, input1.cend(), count1)) << "Bulk enqueue failed";
+    EXPECT_EQ(2U, count1) << "Bulk enqueue did not enqueue the whole range";
+    ASSERT_EQ(string_queue::consumer::result::success, consumer1.try_dequeue_bulk(output1.begin() + 3, 6U, count1)) << "Bulk dequeue failed";
+    EXPECT_EQ(3U, count1) << "Bulk dequeue did not stop when the queue emptied";
+    EXPECT_EQ(input1, output1) << "Values were not dequeued in the order they were enqueued";
+    EXPECT_EQ(string_queue::consumer::result::queue_empty, consumer1.try_dequeue_bulk(output1.begin(), 6U, count1)) << "Queue should be empty";
+    EXPECT_EQ(0U, count1) << "Bulk dequeue from an empty queue reported values dequeued";
+}
+
+TEST(spsc_ring_queue_test, async_bulk)
+{
+    typedef tco::spsc_ring_queue<uint64_t> ulong_queue;
+    const uint64_t total = 200000U;
+    const uint32_t batch = 32U;
+
+    ulong_queue queue1(128);
+    ulong_queue::producer& producer1 = queue1.get_producer();
+    ulong_queue::consumer& consumer1 = queue1.get_consumer();
+    std::thread producer_thread([&] ()
+    {
+	std::array<uint64_t, batch> input;
+	for (uint64_t sent = 0U; sent < total;)
+	{
+	    const uint32_t wanted = static_cast<uint32_t>(std::min<uint64_t>(batch, total - sent));
+	    for (uint32_t index = 0U; index < wanted; ++index)
+	    {
+		input[index] = sent + index;
+	    }
+	    uint32_t count = 0U;
+	    producer1.try_enqueue_bulk(input.cbegin(), input.cbegin() + wanted, count);
+	    sent += count;
+	    if (count == 0U)
+	    {
+		std::this_thread::yield();
+	    }
+	}
+    });
+    std::array<uint64_t, batch> output1;
+    uint64_t expected1 = 0U;
+    bool ordered1 = true;
+    while (expected1 < total)
+    {
+	uint32_t count = 0U;
+	consumer1.try_dequeue_bulk(output1.begin(), batch, count);
+	for (uint32_t index = 0U; index < count; ++index, ++expected1)
+	{
+	    ordered1 = ordered1 && output1[index] == expected1;
+	}
+	if (count == 0U)
+	{
+	    std::this_thread::yield();
+	}
+    }
+    producer_thread.join();
+    EXPECT_TRUE(ordered1) << "Values were not dequeued in the order they were enqueued";
+}
+
+TEST(spsc_ring_queue_test, reserve_commit_basic)
+{
+    typedef tco::spsc_ring_queue<std::string> string_queue;
+
+    string_queue queue1(3);
+    EXPECT_EQ(4U, queue1.get_capacity()) << "Capacity was not rounded up to a power of two";
+    string_queue::producer& producer1 = queue1.get_producer();
+    string_queue::consumer& consumer1 = queue1.get_consumer();
+    EXPECT_EQ(nullptr, consumer1.peek()) << "Queue should be empty";
+    void* slot1 = producer1.reserve();
+    ASSERT_NE(nullptr, slot1) << "Reserve on an empty queue failed";
+    EXPECT_EQ(slot1, producer1.reserve()) << "Reserve without commit moved to another slot";
+    new (slot1) std::string("abc");
+    EXPECT_EQ(nullptr, consumer1.peek()) << "Reserved value was visible before commit";
+    producer1.commit();
+    for (const char* input: {"def", "ghi", "jkl"})
+    {
+	void* slot = producer1.reserve();
+	ASSERT_NE(nullptr, slot) << "Reserve on a queue with room failed";
+	new (slot) std::string(input);
+	producer1.commit();
+    }
+    EXPECT_EQ(nullptr, producer1.reserve()) << "Queue should be full";
+    EXPECT_EQ(string_queue::producer::result::queue_full, producer1.try_enqueue_copy("mno")) << "Queue should be full";
+    std::string* value1 = consumer1.peek();
+    ASSERT_NE(nullptr, value1) << "Peek on a non-empty queue failed";
+    EXPECT_EQ(std::string("abc"), *value1) << "Peek did not return the oldest value";
+    EXPECT_EQ(value1, consumer1.peek()) << "Peek without release moved to another value";
+    consumer1.release();
+    // reserve, commit, peek and release mix freely with the copying operations
+    ASSERT_EQ(string_queue::producer::result::success, producer1.try_enqueue_copy("mno")) << "Enqueue after release failed";
+    std::string output1;
+    ASSERT_EQ(string_queue::consumer::result::success, consumer1.try_dequeue_copy(output1)) << "Dequeue failed";
+    EXPECT_EQ(std::string("def"), output1) << "Dequeue did not return the oldest value";
+    for (const char* expected: {"ghi", "jkl", "mno"})
+    {
+	std::string* value = consumer1.peek();
+	ASSERT_NE(nullptr, value) << "Peek on a non-empty queue failed";
+	EXPECT_EQ(std::string(expected), *value) << "Peek did not return the oldest value";
+	consumer1.release();
+    }
+    EXPECT_EQ(nullptr, consumer1.peek()) << "Queue should be empty";
+}
+
+namespace {
+
+struct lifetime_counter
+{
+    static int constructed;
+    static int destroyed;
+    lifetime_counter(int value_) : value(value_) { ++constructed; }
+    lifetime_counter(const lifetime_counter& other) : value(other.value) { ++constructed; }
+    lifetime_counter& operator=(const lifetime_counter& other) = default;
+    ~lifetime_counter() { ++destroyed; }
+    int value;
+};
+
+int lifetime_counter::constructed = 0;
+int lifetime_counter::destroyed = 0;
+
+} // anonymous namespace
+
+TEST(spsc_ring_queue_test, in_place_lifetime)
+{
+    typedef tco::spsc_ring_queue<lifetime_counter> counter_queue;
+
+    lifetime_counter::constructed = 0;
+    lifetime_counter::destroyed = 0;
+    {
+	// lifetime_counter has no default constructor, so slots must be raw storage
+	counter_queue queue1(8);
+	counter_queue::producer& producer1 = queue1.get_producer();
+	counter_queue::consumer& consumer1 = queue1.get_consumer();
+	EXPECT_EQ(0, lifetime_counter::constructed) << "Queue constructed values up front";
+	for (int value = 0; value < 5; ++value)
+	{
+	    ASSERT_EQ(counter_queue::producer::result::success, producer1.try_enqueue_copy(lifetime_counter(value))) << "Enqueue failed";
+	}
+	lifetime_counter output1(-1);
+	ASSERT_EQ(counter_queue::consumer::result::success, consumer1.try_dequeue_copy(output1)) << "Dequeue failed";
+	EXPECT_EQ(0, output1.value) << "Dequeue did not return the oldest value";
+	consumer1.release();
+	EXPECT_EQ(lifetime_counter::constructed - 4, lifetime_counter::destroyed) << "Dequeued values were not destroyed";
+    }
+    EXPECT_EQ(lifetime_counter::constructed, lifetime_counter::destroyed) << "Values left in the queue were not destroyed";
+}
+
+TEST(spsc_ring_queue_test, blocking_park)
+{
+    typedef tco::spsc_ring_queue<uint64_t, std::allocator<uint64_t>, tco::spin_park_wait<>> ulong_queue;
+    const uint64_t total = 100000U;
+
+    ulong_queue queue1(16);
+    ulong_queue::producer& producer1 = queue1.get_producer();
+    ulong_queue::consumer& consumer1 = queue1.get_consumer();
+    std::thread producer_thread([&] ()
+    {
+	for (uint64_t sent = 0U; sent < total; ++sent)
+	{
+	    producer1.enqueue_copy(sent);
+	}
+    });
+    bool ordered1 = true;
+    for (uint64_t expected = 0U; expected < total; ++expected)
+    {
+	uint64_t actual = 0U;
+	consumer1.dequeue_copy(actual);
+	ordered1 = ordered1 && actual == expected;
+    }
+    producer_thread.join();
+    EXPECT_TRUE(ordered1) << "Values were not dequeued in the order they were enqueued";
+}
+
+TEST(spsc_ring_queue_test, timed_park)
+{
+    typedef tco::spsc_ring_queue<std::string, std::allocator<std::string>, tco::spin_park_wait<>> string_queue;
+
+    string_queue queue1(2);
+    string_queue::producer& producer1 = queue1.get_producer();
+    string_queue::consumer& consumer1 = queue1.get_consumer();
+    std::string output1;
+    EXPECT_EQ(string_queue::consumer::result::queue_empty, consumer1.try_dequeue_copy_for(output1, std::chrono::milliseconds(10))) << "Timed dequeue from an empty queue succeeded";
+    ASSERT_EQ(string_queue::producer::result::success, producer1.try_enqueue_copy_for("abc", std::chrono::milliseconds(10))) << "Timed enqueue into an empty queue failed";
+    ASSERT_EQ(string_queue::producer::result::success, producer1.try_enqueue_move_for(std::string("def"), std::chrono::milliseconds(10))) << "Timed enqueue into a queue with room failed";
+    std::string input1("ghi");
+    EXPECT_EQ(string_queue::producer::result::queue_full, producer1.try_enqueue_move_for(std::move(input1), std::chrono::milliseconds(10))) << "Timed enqueue into a full queue succeeded";
+    EXPECT_EQ(std::string("ghi"), input1) << "Timed out enqueue moved its input away";
+    std::thread consumer_thread([&] ()
+    {
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	std::string output;
+	consumer1.dequeue_move(output);
+    });
+    // the consumer makes room while this waits
+    EXPECT_EQ(string_queue::producer::result::success, producer1.try_enqueue_copy_for(input1, std::chrono::seconds(10))) << "Timed enqueue was not woken by a dequeue";
+    consumer_thread.join();
+    ASSERT_EQ(string_queue::consumer::result::success, consumer1.try_dequeue_move_for(output1, std::chrono::milliseconds(10))) << "Timed dequeue from a non-empty queue failed";
+    EXPECT_EQ(std::string("def"), output1) << "Timed dequeue did not return the oldest value";
+}
@@ -0,0 +1,107 @@
+#include <turbo/container/wait_strategy.hpp>
+#include <turbo/container/wait_strategy.hh>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace tco = turbo::container;
+
+namespace {
+
+template <class wait_t>
+void check_timeout()
+{
+    wait_t wait1;
+    const auto begin = std::chrono::steady_clock::now();
+    const bool result1 = wait1.wait_until([] () -> bool { return false; }, begin + std::chrono::milliseconds(20));
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+    EXPECT_FALSE(result1) << "Wait that could never succeed reported success";
+    EXPECT_GE(elapsed, std::chrono::milliseconds(20)) << "Wait gave up before its deadline";
+    EXPECT_TRUE(wait1.wait_until([] () -> bool { return true; }, begin)) << "Wait did not try before checking an expired deadline";
+}
+
+template <class wait_t>
+void check_wake()
+{
+    wait_t wait1;
+    std::atomic<bool> ready1(false);
+    std::atomic<bool> finished1(false);
+    std::thread waiter([&] ()
+    {
+	wait1.wait([&] () -> bool { return ready1.load(); });
+	finished1.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(finished1.load()) << "Waiter returned before the condition held";
+    ready1.store(true);
+    wait1.notify();
+    waiter.join();
+    EXPECT_TRUE(finished1.load()) << "Waiter did not return";
+}
+
+} // anonymous namespace
+
+TEST(wait_strategy_test, spin_timeout)
+{
+    check_timeout<tco::spin_wait>();
+}
+
+TEST(wait_strategy_test, spin_yield_timeout)
+{
+    check_timeout<tco::spin_yield_wait<>>();
+}
+
+TEST(wait_strategy_test, spin_park_timeout)
+{
+    check_timeout<tco::spin_park_wait<>>();
+}
+
+TEST(wait_strategy_test, spin_yield_wake)
+{
+    check_wake<tco::spin_yield_wait<>>();
+}
+
+TEST(wait_strategy_test, spin_park_wake)
+{
+    check_wake<tco::spin_park_wait<>>();
+}
+
+TEST(wait_strategy_test, spin_park_many_waiters)
+{
+    tco::spin_park_wait<0U> wait1;
+    std::atomic<int> tickets1(0);
+    std::atomic<int> served1(0);
+    std::vector<std::thread> waiters;
+    for (int index = 0; index < 4; ++index)
+    {
+	waiters.emplace_back([&] ()
+	{
+	    wait1.wait([&] () -> bool
+	    {
+		int available = tickets1.load();
+		while (available > 0)
+		{
+		    if (tickets1.compare_exchange_weak(available, available - 1))
+		    {
+			return true;
+		    }
+		}
+		return false;
+	    });
+	    ++served1;
+	});
+    }
+    for (int index = 0; index < 4; ++index)
+    {
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	++tickets1;
+	wait1.notify();
+    }
+    for (std::thread& waiter: waiters)
+    {
+	waiter.join();
+    }
+    EXPECT_EQ(4, served1.load()) << "A waiter was never woken";
+}
@@ -0,0 +1,212 @@
+#include <turbo/memory/allocation_trace.hpp>
+#include <turbo/memory/allocation_trace.hh>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include <turbo/memory/magazine_cache.hpp>
+#include <turbo/memory/magazine_cache.hh>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/memory/slab_allocator.hh>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+std::string make_path(const char* test)
+{
+    const char* directory = std::getenv("TMPDIR");
+    return std::string(directory == nullptr || *directory == '\0' ? "/tmp" : directory)
+	    + "/turbo_allocation_trace_test_" + test + "_" + std::to_string(::getpid());
+}
+
+const void* fake(std::uintptr_t address)
+{
+    return reinterpret_cast<const void*>(address);
+}
+
+} // anonymous namespace
+
+TEST(allocation_trace_test, invalid_file)
+{
+    EXPECT_THROW(tme::trace_recorder recorder("/nonexistent/directory/trace"), tme::trace_error);
+    EXPECT_THROW(tme::trace_reader reader("/nonexistent/directory/trace"), tme::trace_error);
+    const std::string path(make_path("invalid_file"));
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(nullptr, file);
+    std::fputs("not a trace file at all", file);
+    std::fclose(file);
+    EXPECT_THROW(tme::trace_reader reader(path), tme::trace_error);
+    std::remove(path.c_str());
+}
+
+TEST(allocation_trace_test, round_trip)
+{
+    const std::string path(make_path("round_trip"));
+    {
+	tme::trace_recorder recorder(path);
+	recorder.record_allocate(16U, fake(0x1000U));
+	recorder.record_allocate(48U, fake(0x2000U));
+	recorder.record_free(0U, fake(0x1000U));
+	recorder.record_free(48U, fake(0x2000U));
+	EXPECT_EQ(4U, recorder.get_event_count());
+    }
+    tme::trace_reader reader(path);
+    const std::vector<tme::trace_event>& events = reader.get_events();
+    ASSERT_EQ(4U, events.size());
+    EXPECT_EQ(tme::trace_event::kind_type::allocate, events[0].kind);
+    EXPECT_EQ(tme::trace_event::kind_type::allocate, events[1].kind);
+    EXPECT_EQ(tme::trace_event::kind_type::free, events[2].kind);
+    EXPECT_EQ(tme::trace_event::kind_type::free, events[3].kind);
+    EXPECT_EQ(events[0].pointer_id, events[2].pointer_id);
+    EXPECT_EQ(events[1].pointer_id, events[3].pointer_id);
+    EXPECT_NE(events[0].pointer_id, events[1].pointer_id);
+    EXPECT_EQ(16U, events[2].size) << "Free size was not taken from its allocation";
+    EXPECT_EQ(1U, reader.get_thread_count());
+    EXPECT_EQ(2U, reader.get_id_count());
+    EXPECT_EQ(0U, reader.get_dropped_frees());
+    EXPECT_EQ(64U, reader.get_peak_live_bytes());
+    std::remove(path.c_str());
+}
+
+TEST(allocation_trace_test, reused_address)
+{
+    const std::string path(make_path("reused_address"));
+    {
+	tme::trace_recorder recorder(path);
+	for (std::uint32_t iter = 0U; iter < 3U; ++iter)
+	{
+	    recorder.record_allocate(32U, fake(0x1000U));
+	    recorder.record_free(32U, fake(0x1000U));
+	}
+    }
+    tme::trace_reader reader(path);
+    const std::vector<tme::trace_event>& events = reader.get_events();
+    ASSERT_EQ(6U, events.size());
+    EXPECT_EQ(3U, reader.get_id_count());
+    for (std::size_t index = 0U; index < events.size(); index += 2U)
+    {
+	EXPECT_EQ(index / 2U, events[index].pointer_id);
+	EXPECT_EQ(events[index].pointer_id, events[index + 1U].pointer_id);
+    }
+    EXPECT_EQ(32U, reader.get_peak_live_bytes());
+    std::remove(path.c_str());
+}
+
+TEST(allocation_trace_test, free_recorded_early)
+{
+    const std::string path(make_path("free_recorded_early"));
+    {
+	tme::trace_recorder recorder(path);
+	recorder.record_free(64U, fake(0x1000U));
+	recorder.record_allocate(64U, fake(0x1000U));
+	recorder.record_free(8U, fake(0x3000U));
+	std::this_thread::sleep_for(std::chrono::nanoseconds(tme::trace_reader::reorder_window * 2U));
+	recorder.record_allocate(8U, fake(0x3000U));
+    }
+    tme::trace_reader reader(path);
+    const std::vector<tme::trace_event>& events = reader.get_events();
+    ASSERT_EQ(3U, events.size());
+    EXPECT_EQ(tme::trace_event::kind_type::allocate, events[0].kind);
+    EXPECT_EQ(tme::trace_event::kind_type::free, events[1].kind) << "Early free was not moved after its allocation";
+    EXPECT_EQ(events[0].pointer_id, events[1].pointer_id);
+    EXPECT_EQ(tme::trace_event::kind_type::allocate, events[2].kind);
+    EXPECT_EQ(1U, reader.get_dropped_frees()) << "Free outside the reorder window was kept";
+    std::remove(path.c_str());
+}
+
+TEST(allocation_trace_test, parallel_record)
+{
+    const std::string path(make_path("parallel_record"));
+    const std::size_t thread_count = 4U;
+    const std::size_t iterations = tme::trace_recorder::buffer_capacity * 2U;
+    {
+	tme::trace_recorder recorder(path);
+	std::vector<std::thread> threads;
+	for (std::size_t thread = 0U; thread < thread_count; ++thread)
+	{
+	    threads.emplace_back([&recorder, thread, iterations] ()
+	    {
+		const std::uintptr_t base = (thread + 1U) << 24U;
+		for (std::size_t iter = 0U; iter < iterations; ++iter)
+		{
+		    recorder.record_allocate(16U, fake(base + iter * 16U));
+		    recorder.record_free(16U, fake(base + iter * 16U));
+		}
+	    });
+	}
+	for (std::thread& thread : threads)
+	{
+	    thread.join();
+	}
+	EXPECT_EQ(thread_count * iterations * 2U, recorder.get_event_count());
+    }
+    tme::trace_reader reader(path);
+    EXPECT_EQ(thread_count * iterations * 2U, reader.get_events().size());
+    EXPECT_EQ(thread_count, reader.get_thread_count());
+    EXPECT_EQ(thread_count * iterations, reader.get_id_count());
+    EXPECT_EQ(0U, reader.get_dropped_frees());
+    std::remove(path.c_str());
+}
+
+TEST(allocation_trace_test, slab_hooks)
+{
+    const std::string path(make_path("slab_hooks"));
+    tme::concurrent_sized_slab slab(4U, { {16U, 4U}, {64U, 4U} });
+    {
+	tme::trace_recorder recorder(path);
+	recorder.start();
+	EXPECT_EQ(&recorder, tme::trace_recorder::get_active());
+	void* small = slab.malloc(16U);
+	void* large = slab.malloc(64U);
+	slab.free(small, 16U);
+	slab.free(large, 64U);
+	slab.make_unique<std::uint64_t>(123U).second.reset();
+	recorder.stop();
+	EXPECT_EQ(nullptr, tme::trace_recorder::get_active());
+	void* untraced = slab.malloc(16U);
+	slab.free(untraced, 16U);
+    }
+    tme::trace_reader reader(path);
+#if defined(TURBO_MEMORY_TRACE)
+    ASSERT_EQ(6U, reader.get_events().size());
+    EXPECT_EQ(80U, reader.get_peak_live_bytes());
+    EXPECT_EQ(0U, reader.get_dropped_frees()) << "Free through a handle was not paired with its allocation";
+#else
+    EXPECT_TRUE(reader.get_events().empty());
+#endif
+    std::remove(path.c_str());
+}
+
+TEST(allocation_trace_test, magazine_hooks)
+{
+    const std::string path(make_path("magazine_hooks"));
+    tme::concurrent_sized_slab slab(4U, { {16U, 8U} });
+    {
+	tme::magazine_cache cache(slab, 4U);
+	tme::trace_recorder recorder(path);
+	recorder.start();
+	void* first = cache.malloc(16U);
+	void* second = cache.malloc(16U);
+	cache.free(first, 16U);
+	// served from the magazine without touching the slab
+	void* third = cache.malloc(16U);
+	cache.free(second, 16U);
+	cache.free(third, 16U);
+	recorder.stop();
+    }
+    tme::trace_reader reader(path);
+#if defined(TURBO_MEMORY_TRACE)
+    ASSERT_EQ(6U, reader.get_events().size()) << "Magazine hits were not traced";
+    EXPECT_EQ(32U, reader.get_peak_live_bytes());
+    EXPECT_EQ(0U, reader.get_dropped_frees()) << "Free from a magazine was not paired with its allocation";
+#else
+    EXPECT_TRUE(reader.get_events().empty());
+#endif
+    std::remove(path.c_str());
+}
@@ -0,0 +1,115 @@
+#include <turbo/memory/arena.hpp>
+#include <turbo/memory/arena.hh>
+#include <turbo/container/emplacing_skiplist.hpp>
+#include <turbo/container/emplacing_skiplist.hh>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace tco = turbo::container;
+namespace tme = turbo::memory;
+
+namespace turbo {
+namespace memory {
+
+class arena_tester
+{
+public:
+    arena_tester(arena& internal)
+	:
+	    internal_(internal)
+    { }
+    inline std::size_t get_current() const { return internal_.current_; }
+    inline std::size_t get_offset() const { return internal_.offset_; }
+private:
+    arena& internal_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+TEST(arena_test, invalid_construction)
+{
+    EXPECT_THROW(tme::arena(0U), tme::invalid_size_error) << "Arena created with a zero chunk size";
+}
+
+TEST(arena_test, allocate_invalid)
+{
+    tme::arena arena1(256U);
+    EXPECT_EQ(nullptr, arena1.allocate(0U, 8U)) << "Allocated zero bytes";
+    EXPECT_EQ(nullptr, arena1.allocate(8U, 0U)) << "Allocated with a zero alignment";
+    EXPECT_EQ(nullptr, arena1.allocate(8U, 24U)) << "Allocated with an alignment that is not a power of 2";
+}
+
+TEST(arena_test, allocate_basic)
+{
+    tme::arena arena1(256U);
+    tme::arena_tester tester1(arena1);
+    std::uint8_t* byte1 = arena1.allocate<std::uint8_t>();
+    ASSERT_NE(nullptr, byte1) << "Allocation failed";
+    std::uint64_t* value1 = arena1.allocate<std::uint64_t>();
+    ASSERT_NE(nullptr, value1) << "Allocation failed";
+    EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(value1) % alignof(std::uint64_t)) << "Value is not aligned";
+    EXPECT_LE(byte1 + 1, reinterpret_cast<std::uint8_t*>(value1)) << "Allocations overlap";
+    EXPECT_EQ(1U, arena1.get_chunk_count()) << "Unexpected chunk count";
+    std::uint64_t* array1 = arena1.allocate<std::uint64_t>(64U);
+    ASSERT_NE(nullptr, array1) << "Allocation bigger than a chunk failed";
+    EXPECT_EQ(2U, arena1.get_chunk_count()) << "Allocation bigger than a chunk did not get a new chunk";
+    void* aligned1 = arena1.allocate(16U, 128U);
+    ASSERT_NE(nullptr, aligned1) << "Aligned allocation failed";
+    EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(aligned1) % 128U) << "Value is not aligned";
+    EXPECT_EQ(3U, arena1.get_chunk_count()) << "Unexpected chunk count";
+    EXPECT_EQ(2U, tester1.get_current()) << "Unexpected current chunk";
+}
+
+TEST(arena_test, rewind_basic)
+{
+    tme::arena arena1(256U);
+    std::uint64_t* value1 = arena1.allocate<std::uint64_t>();
+    const tme::arena::mark mark1 = arena1.get_mark();
+    std::uint64_t* value2 = arena1.allocate<std::uint64_t>();
+    for (std::size_t count = 0U; count < 100U; ++count)
+    {
+	arena1.allocate<std::uint64_t>(4U);
+    }
+    const std::size_t chunk_count = arena1.get_chunk_count();
+    EXPECT_LT(1U, chunk_count) << "Arena did not grow";
+    arena1.rewind(mark1);
+    EXPECT_TRUE(mark1 == arena1.get_mark()) << "Rewind did not return to the mark";
+    EXPECT_EQ(value2, arena1.allocate<std::uint64_t>()) << "Rewind did not give back the space after the mark";
+    for (std::size_t count = 0U; count < 100U; ++count)
+    {
+	arena1.allocate<std::uint64_t>(4U);
+    }
+    EXPECT_EQ(chunk_count, arena1.get_chunk_count()) << "Chunks were not reused after rewind";
+    arena1.reset();
+    EXPECT_EQ(value1, arena1.allocate<std::uint64_t>()) << "Reset did not give back everything";
+    EXPECT_EQ(chunk_count, arena1.get_chunk_count()) << "Reset freed chunks";
+    arena1.release();
+    EXPECT_EQ(0U, arena1.get_chunk_count()) << "Release did not free every chunk";
+    EXPECT_EQ(0U, arena1.get_used_size()) << "Release did not give back everything";
+    EXPECT_NE(nullptr, arena1.allocate<std::uint64_t>()) << "Allocation after release failed";
+}
+
+TEST(arena_test, skiplist_use)
+{
+    typedef tco::emplacing_skiplist<std::uint32_t, std::string, tme::arena> string_map;
+    tme::arena arena1(4096U);
+    const tme::arena::mark mark1 = arena1.get_mark();
+    for (std::size_t round = 0U; round < 3U; ++round)
+    {
+	{
+	    string_map map1(arena1);
+	    for (std::uint32_t key = 0U; key < 1000U; ++key)
+	    {
+		map1.emplace(key * 7U % 1000U, std::to_string(key));
+	    }
+	    EXPECT_EQ(1000U, map1.size()) << "Unexpected skiplist size";
+	    auto iter = map1.find(343U);
+	    ASSERT_NE(map1.end(), iter) << "Key not found";
+	    EXPECT_EQ(std::to_string(49U), iter->value) << "Unexpected value";
+	}
+	arena1.rewind(mark1);
+    }
+}
@@ -3,12 +3,16 @@
 #include <cstdint>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <fstream>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
+#include <unistd.h>
 #include <gtest/gtest.h>
 #include <turbo/algorithm/recovery.hpp>
 #include <turbo/algorithm/recovery.hh>
@@ -834,6 +838,240 @@ TEST(block_test, parallel_use)
     }
 }
 
+TEST(block_test, find_owner_basic)
+{
+    tme::block block1(sizeof(std::uint64_t), 4U, alignof(std::uint64_t));
+    tme::block block2(sizeof(std::uint64_t), 4096U, alignof(std::uint64_t));
+    std::uint64_t* heap1 = static_cast<std::uint64_t*>(block1.allocate());
+    EXPECT_EQ(&block1, tme::block::find_owner(heap1)) << "Owner of an allocation was not found";
+    std::uint64_t* heap2 = nullptr;
+    for (std::size_t count = 0U; count < 4096U; ++count)
+    {
+	heap2 = static_cast<std::uint64_t*>(block2.allocate());
+	EXPECT_EQ(&block2, tme::block::find_owner(heap2)) << "Owner of an allocation was not found";
+    }
+    std::uint64_t stack1 = 54U;
+    EXPECT_EQ(nullptr, tme::block::find_owner(&stack1)) << "Found an owner for a pointer to the stack";
+    EXPECT_EQ(nullptr, tme::block::find_owner(nullptr)) << "Found an owner for nullptr";
+    tme::block block3(block1);
+    std::uint64_t* heap3 = static_cast<std::uint64_t*>(block3.allocate());
+    EXPECT_EQ(&block3, tme::block::find_owner(heap3)) << "Owner of an allocation from a copied block was not found";
+    EXPECT_EQ(&block1, tme::block::find_owner(heap1)) << "Copying a block changed the owner of the original's allocations";
+    const void* base4 = nullptr;
+    {
+	tme::block block4(sizeof(std::uint64_t), 4U, alignof(std::uint64_t));
+	base4 = block4.get_base_address();
+	EXPECT_EQ(&block4, tme::block::find_owner(base4)) << "Owner of the base address was not found";
+    }
+    EXPECT_EQ(nullptr, tme::block::find_owner(base4)) << "Destroyed block is still registered as an owner";
+}
+
+TEST(block_test, find_owner_shared_page)
+{
+    const std::uintptr_t page_size = 4096U;
+    auto check_owner = [] (tme::block& block) -> void
+    {
+	void* allocation = nullptr;
+	while ((allocation = block.allocate()) != nullptr)
+	{
+	    EXPECT_EQ(&block, tme::block::find_owner(allocation)) << "Owner of an allocation in a shared page was not found";
+	}
+    };
+    const void* base1 = nullptr;
+    {
+	tme::block block1(sizeof(std::uint64_t), 4U, alignof(std::uint64_t));
+	base1 = block1.get_base_address();
+	check_owner(block1);
+    }
+    EXPECT_EQ(nullptr, tme::block::find_owner(base1)) << "Destroyed block in a shared page is still registered as an owner";
+    tme::block block2(sizeof(std::uint64_t), 4U, alignof(std::uint64_t));
+    tme::block block3(sizeof(std::uint64_t), 4U, alignof(std::uint64_t));
+    tme::block block4(sizeof(std::uint64_t), 4U, alignof(std::uint64_t));
+    check_owner(block2);
+    check_owner(block3);
+    check_owner(block4);
+    std::vector<std::uintptr_t> pages
+    {
+	reinterpret_cast<std::uintptr_t>(block2.get_base_address()) / page_size,
+	reinterpret_cast<std::uintptr_t>(block3.get_base_address()) / page_size,
+	reinterpret_cast<std::uintptr_t>(block4.get_base_address()) / page_size
+    };
+    std::sort(pages.begin(), pages.end());
+    EXPECT_GE(2, std::distance(pages.begin(), std::unique(pages.begin(), pages.end()))) << "Small blocks did not share pages";
+    tme::block block5(block4);
+    EXPECT_EQ(&block5, tme::block::find_owner(block5.get_base_address())) << "Owner of a copied block in a shared page was not found";
+    tme::block block6(128U, 4U, 128U);
+    EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(block6.get_base_address()) % 128U) << "Block in a shared page is not aligned as requested";
+    tme::block block7(block6);
+    EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(block7.get_base_address()) % 128U) << "Copy of a block in a shared page is not aligned as requested";
+}
+
+TEST(block_test, bulk_basic)
+{
+    tme::block block1(sizeof(std::uint64_t), 8U, alignof(std::uint64_t));
+    std::array<void*, 12> allocation1;
+    allocation1.fill(nullptr);
+    EXPECT_EQ(5U, block1.allocate_bulk(&allocation1[0], 5U)) << "Bulk allocation of available values failed";
+    EXPECT_EQ(3U, block1.allocate_bulk(&allocation1[5], 7U)) << "Bulk allocation did not stop when the block was exhausted";
+    EXPECT_EQ(0U, block1.allocate_bulk(&allocation1[8], 4U)) << "Bulk allocation from an exhausted block succeeded";
+    EXPECT_EQ(nullptr, block1.allocate()) << "Allocation from an exhausted block succeeded";
+    for (std::size_t index = 0U; index < 8U; ++index)
+    {
+	EXPECT_TRUE(block1.in_range(allocation1[index])) << "Bulk allocation returned an address outside the block";
+	for (std::size_t other = 0U; other < index; ++other)
+	{
+	    EXPECT_NE(allocation1[other], allocation1[index]) << "Bulk allocation returned the same address twice";
+	}
+    }
+    std::uint64_t stack1 = 54U;
+    void* invalid1[] = { allocation1[0], &stack1 };
+    EXPECT_THROW(block1.free_bulk(invalid1, 2U), tme::invalid_pointer_error) << "Bulk free of an address outside the block succeeded";
+    EXPECT_EQ(nullptr, block1.allocate()) << "Rejected bulk free released an address";
+    allocation1[2] = nullptr;
+    block1.free_bulk(&allocation1[0], 8U);
+    EXPECT_EQ(7U, block1.allocate_bulk(&allocation1[0], 12U)) << "Bulk free did not release every non-null address";
+}
+
+TEST(block_test, stack_basic)
+{
+    typedef tme::block::free_list_mode mode;
+    EXPECT_THROW(tme::block(sizeof(std::uint16_t), 4U, alignof(std::uint16_t), mode::index_stack), tme::invalid_size_error) << "Value too small to hold an index was accepted";
+    tme::block block1(sizeof(std::uint64_t), 4U, alignof(std::uint64_t), mode::index_stack);
+    EXPECT_EQ(mode::index_stack, block1.get_free_list_mode()) << "Free list mode was not kept";
+    std::array<void*, 4> allocation1;
+    for (auto&& pointer : allocation1)
+    {
+	pointer = block1.allocate();
+	ASSERT_TRUE(block1.in_range(pointer)) << "Allocation failed";
+	*static_cast<std::uint64_t*>(pointer) = 99U;
+    }
+    EXPECT_EQ(nullptr, block1.allocate()) << "Allocation from an exhausted block succeeded";
+    block1.free(allocation1[1]);
+    block1.free(allocation1[3]);
+    EXPECT_EQ(allocation1[3], block1.allocate()) << "Most recently freed value was not reused first";
+    EXPECT_EQ(allocation1[1], block1.allocate()) << "Freed value was not reused";
+    EXPECT_EQ(nullptr, block1.allocate()) << "Allocation from an exhausted block succeeded";
+    tme::block block2(block1);
+    EXPECT_TRUE(block1 == block2) << "Copied block is not equal to the original";
+    block1.free_bulk(&allocation1[0], allocation1.size());
+    EXPECT_FALSE(block1 == block2) << "Freeing did not change the free list";
+    std::array<void*, 6> allocation2;
+    allocation2.fill(nullptr);
+    EXPECT_EQ(4U, block1.allocate_bulk(&allocation2[0], allocation2.size())) << "Bulk allocation did not take every free value";
+    for (std::size_t index = 0U; index < allocation1.size(); ++index)
+    {
+	EXPECT_EQ(allocation1[index], allocation2[index]) << "Bulk allocation did not return the bulk freed values in order";
+    }
+    EXPECT_EQ(nullptr, block1.allocate()) << "Allocation from an exhausted block succeeded";
+}
+
+TEST(block_test, free_spare_slot)
+{
+    typedef tme::block::free_list_mode mode;
+    for (mode free_list : { mode::ring_queue, mode::index_stack })
+    {
+	// storage has room for one value more than the capacity in case the base has to be aligned
+	tme::block block1(sizeof(std::uint64_t), 4U, alignof(std::uint64_t), free_list);
+	std::uint8_t* base1 = static_cast<std::uint8_t*>(const_cast<void*>(block1.get_base_address()));
+	void* spare1 = base1 + block1.get_capacity() * sizeof(std::uint64_t);
+	EXPECT_THROW(block1.free(spare1), tme::invalid_pointer_error) << "Freeing the spare slot past the capacity succeeded";
+	void* spare2[] = { spare1 };
+	EXPECT_THROW(block1.free_bulk(spare2, 1U), tme::invalid_pointer_error) << "Bulk freeing the spare slot past the capacity succeeded";
+	std::array<void*, 6> allocation1;
+	allocation1.fill(nullptr);
+	EXPECT_EQ(4U, block1.allocate_bulk(&allocation1[0], allocation1.size())) << "Block handed out more values than its capacity";
+	EXPECT_EQ(nullptr, block1.allocate()) << "Allocation from an exhausted block succeeded";
+    }
+}
+
+TEST(block_test, stack_parallel_use)
+{
+    tme::block block1(sizeof(std::uint64_t), 8U, alignof(std::uint64_t), tme::block::free_list_mode::index_stack);
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> threads;
+    for (std::uint64_t id = 1U; id <= 4U; ++id)
+    {
+	threads.emplace_back([&, id] () -> void
+	{
+	    for (std::size_t count = 0U; count < 10000U; ++count)
+	    {
+		std::uint64_t* pointer = static_cast<std::uint64_t*>(block1.allocate());
+		if (pointer == nullptr)
+		{
+		    continue;
+		}
+		*pointer = id;
+		std::this_thread::yield();
+		if (*pointer != id)
+		{
+		    failed.store(true);
+		}
+		block1.free(pointer);
+	    }
+	});
+    }
+    for (auto&& thread : threads)
+    {
+	thread.join();
+    }
+    EXPECT_FALSE(failed.load()) << "The same value was handed to two threads at once";
+    std::array<void*, 9> allocation1;
+    EXPECT_EQ(8U, block1.allocate_bulk(&allocation1[0], allocation1.size())) << "Values were lost from the free list";
+}
+
+TEST(block_test, storage_mapped)
+{
+    typedef tme::storage_policy::backing backing;
+    for (backing source : { backing::heap, backing::mapped, backing::transparent_huge_page, backing::explicit_huge_page })
+    {
+	for (bool prefault : { false, true })
+	{
+	    tme::storage_policy policy1(source, prefault);
+	    tme::block block1(sizeof(std::uint64_t), 1024U, alignof(std::uint64_t), tme::block::free_list_mode::ring_queue, policy1);
+	    EXPECT_TRUE(policy1 == block1.get_storage_policy()) << "Storage policy was not kept";
+	    std::vector<std::uint64_t*> allocation1;
+	    for (std::uint64_t count = 0U; count < 1024U; ++count)
+	    {
+		std::uint64_t* pointer = static_cast<std::uint64_t*>(block1.allocate());
+		ASSERT_NE(nullptr, pointer) << "Allocation from mapped storage failed";
+		EXPECT_EQ(0U, *pointer) << "Storage was not zeroed";
+		EXPECT_EQ(&block1, tme::block::find_owner(pointer)) << "Owner of mapped storage was not found";
+		*pointer = count;
+		allocation1.push_back(pointer);
+	    }
+	    tme::block block2(block1);
+	    EXPECT_TRUE(block1 == block2) << "Copy of a block with mapped storage is not equal to the original";
+	    for (std::uint64_t count = 0U; count < allocation1.size(); ++count)
+	    {
+		EXPECT_EQ(count, *allocation1[count]) << "Value in mapped storage was overwritten";
+		block1.free(allocation1[count]);
+	    }
+	}
+    }
+    tme::block_config config1(sizeof(std::uint64_t), 4U, 4U, 2U, tme::storage_policy(backing::mapped, true));
+    tme::block_list list1(config1);
+    EXPECT_TRUE(config1.storage == list1.get_storage_policy()) << "Storage policy was not passed to the list";
+    for (std::size_t count = 0U; count < 16U; ++count)
+    {
+	EXPECT_NE(nullptr, list1.allocate()) << "Allocation failed";
+    }
+    for (auto&& block : list1)
+    {
+	EXPECT_TRUE(config1.storage == block.get_storage_policy()) << "Appended block does not use the list's storage policy";
+    }
+}
+
+TEST(block_test, storage_unbound_node)
+{
+    // no system has this many nodes, so binding always fails
+    tme::storage_policy policy1(tme::storage_policy::backing::mapped, false, 4000);
+    tme::block block1(sizeof(std::uint64_t), 16U, alignof(std::uint64_t), tme::block::free_list_mode::ring_queue, policy1);
+    EXPECT_EQ(tme::storage_policy::any_node, block1.get_storage_policy().node) << "Block claims storage is bound to a node it could not be bound to";
+    EXPECT_NE(nullptr, block1.allocate()) << "Allocation from unbound storage failed";
+    tme::block block2(block1);
+    EXPECT_EQ(tme::storage_policy::any_node, block2.get_storage_policy().node) << "Copied block claims storage is bound to a node";
+}
+
 TEST(block_test, list_invalid_iterator)
 {
     tme::block_list list1(sizeof(std::int64_t), 4U);
@@ -910,6 +1148,151 @@ TEST(block_test, list_sequential_append)
     EXPECT_TRUE(4U <= iter2->get_capacity()) << "Capacity of first block in block list is less than requested";
 }
 
+TEST(block_test, list_free_lookup)
+{
+    tme::block_list list1(sizeof(std::uint64_t), 2U);
+    std::vector<std::uint64_t*> allocation;
+    for (std::size_t count = 0U; count < 126U; ++count)
+    {
+	allocation.push_back(static_cast<std::uint64_t*>(list1.allocate()));
+	ASSERT_NE(nullptr, allocation.back()) << "Allocation failed";
+    }
+    EXPECT_LE(6U, list1.get_list_size()) << "block_list did not grow";
+    for (auto&& pointer : allocation)
+    {
+	ASSERT_NE(nullptr, tme::block::find_owner(pointer)) << "Owner of an allocation was not found";
+	EXPECT_TRUE(tme::block::find_owner(pointer)->in_range(pointer)) << "Found the wrong owner of an allocation";
+	list1.free(pointer);
+    }
+    const std::size_t list_size = list1.get_list_size();
+    for (std::size_t count = 0U; count < allocation.size(); ++count)
+    {
+	EXPECT_NE(nullptr, list1.allocate()) << "Allocation failed";
+    }
+    EXPECT_EQ(list_size, list1.get_list_size()) << "Freed slots were not returned to their blocks";
+    std::uint64_t stack1 = 54U;
+    EXPECT_NO_THROW(list1.free(&stack1)) << "Freeing an address that no block owns should be a no-op";
+}
+
+TEST(block_test, list_bulk_basic)
+{
+    tme::block_list list1(sizeof(std::uint64_t), 4U);
+    std::vector<void*> allocation1(64U, nullptr);
+    EXPECT_EQ(allocation1.size(), list1.allocate_bulk(&allocation1[0], allocation1.size())) << "Bulk allocation did not grow the list";
+    EXPECT_LE(5U, list1.get_list_size()) << "block_list did not grow";
+    const std::size_t list_size = list1.get_list_size();
+    list1.free_bulk(&allocation1[0], allocation1.size());
+    EXPECT_EQ(allocation1.size(), list1.allocate_bulk(&allocation1[0], allocation1.size())) << "Bulk allocation failed";
+    EXPECT_EQ(list_size, list1.get_list_size()) << "Bulk freed slots were not returned to their blocks";
+    list1.free_bulk(&allocation1[0], allocation1.size());
+}
+
+TEST(block_test, list_trim_basic)
+{
+    tme::block_list list1(sizeof(std::uint64_t), 4U);
+    EXPECT_EQ(0U, list1.trim()) << "Trimmed a list with a single block";
+    std::vector<void*> allocation1;
+    for (std::size_t count = 0U; count < 60U; ++count)
+    {
+	allocation1.push_back(list1.allocate());
+    }
+    ASSERT_EQ(4U, list1.get_list_size()) << "block_list did not grow";
+    EXPECT_EQ(0U, list1.trim()) << "Trimmed blocks that are in use";
+    // keep one value in the second block
+    void* kept1 = allocation1[5];
+    allocation1.erase(allocation1.begin() + 5);
+    list1.free_bulk(&allocation1[0], allocation1.size());
+    EXPECT_EQ(2U, list1.trim()) << "Did not trim the empty trailing blocks";
+    EXPECT_EQ(2U, list1.get_list_size()) << "List size was not updated";
+    EXPECT_EQ(0U, list1.trim()) << "Trimmed the block still in use";
+    list1.free(kept1);
+    EXPECT_EQ(1U, list1.trim()) << "Did not trim the block once it was empty";
+    EXPECT_EQ(1U, list1.get_list_size()) << "List size was not updated";
+    for (std::size_t count = 0U; count < 60U; ++count)
+    {
+	EXPECT_NE(nullptr, list1.allocate()) << "Allocation after trimming failed";
+    }
+}
+
+std::size_t get_resident_size()
+{
+    std::ifstream statm("/proc/self/statm");
+    std::size_t total = 0U;
+    std::size_t resident = 0U;
+    statm >> total >> resident;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+TEST(block_test, list_trim_resident_size)
+{
+    // mapped storage is returned to the system straight away, unlike heap storage which malloc may keep
+    const std::size_t value_size = 1024U;
+    tme::block_list list1(tme::block_config(value_size, 1024U, 0U, 2U, tme::storage_policy(tme::storage_policy::backing::mapped, false)));
+    const std::size_t before = get_resident_size();
+    std::vector<void*> allocation1(64U * 1024U, nullptr);
+    ASSERT_EQ(allocation1.size(), list1.allocate_bulk(&allocation1[0], allocation1.size())) << "Burst allocation failed";
+    for (void* pointer : allocation1)
+    {
+	std::fill_n(static_cast<std::uint8_t*>(pointer), value_size, 1U);
+    }
+    const std::size_t peak = get_resident_size();
+    EXPECT_LE(before + allocation1.size() * value_size, peak + value_size * 1024U) << "Burst did not grow the resident size";
+    list1.free_bulk(&allocation1[0], allocation1.size());
+    EXPECT_LT(0U, list1.trim()) << "Nothing was trimmed after the burst";
+    const std::size_t after = get_resident_size();
+    EXPECT_GT(peak - allocation1.size() * value_size / 2U, after) << "Resident size did not drop after trimming";
+}
+
+TEST(block_test, list_trim_parallel_use)
+{
+    tme::block_list list1(sizeof(std::uint64_t), 2U);
+    std::atomic<bool> stop(false);
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> threads;
+    for (std::uint64_t id = 1U; id <= 3U; ++id)
+    {
+	threads.emplace_back([&, id] () -> void
+	{
+	    std::vector<std::uint64_t*> allocation;
+	    for (std::size_t iteration = 0U; iteration < 2000U; ++iteration)
+	    {
+		for (std::size_t count = 0U; count < 16U; ++count)
+		{
+		    allocation.push_back(static_cast<std::uint64_t*>(list1.allocate()));
+		    *allocation.back() = id;
+		}
+		std::this_thread::yield();
+		for (std::uint64_t* pointer : allocation)
+		{
+		    if (*pointer != id)
+		    {
+			failed.store(true);
+		    }
+		    list1.free(pointer);
+		}
+		allocation.clear();
+	    }
+	});
+    }
+    std::thread trimmer([&] () -> void
+    {
+	while (!stop.load())
+	{
+	    list1.trim();
+	    std::this_thread::yield();
+	}
+    });
+    for (auto&& thread : threads)
+    {
+	thread.join();
+    }
+    stop.store(true);
+    trimmer.join();
+    EXPECT_FALSE(failed.load()) << "A value was handed out twice or released while in use";
+    list1.trim();
+    EXPECT_EQ(1U, list1.get_list_size()) << "Empty list was not trimmed back to its first block";
+}
+
 TEST(block_test, list_copy_construction)
 {
     tme::block_list list1(sizeof(std::uint64_t), 4U);
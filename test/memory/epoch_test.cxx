@@ -0,0 +1,259 @@
+#include <turbo/memory/epoch.hpp>
+#include <turbo/memory/epoch.hh>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/memory/slab_allocator.hh>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+struct tracked
+{
+    tracked(std::atomic<std::size_t>& counter, std::uint64_t content)
+	:
+	    destroyed(counter),
+	    value(content)
+    { }
+    ~tracked()
+    {
+	destroyed.fetch_add(1U, std::memory_order_relaxed);
+    }
+    std::atomic<std::size_t>& destroyed;
+    std::uint64_t value;
+};
+
+void count_reclaim(void* context, void*)
+{
+    static_cast<std::atomic<std::size_t>*>(context)->fetch_add(1U, std::memory_order_relaxed);
+}
+
+} // anonymous namespace
+
+TEST(epoch_test, register_basic)
+{
+    tme::epoch_domain domain1;
+    tme::epoch_domain::participant& record1 = domain1.register_thread();
+    tme::epoch_domain::participant& record2 = domain1.register_thread();
+    EXPECT_NE(&record1, &record2) << "Two registrations share a participant";
+    domain1.unregister_thread(record1);
+    EXPECT_EQ(&record1, &domain1.register_thread()) << "Unregistered participant was not reused";
+    EXPECT_EQ(&domain1.get_local(), &domain1.get_local()) << "Local participant changed between calls";
+    tme::epoch_domain::participant* other = nullptr;
+    std::thread thread1([&] () -> void
+    {
+	other = &domain1.get_local();
+    });
+    thread1.join();
+    EXPECT_NE(&domain1.get_local(), other) << "Two threads share a local participant";
+}
+
+TEST(epoch_test, local_several_domains)
+{
+    tme::epoch_domain domain1;
+    tme::epoch_domain::participant* record1 = &domain1.get_local();
+    tme::epoch_domain::participant* record2 = nullptr;
+    {
+	tme::epoch_domain domain2;
+	record2 = &domain2.get_local();
+	EXPECT_NE(record1, record2) << "Two domains share a local participant";
+	EXPECT_EQ(record1, &domain1.get_local()) << "Local participant changed after using another domain";
+	EXPECT_EQ(record2, &domain2.get_local()) << "Local participant changed after using another domain";
+    }
+    tme::epoch_domain domain3;
+    tme::epoch_domain::participant& record3 = domain3.get_local();
+    tme::epoch_domain::guard guard1(record3);
+    EXPECT_TRUE(record3.is_pinned()) << "Local participant of a new domain was not pinned";
+    EXPECT_FALSE(domain1.get_local().is_pinned()) << "Local participant of a new domain is shared with another domain";
+}
+
+TEST(epoch_test, pin_basic)
+{
+    tme::epoch_domain domain1;
+    tme::epoch_domain::participant& record1 = domain1.register_thread();
+    EXPECT_FALSE(record1.is_pinned()) << "New participant is pinned";
+    {
+	tme::epoch_domain::guard guard1(record1);
+	EXPECT_TRUE(record1.is_pinned()) << "Guard did not pin";
+	{
+	    tme::epoch_domain::guard guard2(record1);
+	    EXPECT_TRUE(record1.is_pinned()) << "Nested guard did not pin";
+	}
+	EXPECT_TRUE(record1.is_pinned()) << "Nested guard unpinned the outer guard";
+	EXPECT_THROW(domain1.unregister_thread(record1), std::invalid_argument) << "Unregistered a pinned participant";
+    }
+    EXPECT_FALSE(record1.is_pinned()) << "Guard did not unpin";
+}
+
+TEST(epoch_test, retire_basic)
+{
+    std::atomic<std::size_t> reclaimed(0U);
+    tme::epoch_domain domain1;
+    tme::epoch_domain::participant& reader = domain1.register_thread();
+    tme::epoch_domain::participant& writer = domain1.register_thread();
+    std::uint64_t value1 = 1U;
+    {
+	tme::epoch_domain::guard guard1(reader);
+	writer.retire(&value1, &count_reclaim, &reclaimed);
+	EXPECT_EQ(1U, writer.get_retired_count()) << "Retired count is wrong";
+	for (std::size_t attempt = 0U; attempt < 8U; ++attempt)
+	{
+	    writer.collect();
+	}
+	EXPECT_EQ(0U, reclaimed.load()) << "Reclaimed a value while a reader was pinned";
+    }
+    for (std::size_t attempt = 0U; attempt < 4U && reclaimed.load() == 0U; ++attempt)
+    {
+	writer.collect();
+    }
+    EXPECT_EQ(1U, reclaimed.load()) << "Retired value was not reclaimed after the reader unpinned";
+    EXPECT_EQ(0U, writer.get_retired_count()) << "Retired count is wrong";
+}
+
+TEST(epoch_test, retire_destroyed)
+{
+    std::atomic<std::size_t> destroyed(0U);
+    {
+	tme::epoch_domain domain1;
+	tme::epoch_domain::participant& record1 = domain1.register_thread();
+	tme::epoch_domain::guard guard1(domain1.register_thread());
+	record1.retire(new tracked(destroyed, 1U));
+	record1.retire(new tracked(destroyed, 2U));
+	record1.collect();
+	EXPECT_EQ(0U, destroyed.load()) << "Reclaimed a value while a reader was pinned";
+	domain1.unregister_thread(record1);
+    }
+    EXPECT_EQ(2U, destroyed.load()) << "Destroying the domain did not reclaim every retired value";
+}
+
+TEST(epoch_test, retire_allocator)
+{
+    std::atomic<std::size_t> destroyed(0U);
+    tme::concurrent_sized_slab slab1(16U, { {sizeof(tracked), 4U} });
+    tme::epoch_domain domain1;
+    tme::epoch_domain::participant& record1 = domain1.register_thread();
+    std::vector<tracked*> values;
+    for (std::size_t index = 0U; index < 4U; ++index)
+    {
+	values.push_back(new (slab1.allocate<tracked>()) tracked(destroyed, index));
+    }
+    for (tracked* value : values)
+    {
+	record1.retire(slab1, value);
+    }
+    for (std::size_t attempt = 0U; attempt < 4U && destroyed.load() != values.size(); ++attempt)
+    {
+	record1.collect();
+    }
+    EXPECT_EQ(values.size(), destroyed.load()) << "Retired values were not destroyed";
+    for (std::size_t index = 0U; index < values.size(); ++index)
+    {
+	tracked* value = slab1.allocate<tracked>();
+	EXPECT_NE(nullptr, value) << "Retired values were not returned to the slab";
+	slab1.deallocate(value);
+    }
+}
+
+TEST(epoch_test, synchronize_basic)
+{
+    tme::epoch_domain domain1;
+    std::atomic<bool> pinned(false);
+    std::atomic<bool> release(false);
+    std::atomic<bool> synchronized(false);
+    std::thread reader([&] () -> void
+    {
+	tme::epoch_domain::guard guard1(domain1.get_local());
+	pinned.store(true);
+	while (!release.load())
+	{
+	    std::this_thread::yield();
+	}
+	EXPECT_FALSE(synchronized.load()) << "synchronize returned while a reader was pinned";
+    });
+    while (!pinned.load())
+    {
+	std::this_thread::yield();
+    }
+    std::thread writer([&] () -> void
+    {
+	domain1.synchronize();
+	synchronized.store(true);
+    });
+    for (std::size_t count = 0U; count < 100U; ++count)
+    {
+	std::this_thread::yield();
+    }
+    release.store(true);
+    reader.join();
+    writer.join();
+    EXPECT_TRUE(synchronized.load()) << "synchronize did not return";
+}
+
+TEST(epoch_test, parallel_use)
+{
+    struct node
+    {
+	std::atomic<bool> reclaimed;
+	std::uint64_t value;
+    };
+    const std::size_t node_count = 4096U;
+    std::unique_ptr<node[]> nodes(new node[node_count]);
+    for (std::size_t index = 0U; index < node_count; ++index)
+    {
+	nodes[index].reclaimed.store(false);
+	nodes[index].value = index;
+    }
+    tme::epoch_domain domain1;
+    std::atomic<node*> shared(&nodes[0]);
+    std::atomic<bool> finished(false);
+    std::atomic<std::size_t> failures(0U);
+    std::vector<std::thread> readers;
+    for (std::size_t count = 0U; count < 3U; ++count)
+    {
+	readers.emplace_back([&] () -> void
+	{
+	    tme::epoch_domain::participant& record = domain1.get_local();
+	    while (!finished.load(std::memory_order_acquire))
+	    {
+		tme::epoch_domain::guard guard1(record);
+		node* current = shared.load(std::memory_order_acquire);
+		for (std::size_t spin = 0U; spin < 16U; ++spin)
+		{
+		    if (current->reclaimed.load(std::memory_order_acquire))
+		    {
+			failures.fetch_add(1U);
+		    }
+		}
+	    }
+	});
+    }
+    std::thread writer([&] () -> void
+    {
+	tme::epoch_domain::participant& record = domain1.get_local();
+	for (std::size_t index = 1U; index < node_count; ++index)
+	{
+	    node* previous = shared.exchange(&nodes[index], std::memory_order_acq_rel);
+	    record.retire(previous, [] (void*, void* pointer) -> void
+	    {
+		static_cast<node*>(pointer)->reclaimed.store(true, std::memory_order_release);
+	    }, nullptr);
+	    if (index % 64U == 0U)
+	    {
+		std::this_thread::yield();
+	    }
+	}
+	finished.store(true, std::memory_order_release);
+    });
+    writer.join();
+    for (auto&& reader : readers)
+    {
+	reader.join();
+    }
+    EXPECT_EQ(0U, failures.load()) << "A reader observed a reclaimed node";
+}
@@ -0,0 +1,154 @@
+#include <turbo/memory/large_object.hpp>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/memory/slab_allocator.hh>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+const std::size_t page_size = tme::large_object_tier::page_size;
+
+tme::large_object_config make_config(std::size_t chunk_pages, std::chrono::milliseconds delay)
+{
+    return tme::large_object_config(chunk_pages * page_size, delay);
+}
+
+} // anonymous namespace
+
+TEST(large_object_test, allocate_invalid)
+{
+    tme::large_object_tier tier1(make_config(16U, std::chrono::milliseconds(0)));
+    EXPECT_EQ(nullptr, tier1.allocate(0U)) << "Allocated a zero length span";
+    std::uint64_t value1 = 5U;
+    EXPECT_NO_THROW(tier1.deallocate(&value1)) << "Deallocate should just ignore invalid addresses";
+    EXPECT_FALSE(tier1.owns(&value1)) << "Tier owns an address it did not allocate";
+    EXPECT_EQ(0U, tier1.get_mapped_size()) << "Tier mapped storage without any allocation";
+}
+
+TEST(large_object_test, allocate_basic)
+{
+    tme::large_object_tier tier1(make_config(16U, std::chrono::hours(1)));
+    void* span1 = tier1.allocate(page_size + 1U);
+    ASSERT_NE(nullptr, span1) << "Allocation failed";
+    EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(span1) % page_size) << "Span is not page aligned";
+    EXPECT_EQ(page_size * 2U, tier1.usable_size(span1)) << "Span was not rounded up to whole pages";
+    std::memset(span1, 0xAB, tier1.usable_size(span1));
+    EXPECT_EQ(page_size * 16U, tier1.get_mapped_size()) << "Unexpected chunk size";
+    EXPECT_EQ(14U, tier1.get_cached_pages()) << "Remainder of the chunk was not cached";
+    void* span2 = tier1.allocate(page_size * 32U);
+    ASSERT_NE(nullptr, span2) << "Allocation bigger than a chunk failed";
+    EXPECT_EQ(page_size * 48U, tier1.get_mapped_size()) << "Oversized allocation did not get its own chunk";
+    tier1.deallocate(span1);
+    EXPECT_FALSE(tier1.owns(span1)) << "Deallocated span is still owned";
+    EXPECT_EQ(16U, tier1.get_cached_pages()) << "Deallocated span was not cached";
+    EXPECT_EQ(span1, tier1.allocate(page_size * 16U)) << "Freed span was not merged with its neighbour";
+    tier1.deallocate(span2);
+}
+
+TEST(large_object_test, best_fit)
+{
+    tme::large_object_tier tier1(make_config(64U, std::chrono::hours(1)));
+    std::vector<void*> spans;
+    for (std::size_t pages : { 4U, 1U, 2U, 1U, 8U, 1U })
+    {
+	spans.push_back(tier1.allocate(pages * page_size));
+	ASSERT_NE(nullptr, spans.back()) << "Allocation failed";
+    }
+    // leave free holes of 4, 2 and 8 pages that cannot merge
+    tier1.deallocate(spans[0]);
+    tier1.deallocate(spans[2]);
+    tier1.deallocate(spans[4]);
+    EXPECT_EQ(spans[2], tier1.allocate(page_size * 2U)) << "Did not take the best fitting span";
+    EXPECT_EQ(spans[0], tier1.allocate(page_size * 3U)) << "Did not take the best fitting span";
+    EXPECT_EQ(spans[4], tier1.allocate(page_size * 5U)) << "Did not take the best fitting span";
+}
+
+TEST(large_object_test, release_idle)
+{
+    tme::large_object_tier tier1(make_config(16U, std::chrono::milliseconds(20)));
+    void* span1 = tier1.allocate(page_size * 4U);
+    ASSERT_NE(nullptr, span1) << "Allocation failed";
+    std::memset(span1, 0xAB, page_size * 4U);
+    tier1.deallocate(span1);
+    // the freed span merges with the untouched rest of the chunk
+    EXPECT_EQ(0U, tier1.get_released_pages()) << "Span was released before the delay";
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    tier1.release_idle();
+    EXPECT_EQ(16U, tier1.get_released_pages()) << "Idle span was not released after the delay";
+    std::uint8_t* span2 = static_cast<std::uint8_t*>(tier1.allocate(page_size * 4U));
+    ASSERT_EQ(span1, span2) << "Released span was not reused";
+    EXPECT_TRUE(std::all_of(span2, span2 + page_size * 4U, [] (std::uint8_t value) -> bool { return value == 0U; }))
+	    << "Released pages were not returned to the OS";
+}
+
+TEST(large_object_test, slab_large_objects)
+{
+    tme::concurrent_sized_slab slab1(2U, { {64U, 4U}, {256U, 4U} });
+    EXPECT_EQ(nullptr, slab1.get_large_object_tier()) << "Slab has a large object tier by default";
+    EXPECT_EQ(nullptr, slab1.malloc(page_size * 4U)) << "Slab without a large object tier served a large allocation";
+    tme::concurrent_sized_slab slab2(2U, { {64U, 4U}, {256U, 4U} }, 1U, make_config(64U, std::chrono::milliseconds(0)));
+    ASSERT_NE(nullptr, slab2.get_large_object_tier()) << "Slab has no large object tier";
+    void* small1 = slab2.malloc(64U);
+    EXPECT_NE(nullptr, small1) << "Small allocation failed";
+    EXPECT_FALSE(slab2.get_large_object_tier()->owns(small1)) << "Small allocation came from the large object tier";
+    void* large1 = slab2.malloc(page_size * 4U);
+    ASSERT_NE(nullptr, large1) << "Large allocation failed";
+    EXPECT_TRUE(slab2.get_large_object_tier()->owns(large1)) << "Large allocation did not come from the large object tier";
+    std::uint64_t* array1 = slab2.allocate<std::uint64_t>(1024U);
+    ASSERT_NE(nullptr, array1) << "Large array allocation failed";
+    EXPECT_EQ(page_size * 2U, slab2.get_large_object_tier()->usable_size(array1)) << "Large array has the wrong size";
+    slab2.deallocate(array1, 1024U);
+    EXPECT_FALSE(slab2.get_large_object_tier()->owns(array1)) << "Large array was not returned to the tier";
+    slab2.free(large1, page_size * 4U);
+    EXPECT_FALSE(slab2.get_large_object_tier()->owns(large1)) << "Large allocation was not returned to the tier";
+    slab2.free(small1, 64U);
+    tme::concurrent_sized_slab slab3(slab2);
+    ASSERT_NE(nullptr, slab3.get_large_object_tier()) << "Copy has no large object tier";
+    EXPECT_EQ(slab2.get_large_object_tier()->get_config(), slab3.get_large_object_tier()->get_config()) << "Copy has a different large object config";
+}
+
+TEST(large_object_test, parallel_use)
+{
+    tme::large_object_tier tier1(make_config(256U, std::chrono::milliseconds(1)));
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0U; index < 4U; ++index)
+    {
+	threads.emplace_back([&tier1, index] () -> void
+	{
+	    std::vector<std::uint8_t*> spans;
+	    for (std::size_t round = 0U; round < 2000U; ++round)
+	    {
+		const std::size_t size = page_size * (1U + (round * 7U + index) % 8U);
+		std::uint8_t* span1 = static_cast<std::uint8_t*>(tier1.allocate(size));
+		ASSERT_NE(nullptr, span1) << "Allocation failed";
+		span1[0] = static_cast<std::uint8_t>(index);
+		span1[size - 1U] = static_cast<std::uint8_t>(index);
+		spans.push_back(span1);
+		if (spans.size() > 8U)
+		{
+		    std::uint8_t* oldest = spans.front();
+		    spans.erase(spans.begin());
+		    EXPECT_EQ(index, oldest[0]) << "A span was overwritten by another thread";
+		    EXPECT_EQ(index, oldest[tier1.usable_size(oldest) - 1U]) << "A span was overwritten by another thread";
+		    tier1.deallocate(oldest);
+		}
+	    }
+	    for (std::uint8_t* span1 : spans)
+	    {
+		tier1.deallocate(span1);
+	    }
+	});
+    }
+    for (auto&& thread : threads)
+    {
+	thread.join();
+    }
+    EXPECT_EQ(tier1.get_mapped_size() / page_size, tier1.get_cached_pages()) << "Not every page was returned to the cache";
+}
@@ -0,0 +1,186 @@
+#include <turbo/memory/magazine_cache.hpp>
+#include <turbo/memory/magazine_cache.hh>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/memory/slab_allocator.hh>
+
+namespace turbo {
+namespace memory {
+
+class magazine_cache_tester
+{
+public:
+    magazine_cache_tester(magazine_cache& cache)
+	:
+	    cache_(cache)
+    { }
+    inline capacity_type get_cached_count(std::size_t bucket) const
+    {
+	return cache_.magazine_map_[bucket].get_count();
+    }
+private:
+    magazine_cache& cache_;
+};
+
+} // namespace memory
+} // namespace turbo
+
+namespace tme = turbo::memory;
+
+struct record
+{
+    std::uint16_t first;
+    std::uint32_t second;
+    std::uint64_t third;
+};
+
+TEST(magazine_cache_test, invalid_construction)
+{
+    tme::concurrent_sized_slab slab1(4U, { {sizeof(std::uint64_t), 8U} });
+    ASSERT_THROW(tme::magazine_cache(slab1, 0U), std::invalid_argument) << "magazine_cache constructed with 0 depth did not throw";
+}
+
+TEST(magazine_cache_test, allocate_invalid)
+{
+    tme::concurrent_sized_slab slab1(4U, { {8U, 8U}, {32U, 8U} });
+    tme::magazine_cache cache1(slab1, 4U);
+    EXPECT_EQ(nullptr, cache1.malloc(64U)) << "Allocation succeeded for a size beyond the configured range";
+    EXPECT_EQ(nullptr, cache1.malloc(0U)) << "Allocation succeeded for a size of 0";
+    EXPECT_EQ(nullptr, cache1.allocate<std::uint64_t>(0U)) << "Allocation succeeded for a quantity of 0";
+}
+
+TEST(magazine_cache_test, large_objects)
+{
+    const std::size_t page_size = 4096U;
+    tme::concurrent_sized_slab slab1(2U, { {64U, 4U}, {256U, 4U} }, 1U, tme::large_object_config(page_size * 16U, std::chrono::milliseconds(0)));
+    tme::magazine_cache cache1(slab1, 4U);
+    tme::magazine_cache_tester tester1(cache1);
+    void* large1 = cache1.malloc(page_size * 2U);
+    ASSERT_NE(nullptr, large1) << "Allocation beyond the buckets was not passed to the slab";
+    EXPECT_TRUE(slab1.get_large_object_tier()->owns(large1)) << "Allocation beyond the buckets did not come from the large object tier";
+    cache1.free(large1, page_size * 2U);
+    EXPECT_FALSE(slab1.get_large_object_tier()->owns(large1)) << "Free beyond the buckets was not passed to the slab";
+    EXPECT_EQ(0U, tester1.get_cached_count(0U)) << "Large object went through a magazine";
+    EXPECT_EQ(0U, tester1.get_cached_count(1U)) << "Large object went through a magazine";
+}
+
+TEST(magazine_cache_test, allocate_basic)
+{
+    tme::concurrent_sized_slab slab1(4U, { {sizeof(record), 8U} });
+    tme::magazine_cache cache1(slab1, 4U);
+    tme::magazine_cache_tester tester1(cache1);
+    record* record1 = cache1.allocate<record>();
+    EXPECT_NE(nullptr, record1) << "Allocation failed";
+    EXPECT_EQ(1U, tester1.get_cached_count(0U)) << "Refill did not fetch a batch of half the depth";
+    record* record2 = cache1.allocate<record>();
+    EXPECT_NE(nullptr, record2) << "Allocation failed";
+    EXPECT_NE(record1, record2) << "Same slot allocated twice";
+    EXPECT_EQ(0U, tester1.get_cached_count(0U)) << "Allocation did not come from the magazine";
+    cache1.deallocate(record1);
+    cache1.deallocate(record2);
+    EXPECT_EQ(2U, tester1.get_cached_count(0U)) << "Deallocation did not go to the magazine";
+    EXPECT_EQ(record2, cache1.allocate<record>()) << "Magazine did not return the most recently freed slot";
+    EXPECT_EQ(record1, cache1.allocate<record>()) << "Magazine did not return the most recently freed slot";
+}
+
+TEST(magazine_cache_test, deallocate_bounded)
+{
+    tme::concurrent_sized_slab slab1(4U, { {sizeof(std::uint64_t), 16U} });
+    tme::magazine_cache cache1(slab1, 4U);
+    tme::magazine_cache_tester tester1(cache1);
+    std::array<std::uint64_t*, 8U> allocation;
+    for (auto&& pointer : allocation)
+    {
+	pointer = slab1.allocate<std::uint64_t>();
+	ASSERT_NE(nullptr, pointer) << "Allocation failed";
+    }
+    for (auto&& pointer : allocation)
+    {
+	cache1.deallocate(pointer);
+	EXPECT_GE(4U, tester1.get_cached_count(0U)) << "Magazine grew beyond its depth";
+    }
+    EXPECT_LT(0U, tester1.get_cached_count(0U)) << "Magazine is unexpectedly empty";
+}
+
+TEST(magazine_cache_test, flush_basic)
+{
+    tme::concurrent_sized_slab slab1(4U, { {sizeof(std::uint64_t), 4U} });
+    {
+	tme::magazine_cache cache1(slab1, 8U);
+	tme::magazine_cache_tester tester1(cache1);
+	std::array<std::uint64_t*, 4U> allocation;
+	for (auto&& pointer : allocation)
+	{
+	    pointer = cache1.allocate<std::uint64_t>();
+	    ASSERT_NE(nullptr, pointer) << "Allocation failed";
+	}
+	for (auto&& pointer : allocation)
+	{
+	    cache1.deallocate(pointer);
+	}
+	cache1.flush();
+	EXPECT_EQ(0U, tester1.get_cached_count(0U)) << "Flush did not empty the magazine";
+    }
+    const std::size_t list_size = slab1.at(sizeof(std::uint64_t)).get_list_size();
+    {
+	tme::magazine_cache cache2(slab1, 8U);
+	std::uint64_t* pointer1 = cache2.allocate<std::uint64_t>();
+	std::uint64_t* pointer2 = cache2.allocate<std::uint64_t>();
+	cache2.deallocate(pointer1);
+	cache2.deallocate(pointer2);
+    }
+    std::array<std::uint64_t*, 4U> allocation;
+    for (auto&& pointer : allocation)
+    {
+	pointer = slab1.allocate<std::uint64_t>();
+	EXPECT_NE(nullptr, pointer) << "Allocation failed";
+    }
+    EXPECT_EQ(list_size, slab1.at(sizeof(std::uint64_t)).get_list_size()) << "Slots held by a destroyed magazine_cache were not returned to the slab";
+}
+
+TEST(magazine_cache_test, parallel_use)
+{
+    tme::concurrent_sized_slab slab1(64U, { {sizeof(record), 64U}, {sizeof(std::uint64_t), 64U} });
+    auto task = [&slab1] () -> void
+    {
+	tme::magazine_cache cache(slab1, 16U);
+	std::vector<record*> records;
+	std::vector<std::uint64_t*> numbers;
+	for (std::uint32_t round = 0U; round < 64U; ++round)
+	{
+	    for (std::uint32_t count = 0U; count < 24U; ++count)
+	    {
+		records.push_back(cache.allocate<record>());
+		numbers.push_back(cache.allocate<std::uint64_t>());
+		ASSERT_NE(nullptr, records.back()) << "Allocation failed";
+		ASSERT_NE(nullptr, numbers.back()) << "Allocation failed";
+		records.back()->third = round;
+		*(numbers.back()) = round;
+	    }
+	    for (std::uint32_t count = 0U; count < 24U; ++count)
+	    {
+		EXPECT_EQ(round, records[count]->third) << "Slot was handed out more than once";
+		EXPECT_EQ(round, *(numbers[count])) << "Slot was handed out more than once";
+		cache.deallocate(records[count]);
+		cache.deallocate(numbers[count]);
+	    }
+	    records.clear();
+	    numbers.clear();
+	}
+    };
+    std::thread thread1(task);
+    std::thread thread2(task);
+    std::thread thread3(task);
+    std::thread thread4(task);
+    thread1.join();
+    thread2.join();
+    thread3.join();
+    thread4.join();
+}
@@ -0,0 +1,97 @@
+#include <turbo/memory/numa_slab.hpp>
+#include <turbo/memory/numa_slab.hh>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <turbo/memory/block.hpp>
+#include <turbo/memory/block.hh>
+
+namespace tme = turbo::memory;
+
+TEST(numa_sized_slab_test, invalid_construction)
+{
+    EXPECT_THROW(tme::numa_sized_slab(2U, { {sizeof(std::uint64_t), 4U} }, std::vector<int>()), std::invalid_argument) << "Slab with no nodes was constructed";
+    EXPECT_THROW(tme::numa_sized_slab(2U, { {sizeof(std::uint64_t), 4U} }, std::vector<int>{0, -1}), std::invalid_argument) << "Slab with a negative node was constructed";
+}
+
+TEST(numa_sized_slab_test, detect_node_count)
+{
+    tme::numa_sized_slab slab1(2U, { {sizeof(std::uint64_t), 4U} });
+    EXPECT_LE(1U, tme::numa_sized_slab::detect_node_count()) << "Detected no nodes";
+    EXPECT_EQ(tme::numa_sized_slab::detect_node_count(), slab1.get_node_count()) << "Slab does not have a slab per node";
+    EXPECT_GT(slab1.get_node_count(), slab1.find_current_node()) << "Current node is out of range";
+    const std::vector<int> nodes1(tme::numa_sized_slab::detect_nodes());
+    EXPECT_TRUE(std::is_sorted(nodes1.cbegin(), nodes1.cend())) << "Detected nodes are not in order";
+    EXPECT_EQ(nodes1.cend(), std::adjacent_find(nodes1.cbegin(), nodes1.cend())) << "A node was detected twice";
+    for (std::size_t index = 0U; index < slab1.get_node_count(); ++index)
+    {
+	EXPECT_EQ(nodes1[index], slab1.get_node_id(index)) << "Slab was not built for a detected node";
+    }
+}
+
+TEST(numa_sized_slab_test, single_node)
+{
+    tme::numa_sized_slab slab1(2U, { {sizeof(std::uint64_t), 4U} }, std::vector<int>{0});
+    std::uint64_t* value1 = slab1.allocate<std::uint64_t>();
+    ASSERT_NE(nullptr, value1) << "Allocation failed";
+    EXPECT_EQ(0U, slab1.find_current_node()) << "Single node slab did not route to node 0";
+    EXPECT_TRUE(tme::storage_policy() == tme::block::find_owner(value1)->get_storage_policy()) << "Single node slab changed the storage policy";
+    slab1.deallocate(value1);
+}
+
+TEST(numa_sized_slab_test, home_node_free)
+{
+    // storage that cannot be bound to a node that does not exist reports no node, so this works on any machine
+    tme::numa_sized_slab slab1(2U, { {sizeof(std::uint64_t), 4U} }, std::vector<int>{0, 1});
+    ASSERT_EQ(2U, slab1.get_node_count()) << "Slab does not have a slab per node";
+    for (std::size_t node = 0U; node < slab1.get_node_count(); ++node)
+    {
+	std::uint64_t* value1 = slab1.get_node_slab(node).allocate<std::uint64_t>();
+	ASSERT_NE(nullptr, value1) << "Allocation from node " << node << " failed";
+	const tme::block* owner1 = tme::block::find_owner(value1);
+	ASSERT_NE(nullptr, owner1) << "Owner of a node allocation was not found";
+	const int bound1 = owner1->get_storage_policy().node;
+	EXPECT_TRUE(bound1 == slab1.get_node_id(node) || bound1 == tme::storage_policy::any_node) << "Storage claims to be bound to another node";
+	EXPECT_NE(tme::storage_policy::backing::heap, owner1->get_storage_policy().source) << "Node storage was taken from the heap";
+	slab1.deallocate(value1);
+	std::vector<std::uint64_t*> allocation1;
+	for (std::size_t count = 0U; count < 4U; ++count)
+	{
+	    allocation1.push_back(slab1.get_node_slab(node).allocate<std::uint64_t>());
+	}
+	EXPECT_NE(allocation1.cend(), std::find(allocation1.cbegin(), allocation1.cend(), value1)) << "Freed value did not return to its home node";
+	for (std::uint64_t* value : allocation1)
+	{
+	    slab1.get_node_slab(node).deallocate(value);
+	}
+    }
+}
+
+TEST(numa_sized_slab_test, parallel_use)
+{
+    tme::numa_sized_slab slab1(16U, { {sizeof(std::string), 16U} });
+    std::vector<std::thread> threads;
+    for (std::size_t count = 0U; count < 4U; ++count)
+    {
+	threads.emplace_back([&] () -> void
+	{
+	    for (std::size_t iteration = 0U; iteration < 1000U; ++iteration)
+	    {
+		void* value = slab1.malloc(sizeof(std::string));
+		if (value != nullptr)
+		{
+		    slab1.free(value, sizeof(std::string));
+		}
+	    }
+	});
+    }
+    for (auto&& thread : threads)
+    {
+	thread.join();
+    }
+    EXPECT_NE(nullptr, slab1.malloc(sizeof(std::string))) << "Allocation after parallel use failed";
+}
@@ -0,0 +1,78 @@
+#include <turbo/memory/page_map.hpp>
+#include <turbo/memory/page_map.hh>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <array>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace tme = turbo::memory;
+
+typedef tme::page_map<std::uint64_t> uint64_map;
+
+TEST(page_map_test, find_empty)
+{
+    std::unique_ptr<uint64_map> map1(new uint64_map());
+    std::uint64_t value1 = 5U;
+    EXPECT_EQ(nullptr, map1->find(&value1)) << "Found a value in an empty page_map";
+    EXPECT_EQ(nullptr, map1->find(nullptr)) << "Found a value in an empty page_map";
+}
+
+TEST(page_map_test, insert_invalid)
+{
+    std::unique_ptr<uint64_map> map1(new uint64_map());
+    std::uint64_t value1 = 5U;
+    EXPECT_FALSE(map1->insert(&value1, 0U, &value1)) << "Inserted a range with zero length";
+    const std::uintptr_t beyond = std::numeric_limits<std::uintptr_t>::max() - uint64_map::page_size;
+    EXPECT_FALSE(map1->insert(reinterpret_cast<const void*>(beyond), uint64_map::page_size, &value1)) << "Inserted an address beyond the mapped address width";
+    EXPECT_EQ(nullptr, map1->find(reinterpret_cast<const void*>(beyond))) << "Found an address beyond the mapped address width";
+}
+
+TEST(page_map_test, insert_basic)
+{
+    std::unique_ptr<uint64_map> map1(new uint64_map());
+    std::unique_ptr<std::uint8_t[]> storage1(new std::uint8_t[uint64_map::page_size * 4U]);
+    std::uint64_t value1 = 5U;
+    const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(&storage1[0]);
+    const std::uintptr_t aligned = (first + uint64_map::page_size - 1U) & ~(uint64_map::page_size - 1U);
+    std::uint8_t* region1 = reinterpret_cast<std::uint8_t*>(aligned);
+    EXPECT_TRUE(map1->insert(region1, uint64_map::page_size * 2U, &value1)) << "Insert failed";
+    EXPECT_EQ(&value1, map1->find(region1)) << "First byte of the range not found";
+    EXPECT_EQ(&value1, map1->find(region1 + uint64_map::page_size)) << "Second page of the range not found";
+    EXPECT_EQ(&value1, map1->find(region1 + uint64_map::page_size * 2U - 1U)) << "Last byte of the range not found";
+    EXPECT_EQ(nullptr, map1->find(region1 + uint64_map::page_size * 2U)) << "Page after the range was found";
+    map1->erase(region1, uint64_map::page_size * 2U);
+    EXPECT_EQ(nullptr, map1->find(region1)) << "Erased page was found";
+    EXPECT_EQ(nullptr, map1->find(region1 + uint64_map::page_size)) << "Erased page was found";
+}
+
+TEST(page_map_test, parallel_insert)
+{
+    std::unique_ptr<uint64_map> map1(new uint64_map());
+    const std::size_t page_count = 64U;
+    std::unique_ptr<std::uint8_t[]> storage1(new std::uint8_t[uint64_map::page_size * (page_count * 4U + 1U)]);
+    const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(&storage1[0]);
+    std::uint8_t* region1 = reinterpret_cast<std::uint8_t*>((first + uint64_map::page_size - 1U) & ~(uint64_map::page_size - 1U));
+    std::array<std::uint64_t, 4U> values { {0U, 1U, 2U, 3U} };
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0U; index < values.size(); ++index)
+    {
+	threads.emplace_back([&, index] () -> void
+	{
+	    for (std::size_t page = index; page < page_count * 4U; page += values.size())
+	    {
+		map1->insert(region1 + page * uint64_map::page_size, uint64_map::page_size, &values[index]);
+	    }
+	});
+    }
+    for (auto&& thread : threads)
+    {
+	thread.join();
+    }
+    for (std::size_t page = 0U; page < page_count * 4U; ++page)
+    {
+	EXPECT_EQ(&values[page % values.size()], map1->find(region1 + page * uint64_map::page_size + 7U)) << "Page " << page << " maps to the wrong value";
+    }
+}
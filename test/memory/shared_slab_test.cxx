@@ -0,0 +1,204 @@
+#include <turbo/memory/shared_slab.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+std::string make_name(const char* test)
+{
+    return std::string("/turbo_shared_slab_test_") + test + "_" + std::to_string(::getpid());
+}
+
+struct message
+{
+    std::uint64_t sequence;
+    char text[24];
+};
+
+} // anonymous namespace
+
+TEST(shared_slab_test, create_invalid)
+{
+    const std::vector<tme::block_config> empty_config;
+    EXPECT_THROW(tme::shared_sized_slab slab(empty_config), tme::invalid_size_error)
+	    << "Created a slab without buckets";
+    EXPECT_THROW(tme::shared_sized_slab slab(std::vector<tme::block_config>{ {2U, 8U} }), tme::invalid_size_error)
+	    << "Created a slab with values too small for a free list index";
+    EXPECT_THROW(tme::shared_sized_slab slab(make_name("create_invalid")), tme::segment_error)
+	    << "Attached to a segment that does not exist";
+    const std::string name(make_name("create_invalid"));
+    tme::shared_sized_slab slab1(name, { {8U, 8U} });
+    EXPECT_THROW(tme::shared_sized_slab slab(name, { {8U, 8U} }), tme::segment_error)
+	    << "Created a segment whose name is already taken";
+    tme::shared_sized_slab::unlink(name);
+}
+
+TEST(shared_slab_test, allocate_basic)
+{
+    tme::shared_sized_slab slab1(std::vector<tme::block_config>{ {8U, 4U}, {32U, 2U} });
+    EXPECT_EQ(3U, slab1.get_bucket_count()) << "Buckets were not calibrated to powers of 2";
+    EXPECT_EQ(16U, slab1.get_value_size(1U)) << "Filler bucket has the wrong size";
+    EXPECT_EQ(0U, slab1.get_capacity(1U)) << "Filler bucket has values";
+    std::vector<void*> values;
+    for (std::size_t count = 0U; count < 4U; ++count)
+    {
+	void* value = slab1.allocate(8U);
+	ASSERT_NE(nullptr, value) << "Allocation failed";
+	EXPECT_TRUE(slab1.owns(value)) << "Allocated value is outside the segment";
+	EXPECT_EQ(value, slab1.from_offset(slab1.to_offset(value))) << "Offset does not round trip";
+	values.push_back(value);
+    }
+    void* spilled1 = slab1.allocate(8U);
+    EXPECT_NE(nullptr, spilled1) << "Allocation from a full bucket did not fall through to a bigger bucket";
+    EXPECT_EQ(32U, slab1.get_value_size(2U)) << "Last bucket has the wrong size";
+    void* spilled2 = slab1.allocate(16U);
+    EXPECT_NE(nullptr, spilled2) << "Allocation from a filler bucket did not fall through to a bigger bucket";
+    EXPECT_EQ(nullptr, slab1.allocate(24U)) << "Allocated from a full bucket";
+    EXPECT_EQ(nullptr, slab1.allocate(64U)) << "Allocated a size without a bucket";
+    slab1.free(spilled1);
+    EXPECT_EQ(spilled1, slab1.allocate(24U)) << "Value freed to a bigger bucket was not reused";
+    EXPECT_THROW(slab1.free(static_cast<std::uint8_t*>(values[0]) + 1U), tme::invalid_pointer_error)
+	    << "Freed an address in the middle of a value";
+    std::uint64_t local = 0U;
+    EXPECT_THROW(slab1.free(&local), tme::invalid_pointer_error) << "Freed an address outside the segment";
+    slab1.free(values[2]);
+    EXPECT_EQ(values[2], slab1.allocate(8U)) << "Freed value was not reused";
+}
+
+TEST(shared_slab_test, named_attach)
+{
+    const std::string name(make_name("named_attach"));
+    tme::shared_sized_slab slab1(name, { {sizeof(message), 8U} });
+    tme::shared_sized_slab slab2(name);
+    EXPECT_EQ(slab1.get_segment_size(), slab2.get_segment_size()) << "Attached slab sees a different segment size";
+    message* value1 = slab1.allocate<message>();
+    ASSERT_NE(nullptr, value1) << "Allocation failed";
+    value1->sequence = 123U;
+    std::strcpy(value1->text, "abc123");
+    message* value2 = slab2.from_offset<message>(slab1.to_offset(value1));
+    ASSERT_NE(nullptr, value2) << "Offset is not valid in the attached slab";
+    EXPECT_EQ(123U, value2->sequence) << "Attached slab sees different contents";
+    EXPECT_EQ(std::string("abc123"), value2->text) << "Attached slab sees different contents";
+    slab2.free(value2);
+    EXPECT_EQ(value1, slab1.allocate<message>()) << "Value freed through the attached slab was not reused";
+    tme::shared_sized_slab::unlink(name);
+    EXPECT_THROW(tme::shared_sized_slab slab(name), tme::segment_error) << "Attached to an unlinked segment";
+}
+
+TEST(shared_slab_test, child_process_use)
+{
+    tme::shared_sized_slab slab1(std::vector<tme::block_config>{ {sizeof(message), 64U} });
+    int offsets[2];
+    ASSERT_EQ(0, ::pipe(offsets)) << "Unable to create pipe";
+    const pid_t pid = ::fork();
+    ASSERT_NE(-1, pid) << "Unable to fork";
+    if (pid == 0)
+    {
+	::close(offsets[0]);
+	int status = 0;
+	try
+	{
+	    // map the segment afresh through the inherited descriptor, as an exec'd child would
+	    tme::shared_sized_slab slab2(::dup(slab1.get_descriptor()));
+	    for (std::uint64_t sequence = 0U; sequence < 32U; ++sequence)
+	    {
+		message* value = slab2.allocate<message>();
+		if (value == nullptr)
+		{
+		    status = 1;
+		    break;
+		}
+		value->sequence = sequence;
+		std::strcpy(value->text, std::to_string(sequence).c_str());
+		const tme::shared_sized_slab::offset_type offset = slab2.to_offset(value);
+		if (::write(offsets[1], &offset, sizeof(offset)) != sizeof(offset))
+		{
+		    status = 2;
+		    break;
+		}
+	    }
+	}
+	catch (...)
+	{
+	    status = 3;
+	}
+	::close(offsets[1]);
+	::_exit(status);
+    }
+    ::close(offsets[1]);
+    std::vector<message*> values;
+    tme::shared_sized_slab::offset_type offset = 0U;
+    while (::read(offsets[0], &offset, sizeof(offset)) == sizeof(offset))
+    {
+	message* value = slab1.from_offset<message>(offset);
+	ASSERT_NE(nullptr, value) << "Child sent an invalid offset";
+	EXPECT_EQ(values.size(), value->sequence) << "Value written by the child is wrong";
+	EXPECT_EQ(std::to_string(values.size()), value->text) << "Value written by the child is wrong";
+	values.push_back(value);
+    }
+    ::close(offsets[0]);
+    int status = -1;
+    ASSERT_EQ(pid, ::waitpid(pid, &status, 0)) << "Unable to wait for child";
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0) << "Child failed with status " << status;
+    EXPECT_EQ(32U, values.size()) << "Child did not send every offset";
+    for (message* value : values)
+    {
+	slab1.free(value);
+    }
+    std::size_t available = 0U;
+    while (slab1.allocate<message>() != nullptr)
+    {
+	++available;
+    }
+    EXPECT_EQ(64U, available) << "Values allocated by the child were not all freed";
+}
+
+TEST(shared_slab_test, parallel_use)
+{
+    tme::shared_sized_slab slab1(std::vector<tme::block_config>{ {sizeof(std::uint64_t), 256U} });
+    std::vector<std::thread> threads;
+    for (std::uint64_t thread = 0U; thread < 4U; ++thread)
+    {
+	threads.emplace_back([&slab1, thread] () -> void
+	{
+	    std::vector<std::uint64_t*> values;
+	    for (std::size_t round = 0U; round < 1000U; ++round)
+	    {
+		for (std::size_t count = 0U; count < 32U; ++count)
+		{
+		    std::uint64_t* value = slab1.allocate<std::uint64_t>();
+		    if (value != nullptr)
+		    {
+			*value = thread;
+			values.push_back(value);
+		    }
+		}
+		for (std::uint64_t* value : values)
+		{
+		    EXPECT_EQ(thread, *value) << "Value was handed to two threads at once";
+		    slab1.free(value);
+		}
+		values.clear();
+	    }
+	});
+    }
+    for (auto&& thread : threads)
+    {
+	thread.join();
+    }
+    std::size_t available = 0U;
+    while (slab1.allocate<std::uint64_t>() != nullptr)
+    {
+	++available;
+    }
+    EXPECT_EQ(256U, available) << "Values were lost";
+}
@@ -0,0 +1,48 @@
+#include <turbo/memory/size_class.hpp>
+#include <turbo/memory/size_class.hh>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+
+namespace tme = turbo::memory;
+
+TEST(size_class_test, class_size_basic)
+{
+    for (std::size_t shift = 0U; shift <= 4U; ++shift)
+    {
+	for (std::size_t size = 1U; size <= (1U << 20U); ++size)
+	{
+	    const std::size_t number = tme::size_class_table::class_number(size, shift);
+	    const std::size_t class_size = tme::size_class_table::class_size(number, shift);
+	    ASSERT_LE(size, class_size) << "Class " << number << " cannot hold size " << size << " with shift " << shift;
+	    ASSERT_TRUE(number == 0U || tme::size_class_table::class_size(number - 1U, shift) < size)
+		    << "Size " << size << " fits a smaller class than " << number << " with shift " << shift;
+	}
+    }
+    EXPECT_EQ(4U, tme::size_class_table::class_size(tme::size_class_table::class_number(3U, 0U), 0U)) << "Power of 2 classes are wrong";
+    EXPECT_EQ(1024U, tme::size_class_table::class_size(tme::size_class_table::class_number(513U, 0U), 0U)) << "Power of 2 classes are wrong";
+    EXPECT_EQ(40U, tme::size_class_table::class_size(tme::size_class_table::class_number(33U, 2U), 2U)) << "Quarter classes are wrong";
+    EXPECT_EQ(1280U, tme::size_class_table::class_size(tme::size_class_table::class_number(1025U, 2U), 2U)) << "Quarter classes are wrong";
+}
+
+TEST(size_class_test, find_bucket_basic)
+{
+    tme::size_class_table table1(24U, 4U);
+    EXPECT_EQ(4U, table1.get_classes_per_doubling()) << "Unexpected classes per doubling";
+    EXPECT_EQ(24U, table1.get_bucket_size(0U)) << "Unexpected first bucket size";
+    EXPECT_EQ(0U, table1.find_bucket(0U)) << "Unexpected bucket for size 0";
+    EXPECT_EQ(0U, table1.find_bucket(1U)) << "Unexpected bucket for a size below the first class";
+    for (std::size_t size = 24U; size <= 8192U; ++size)
+    {
+	const std::size_t bucket = table1.find_bucket(size);
+	ASSERT_LE(size, table1.get_bucket_size(bucket)) << "Bucket " << bucket << " cannot hold size " << size;
+	ASSERT_TRUE(bucket == 0U || table1.get_bucket_size(bucket - 1U) < size) << "Size " << size << " fits a smaller bucket than " << bucket;
+    }
+}
+
+TEST(size_class_test, invalid_granularity)
+{
+    EXPECT_THROW(tme::size_class_table(8U, 0U), std::invalid_argument) << "Accepted 0 classes per doubling";
+    EXPECT_THROW(tme::size_class_table(8U, 6U), std::invalid_argument) << "Accepted classes per doubling that is not a power of 2";
+    EXPECT_THROW(tme::size_class_table(8U, 32U), std::invalid_argument) << "Accepted too many classes per doubling";
+}
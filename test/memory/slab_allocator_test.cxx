@@ -171,6 +171,35 @@ TEST(concurrent_sized_slab_test, find_block_bucket_invalid)
     EXPECT_EQ(4U, tester3.find_block_bucket(257U)) << "Unexpected bucket with bucket size parameter of 257U";
 }
 
+TEST(concurrent_sized_slab_test, find_block_bucket_fine)
+{
+    tme::concurrent_sized_slab slab1(16U, { {16U, 16U}, {64U, 16U}, {2048U, 16U} }, 4U);
+    tme::concurrent_sized_slab_tester tester1(slab1);
+    EXPECT_EQ(4U, slab1.get_classes_per_doubling()) << "Unexpected classes per doubling";
+    EXPECT_EQ(0U, tester1.find_block_bucket(1U)) << "Unexpected bucket with bucket size parameter of 1U";
+    EXPECT_EQ(0U, tester1.find_block_bucket(16U)) << "Unexpected bucket with bucket size parameter of 16U";
+    EXPECT_EQ(1U, tester1.find_block_bucket(17U)) << "Unexpected bucket with bucket size parameter of 17U";
+    EXPECT_EQ(1U, tester1.find_block_bucket(20U)) << "Unexpected bucket with bucket size parameter of 20U";
+    EXPECT_EQ(2U, tester1.find_block_bucket(21U)) << "Unexpected bucket with bucket size parameter of 21U";
+    EXPECT_EQ(4U, tester1.find_block_bucket(32U)) << "Unexpected bucket with bucket size parameter of 32U";
+    EXPECT_EQ(5U, tester1.find_block_bucket(33U)) << "Unexpected bucket with bucket size parameter of 33U";
+    EXPECT_EQ(8U, tester1.find_block_bucket(64U)) << "Unexpected bucket with bucket size parameter of 64U";
+    EXPECT_EQ(25U, tester1.find_block_bucket(1025U)) << "Unexpected bucket with bucket size parameter of 1025U";
+    EXPECT_EQ(28U, tester1.find_block_bucket(2048U)) << "Unexpected bucket with bucket size parameter of 2048U";
+    EXPECT_EQ(29U, tester1.find_block_bucket(2049U)) << "Unexpected bucket with bucket size parameter of 2049U";
+    EXPECT_EQ(20U, slab1.at(17U).get_value_size()) << "Unexpected value size for a 17 byte allocation";
+    EXPECT_EQ(40U, slab1.at(33U).get_value_size()) << "Unexpected value size for a 33 byte allocation";
+    EXPECT_EQ(1280U, slab1.at(1025U).get_value_size()) << "Unexpected value size for a 1025 byte allocation";
+    EXPECT_EQ(2048U, slab1.at(2048U).get_value_size()) << "Unexpected value size for a 2048 byte allocation";
+    EXPECT_FALSE(slab1.in_configured_range(2049U)) << "A size beyond the largest class is in range";
+    void* pointer1 = slab1.malloc(33U);
+    EXPECT_NE(nullptr, pointer1) << "Allocation from a fine grained bucket failed";
+    ASSERT_NE(nullptr, tme::block::find_owner(pointer1)) << "Allocation has no owning block";
+    EXPECT_EQ(40U, tme::block::find_owner(pointer1)->get_value_size()) << "Allocation did not come from the 40 byte bucket";
+    slab1.free(pointer1, 33U);
+    EXPECT_THROW(tme::concurrent_sized_slab(16U, { {16U, 16U} }, 3U), std::invalid_argument) << "Accepted classes per doubling that is not a power of 2";
+}
+
 template <class value_t, std::size_t limit>
 class concurrent_sized_slab_producer_task
 {
@@ -860,6 +889,47 @@ TEST(concurrent_sized_slab_test, malloc_invalid)
     EXPECT_EQ(nullptr, slab1.malloc(0U)) << "Allocating a quantity of 0 succeeded";
 }
 
+TEST(concurrent_sized_slab_test, bulk_basic)
+{
+    tme::concurrent_sized_slab slab1(2U, { {sizeof(std::uint64_t), 8U}, {sizeof(std::string), 4U} });
+    std::array<void*, 8> allocation1;
+    allocation1.fill(nullptr);
+    EXPECT_EQ(0U, slab1.allocate_bulk(0U, &allocation1[0], allocation1.size())) << "Bulk allocating values of size 0 succeeded";
+    EXPECT_EQ(allocation1.size(), slab1.allocate_bulk(sizeof(std::uint64_t), &allocation1[0], allocation1.size())) << "Bulk allocation failed";
+    for (auto&& pointer : allocation1)
+    {
+	ASSERT_NE(nullptr, pointer) << "Bulk allocation returned nullptr";
+	*static_cast<std::uint64_t*>(pointer) = 23U;
+    }
+    slab1.free_bulk(sizeof(std::uint64_t), &allocation1[0], allocation1.size());
+    std::uint64_t* single1 = slab1.allocate<std::uint64_t>();
+    EXPECT_NE(allocation1.cend(), std::find(allocation1.cbegin(), allocation1.cend(), single1)) << "Bulk freed values were not reused";
+    slab1.deallocate(single1);
+}
+
+TEST(concurrent_sized_slab_test, trim_basic)
+{
+    tme::concurrent_sized_slab slab1(2U, { {sizeof(std::uint64_t), 2U}, {sizeof(std::string), 2U} });
+    std::vector<std::uint64_t*> allocation1;
+    std::vector<std::string*> allocation2;
+    for (std::size_t count = 0U; count < 32U; ++count)
+    {
+	allocation1.push_back(slab1.allocate<std::uint64_t>());
+	allocation2.push_back(slab1.allocate<std::string>());
+    }
+    EXPECT_EQ(0U, slab1.trim()) << "Trimmed blocks that are in use";
+    for (std::size_t count = 0U; count < 32U; ++count)
+    {
+	slab1.deallocate(allocation1[count]);
+	slab1.deallocate(allocation2[count]);
+    }
+    EXPECT_LT(0U, slab1.trim()) << "Nothing was trimmed";
+    for (auto&& list : slab1)
+    {
+	EXPECT_EQ(1U, list.get_list_size()) << "Bucket was not trimmed back to its first block";
+    }
+}
+
 TEST(concurrent_sized_slab_test, concurrent_sized_slab_copy_construction)
 {
     tme::concurrent_sized_slab slab1(2U, { {sizeof(std::string), 2U} });
@@ -1112,7 +1182,7 @@ TEST(concurrent_sized_slab_test, concurrent_sized_slab_make_unique_invalid)
 
 TEST(concurrent_sized_slab_test, concurrent_sized_slab_make_shared_basic)
 {
-    tme::concurrent_sized_slab slab1(3U, { {sizeof(std::string), 3U} });
+    tme::concurrent_sized_slab slab1(3U, { {sizeof(tme::slab_shared_ptr<std::string>::node_type), 3U} });
     {
 	auto result1 = slab1.make_shared<std::string>("abc123");
 	EXPECT_EQ(tme::make_result::success, result1.first) << "Make shared slab string failed";
@@ -1150,7 +1220,7 @@ TEST(concurrent_sized_slab_test, concurrent_sized_slab_make_shared_invalid)
 
 TEST(concurrent_sized_slab_test, concurrent_sized_slab_make_mixed_basic)
 {
-    tme::concurrent_sized_slab slab1(4U, { {sizeof(std::string), 4U} });
+    tme::concurrent_sized_slab slab1(4U, { {sizeof(std::string), 4U}, {sizeof(tme::slab_shared_ptr<std::string>::node_type), 4U} });
     {
 	auto result1 = slab1.make_unique<std::string>("abc123");
 	EXPECT_EQ(tme::make_result::success, result1.first) << "Make unique slab string failed";
@@ -1251,6 +1321,19 @@ TEST(concurrent_sized_slab_test, calibrate_positive)
 	    << "{" << actual5[2].block_size << ", " << actual5[2].initial_capacity << "} ]";
 }
 
+
+TEST(concurrent_sized_slab_test, calibrate_fine)
+{
+    std::vector<tme::block_config> input1{ {64U, 4U}, {24U, 8U}, {16U, 16U}, {18U, 2U} };
+    std::vector<std::pair<std::size_t, std::size_t>> expected1{ {16U, 16U}, {20U, 2U}, {24U, 8U}, {28U, 0U}, {32U, 0U}, {40U, 0U}, {48U, 0U}, {56U, 0U}, {64U, 4U} };
+    std::vector<tme::block_config> actual1(tme::calibrate(2U, input1, 4U));
+    ASSERT_EQ(expected1.size(), actual1.size()) << "Incorrect number of buckets for 4 classes per doubling";
+    for (std::size_t index = 0U; index < expected1.size(); ++index)
+    {
+	EXPECT_EQ(expected1[index].first, actual1[index].block_size) << "Incorrect block size for bucket " << index;
+	EXPECT_EQ(expected1[index].second, actual1[index].initial_capacity) << "Incorrect capacity for bucket " << index;
+    }
+}
 TEST(concurrent_sized_slab_test, calibrate_repeating)
 {
     std::vector<tme::block_config> input1{ {64U, 4U}, {32U, 8U}, {64U, 16U} };
@@ -0,0 +1,160 @@
+#include <turbo/memory/slab_ptr.hpp>
+#include <turbo/memory/slab_ptr.hh>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/memory/slab_allocator.hh>
+
+namespace tme = turbo::memory;
+
+namespace {
+
+struct type_index
+{
+    template <class value_t>
+    static std::size_t get_index();
+};
+
+template <>
+std::size_t type_index::get_index<std::uint64_t>()
+{
+    return 1U;
+}
+
+template <>
+std::size_t type_index::get_index<tme::slab_shared_ptr<std::string>::node_type>()
+{
+    return 0U;
+}
+
+template <>
+std::size_t type_index::get_index<tme::slab_shared_ptr<std::uint64_t>::node_type>()
+{
+    return 1U;
+}
+
+} // anonymous namespace
+
+TEST(slab_ptr_test, handle_size)
+{
+    EXPECT_EQ(sizeof(void*), sizeof(tme::slab_unique_ptr<std::string>)) << "slab_unique_ptr is bigger than a pointer";
+    EXPECT_EQ(sizeof(void*), sizeof(tme::slab_shared_ptr<std::string>)) << "slab_shared_ptr is bigger than a pointer";
+}
+
+namespace {
+
+struct base_record
+{
+    std::uint64_t id;
+};
+
+struct derived_record : std::string, base_record
+{ };
+
+} // anonymous namespace
+
+TEST(slab_ptr_test, unique_conversion)
+{
+    static_assert(!std::is_constructible<tme::slab_unique_ptr<base_record>, tme::slab_unique_ptr<derived_record>&&>::value,
+	    "slab_unique_ptr converts to a handle of a base that sits at an offset in the slot");
+    static_assert(std::is_constructible<tme::slab_unique_ptr<derived_record>, tme::slab_unique_ptr<derived_record>&&>::value,
+	    "slab_unique_ptr cannot be moved");
+}
+
+TEST(slab_ptr_test, unique_release)
+{
+    tme::concurrent_sized_slab slab1(1U, { {sizeof(std::string), 1U} });
+    {
+	auto result1 = slab1.make_unique<std::string>("abc123");
+	EXPECT_EQ(tme::make_result::success, result1.first) << "Make unique slab string failed";
+	const std::string* address1 = result1.second.get();
+	result1.second.reset();
+	auto result2 = slab1.make_unique<std::string>("xyz789");
+	EXPECT_EQ(tme::make_result::success, result2.first) << "Make unique slab string failed";
+	EXPECT_EQ(address1, result2.second.get()) << "Freed slot was not returned to the slab";
+	EXPECT_EQ(std::string("xyz789"), *result2.second) << "String in memory slab didn't initialise";
+	tme::slab_unique_ptr<std::string> moved(std::move(result2.second));
+	EXPECT_EQ(nullptr, result2.second.get()) << "Moved from slab_unique_ptr still owns its value";
+	EXPECT_EQ(std::string("xyz789"), *moved) << "Moved slab_unique_ptr lost its value";
+	EXPECT_EQ(address1, moved.get()) << "Moved slab_unique_ptr points somewhere else";
+    }
+    auto result3 = slab1.make_unique<std::string>("!@#");
+    EXPECT_EQ(tme::make_result::success, result3.first) << "Make unique slab string failed";
+    auto result4 = slab1.make_unique<std::string>("$%^");
+    EXPECT_EQ(tme::make_result::success, result4.first) << "Make unique slab string failed";
+    EXPECT_TRUE(slab1.at(sizeof(std::string)).cbegin()->in_range(result3.second.get()))
+	    << "Destroyed slab_unique_ptr did not free its slot";
+}
+
+TEST(slab_ptr_test, shared_use_count)
+{
+    tme::concurrent_sized_slab slab1(1U, { {sizeof(tme::slab_shared_ptr<std::string>::node_type), 1U} });
+    const tme::block& first_block = *slab1.at(sizeof(tme::slab_shared_ptr<std::string>::node_type)).cbegin();
+    {
+	auto result1 = slab1.make_shared<std::string>("abc123");
+	EXPECT_EQ(tme::make_result::success, result1.first) << "Make shared slab string failed";
+	EXPECT_TRUE(first_block.in_range(result1.second.get())) << "First value does not sit in the first block";
+	EXPECT_EQ(1U, result1.second.use_count()) << "New slab_shared_ptr does not have a single owner";
+	tme::slab_shared_ptr<std::string> copy1(result1.second);
+	EXPECT_EQ(2U, result1.second.use_count()) << "Copy did not increment the count";
+	EXPECT_TRUE(copy1 == result1.second) << "Copy does not point to the same value";
+	tme::slab_shared_ptr<std::string> moved1(std::move(copy1));
+	EXPECT_EQ(2U, result1.second.use_count()) << "Move changed the count";
+	EXPECT_FALSE(copy1) << "Moved from slab_shared_ptr still owns its value";
+	result1.second.reset();
+	EXPECT_EQ(1U, moved1.use_count()) << "Reset did not decrement the count";
+	EXPECT_EQ(std::string("abc123"), *moved1) << "Shared value was destroyed while still owned";
+	auto result2 = slab1.make_shared<std::string>("xyz789");
+	EXPECT_EQ(tme::make_result::success, result2.first) << "Make shared slab string failed";
+	EXPECT_FALSE(first_block.in_range(result2.second.get())) << "Slot was freed while still owned";
+    }
+    auto result3 = slab1.make_shared<std::string>("lmn456");
+    EXPECT_EQ(tme::make_result::success, result3.first) << "Make shared slab string failed";
+    EXPECT_TRUE(first_block.in_range(result3.second.get())) << "Last slab_shared_ptr did not free its slot";
+    EXPECT_EQ(std::string("lmn456"), *result3.second) << "Shared slab string didn't initialise";
+}
+
+TEST(slab_ptr_test, typed_slab_use)
+{
+    tme::concurrent_typed_slab<type_index> slab1({
+	    {sizeof(tme::slab_shared_ptr<std::string>::node_type), 2U},
+	    {sizeof(std::uint64_t), 2U} });
+    auto result1 = slab1.make_shared<std::string>("abc123");
+    EXPECT_EQ(tme::make_result::success, result1.first) << "Make shared slab string failed";
+    EXPECT_EQ(std::string("abc123"), *result1.second) << "Shared slab string didn't initialise";
+    auto result2 = slab1.make_unique<std::uint64_t>(123U);
+    EXPECT_EQ(tme::make_result::success, result2.first) << "Make unique slab integer failed";
+    EXPECT_EQ(123U, *result2.second) << "Integer in memory slab didn't initialise";
+    auto result3 = slab1.make_shared<std::uint64_t>(456U);
+    EXPECT_EQ(tme::make_result::slab_full, result3.first) << "Make shared succeeded with a bucket too small for the count";
+}
+
+TEST(slab_ptr_test, parallel_share)
+{
+    tme::concurrent_sized_slab slab1(64U, { {sizeof(tme::slab_shared_ptr<std::uint64_t>::node_type), 64U} });
+    for (std::size_t round = 0U; round < 100U; ++round)
+    {
+	auto result1 = slab1.make_shared<std::uint64_t>(round);
+	ASSERT_EQ(tme::make_result::success, result1.first) << "Make shared slab integer failed";
+	std::vector<std::thread> threads;
+	for (std::size_t thread = 0U; thread < 4U; ++thread)
+	{
+	    threads.emplace_back([result1] () -> void
+	    {
+		std::vector<tme::slab_shared_ptr<std::uint64_t>> copies(100U, result1.second);
+		copies.clear();
+	    });
+	}
+	for (auto&& thread : threads)
+	{
+	    thread.join();
+	}
+	EXPECT_EQ(1U, result1.second.use_count()) << "Copies made by other threads were not all released";
+	EXPECT_EQ(round, *result1.second) << "Shared value changed";
+    }
+}
@@ -0,0 +1,115 @@
+#include <turbo/memory/slab_statistics.hpp>
+#include <turbo/memory/slab_statistics.hh>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <turbo/memory/block.hpp>
+#include <turbo/memory/block.hh>
+#include <turbo/memory/slab_allocator.hpp>
+#include <turbo/memory/slab_allocator.hh>
+
+namespace tme = turbo::memory;
+
+TEST(slab_statistics_test, sharded_counter_parallel_add)
+{
+    std::unique_ptr<tme::sharded_counter> counter1(new tme::sharded_counter());
+    EXPECT_EQ(0, counter1->sum()) << "New counter is not 0";
+    std::vector<std::thread> threads;
+    for (std::size_t count = 0U; count < 8U; ++count)
+    {
+	threads.emplace_back([&] () -> void
+	{
+	    for (std::size_t iteration = 0U; iteration < 1000U; ++iteration)
+	    {
+		counter1->add(3);
+		counter1->add(-1);
+	    }
+	});
+    }
+    for (auto&& thread : threads)
+    {
+	thread.join();
+    }
+    EXPECT_EQ(8 * 1000 * 2, counter1->sum()) << "Increments were lost";
+}
+
+TEST(slab_statistics_test, list_snapshot)
+{
+    tme::block_list list1(sizeof(std::uint64_t), 4U);
+    std::vector<void*> allocation1;
+    for (std::size_t count = 0U; count < 10U; ++count)
+    {
+	allocation1.push_back(list1.allocate());
+    }
+    for (std::size_t count = 0U; count < 4U; ++count)
+    {
+	list1.free(allocation1.back());
+	allocation1.pop_back();
+    }
+    tme::bucket_statistics snapshot1 = list1.get_statistics();
+    EXPECT_EQ(sizeof(std::uint64_t), snapshot1.value_size) << "Wrong value size";
+#if defined(TURBO_MEMORY_STATISTICS)
+    EXPECT_EQ(10U, snapshot1.allocations) << "Wrong allocation count";
+    EXPECT_EQ(4U, snapshot1.frees) << "Wrong free count";
+    EXPECT_EQ(6, snapshot1.live_objects) << "Wrong live object count";
+    EXPECT_LE(6, snapshot1.high_water_mark) << "High water mark is below the live object count";
+    EXPECT_GE(10, snapshot1.high_water_mark) << "High water mark is above the peak";
+    EXPECT_LE(1U, snapshot1.contingency_appends) << "Appending blocks was not counted";
+#else
+    EXPECT_EQ(0U, snapshot1.allocations) << "Statistics were gathered while disabled";
+    EXPECT_EQ(0U, snapshot1.frees) << "Statistics were gathered while disabled";
+    EXPECT_EQ(0U, snapshot1.contingency_appends) << "Statistics were gathered while disabled";
+#endif
+    list1.free_bulk(&allocation1[0], allocation1.size());
+#if defined(TURBO_MEMORY_STATISTICS)
+    EXPECT_EQ(0, list1.get_statistics().live_objects) << "Bulk free was not counted";
+#endif
+}
+
+TEST(slab_statistics_test, handle_free)
+{
+    tme::concurrent_sized_slab slab1(4U, { {sizeof(std::string), 4U} });
+    {
+	auto result1 = slab1.make_unique<std::string>("abc123");
+	ASSERT_EQ(tme::make_result::success, result1.first) << "Make unique slab string failed";
+    }
+    const tme::bucket_statistics snapshot1 = slab1.at(sizeof(std::string)).get_statistics();
+#if defined(TURBO_MEMORY_STATISTICS)
+    EXPECT_EQ(1U, snapshot1.frees) << "Free through a handle was not counted";
+    EXPECT_EQ(0, snapshot1.live_objects) << "Value freed through a handle is still live";
+#else
+    EXPECT_EQ(0U, snapshot1.frees) << "Statistics were gathered while disabled";
+#endif
+}
+
+TEST(slab_statistics_test, slab_snapshot)
+{
+    tme::concurrent_sized_slab slab1(4U, { {sizeof(std::uint32_t), 8U}, {sizeof(std::string), 8U} });
+    std::vector<std::string*> allocation1;
+    for (std::size_t count = 0U; count < 128U; ++count)
+    {
+	allocation1.push_back(slab1.allocate<std::string>());
+    }
+    const std::vector<tme::block_config> config1(slab1.get_block_config());
+    const std::vector<tme::bucket_statistics> snapshot1(slab1.get_statistics());
+    ASSERT_EQ(config1.size(), snapshot1.size()) << "There is not a snapshot per bucket";
+    std::int64_t live = 0;
+    for (std::size_t bucket = 0U; bucket < snapshot1.size(); ++bucket)
+    {
+	EXPECT_EQ(config1[bucket].block_size, snapshot1[bucket].value_size) << "Snapshot is out of order";
+	live += snapshot1[bucket].live_objects;
+    }
+#if defined(TURBO_MEMORY_STATISTICS)
+    EXPECT_EQ(128, live) << "Live objects across buckets is wrong";
+    EXPECT_LE(128, snapshot1.back().high_water_mark) << "High water mark was not sampled";
+#else
+    EXPECT_EQ(0, live) << "Statistics were gathered while disabled";
+#endif
+    for (std::string* pointer : allocation1)
+    {
+	slab1.deallocate(pointer);
+    }
+}
@@ -0,0 +1,179 @@
+#include <turbo/memory/slab_std_allocator.hpp>
+#include <turbo/memory/slab_std_allocator.hh>
+#include <turbo/container/mpmc_ring_queue.hpp>
+#include <turbo/container/mpmc_ring_queue.hh>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <array>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tco = turbo::container;
+namespace tme = turbo::memory;
+
+namespace {
+
+struct any_type_index_policy
+{
+    template <class value_t>
+    static std::size_t get_index()
+    {
+	return 0U;
+    }
+};
+
+typedef tme::concurrent_typed_slab<any_type_index_policy> any_typed_slab;
+
+tme::concurrent_sized_slab& get_queue_slab()
+{
+    static tme::concurrent_sized_slab slab(4U, { {64U, 4U}, {1024U, 4U} });
+    return slab;
+}
+
+///
+/// For containers that default construct their allocator
+///
+template <class value_t>
+class queue_allocator : public tme::slab_std_allocator<value_t>
+{
+public:
+    template <class other_t>
+    struct rebind
+    {
+	typedef queue_allocator<other_t> other;
+    };
+    queue_allocator() noexcept : tme::slab_std_allocator<value_t>(get_queue_slab()) { }
+    template <class other_t>
+    queue_allocator(const queue_allocator<other_t>&) noexcept : tme::slab_std_allocator<value_t>(get_queue_slab()) { }
+};
+
+} // anonymous namespace
+
+TEST(slab_std_allocator_test, rebind_basic)
+{
+    tme::concurrent_sized_slab slab1(4U, { {64U, 4U} });
+    tme::concurrent_sized_slab slab2(4U, { {64U, 4U} });
+    tme::slab_std_allocator<std::uint64_t> allocator1(slab1);
+    tme::slab_std_allocator<std::string>::rebind<std::uint64_t>::other allocator2(allocator1);
+    tme::slab_std_allocator<std::string> allocator3(allocator1);
+    tme::slab_std_allocator<std::uint64_t> allocator4(slab2);
+    tme::slab_std_allocator<std::uint64_t> allocator5;
+    EXPECT_EQ(&slab1, allocator3.get_slab()) << "Rebound allocator does not share the slab";
+    EXPECT_TRUE(allocator1 == allocator2) << "Copies of an allocator are not equal";
+    EXPECT_TRUE(allocator1 == allocator3) << "Rebound copies of an allocator are not equal";
+    EXPECT_TRUE(allocator1 != allocator4) << "Allocators of different slabs are equal";
+    EXPECT_EQ(nullptr, allocator5.get_slab()) << "Default constructed allocator has a slab";
+}
+
+TEST(slab_std_allocator_test, allocate_basic)
+{
+    tme::concurrent_sized_slab slab1(4U, { {64U, 4U}, {256U, 4U} });
+    tme::slab_std_allocator<std::uint64_t> allocator1(slab1);
+    std::uint64_t* value1 = allocator1.allocate(1U);
+    EXPECT_NE(nullptr, tme::block::find_owner(value1)) << "Single value did not come from the slab";
+    std::uint64_t* array1 = allocator1.allocate(20U);
+    EXPECT_NE(nullptr, tme::block::find_owner(array1)) << "Array did not come from the slab";
+    EXPECT_EQ(256U, tme::block::find_owner(array1)->get_value_size()) << "Array did not come from the bucket of its total size";
+    std::uint64_t* array2 = allocator1.allocate(100U);
+    EXPECT_EQ(nullptr, tme::block::find_owner(array2)) << "Out of range array did not fall back";
+    array2[99] = 5U;
+    allocator1.deallocate(array2, 100U);
+    allocator1.deallocate(array1, 20U);
+    allocator1.deallocate(value1, 1U);
+    tme::slab_std_allocator<std::uint64_t> allocator2;
+    std::uint64_t* value2 = allocator2.allocate(1U);
+    EXPECT_EQ(nullptr, tme::block::find_owner(value2)) << "Allocator without a slab did not fall back";
+    allocator2.deallocate(value2, 1U);
+}
+
+TEST(slab_std_allocator_test, allocate_large_objects)
+{
+    tme::concurrent_sized_slab slab1(4U, { {64U, 4U} }, 1U, tme::large_object_config());
+    tme::slab_std_allocator<std::uint64_t> allocator1(slab1);
+    std::uint64_t* array1 = allocator1.allocate(4096U);
+    EXPECT_TRUE(slab1.get_large_object_tier()->owns(array1)) << "Large array did not come from the large object tier";
+    allocator1.deallocate(array1, 4096U);
+    EXPECT_FALSE(slab1.get_large_object_tier()->owns(array1)) << "Large array was not returned to the large object tier";
+}
+
+TEST(slab_std_allocator_test, vector_use)
+{
+    tme::concurrent_sized_slab slab1(4U, { {64U, 4U}, {128U, 4U}, {256U, 4U} });
+    std::vector<std::uint32_t, tme::slab_std_allocator<std::uint32_t>> vector1 { tme::slab_std_allocator<std::uint32_t>(slab1) };
+    for (std::uint32_t value = 0U; value < 1000U; ++value)
+    {
+	vector1.push_back(value);
+	if (value == 8U)
+	{
+	    EXPECT_NE(nullptr, tme::block::find_owner(vector1.data())) << "Small vector storage did not come from the slab";
+	}
+    }
+    EXPECT_EQ(nullptr, tme::block::find_owner(vector1.data())) << "Large vector storage did not fall back";
+    for (std::uint32_t value = 0U; value < 1000U; ++value)
+    {
+	ASSERT_EQ(value, vector1[value]) << "Vector contents were lost while growing";
+    }
+}
+
+TEST(slab_std_allocator_test, unordered_map_use)
+{
+    typedef tme::slab_std_allocator<std::pair<const std::uint64_t, std::uint64_t>> allocator_type;
+    typedef std::unordered_map<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>, allocator_type> map_type;
+    tme::concurrent_sized_slab slab1(64U, { {32U, 64U}, {64U, 64U} });
+    map_type map1(16U, std::hash<std::uint64_t>(), std::equal_to<std::uint64_t>(), allocator_type(slab1));
+    for (std::uint64_t key = 0U; key < 1000U; ++key)
+    {
+	map1.emplace(key, key * 2U);
+    }
+    EXPECT_NE(nullptr, tme::block::find_owner(&(*map1.find(500U)))) << "Map node did not come from the slab";
+    for (std::uint64_t key = 0U; key < 1000U; key += 2U)
+    {
+	map1.erase(key);
+    }
+    EXPECT_EQ(500U, map1.size()) << "Unexpected map size";
+    for (std::uint64_t key = 1U; key < 1000U; key += 2U)
+    {
+	ASSERT_EQ(key * 2U, map1.at(key)) << "Unexpected map value";
+    }
+}
+
+TEST(slab_std_allocator_test, typed_slab_use)
+{
+    any_typed_slab slab1({ {64U, 8U} });
+    std::list<std::uint32_t, tme::slab_std_allocator<std::uint32_t, any_typed_slab>> list1 { tme::slab_std_allocator<std::uint32_t, any_typed_slab>(slab1) };
+    for (std::uint32_t value = 0U; value < 100U; ++value)
+    {
+	list1.push_back(value);
+    }
+    EXPECT_NE(nullptr, tme::block::find_owner(&list1.front())) << "List node did not come from the slab";
+    std::uint32_t expected = 0U;
+    for (std::uint32_t value : list1)
+    {
+	ASSERT_EQ(expected++, value) << "Unexpected list value";
+    }
+    tme::slab_std_allocator<std::array<std::uint8_t, 128U>, any_typed_slab> allocator1(slab1);
+    auto* array1 = allocator1.allocate(1U);
+    EXPECT_EQ(nullptr, tme::block::find_owner(array1)) << "Value too big for its bucket did not fall back";
+    allocator1.deallocate(array1, 1U);
+}
+
+TEST(slab_std_allocator_test, ring_queue_use)
+{
+    typedef tco::mpmc_ring_queue<std::uint64_t, queue_allocator> uint_queue;
+    uint_queue queue1(8U, 1U);
+    uint_queue::producer& producer1 = queue1.get_producer();
+    uint_queue::consumer& consumer1 = queue1.get_consumer();
+    for (std::uint64_t value = 0U; value < 8U; ++value)
+    {
+	ASSERT_EQ(uint_queue::producer::result::success, producer1.try_enqueue_copy(value)) << "Enqueue failed";
+    }
+    for (std::uint64_t expected = 0U; expected < 8U; ++expected)
+    {
+	std::uint64_t actual = 0U;
+	ASSERT_EQ(uint_queue::consumer::result::success, consumer1.try_dequeue_copy(actual)) << "Dequeue failed";
+	EXPECT_EQ(expected, actual) << "Unexpected value";
+    }
+}
@@ -0,0 +1,156 @@
+#include <turbo/memory/typed_slab.hpp>
+#include <turbo/memory/typed_slab.hh>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest.h>
+#include <turbo/container/bitwise_trie.hpp>
+#include <turbo/container/bitwise_trie.hh>
+#include <turbo/memory/cstdlib_allocator.hpp>
+
+namespace tco = turbo::container;
+namespace tme = turbo::memory;
+
+namespace {
+
+struct record
+{
+    record(std::uint32_t a, std::uint32_t b, std::uint32_t c) : first(a), second(b), third(c) { }
+    std::uint32_t first;
+    std::uint32_t second;
+    std::uint32_t third;
+};
+
+struct alignas(32) aligned_record
+{
+    std::uint64_t value;
+};
+
+} // anonymous namespace
+
+TEST(typed_slab_test, bucket_of_basic)
+{
+    typedef tme::typed_slab<std::uint8_t, std::string, record> slab_type;
+    static_assert(slab_type::bucket_of<std::uint8_t>::value == 0U, "wrong bucket for first type");
+    static_assert(slab_type::bucket_of<std::string>::value == 1U, "wrong bucket for second type");
+    static_assert(slab_type::bucket_of<record>::value == 2U, "wrong bucket for last type");
+    static_assert(slab_type::bucket_of<std::int8_t>::value == 0U, "unlisted type did not use the slot it fits");
+    static_assert(slab_type::value_sizes[1U] == sizeof(std::string), "wrong slot size");
+    slab_type slab1(4U, 4U);
+    std::size_t bucket = 0U;
+    for (auto&& list : slab1)
+    {
+	EXPECT_EQ(slab_type::value_sizes[bucket], list.get_value_size()) << "Bucket " << bucket << " has the wrong value size";
+	++bucket;
+    }
+    EXPECT_EQ(slab_type::type_count, bucket) << "Wrong number of buckets";
+    std::string* string1 = slab1.allocate<std::string>();
+    ASSERT_NE(nullptr, string1) << "Allocation failed";
+    EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(string1) % alignof(std::string)) << "Slot is not aligned for its type";
+    slab1.deallocate(string1);
+}
+
+TEST(typed_slab_test, allocate_basic)
+{
+    tme::typed_slab<std::uint16_t, std::uint64_t, aligned_record> slab1({ {2U, 4U, 8U} }, 0U);
+    std::vector<std::uint64_t*> values;
+    for (std::size_t count = 0U; count < 4U; ++count)
+    {
+	std::uint64_t* value = slab1.allocate<std::uint64_t>();
+	ASSERT_NE(nullptr, value) << "Allocation failed";
+	EXPECT_TRUE(slab1.at<std::uint64_t>().cbegin()->in_range(value)) << "Value came from the wrong bucket";
+	*value = count;
+	values.push_back(value);
+    }
+    for (std::size_t count = 0U; count < 8U; ++count)
+    {
+	aligned_record* value = slab1.allocate<aligned_record>();
+	ASSERT_NE(nullptr, value) << "Allocation failed";
+	EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(value) % alignof(aligned_record)) << "Value is not aligned for its type";
+	slab1.deallocate(value);
+    }
+    for (std::size_t count = 0U; count < values.size(); ++count)
+    {
+	EXPECT_EQ(count, *values[count]) << "Value was overwritten";
+	slab1.deallocate(values[count]);
+    }
+}
+
+TEST(typed_slab_test, make_basic)
+{
+    tme::typed_slab<std::string, tme::slab_shared_ptr<record>::node_type> slab1(2U, 2U);
+    {
+	auto result1 = slab1.make_unique<std::string>("abc123");
+	EXPECT_EQ(tme::make_result::success, result1.first) << "Make unique slab string failed";
+	EXPECT_EQ(std::string("abc123"), *result1.second) << "String in memory slab didn't initialise";
+	auto result2 = slab1.make_shared<record>(1U, 2U, 3U);
+	EXPECT_EQ(tme::make_result::success, result2.first) << "Make shared slab record failed";
+	EXPECT_EQ(3U, result2.second->third) << "Record in memory slab didn't initialise";
+	auto copy2 = result2.second;
+	EXPECT_EQ(2U, copy2.use_count()) << "Copy did not increment the count";
+    }
+    auto result3 = slab1.make_unique<std::string>("xyz789");
+    EXPECT_TRUE(slab1.at<std::string>().cbegin()->in_range(result3.second.get())) << "Unique value was not freed";
+}
+
+TEST(typed_slab_test, bitwise_trie_use)
+{
+    // the node types are private to the trie, so placeholder slots are listed in their place
+    typedef tco::bitwise_trie<std::uint32_t, std::string, tme::cstdlib_typed_allocator> probe_type;
+    typedef tme::typed_slab<
+	    std::aligned_storage<probe_type::node_sizes[0U], probe_type::node_alignments[0U]>::type,
+	    std::aligned_storage<probe_type::node_sizes[1U], probe_type::node_alignments[1U]>::type> slab_type;
+    typedef tco::bitwise_trie<std::uint32_t, std::string, slab_type> trie_type;
+    static_assert(probe_type::node_sizes[0U] == trie_type::node_sizes[0U] && probe_type::node_sizes[1U] == trie_type::node_sizes[1U],
+	    "node sizes depend on the allocator");
+    slab_type slab1(64U, 64U);
+    trie_type trie1(slab1);
+    for (std::uint32_t key = 0U; key < 1000U; ++key)
+    {
+	EXPECT_TRUE(std::get<1>(trie1.emplace(key * 7U, std::to_string(key)))) << "Emplace failed for key " << key;
+    }
+    EXPECT_EQ(1000U, trie1.size()) << "Trie has the wrong size";
+    for (std::uint32_t key = 0U; key < 1000U; ++key)
+    {
+	auto iter = trie1.find(key * 7U);
+	ASSERT_NE(trie1.cend(), iter) << "Could not find key " << key;
+	EXPECT_EQ(std::to_string(key), *iter) << "Wrong value for key " << key;
+    }
+}
+
+TEST(typed_slab_test, parallel_use)
+{
+    tme::typed_slab<std::uint32_t, std::uint64_t> slab1(1024U, 1024U);
+    std::vector<std::thread> threads;
+    for (std::uint32_t thread = 0U; thread < 4U; ++thread)
+    {
+	threads.emplace_back([&slab1, thread] () -> void
+	{
+	    std::vector<std::uint64_t*> values;
+	    for (std::uint32_t round = 0U; round < 100U; ++round)
+	    {
+		for (std::uint32_t count = 0U; count < 100U; ++count)
+		{
+		    std::uint64_t* value = slab1.allocate<std::uint64_t>();
+		    if (value != nullptr)
+		    {
+			*value = thread;
+			values.push_back(value);
+		    }
+		}
+		for (std::uint64_t* value : values)
+		{
+		    EXPECT_EQ(thread, *value) << "Value was overwritten by another thread";
+		    slab1.deallocate(value);
+		}
+		values.clear();
+	    }
+	});
+    }
+    for (auto&& thread : threads)
+    {
+	thread.join();
+    }
+}
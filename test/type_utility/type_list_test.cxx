@@ -0,0 +1,45 @@
+#include <turbo/type_utility/type_list.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace ttu = turbo::type_utility;
+
+namespace {
+
+template <class value_t, class other_t>
+struct same_size : std::integral_constant<bool, sizeof(value_t) == sizeof(other_t)>
+{ };
+
+} // anonymous namespace
+
+TEST(type_list_test, index_of_basic)
+{
+    static_assert(ttu::index_of<std::uint8_t, std::uint8_t, std::uint16_t, std::string>::value == 0U,
+	    "failed to find first type");
+    static_assert(ttu::index_of<std::string, std::uint8_t, std::uint16_t, std::string>::value == 2U,
+	    "failed to find last type");
+    static_assert(ttu::index_of<std::uint16_t, std::uint16_t, std::uint16_t>::value == 0U,
+	    "duplicate type did not resolve to its first position");
+    static_assert(ttu::index_of<std::uint32_t, std::uint8_t, std::uint16_t>::value == 2U,
+	    "missing type did not resolve to the list length");
+    static_assert(ttu::index_of<std::uint32_t>::value == 0U,
+	    "missing type did not resolve to the length of an empty list");
+}
+
+TEST(type_list_test, find_first_basic)
+{
+    static_assert(ttu::find_first<same_size, std::int16_t, std::uint8_t, std::uint16_t, std::uint32_t>::value == 1U,
+	    "failed to find type matching the predicate");
+    static_assert(ttu::find_first<same_size, std::uint64_t, std::uint8_t, std::uint16_t>::value == 2U,
+	    "type not matching the predicate resolved to a position in the list");
+}
+
+TEST(type_list_test, type_at_basic)
+{
+    static_assert(std::is_same<std::uint8_t, ttu::type_at<0U, std::uint8_t, std::uint16_t, std::string>::type>::value,
+	    "failed to get first type");
+    static_assert(std::is_same<std::string, ttu::type_at<2U, std::uint8_t, std::uint16_t, std::string>::type>::value,
+	    "failed to get last type");
+}